@@ -0,0 +1,163 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <NumericConcepts/Numeric.hpp>
+#include <NumericConcepts/Ranges.hpp>
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <ranges>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @file bench_common.hpp
+ * @brief Containers, precisions and arguments shared by the benchmarks.
+ * @details Each container holder owns n reproducible values of type T and
+ * exposes them through range(), so that one benchmark body can be
+ * instantiated for every container and precision.
+ */
+
+namespace NumericBenchmarks {
+
+using namespace NumericConcepts;
+
+/// Returns n reproducible values in [-1, 1).
+template <typename T>
+std::vector<T> values(std::size_t n) {
+  auto v = std::vector<T>(n);
+  auto state = std::uint32_t{12345};
+  auto next = [&]() {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<double>(state >> 8) / (1 << 23) - 1.0;
+  };
+  for (auto& x : v) {
+    if constexpr (Complex<T>) {
+      auto re = next();
+      x = T(re, next());
+    } else {
+      x = static_cast<T>(next());
+    }
+  }
+  return v;
+}
+
+template <typename T>
+struct Vector {
+  static constexpr const char* name = "vector";
+  std::vector<T> storage;
+  explicit Vector(std::size_t n) : storage{values<T>(n)} {}
+  std::vector<T>& range() { return storage; }
+};
+
+template <typename T>
+struct Deque {
+  static constexpr const char* name = "deque";
+  std::deque<T> storage;
+  explicit Deque(std::size_t n) {
+    auto v = values<T>(n);
+    storage.assign(v.begin(), v.end());
+  }
+  std::deque<T>& range() { return storage; }
+};
+
+template <typename T>
+struct List {
+  static constexpr const char* name = "list";
+  std::list<T> storage;
+  explicit List(std::size_t n) {
+    auto v = values<T>(n);
+    storage.assign(v.begin(), v.end());
+  }
+  std::list<T>& range() { return storage; }
+};
+
+template <typename T>
+struct Span {
+  static constexpr const char* name = "span";
+  std::vector<T> storage;
+  explicit Span(std::size_t n) : storage{values<T>(n)} {}
+  std::span<const T> range() { return storage; }
+};
+
+/// A random access view computing each element on the fly.
+template <typename T>
+struct View {
+  static constexpr const char* name = "transform_view";
+  std::vector<T> storage;
+  explicit View(std::size_t n) : storage{values<T>(n)} {}
+  auto range() { return storage | std::views::transform(std::negate<>{}); }
+};
+
+/// The name of a precision covered by Float, Double or LongDouble.
+template <typename T>
+std::string precision_name() {
+  using P = RemoveComplex<T>;
+  auto name = std::string{Float<P>    ? "float"
+                          : Double<P> ? "double"
+                                      : "long_double"};
+  return Complex<T> ? "complex_" + name : name;
+}
+
+/// Calls f.template operator()<C<T>>() for each container C and each real
+/// precision T covered by Float, Double and LongDouble.
+template <template <typename> typename... Containers, typename F>
+void for_each_real(F f) {
+  auto precisions = [&]<template <typename> typename C>() {
+    f.template operator()<C<float>>();
+    f.template operator()<C<double>>();
+    f.template operator()<C<long double>>();
+  };
+  (precisions.template operator()<Containers>(), ...);
+}
+
+/// Calls f.template operator()<C<std::complex<T>>>() for each container C
+/// and each precision T covered by Float, Double and LongDouble.
+template <template <typename> typename... Containers, typename F>
+void for_each_complex(F f) {
+  auto precisions = [&]<template <typename> typename C>() {
+    f.template operator()<C<std::complex<float>>>();
+    f.template operator()<C<std::complex<double>>>();
+    f.template operator()<C<std::complex<long double>>>();
+  };
+  (precisions.template operator()<Containers>(), ...);
+}
+
+/// The value type of a container holder.
+template <typename Holder>
+using HolderValue = std::ranges::range_value_t<
+    decltype(std::declval<Holder&>().range())>;
+
+/// Registers a benchmark named family/container/precision.
+template <typename Holder, typename Fn>
+benchmark::internal::Benchmark* register_benchmark(const std::string& family,
+                                                   Fn* fn) {
+  using T = HolderValue<Holder>;
+  auto name = family + "/" + Holder::name + "/" + precision_name<T>();
+  return benchmark::RegisterBenchmark(name.c_str(), fn);
+}
+
+/// Problem sizes and thread counts for the parallel benchmarks.
+inline void sizes_and_threads(benchmark::internal::Benchmark* b) {
+  auto hardware = static_cast<std::int64_t>(
+      std::max(1u, std::thread::hardware_concurrency()));
+  auto threads = std::vector<std::int64_t>{1, 2, 4};
+  if (hardware > 4) threads.push_back(hardware);
+  b->ArgsProduct({{1 << 12, 1 << 20}, threads})->ArgNames({"n", "threads"});
+  b->UseRealTime();
+}
+
+/// Problem sizes for the sequential baselines.
+inline void sizes(benchmark::internal::Benchmark* b) {
+  b->Args({1 << 12})->Args({1 << 20})->ArgNames({"n"});
+}
+
+}  // namespace NumericBenchmarks
@@ -0,0 +1,72 @@
+#include "bench_common.hpp"
+
+#include <NumericConcepts/Parallel.hpp>
+#include <NumericConcepts/Summation.hpp>
+
+/**
+ * @file bench_reduce.cpp
+ * @brief Reductions through parallel_reduce and sum over every container and
+ * precision, next to a hand-written loop over a std::vector.
+ */
+
+namespace NumericBenchmarks {
+namespace {
+
+template <typename Holder>
+void loop_reduce(benchmark::State& state) {
+  using T = HolderValue<Holder>;
+  auto holder = Holder(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto total = T{0};
+    for (auto x : holder.range()) total += x;
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Holder>
+void parallel_reduce_sum(benchmark::State& state) {
+  using T = HolderValue<Holder>;
+  auto holder = Holder(static_cast<std::size_t>(state.range(0)));
+  auto pool =
+      ThreadPool({.threads = static_cast<std::size_t>(state.range(1))});
+  for (auto _ : state) {
+    auto total = parallel_reduce(holder.range(), T{0}, std::plus<>{},
+                                 {.pool = &pool});
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Holder>
+void compensated_sum(benchmark::State& state) {
+  auto holder = Holder(static_cast<std::size_t>(state.range(0)));
+  auto threads = static_cast<std::size_t>(state.range(1));
+  for (auto _ : state) {
+    auto total = sum(holder.range(), NeumaierSum{}, threads);
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+const auto registered = [] {
+  auto baseline = []<typename Holder>() {
+    register_benchmark<Holder>("Reduce/loop", loop_reduce<Holder>)
+        ->Apply(sizes);
+  };
+  auto generic = []<typename Holder>() {
+    register_benchmark<Holder>("Reduce/parallel_reduce",
+                               parallel_reduce_sum<Holder>)
+        ->Apply(sizes_and_threads);
+    register_benchmark<Holder>("Reduce/sum", compensated_sum<Holder>)
+        ->Apply(sizes_and_threads);
+  };
+  for_each_real<Vector>(baseline);
+  for_each_complex<Vector>(baseline);
+  for_each_real<Vector, Deque, List, Span, View>(generic);
+  for_each_complex<Vector, Deque, List, Span, View>(generic);
+  return true;
+}();
+
+}  // namespace
+}  // namespace NumericBenchmarks
@@ -0,0 +1,75 @@
+#include "bench_common.hpp"
+
+#include <NumericConcepts/Sampling.hpp>
+#include <cmath>
+
+/**
+ * @file bench_sampling.cpp
+ * @brief Function sampling through sample() with scalar and batched
+ * functions over every grid container and precision, next to a hand-written
+ * loop over std::vectors.
+ */
+
+namespace NumericBenchmarks {
+namespace {
+
+constexpr auto gaussian = [](auto x) {
+  using std::exp;
+  return exp(-x * x);
+};
+
+template <typename Holder>
+void loop_sample(benchmark::State& state) {
+  using T = HolderValue<Holder>;
+  auto n = static_cast<std::size_t>(state.range(0));
+  auto holder = Holder(n);
+  auto out = std::vector<T>(n);
+  for (auto _ : state) {
+    auto& grid = holder.range();
+    for (auto i = std::size_t{0}; i < n; ++i) out[i] = gaussian(grid[i]);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Holder, bool Batched>
+void generic_sample(benchmark::State& state) {
+  using T = HolderValue<Holder>;
+  auto n = static_cast<std::size_t>(state.range(0));
+  auto holder = Holder(n);
+  auto out = std::vector<T>(n);
+  auto f = [] {
+    auto scalar = [](T x) { return gaussian(x); };
+    if constexpr (Batched) {
+      return as_batch(scalar);
+    } else {
+      return scalar;
+    }
+  }();
+  for (auto _ : state) {
+    sample(f, holder.range(), out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+const auto registered = [] {
+  auto baseline = []<typename Holder>() {
+    register_benchmark<Holder>("Sample/loop", loop_sample<Holder>)
+        ->Apply(sizes);
+  };
+  auto generic = []<typename Holder>() {
+    register_benchmark<Holder>("Sample/scalar", generic_sample<Holder, false>)
+        ->Apply(sizes);
+    register_benchmark<Holder>("Sample/batched", generic_sample<Holder, true>)
+        ->Apply(sizes);
+  };
+  for_each_real<Vector>(baseline);
+  for_each_real<Vector, Deque, List, Span, View>(generic);
+  return true;
+}();
+
+}  // namespace
+}  // namespace NumericBenchmarks
@@ -0,0 +1,69 @@
+#include "bench_common.hpp"
+
+#include <NumericConcepts/Parallel.hpp>
+
+/**
+ * @file bench_transform.cpp
+ * @brief Element-wise transforms through parallel_transform over every input
+ * container and precision, next to a hand-written loop over std::vectors.
+ */
+
+namespace NumericBenchmarks {
+namespace {
+
+// A cheap polynomial, so that the benchmarks measure traversal overhead.
+constexpr auto polynomial = [](auto x) {
+  using T = decltype(x);
+  return (x + T{2}) * x + T{1};
+};
+
+template <typename Holder>
+void loop_transform(benchmark::State& state) {
+  using T = HolderValue<Holder>;
+  auto n = static_cast<std::size_t>(state.range(0));
+  auto holder = Holder(n);
+  auto out = std::vector<T>(n);
+  for (auto _ : state) {
+    auto& in = holder.range();
+    for (auto i = std::size_t{0}; i < n; ++i) out[i] = polynomial(in[i]);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Holder>
+void generic_transform(benchmark::State& state) {
+  using T = HolderValue<Holder>;
+  auto n = static_cast<std::size_t>(state.range(0));
+  auto holder = Holder(n);
+  auto out = std::vector<T>(n);
+  auto pool =
+      ThreadPool({.threads = static_cast<std::size_t>(state.range(1))});
+  for (auto _ : state) {
+    parallel_transform(holder.range(), out, polynomial, {.pool = &pool});
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+const auto registered = [] {
+  auto baseline = []<typename Holder>() {
+    register_benchmark<Holder>("Transform/loop", loop_transform<Holder>)
+        ->Apply(sizes);
+  };
+  auto generic = []<typename Holder>() {
+    register_benchmark<Holder>("Transform/parallel_transform",
+                               generic_transform<Holder>)
+        ->Apply(sizes_and_threads);
+  };
+  for_each_real<Vector>(baseline);
+  for_each_complex<Vector>(baseline);
+  for_each_real<Vector, Deque, List, Span, View>(generic);
+  for_each_complex<Vector, Deque, List, Span, View>(generic);
+  return true;
+}();
+
+}  // namespace
+}  // namespace NumericBenchmarks
@@ -0,0 +1,93 @@
+#include <NumericConcepts/Numeric.hpp>
+#include <NumericConcepts/Ranges.hpp>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file compile_time_precision.cpp
+ * @brief A translation unit whose compile time measures the cost of the
+ * SamePrecision and SameRangePrecision concepts for a given pack size.
+ * @details It checks INSTANCES packs of a real type (or a range of it)
+ * followed by PACK_SIZE real or complex types of the same precision. Each
+ * pack uses its own real and complex types, registered through RealType and
+ * ComplexType, so that no check is answered from the compiler's cache of
+ * satisfied constraints.
+ * Compiling with CHECK_CONCEPTS=0 builds the same packs without checking
+ * them, giving the baseline to subtract. The compile_time_benchmark target
+ * compiles it for several pack sizes.
+ */
+
+#ifndef PACK_SIZE
+#define PACK_SIZE 8
+#endif
+
+#ifndef INSTANCES
+#define INSTANCES 256
+#endif
+
+#ifndef CHECK_CONCEPTS
+#define CHECK_CONCEPTS 1
+#endif
+
+namespace {
+
+// The real and complex types of pack I.
+template <std::size_t I>
+struct TaggedReal {
+  double value;
+};
+
+template <std::size_t I>
+struct TaggedComplex {
+  TaggedReal<I> re, im;
+};
+
+}  // namespace
+
+namespace NumericConcepts {
+
+template <std::size_t I>
+struct RealType<TaggedReal<I>> : public std::true_type {};
+
+template <std::size_t I>
+struct ComplexType<TaggedComplex<I>> : public std::true_type {
+  using value_type = TaggedReal<I>;
+};
+
+}  // namespace NumericConcepts
+
+namespace {
+
+using namespace NumericConcepts;
+
+// Type K of pack I alternates between the pack's real and complex types.
+template <std::size_t I, std::size_t K>
+using Scalar = std::conditional_t<K % 2 != 0, TaggedComplex<I>, TaggedReal<I>>;
+
+template <std::size_t I, std::size_t K>
+using Range = std::array<Scalar<I, K>, K + 1>;
+
+template <typename... Ts>
+struct Pack {};
+
+template <std::size_t I, std::size_t... Ks>
+constexpr bool check(std::index_sequence<Ks...>) {
+#if CHECK_CONCEPTS
+  return SamePrecision<TaggedReal<I>, Scalar<I, Ks>...> and
+         SameRangePrecision<std::array<TaggedReal<I>, 1>, Range<I, Ks>...>;
+#else
+  return sizeof(Pack<TaggedReal<I>, Scalar<I, Ks>...>) > 0 and
+         sizeof(Pack<std::array<TaggedReal<I>, 1>, Range<I, Ks>...>) > 0;
+#endif
+}
+
+template <std::size_t... Is>
+constexpr bool check_all(std::index_sequence<Is...>) {
+  return (check<Is>(std::make_index_sequence<PACK_SIZE>{}) and ...);
+}
+
+static_assert(check_all(std::make_index_sequence<INSTANCES>{}));
+
+}  // namespace
@@ -0,0 +1,73 @@
+# Measures how the compile time of benchmarks/compile_time_precision.cpp
+# grows with the pack size of the Same*Precision concepts.
+#
+# Run by the compile_time_benchmark target as
+#   cmake -DCXX=<compiler> -DCXX_ID=<compiler id> -DSOURCE=<file>
+#         -DINCLUDE_DIR=<dir> -DOUTPUT=<json file> -DPACK_SIZES=1|2|4
+#         -DINSTANCES=<n> -DREPETITIONS=<n> -P CompileTimeBenchmark.cmake
+#
+# Each configuration is compiled REPETITIONS times with and without the
+# concept checks, and the fastest time of each is kept. Sub-second
+# timestamps need CMake 3.23.
+
+cmake_minimum_required(VERSION 3.23)
+
+string(REPLACE "|" ";" PACK_SIZES "${PACK_SIZES}")
+
+if(CXX_ID STREQUAL "MSVC")
+    set(FLAGS /nologo /std:c++20 /Zs /I${INCLUDE_DIR})
+    set(DEFINE /D)
+else()
+    set(FLAGS -std=c++20 -fsyntax-only -I${INCLUDE_DIR})
+    set(DEFINE -D)
+endif()
+
+# Sets out_var to the fastest compile time in microseconds
+function(time_compile out_var pack_size check)
+    set(best -1)
+    foreach(repetition RANGE 1 ${REPETITIONS})
+        string(TIMESTAMP start "%s%f")
+        execute_process(
+            COMMAND ${CXX} ${FLAGS}
+                    ${DEFINE}PACK_SIZE=${pack_size}
+                    ${DEFINE}INSTANCES=${INSTANCES}
+                    ${DEFINE}CHECK_CONCEPTS=${check}
+                    ${SOURCE}
+            RESULT_VARIABLE result
+            ERROR_VARIABLE errors
+        )
+        string(TIMESTAMP stop "%s%f")
+        if(NOT result EQUAL 0)
+            message(FATAL_ERROR "Compiling with PACK_SIZE=${pack_size} failed:\n${errors}")
+        endif()
+        math(EXPR elapsed "${stop} - ${start}")
+        if(best LESS 0 OR elapsed LESS best)
+            set(best ${elapsed})
+        endif()
+    endforeach()
+    set(${out_var} ${best} PARENT_SCOPE)
+endfunction()
+
+message(STATUS "pack size   baseline (ms)   concepts (ms)   per check (us)")
+set(entries "")
+foreach(pack_size IN LISTS PACK_SIZES)
+    time_compile(baseline ${pack_size} 0)
+    time_compile(concepts ${pack_size} 1)
+    math(EXPR per_check "(${concepts} - ${baseline}) / ${INSTANCES}")
+    math(EXPR baseline_ms "${baseline} / 1000")
+    math(EXPR concepts_ms "${concepts} / 1000")
+    message(STATUS "${pack_size}\t    ${baseline_ms}\t\t    ${concepts_ms}\t\t    ${per_check}")
+    list(APPEND entries
+        "    {\"name\": \"SamePrecision/pack_size:${pack_size}\", \"pack_size\": ${pack_size}, \"baseline_us\": ${baseline}, \"concepts_us\": ${concepts}, \"per_check_us\": ${per_check}}")
+endforeach()
+
+list(JOIN entries ",\n" entries)
+file(WRITE ${OUTPUT}
+"{
+  \"context\": {\"compiler\": \"${CXX}\", \"instances\": ${INSTANCES}, \"repetitions\": ${REPETITIONS}},
+  \"benchmarks\": [
+${entries}
+  ]
+}
+")
+message(STATUS "Results written to ${OUTPUT}")
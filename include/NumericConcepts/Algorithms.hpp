@@ -0,0 +1,475 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+#include "Simd.hpp"
+
+/**
+ * @file Algorithms.hpp
+ * @brief Defines BLAS level-1 style algorithms over numeric ranges.
+ * @details Each algorithm accepts any real or complex range. When the
+ * arguments are contiguous real ranges of the same value type the work is
+ * done by a SIMD kernel, as it is for complex ranges in split layout (see
+ * SplitComplexRange). Otherwise a plain scalar loop over the iterators is
+ * used. Where two ranges are involved, only the first `min(size(x), size(y))`
+ * elements take part. Reductions are accumulated in AccumulatorPrecision, so
+ * 16-bit data is summed in float.
+ */
+
+namespace NumericConcepts {
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Concept for contiguous real ranges that can be passed to the SIMD
+ * kernels together.
+ */
+template <typename T, typename... Ts>
+concept SimdRealRanges =
+    ContiguousRealRange<T> and (ContiguousRealRange<Ts> and ...) and
+    SameRangeValueType<T, Ts...> and
+    std::same_as<AccumulatorPrecision<RangePrecision<T>>, RangePrecision<T>>;
+
+/**
+ * @internal
+ * @brief Concept for contiguous complex ranges whose data can be read as
+ * interleaved real and imaginary parts.
+ */
+template <typename T>
+concept SimdComplexRange =
+    ContiguousComplexRange<T> and
+    std::same_as<std::ranges::range_value_t<T>,
+                 std::complex<RangePrecision<T>>> and
+    std::same_as<AccumulatorPrecision<RangePrecision<T>>, RangePrecision<T>>;
+
+/**
+ * @internal
+ * @brief Concept for split complex ranges that can be passed to the SIMD
+ * kernels together.
+ */
+template <typename T, typename... Ts>
+concept SimdSplitRanges =
+    SplitComplexRange<T> and (SplitComplexRange<Ts> and ...) and
+    SameRangePrecision<T, Ts...> and
+    std::same_as<AccumulatorPrecision<RangePrecision<T>>, RangePrecision<T>>;
+
+/**
+ * @internal
+ * @brief Returns a pointer to the interleaved real and imaginary parts of a
+ * contiguous std::complex range.
+ */
+template <SimdComplexRange T>
+auto interleaved_data(T&& range) {
+  using Real = RangePrecision<T>;
+  using Pointer = std::conditional_t<
+      std::is_const_v<std::remove_reference_t<
+          std::ranges::range_reference_t<T>>>,
+      const Real*, Real*>;
+  return reinterpret_cast<Pointer>(std::ranges::data(range));
+}
+
+/**
+ * @internal
+ * @brief Converts a real or complex value, or a proxy to one, to the real or
+ * complex type V.
+ */
+template <RealOrComplex V, typename T>
+V numeric_cast(const T& value) {
+  if constexpr (Complex<V> and Complex<T>) {
+    using P = RemoveComplex<V>;
+    auto z = static_cast<std::complex<RemoveComplex<T>>>(value);
+    return V(static_cast<P>(z.real()), static_cast<P>(z.imag()));
+  } else if constexpr (Complex<V>) {
+    return V(static_cast<RemoveComplex<V>>(value));
+  } else {
+    return static_cast<V>(value);
+  }
+}
+
+/**
+ * @internal
+ * @brief Returns the common length of two sized ranges.
+ */
+template <typename T, typename U>
+std::size_t common_size(T&& x, U&& y) {
+  return std::min(static_cast<std::size_t>(std::ranges::size(x)),
+                  static_cast<std::size_t>(std::ranges::size(y)));
+}
+
+template <typename T>
+T dot_kernel(const T* x, const T* y, std::size_t n) {
+  using S = Simd<T>;
+  constexpr auto w = S::width;
+  // Loop bounds computed up front, which the compiler can bound, rather than
+  // conditions such as i + w <= n that it assumes may wrap.
+  auto m4 = n - n % (4 * w);
+  auto m = n - n % w;
+  auto s0 = S::zero(), s1 = S::zero(), s2 = S::zero(), s3 = S::zero();
+  auto i = std::size_t{0};
+  for (; i < m4; i += 4 * w) {
+    s0 = S::fma(S::load(x + i), S::load(y + i), s0);
+    s1 = S::fma(S::load(x + i + w), S::load(y + i + w), s1);
+    s2 = S::fma(S::load(x + i + 2 * w), S::load(y + i + 2 * w), s2);
+    s3 = S::fma(S::load(x + i + 3 * w), S::load(y + i + 3 * w), s3);
+  }
+  for (; i < m; i += w) {
+    s0 = S::fma(S::load(x + i), S::load(y + i), s0);
+  }
+  auto sum = S::reduce_add(S::add(S::add(s0, s1), S::add(s2, s3)));
+  for (; i < n; ++i) sum += x[i] * y[i];
+  return sum;
+}
+
+template <typename T>
+void axpy_kernel(T a, const T* x, T* y, std::size_t n) {
+  using S = Simd<T>;
+  constexpr auto w = S::width;
+  auto m = n - n % w;
+  auto va = S::set1(a);
+  auto i = std::size_t{0};
+  for (; i < m; i += w) {
+    S::store(y + i, S::fma(va, S::load(x + i), S::load(y + i)));
+  }
+  for (; i < n; ++i) y[i] += a * x[i];
+}
+
+template <typename T>
+void scal_kernel(T a, T* x, std::size_t n) {
+  using S = Simd<T>;
+  constexpr auto w = S::width;
+  auto m = n - n % w;
+  auto va = S::set1(a);
+  auto i = std::size_t{0};
+  for (; i < m; i += w) S::store(x + i, S::mul(va, S::load(x + i)));
+  for (; i < n; ++i) x[i] *= a;
+}
+
+template <typename T>
+T asum_kernel(const T* x, std::size_t n) {
+  using S = Simd<T>;
+  constexpr auto w = S::width;
+  auto m2 = n - n % (2 * w);
+  auto m = n - n % w;
+  auto s0 = S::zero(), s1 = S::zero();
+  auto i = std::size_t{0};
+  for (; i < m2; i += 2 * w) {
+    s0 = S::add(S::abs(S::load(x + i)), s0);
+    s1 = S::add(S::abs(S::load(x + i + w)), s1);
+  }
+  for (; i < m; i += w) s0 = S::add(S::abs(S::load(x + i)), s0);
+  auto sum = S::reduce_add(S::add(s0, s1));
+  for (; i < n; ++i) sum += std::abs(x[i]);
+  return sum;
+}
+
+/**
+ * @internal
+ * @brief Accumulates a value into an overflow- and underflow-safe sum of
+ * squares held as `scale * scale * ssq`.
+ */
+template <typename T>
+void scaled_sumsq(T value, T& scale, T& ssq) {
+  if (value == T{0}) return;
+  auto a = std::abs(value);
+  if (scale < a) {
+    auto r = scale / a;
+    ssq = T{1} + ssq * r * r;
+    scale = a;
+  } else {
+    auto r = a / scale;
+    ssq += r * r;
+  }
+}
+
+/**
+ * @internal
+ * @brief Computes the norm of the concatenation of the given arrays.
+ * @details A fast sum of squares is used unless it overflows or is small
+ * enough to have lost accuracy, in which case the arrays are rescanned with
+ * scaling.
+ */
+template <typename T, std::same_as<const T*>... Ts>
+T nrm2_kernel(std::size_t n, const T* x, Ts... xs) {
+  auto sumsq = (dot_kernel(x, x, n) + ... + dot_kernel(xs, xs, n));
+  constexpr auto small =
+      std::numeric_limits<T>::min() / std::numeric_limits<T>::epsilon();
+  if (std::isfinite(sumsq) && sumsq >= small) return std::sqrt(sumsq);
+  auto scale = T{0}, ssq = T{1};
+  for (auto p : {x, xs...}) {
+    for (auto i = std::size_t{0}; i < n; ++i) scaled_sumsq(p[i], scale, ssq);
+  }
+  return scale * std::sqrt(ssq);
+}
+
+/**
+ * @internal
+ * @brief Computes y = a * x + y for complex a and split complex x and y.
+ */
+template <typename T>
+void split_axpy_kernel(T ar, T ai, const T* xr, const T* xi, T* yr, T* yi,
+                       std::size_t n) {
+  using S = Simd<T>;
+  constexpr auto w = S::width;
+  auto m = n - n % w;
+  auto var = S::set1(ar), vai = S::set1(ai);
+  auto i = std::size_t{0};
+  for (; i < m; i += w) {
+    auto vxr = S::load(xr + i), vxi = S::load(xi + i);
+    S::store(yr + i, S::fma(var, vxr, S::sub(S::load(yr + i),
+                                             S::mul(vai, vxi))));
+    S::store(yi + i, S::fma(var, vxi, S::fma(vai, vxr, S::load(yi + i))));
+  }
+  for (; i < n; ++i) {
+    auto re = xr[i], im = xi[i];
+    yr[i] += ar * re - ai * im;
+    yi[i] += ar * im + ai * re;
+  }
+}
+
+/**
+ * @internal
+ * @brief Computes x = a * x for complex a and split complex x.
+ */
+template <typename T>
+void split_scal_kernel(T ar, T ai, T* xr, T* xi, std::size_t n) {
+  using S = Simd<T>;
+  constexpr auto w = S::width;
+  auto m = n - n % w;
+  auto var = S::set1(ar), vai = S::set1(ai);
+  auto i = std::size_t{0};
+  for (; i < m; i += w) {
+    auto vxr = S::load(xr + i), vxi = S::load(xi + i);
+    S::store(xr + i, S::sub(S::mul(var, vxr), S::mul(vai, vxi)));
+    S::store(xi + i, S::fma(var, vxi, S::mul(vai, vxr)));
+  }
+  for (; i < n; ++i) {
+    auto re = xr[i], im = xi[i];
+    xr[i] = ar * re - ai * im;
+    xi[i] = ar * im + ai * re;
+  }
+}
+
+}  // namespace Detail
+
+/**
+ * @brief Computes the unconjugated dot product, sum of x[i] * y[i].
+ * @tparam X The RealOrComplexRange type of the first argument.
+ * @tparam Y The RealOrComplexRange type of the second argument.
+ * @param x The first range.
+ * @param y The second range.
+ * @return The dot product. This is real if both ranges are real, and complex
+ * otherwise.
+ */
+template <RealOrComplexRange X, RealOrComplexRange Y>
+  requires SameRangePrecision<X, Y>
+auto dot(X&& x, Y&& y) {
+  using Real = AccumulatorPrecision<RangePrecision<X>>;
+  using Value = std::conditional_t<RealRange<X> and RealRange<Y>, Real,
+                                   std::complex<Real>>;
+  if constexpr (Detail::SimdRealRanges<X, Y>) {
+    return Detail::dot_kernel(std::ranges::data(x), std::ranges::data(y),
+                              Detail::common_size(x, y));
+  } else if constexpr (Detail::SimdSplitRanges<X, Y>) {
+    auto n = Detail::common_size(x, y);
+    auto xr = x.real_data(), xi = x.imag_data();
+    auto yr = y.real_data(), yi = y.imag_data();
+    return Value{Detail::dot_kernel(xr, yr, n) - Detail::dot_kernel(xi, yi, n),
+                 Detail::dot_kernel(xr, yi, n) + Detail::dot_kernel(xi, yr, n)};
+  } else {
+    auto sum = Value{0};
+    auto xi = std::ranges::begin(x);
+    auto yi = std::ranges::begin(y);
+    for (; xi != std::ranges::end(x) && yi != std::ranges::end(y);
+         ++xi, ++yi) {
+      sum += Detail::numeric_cast<Value>(*xi) *
+             Detail::numeric_cast<Value>(*yi);
+    }
+    return sum;
+  }
+}
+
+/**
+ * @brief Computes the conjugated dot product, sum of conj(x[i]) * y[i].
+ * @details For real ranges this is identical to dot.
+ * @tparam X The RealOrComplexRange type of the first argument.
+ * @tparam Y The RealOrComplexRange type of the second argument.
+ * @param x The range to be conjugated.
+ * @param y The second range.
+ * @return The conjugated dot product.
+ */
+template <RealOrComplexRange X, RealOrComplexRange Y>
+  requires SameRangePrecision<X, Y>
+auto dotc(X&& x, Y&& y) {
+  if constexpr (RealRange<X>) {
+    return dot(std::forward<X>(x), std::forward<Y>(y));
+  } else if constexpr (Detail::SimdSplitRanges<X, Y>) {
+    auto n = Detail::common_size(x, y);
+    auto xr = x.real_data(), xi = x.imag_data();
+    auto yr = y.real_data(), yi = y.imag_data();
+    return std::complex<RangePrecision<X>>{
+        Detail::dot_kernel(xr, yr, n) + Detail::dot_kernel(xi, yi, n),
+        Detail::dot_kernel(xr, yi, n) - Detail::dot_kernel(xi, yr, n)};
+  } else {
+    using Value = std::complex<AccumulatorPrecision<RangePrecision<X>>>;
+    auto sum = Value{0};
+    auto xi = std::ranges::begin(x);
+    auto yi = std::ranges::begin(y);
+    for (; xi != std::ranges::end(x) && yi != std::ranges::end(y);
+         ++xi, ++yi) {
+      sum += std::conj(Detail::numeric_cast<Value>(*xi)) *
+             Detail::numeric_cast<Value>(*yi);
+    }
+    return sum;
+  }
+}
+
+/**
+ * @brief Computes y = a * x + y in place.
+ * @details A complex x can only be added into a complex y.
+ * @tparam S The scalar type, convertible to the value type of Y.
+ * @tparam X The RealOrComplexRange type of x.
+ * @tparam Y The RealOrComplexWritableRange type of y.
+ * @param a The scalar multiplier.
+ * @param x The range to be scaled and added.
+ * @param y The range to be updated.
+ */
+template <typename S, RealOrComplexRange X, RealOrComplexWritableRange Y>
+  requires SameRangePrecision<X, Y> and (RealRange<X> or ComplexRange<Y>) and
+           std::convertible_to<S, std::ranges::range_value_t<Y>>
+void axpy(S a, X&& x, Y&& y) {
+  using Value = std::ranges::range_value_t<Y>;
+  if constexpr (Detail::SimdRealRanges<X, Y>) {
+    Detail::axpy_kernel(static_cast<Value>(a), std::ranges::data(x),
+                        std::ranges::data(y), Detail::common_size(x, y));
+  } else if constexpr (Detail::SimdSplitRanges<X, Y> and
+                       SplitComplexWritableRange<Y>) {
+    auto alpha = static_cast<Value>(a);
+    Detail::split_axpy_kernel(alpha.real(), alpha.imag(), x.real_data(),
+                              x.imag_data(), y.real_data(), y.imag_data(),
+                              Detail::common_size(x, y));
+  } else {
+    auto alpha = static_cast<Value>(a);
+    auto xi = std::ranges::begin(x);
+    auto yi = std::ranges::begin(y);
+    for (; xi != std::ranges::end(x) && yi != std::ranges::end(y);
+         ++xi, ++yi) {
+      *yi = static_cast<Value>(*yi) + alpha * static_cast<Value>(*xi);
+    }
+  }
+}
+
+/**
+ * @brief Computes x = a * x in place.
+ * @tparam S The scalar type, convertible to the value type of X.
+ * @tparam X The RealOrComplexWritableRange type of x.
+ * @param a The scalar multiplier.
+ * @param x The range to be scaled.
+ */
+template <typename S, RealOrComplexWritableRange X>
+  requires std::convertible_to<S, std::ranges::range_value_t<X>>
+void scal(S a, X&& x) {
+  using Value = std::ranges::range_value_t<X>;
+  if constexpr (Detail::SimdRealRanges<X>) {
+    Detail::scal_kernel(static_cast<Value>(a), std::ranges::data(x),
+                        static_cast<std::size_t>(std::ranges::size(x)));
+  } else if constexpr (Detail::SimdComplexRange<X> and Real<S>) {
+    Detail::scal_kernel(static_cast<RangePrecision<X>>(a),
+                        Detail::interleaved_data(x),
+                        2 * static_cast<std::size_t>(std::ranges::size(x)));
+  } else if constexpr (SplitComplexWritableRange<X>) {
+    auto alpha = static_cast<Value>(a);
+    Detail::split_scal_kernel(alpha.real(), alpha.imag(), x.real_data(),
+                              x.imag_data(),
+                              static_cast<std::size_t>(std::ranges::size(x)));
+  } else {
+    auto alpha = static_cast<Value>(a);
+    for (auto xi = std::ranges::begin(x); xi != std::ranges::end(x); ++xi) {
+      *xi = alpha * static_cast<Value>(*xi);
+    }
+  }
+}
+
+/**
+ * @brief Computes the Euclidean norm of a range.
+ * @details The result is computed without destructive overflow or underflow
+ * in intermediate sums of squares.
+ * @tparam X The RealOrComplexRange type.
+ * @param x The range.
+ * @return The norm, in the AccumulatorPrecision of the range.
+ */
+template <RealOrComplexRange X>
+auto nrm2(X&& x) {
+  using Real = AccumulatorPrecision<RangePrecision<X>>;
+  if constexpr (Detail::SimdRealRanges<X>) {
+    return Detail::nrm2_kernel(static_cast<std::size_t>(std::ranges::size(x)),
+                               std::ranges::data(x));
+  } else if constexpr (Detail::SimdComplexRange<X>) {
+    return Detail::nrm2_kernel(
+        2 * static_cast<std::size_t>(std::ranges::size(x)),
+        Detail::interleaved_data(x));
+  } else if constexpr (Detail::SimdSplitRanges<X>) {
+    return Detail::nrm2_kernel(static_cast<std::size_t>(std::ranges::size(x)),
+                               static_cast<const Real*>(x.real_data()),
+                               static_cast<const Real*>(x.imag_data()));
+  } else {
+    auto scale = Real{0}, ssq = Real{1};
+    for (auto&& value : x) {
+      if constexpr (RealRange<X>) {
+        Detail::scaled_sumsq(static_cast<Real>(value), scale, ssq);
+      } else {
+        auto z = Detail::numeric_cast<std::complex<Real>>(value);
+        Detail::scaled_sumsq(z.real(), scale, ssq);
+        Detail::scaled_sumsq(z.imag(), scale, ssq);
+      }
+    }
+    return scale * std::sqrt(ssq);
+  }
+}
+
+/**
+ * @brief Computes the sum of absolute values of a range.
+ * @details Following BLAS, the absolute value of a complex element is taken
+ * to be |re| + |im|.
+ * @tparam X The RealOrComplexRange type.
+ * @param x The range.
+ * @return The sum, in the AccumulatorPrecision of the range.
+ */
+template <RealOrComplexRange X>
+auto asum(X&& x) {
+  using Real = AccumulatorPrecision<RangePrecision<X>>;
+  if constexpr (Detail::SimdRealRanges<X>) {
+    return Detail::asum_kernel(std::ranges::data(x),
+                               static_cast<std::size_t>(std::ranges::size(x)));
+  } else if constexpr (Detail::SimdComplexRange<X>) {
+    return Detail::asum_kernel(
+        Detail::interleaved_data(x),
+        2 * static_cast<std::size_t>(std::ranges::size(x)));
+  } else if constexpr (Detail::SimdSplitRanges<X>) {
+    auto n = static_cast<std::size_t>(std::ranges::size(x));
+    return Detail::asum_kernel(x.real_data(), n) +
+           Detail::asum_kernel(x.imag_data(), n);
+  } else {
+    auto sum = Real{0};
+    for (auto&& value : x) {
+      if constexpr (RealRange<X>) {
+        sum += std::abs(static_cast<Real>(value));
+      } else {
+        auto z = Detail::numeric_cast<std::complex<Real>>(value);
+        sum += std::abs(z.real()) + std::abs(z.imag());
+      }
+    }
+    return sum;
+  }
+}
+
+}  // namespace NumericConcepts
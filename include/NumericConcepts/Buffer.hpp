@@ -0,0 +1,325 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+
+/**
+ * @file Buffer.hpp
+ * @brief Defines an aligned numeric buffer backed by a pluggable memory
+ * resource, and an arena resource for short-lived buffers.
+ * @details NumericBuffer allocates through a `std::pmr::memory_resource`, so
+ * it can draw from a NumericArena, a `std::pmr::unsynchronized_pool_resource`
+ * or any other resource. Its storage is always aligned to
+ * NumericBuffer::alignment bytes.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief Tag type requesting that new elements are left uninitialized.
+ */
+struct UninitializedTag {
+  explicit UninitializedTag() = default;
+};
+
+/**
+ * @brief Tag value requesting that new elements are left uninitialized.
+ * @details Numeric types are implicit-lifetime types, so the elements exist
+ * once the storage is allocated, but their values are unspecified until
+ * written.
+ */
+inline constexpr UninitializedTag Uninitialized{};
+
+/**
+ * @brief A memory resource that hands out memory by bumping a pointer
+ * through large chunks.
+ * @details Deallocation is a no-op. Calling reset() makes all of the memory
+ * available again without returning it to the upstream resource, so a loop
+ * that allocates the same temporaries on each iteration stops allocating
+ * after the first. The arena is not thread-safe.
+ */
+class NumericArena : public std::pmr::memory_resource {
+ public:
+  /**
+   * @brief Constructs an arena.
+   * @param chunk_size The size in bytes of the first chunk requested from
+   * upstream. Later chunks double in size.
+   * @param upstream The resource from which chunks are obtained.
+   */
+  explicit NumericArena(
+      std::size_t chunk_size = 1 << 20,
+      std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+      : _next_size{std::max<std::size_t>(chunk_size, 64)},
+        _upstream{upstream} {}
+
+  NumericArena(const NumericArena&) = delete;
+  NumericArena& operator=(const NumericArena&) = delete;
+
+  ~NumericArena() override { release(); }
+
+  /**
+   * @brief Makes all memory handed out so far available for reuse.
+   * @details Memory previously returned by the arena must no longer be used.
+   */
+  void reset() {
+    _current = 0;
+    _offset = 0;
+  }
+
+  /**
+   * @brief Returns all chunks to the upstream resource.
+   */
+  void release() {
+    for (auto& chunk : _chunks) {
+      _upstream->deallocate(chunk.data, chunk.size, chunk.alignment);
+    }
+    _chunks.clear();
+    reset();
+  }
+
+  /// The total number of bytes held from the upstream resource.
+  std::size_t capacity() const {
+    auto total = std::size_t{0};
+    for (auto& chunk : _chunks) total += chunk.size;
+    return total;
+  }
+
+  std::pmr::memory_resource* upstream_resource() const { return _upstream; }
+
+ private:
+  static constexpr std::size_t ChunkAlignment = 64;
+
+  struct Chunk {
+    std::byte* data;
+    std::size_t size;
+    std::size_t alignment;
+  };
+
+  std::vector<Chunk> _chunks;
+  std::size_t _current = 0;
+  std::size_t _offset = 0;
+  std::size_t _next_size;
+  std::pmr::memory_resource* _upstream;
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    bytes = std::max<std::size_t>(bytes, 1);
+    for (; _current < _chunks.size(); ++_current, _offset = 0) {
+      auto& chunk = _chunks[_current];
+      // Align the address itself, as a chunk may be less aligned than the
+      // request.
+      auto address = reinterpret_cast<std::uintptr_t>(chunk.data) + _offset;
+      auto start = _offset + (alignment - address % alignment) % alignment;
+      if (start <= chunk.size && bytes <= chunk.size - start) {
+        _offset = start + bytes;
+        return chunk.data + start;
+      }
+    }
+    auto size = std::max(_next_size, bytes + alignment);
+    auto chunk_alignment = std::max(alignment, ChunkAlignment);
+    auto data =
+        static_cast<std::byte*>(_upstream->allocate(size, chunk_alignment));
+    _chunks.push_back({data, size, chunk_alignment});
+    _next_size = 2 * size;
+    _current = _chunks.size() - 1;
+    _offset = bytes;
+    return data;
+  }
+
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const
+      noexcept override {
+    return this == &other;
+  }
+};
+
+/**
+ * @brief A contiguous, aligned buffer of numeric values that allocates from
+ * a std::pmr::memory_resource.
+ * @details The buffer satisfies NumericWritableRange, ContiguousRange and
+ * AlignedRange<NumericBuffer<T>, 64>. Elements can be left uninitialized
+ * by passing Uninitialized, and clear() keeps the storage for reuse.
+ * @tparam T The Numeric element type.
+ */
+template <Numeric T>
+class NumericBuffer {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  /// Alignment in bytes of the buffer's storage.
+  static constexpr std::size_t alignment = 64;
+
+  explicit NumericBuffer(
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : _resource{resource} {}
+
+  /// Constructs a buffer of n value-initialized elements.
+  explicit NumericBuffer(
+      size_type n,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : NumericBuffer(n, T{}, resource) {}
+
+  /// Constructs a buffer of n copies of value.
+  NumericBuffer(
+      size_type n, const T& value,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : NumericBuffer(n, Uninitialized, resource) {
+    std::fill_n(_data, n, value);
+  }
+
+  /// Constructs a buffer of n uninitialized elements.
+  NumericBuffer(
+      size_type n, UninitializedTag,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : NumericBuffer(resource) {
+    reserve(n);
+    _size = n;
+  }
+
+  /// Constructs a buffer holding a copy of a range.
+  template <NumericRange R>
+    requires std::convertible_to<std::ranges::range_value_t<R>, T> &&
+             (!std::same_as<std::remove_cvref_t<R>, NumericBuffer>)
+  explicit NumericBuffer(
+      R&& range,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : NumericBuffer(resource) {
+    if constexpr (std::ranges::sized_range<R>) {
+      reserve(static_cast<size_type>(std::ranges::size(range)));
+    }
+    for (auto&& value : range) push_back(static_cast<T>(value));
+  }
+
+  /// Copies a buffer, allocating from the same resource.
+  NumericBuffer(const NumericBuffer& other)
+      : NumericBuffer(other._size, Uninitialized, other._resource) {
+    std::copy_n(other._data, _size, _data);
+  }
+
+  NumericBuffer(NumericBuffer&& other) noexcept
+      : _data{std::exchange(other._data, nullptr)},
+        _size{std::exchange(other._size, 0)},
+        _capacity{std::exchange(other._capacity, 0)},
+        _resource{other._resource} {}
+
+  NumericBuffer& operator=(const NumericBuffer& other) {
+    if (this != &other) {
+      resize(other._size, Uninitialized);
+      std::copy_n(other._data, _size, _data);
+    }
+    return *this;
+  }
+
+  NumericBuffer& operator=(NumericBuffer&& other) noexcept {
+    if (this != &other) {
+      deallocate();
+      _data = std::exchange(other._data, nullptr);
+      _size = std::exchange(other._size, 0);
+      _capacity = std::exchange(other._capacity, 0);
+      _resource = other._resource;
+    }
+    return *this;
+  }
+
+  ~NumericBuffer() { deallocate(); }
+
+  size_type size() const { return _size; }
+  size_type capacity() const { return _capacity; }
+  bool empty() const { return _size == 0; }
+  std::pmr::memory_resource* resource() const { return _resource; }
+
+  T* data() { return _data; }
+  const T* data() const { return _data; }
+
+  T& operator[](size_type i) { return _data[i]; }
+  const T& operator[](size_type i) const { return _data[i]; }
+
+  iterator begin() { return _data; }
+  iterator end() { return _data + _size; }
+  const_iterator begin() const { return _data; }
+  const_iterator end() const { return _data + _size; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  /// Ensures storage for at least n elements, preserving the contents.
+  void reserve(size_type n) {
+    if (n <= _capacity) return;
+    auto data = static_cast<T*>(_resource->allocate(n * sizeof(T), alignment));
+    auto size = _size;
+    if (size > 0) std::memcpy(data, _data, size * sizeof(T));
+    deallocate();
+    _data = data;
+    _size = size;
+    _capacity = n;
+  }
+
+  /// Resizes the buffer, value-initializing any new elements.
+  void resize(size_type n) { resize(n, T{}); }
+
+  /// Resizes the buffer, setting any new elements to value.
+  void resize(size_type n, const T& value) {
+    // Copied first, since value may be an element that reallocation frees.
+    auto copy = value;
+    auto old = _size;
+    resize(n, Uninitialized);
+    if (n > old) std::fill(_data + old, _data + n, copy);
+  }
+
+  /// Resizes the buffer, leaving any new elements uninitialized.
+  void resize(size_type n, UninitializedTag) {
+    reserve(n);
+    _size = n;
+  }
+
+  void push_back(const T& value) {
+    auto copy = value;
+    if (_size == _capacity) reserve(std::max<size_type>(16, 2 * _capacity));
+    _data[_size++] = copy;
+  }
+
+  /// Removes all elements, keeping the storage for reuse.
+  void clear() { _size = 0; }
+
+  /// Returns the storage to the memory resource.
+  void shrink_to_fit() {
+    if (_size == _capacity) return;
+    auto other = NumericBuffer(_size, Uninitialized, _resource);
+    std::copy_n(_data, _size, other._data);
+    *this = std::move(other);
+  }
+
+ private:
+  T* _data = nullptr;
+  size_type _size = 0;
+  size_type _capacity = 0;
+  std::pmr::memory_resource* _resource;
+
+  void deallocate() {
+    if (_data) _resource->deallocate(_data, _capacity * sizeof(T), alignment);
+    _data = nullptr;
+    _size = 0;
+    _capacity = 0;
+  }
+};
+
+}  // namespace NumericConcepts
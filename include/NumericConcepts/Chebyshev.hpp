@@ -0,0 +1,335 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Functions.hpp"
+#include "Numeric.hpp"
+#include "Parallel.hpp"
+#include "Ranges.hpp"
+#include "Threading.hpp"
+
+/**
+ * @file Chebyshev.hpp
+ * @brief Defines piecewise Chebyshev interpolants that stand in for
+ * expensive real or complex functions of a real variable.
+ * @details chebyshev_proxy() samples a function at Chebyshev–Lobatto points,
+ * doubling the number of points on each interval until the trailing
+ * Chebyshev coefficients fall below the tolerance, and bisecting intervals
+ * on which that does not happen. The resulting ChebyshevProxy is evaluated
+ * by the Clenshaw recurrence and satisfies the same function concept as the
+ * original, so it can replace the function at existing call sites.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief Options for building a Chebyshev proxy.
+ */
+struct ChebyshevOptions {
+  /// Tolerance relative to the largest coefficient on each interval, zero
+  /// meaning sixteen times the machine epsilon.
+  double tolerance = 0;
+  /// The maximum number of sample points per interval, rounded down to one
+  /// more than a power of two.
+  std::size_t max_points = 257;
+  /// The maximum number of intervals.
+  std::size_t max_pieces = 64;
+  /// Grain size and pool used to sample the function in parallel.
+  ParallelOptions parallel = {.grain = 4};
+};
+
+/**
+ * @brief A piecewise Chebyshev interpolant of a function on an interval.
+ * @details Points outside the interval are evaluated by extrapolating the
+ * polynomial on the nearest end interval, which quickly loses accuracy.
+ * @tparam T The floating-point argument type.
+ * @tparam V The real or complex value type, of precision T.
+ */
+template <std::floating_point T, RealOrComplex V>
+  requires std::same_as<RemoveComplex<V>, T>
+class ChebyshevProxy {
+ public:
+  using argument_type = T;
+  using value_type = V;
+
+  ChebyshevProxy() = default;
+
+  /**
+   * @brief Constructs a proxy from the coefficients on each interval.
+   * @param breaks The increasing interval end points, one more than the
+   * number of intervals.
+   * @param coefficients The Chebyshev coefficients on each interval.
+   * @param converged Whether every interval met the tolerance.
+   */
+  ChebyshevProxy(std::vector<T> breaks,
+                 const std::vector<std::vector<V>>& coefficients,
+                 bool converged = true)
+      : _breaks{std::move(breaks)}, _converged{converged} {
+    if (_breaks.size() != coefficients.size() + 1 || coefficients.empty()) {
+      throw std::invalid_argument("ChebyshevProxy: mismatched intervals");
+    }
+    for (auto& c : coefficients) _stride = std::max(_stride, c.size());
+    _coefficients.assign(coefficients.size() * _stride, V{0});
+    for (auto p = std::size_t{0}; p < coefficients.size(); ++p) {
+      std::ranges::copy(coefficients[p], _coefficients.begin() + p * _stride);
+      auto a = _breaks[p], b = _breaks[p + 1];
+      _scale.push_back(T{2} / (b - a));
+      _shift.push_back(-(a + b) / (b - a));
+    }
+  }
+
+  /// Evaluates the interpolant at x.
+  V operator()(T x) const {
+    auto p = piece(x);
+    auto t = x * _scale[p] + _shift[p];
+    auto c = _coefficients.data() + p * _stride;
+    auto b1 = V{0}, b2 = V{0};
+    for (auto k = _stride; k-- > 1;) {
+      auto b0 = c[k] + T{2} * t * b1 - b2;
+      b2 = b1;
+      b1 = b0;
+    }
+    return c[0] + t * b1 - b2;
+  }
+
+  /**
+   * @brief Evaluates the interpolant at many points.
+   * @details Points are processed in blocks, with the Clenshaw recurrence
+   * stepping all points of a block together so that the inner loop
+   * vectorizes. Evaluation stops when either range is exhausted.
+   * @param x The points.
+   * @param out The range to write the values to.
+   * @return The number of values written.
+   */
+  template <RealRange In, RealOrComplexWritableRange Out>
+    requires std::indirectly_writable<std::ranges::iterator_t<Out>, V>
+  std::size_t evaluate(In&& x, Out&& out) const {
+    constexpr auto block = std::size_t{64};
+    T t[block];
+    std::size_t offset[block];
+    V b1[block], b2[block];
+
+    auto xi = std::ranges::begin(x);
+    auto oi = std::ranges::begin(out);
+    auto count = std::size_t{0};
+    while (xi != std::ranges::end(x) && oi != std::ranges::end(out)) {
+      auto m = std::size_t{0};
+      for (; m < block && xi != std::ranges::end(x); ++m, ++xi) {
+        auto value = static_cast<T>(*xi);
+        auto p = piece(value);
+        t[m] = value * _scale[p] + _shift[p];
+        offset[m] = p * _stride;
+        b1[m] = V{0};
+        b2[m] = V{0};
+      }
+      for (auto k = _stride; k-- > 1;) {
+        for (auto j = std::size_t{0}; j < m; ++j) {
+          auto c = _coefficients[offset[j] + k];
+          auto b0 = c + T{2} * t[j] * b1[j] - b2[j];
+          b2[j] = b1[j];
+          b1[j] = b0;
+        }
+      }
+      auto j = std::size_t{0};
+      for (; j < m && oi != std::ranges::end(out); ++j, ++oi) {
+        *oi = _coefficients[offset[j]] + t[j] * b1[j] - b2[j];
+      }
+      count += j;
+    }
+    return count;
+  }
+
+  /**
+   * @brief Evaluates the interpolant at many points, so that the proxy
+   * satisfies BatchRealFunction or BatchComplexFunction.
+   * @param x The points.
+   * @param out The range to write the values to.
+   */
+  template <RealOrComplexWritableRange Out>
+    requires std::indirectly_writable<std::ranges::iterator_t<Out>, V>
+  void operator()(std::span<const T> x, Out&& out) const {
+    evaluate(x, std::forward<Out>(out));
+  }
+
+  /// The number of intervals.
+  std::size_t pieces() const { return _scale.size(); }
+
+  /// The largest number of coefficients on any interval.
+  std::size_t max_coefficients() const { return _stride; }
+
+  /// The interval end points.
+  std::span<const T> breaks() const { return _breaks; }
+
+  /// The Chebyshev coefficients on interval p, padded with zeros.
+  std::span<const V> coefficients(std::size_t p) const {
+    return std::span<const V>(_coefficients).subspan(p * _stride, _stride);
+  }
+
+  /// Whether every interval met the tolerance.
+  bool converged() const { return _converged; }
+
+ private:
+  std::vector<T> _breaks;
+  std::vector<V> _coefficients;
+  std::vector<T> _scale;
+  std::vector<T> _shift;
+  std::size_t _stride = 0;
+  bool _converged = true;
+
+  std::size_t piece(T x) const {
+    auto first = _breaks.begin() + 1;
+    auto last = _breaks.end() - 1;
+    return static_cast<std::size_t>(std::upper_bound(first, last, x) - first);
+  }
+};
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Computes Chebyshev coefficients from values at the n
+ * Chebyshev–Lobatto points cos(pi j / (n - 1)) by a direct DCT-I.
+ */
+template <typename T, typename V>
+std::vector<V> chebyshev_coefficients(const std::vector<V>& values) {
+  auto n = values.size();
+  auto N = n - 1;
+  auto cosines = std::vector<T>(2 * N);
+  for (auto m = std::size_t{0}; m < 2 * N; ++m) {
+    cosines[m] = std::cos(std::numbers::pi_v<T> * static_cast<T>(m) /
+                          static_cast<T>(N));
+  }
+  auto c = std::vector<V>(n, V{0});
+  for (auto k = std::size_t{0}; k < n; ++k) {
+    auto sum = V{0};
+    for (auto j = std::size_t{0}; j < n; ++j) {
+      auto term = values[j] * cosines[(j * k) % (2 * N)];
+      sum += (j == 0 || j == N) ? term / T{2} : term;
+    }
+    c[k] = sum * (T{2} / static_cast<T>(N));
+  }
+  c.front() /= T{2};
+  c.back() /= T{2};
+  return c;
+}
+
+/**
+ * @internal
+ * @brief Builds the coefficients on [a, b] with up to max_points points,
+ * setting converged to whether the tolerance was met.
+ */
+template <typename T, typename V, typename F>
+std::vector<V> chebyshev_piece(F& f, T a, T b, T tolerance,
+                               std::size_t max_points,
+                               const ParallelOptions& parallel,
+                               bool& converged) {
+  auto& pool = options_pool(parallel);
+  auto values = std::vector<V>{};
+  auto c = std::vector<V>{};
+  converged = false;
+  for (auto n = std::size_t{17}; n <= max_points && !converged;
+       n = 2 * n - 1) {
+    // The points for n include those for the previous n at even indices.
+    auto next = std::vector<V>(n);
+    for (auto j = std::size_t{0}; j < values.size(); ++j) {
+      next[2 * j] = values[j];
+    }
+    auto fresh = values.empty();
+    auto N = static_cast<T>(n - 1);
+    parallel_range(pool, n, parallel.grain,
+                   [&](std::size_t lo, std::size_t hi) {
+                     for (auto j = lo; j < hi; ++j) {
+                       if (!fresh && j % 2 == 0) continue;
+                       auto t = std::cos(std::numbers::pi_v<T> *
+                                         static_cast<T>(j) / N);
+                       auto x = (a + b) / 2 + (b - a) / 2 * t;
+                       next[j] = static_cast<V>(std::invoke(f, x));
+                     }
+                   });
+    values = std::move(next);
+
+    c = chebyshev_coefficients<T>(values);
+    auto scale = T{0};
+    for (auto& ck : c) scale = std::max<T>(scale, std::abs(ck));
+    auto cutoff = tolerance * std::max(scale, std::numeric_limits<T>::min());
+    converged = std::abs(c[n - 1]) <= cutoff &&
+                std::abs(c[n - 2]) <= cutoff && std::abs(c[n - 3]) <= cutoff;
+    if (converged) {
+      while (c.size() > 1 && std::abs(c.back()) <= cutoff) c.pop_back();
+    }
+  }
+  return c;
+}
+
+}  // namespace Detail
+
+/**
+ * @brief Builds a piecewise Chebyshev interpolant of a function on [a, b].
+ * @details Sample points on each interval are evaluated in parallel, so f
+ * must be safe to call concurrently. Intervals whose coefficients do not
+ * decay to the tolerance within ChebyshevOptions::max_points points are
+ * bisected, up to ChebyshevOptions::max_pieces intervals in total. If that
+ * limit is reached, the best available interpolant is returned and its
+ * converged() member is false.
+ * @param f The function, returning a real or complex value.
+ * @param a The lower end of the interval.
+ * @param b The upper end of the interval.
+ * @param options The tolerance, size limits and parallel options.
+ * @return The interpolant, which satisfies RealFunction<..., T> or
+ * ComplexFunction<..., T> as f does.
+ */
+template <std::floating_point T, typename F>
+  requires RealFunction<F&, T> or ComplexFunction<F&, T>
+auto chebyshev_proxy(F f, T a, T b, const ChebyshevOptions& options = {}) {
+  using Result = std::remove_cvref_t<std::invoke_result_t<F&, T>>;
+  using V = ReplacePrecision<Result, T>;
+  if (!(a < b)) throw std::invalid_argument("chebyshev_proxy: empty interval");
+
+  auto tolerance = options.tolerance > 0
+                       ? static_cast<T>(options.tolerance)
+                       : 16 * std::numeric_limits<T>::epsilon();
+  auto max_points = std::size_t{17};
+  while (2 * max_points - 1 <= options.max_points) {
+    max_points = 2 * max_points - 1;
+  }
+  auto max_pieces = std::max<std::size_t>(options.max_pieces, 1);
+
+  // Intervals still to be built, processed left to right.
+  auto pending = std::vector<std::pair<T, T>>{{a, b}};
+  auto breaks = std::vector<T>{a};
+  auto coefficients = std::vector<std::vector<V>>{};
+  auto converged = true;
+  while (!pending.empty()) {
+    auto [lo, hi] = pending.back();
+    pending.pop_back();
+    auto pieces = coefficients.size() + pending.size() + 1;
+    auto ok = false;
+    auto c = Detail::chebyshev_piece<T, V>(f, lo, hi, tolerance, max_points,
+                                           options.parallel, ok);
+    if (!ok && pieces < max_pieces) {
+      auto mid = lo + (hi - lo) / 2;
+      pending.emplace_back(mid, hi);
+      pending.emplace_back(lo, mid);
+      continue;
+    }
+    converged = converged && ok;
+    coefficients.push_back(std::move(c));
+    breaks.push_back(hi);
+  }
+  return ChebyshevProxy<T, V>(std::move(breaks), coefficients, converged);
+}
+
+}  // namespace NumericConcepts
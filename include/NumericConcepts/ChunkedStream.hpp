@@ -0,0 +1,462 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <streambuf>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+
+#if __has_include(<unistd.h>) && __has_include(<poll.h>)
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#define NUMERIC_CONCEPTS_HAS_FD_STREAMS 1
+#endif
+
+/**
+ * @file ChunkedStream.hpp
+ * @brief Defines an input range that streams numeric data from a file or
+ * stream in fixed-size chunks, reading ahead on a background thread.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief The encoding of the values in a numeric stream.
+ */
+enum class StreamFormat {
+  /// Packed values in native byte order.
+  Binary,
+  /// Whitespace-separated values as read by `operator>>`.
+  Text
+};
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Concept for types that a text stream can be parsed into. Character
+ * sized integers are parsed as numbers rather than as characters.
+ * @tparam T The type to check.
+ */
+template <typename T>
+concept TextStreamable =
+    (Integral<T> and sizeof(T) == 1) or
+    requires(std::istream& in, T& value) { in >> value; };
+
+/**
+ * @internal
+ * @brief Parses one value from a text stream.
+ * @return False if no value could be parsed, in which case the stream's
+ * failbit is set.
+ */
+template <TextStreamable T>
+bool read_text(std::istream& in, T& value) {
+  if constexpr (Integral<T> and sizeof(T) == 1) {
+    using Wide = std::conditional_t<std::is_signed_v<T>, int, unsigned>;
+    auto wide = Wide{};
+    if (!(in >> wide)) return false;
+    value = static_cast<T>(wide);
+    if (static_cast<Wide>(value) != wide) {
+      in.setstate(std::ios::failbit);
+      return false;
+    }
+    return true;
+  } else {
+    return static_cast<bool>(in >> value);
+  }
+}
+
+#if defined(NUMERIC_CONCEPTS_HAS_FD_STREAMS)
+
+/**
+ * @internal
+ * @brief Stream buffer reading from a POSIX file descriptor.
+ * @details Large reads bypass the internal buffer. Each read first polls
+ * the descriptor together with an internal pipe, so that interrupt() can
+ * end a read blocked on a pipe, socket or terminal.
+ */
+class FdStreamBuf : public std::streambuf {
+ public:
+  explicit FdStreamBuf(int fd) : _fd{fd} {
+    if (::pipe(_stop) != 0) {
+      throw std::system_error(errno, std::generic_category(), "pipe");
+    }
+    ::fcntl(_stop[0], F_SETFD, FD_CLOEXEC);
+    ::fcntl(_stop[1], F_SETFD, FD_CLOEXEC);
+  }
+
+  FdStreamBuf(const FdStreamBuf&) = delete;
+  FdStreamBuf& operator=(const FdStreamBuf&) = delete;
+
+  ~FdStreamBuf() override {
+    ::close(_stop[0]);
+    ::close(_stop[1]);
+  }
+
+  /// Makes the pending read and all later reads return end of file.
+  void interrupt() {
+    auto byte = char{0};
+    static_cast<void>(::write(_stop[1], &byte, 1));
+  }
+
+ protected:
+  int_type underflow() override {
+    auto n = read_some(_buffer, sizeof(_buffer));
+    if (n <= 0) return traits_type::eof();
+    setg(_buffer, _buffer, _buffer + n);
+    return traits_type::to_int_type(*gptr());
+  }
+
+  std::streamsize xsgetn(char* s, std::streamsize count) override {
+    auto total = std::streamsize{0};
+    auto buffered = std::min<std::streamsize>(egptr() - gptr(), count);
+    if (buffered > 0) {
+      std::copy_n(gptr(), buffered, s);
+      gbump(static_cast<int>(buffered));
+      total = buffered;
+    }
+    while (total < count) {
+      auto n = read_some(s + total, count - total);
+      if (n <= 0) break;
+      total += n;
+    }
+    return total;
+  }
+
+ private:
+  int _fd;
+  int _stop[2];
+  char _buffer[1 << 16];
+
+  std::streamsize read_some(char* s, std::streamsize count) {
+    while (true) {
+      pollfd fds[2] = {{_fd, POLLIN, 0}, {_stop[0], POLLIN, 0}};
+      if (::poll(fds, 2, -1) < 0) {
+        if (errno == EINTR) continue;
+        throw std::system_error(errno, std::generic_category(), "poll");
+      }
+      if (fds[1].revents != 0) return 0;
+      auto n = ::read(_fd, s, static_cast<std::size_t>(count));
+      if (n >= 0) return n;
+      if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+        throw std::system_error(errno, std::generic_category(), "read");
+      }
+    }
+  }
+};
+
+#endif
+
+}  // namespace Detail
+
+/**
+ * @brief An input range of numeric values read from a stream in chunks.
+ * @details A background thread fills up to `read_ahead` chunks while the
+ * consumer processes the current one, so the disk stays busy during
+ * computation. The stream is itself a single-pass input range of elements
+ * satisfying NumericRange, and chunks() gives a single-pass range of
+ * contiguous `std::span<const T>` chunks. Only one of the two may be
+ * iterated. Errors raised while reading are rethrown to the consumer.
+ *
+ * A binary stream whose length is not a multiple of sizeof(T) has its
+ * trailing bytes ignored. A text stream ends at the first value that fails
+ * to parse or does not fit in T. Character-sized integers are read from text
+ * as numbers. Types without a text representation, such as `_Float16`, can
+ * only be read from binary streams.
+ * @tparam T The Numeric element type, other than bool.
+ */
+template <Numeric T>
+  requires(!std::same_as<T, bool>)
+class ChunkedNumericStream {
+  using Chunk = std::vector<T>;
+
+ public:
+  /**
+   * @brief Streams values from a std::istream.
+   * @param in The stream, which must outlive this object.
+   * @param format Whether the values are binary or text.
+   * @param chunk_size The number of elements in each chunk.
+   * @param read_ahead The number of chunks read ahead of the consumer.
+   * @throws std::invalid_argument If format is Text and T cannot be parsed
+   * from text.
+   */
+  explicit ChunkedNumericStream(std::istream& in,
+                                StreamFormat format = StreamFormat::Binary,
+                                std::size_t chunk_size = 1 << 16,
+                                std::size_t read_ahead = 2)
+      : _in{&in},
+        _format{checked_format(format)},
+        _chunk_size{std::max<std::size_t>(chunk_size, 1)},
+        _read_ahead{std::max<std::size_t>(read_ahead, 1)} {
+    start();
+  }
+
+#if defined(NUMERIC_CONCEPTS_HAS_FD_STREAMS)
+  /**
+   * @brief Streams values from a POSIX file descriptor.
+   * @param fd The open file descriptor, which is not closed by this object.
+   * It may refer to a regular file, a pipe or a socket.
+   * @param format Whether the values are binary or text.
+   * @param chunk_size The number of elements in each chunk.
+   * @param read_ahead The number of chunks read ahead of the consumer.
+   * @throws std::invalid_argument If format is Text and T cannot be parsed
+   * from text.
+   */
+  explicit ChunkedNumericStream(int fd,
+                                StreamFormat format = StreamFormat::Binary,
+                                std::size_t chunk_size = 1 << 16,
+                                std::size_t read_ahead = 2)
+      : _buffer{std::make_unique<Detail::FdStreamBuf>(fd)},
+        _owned{std::make_unique<std::istream>(_buffer.get())},
+        _in{_owned.get()},
+        _format{checked_format(format)},
+        _chunk_size{std::max<std::size_t>(chunk_size, 1)},
+        _read_ahead{std::max<std::size_t>(read_ahead, 1)} {
+    _owned->exceptions(std::ios::badbit);
+    start();
+  }
+#endif
+
+  ChunkedNumericStream(const ChunkedNumericStream&) = delete;
+  ChunkedNumericStream& operator=(const ChunkedNumericStream&) = delete;
+
+  /**
+   * @brief Stops the reader thread.
+   * @details A read from a file descriptor is interrupted, even if it is
+   * blocked waiting for data on a pipe or socket. A read from a
+   * std::istream cannot be interrupted and is allowed to finish, so such a
+   * stream must not block indefinitely.
+   */
+  ~ChunkedNumericStream() {
+    {
+      auto lock = std::scoped_lock(_mutex);
+      _stopped = true;
+    }
+    _cv.notify_all();
+#if defined(NUMERIC_CONCEPTS_HAS_FD_STREAMS)
+    if (_buffer) _buffer->interrupt();
+#endif
+    _reader.join();
+  }
+
+  /**
+   * @brief Single-pass range over the chunks of the stream.
+   */
+  class ChunkRange {
+   public:
+    class iterator {
+     public:
+      using value_type = std::span<const T>;
+      using difference_type = std::ptrdiff_t;
+
+      iterator() = default;
+      explicit iterator(ChunkedNumericStream* stream) : _stream{stream} {}
+
+      std::span<const T> operator*() const { return _stream->_current; }
+      iterator& operator++() {
+        _stream->advance();
+        return *this;
+      }
+      void operator++(int) { ++*this; }
+
+      friend bool operator==(const iterator& it, std::default_sentinel_t) {
+        return it._stream->exhausted();
+      }
+
+     private:
+      ChunkedNumericStream* _stream = nullptr;
+    };
+
+    explicit ChunkRange(ChunkedNumericStream* stream) : _stream{stream} {}
+
+    iterator begin() {
+      _stream->prime();
+      return iterator(_stream);
+    }
+    std::default_sentinel_t end() const { return {}; }
+
+   private:
+    ChunkedNumericStream* _stream;
+  };
+
+  /**
+   * @brief Input iterator over the elements of the stream.
+   * @details A reference obtained by dereferencing is valid until the
+   * iterator is next incremented.
+   */
+  class iterator {
+   public:
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+    explicit iterator(ChunkedNumericStream* stream) : _stream{stream} {}
+
+    const T& operator*() const { return _stream->_current[_index]; }
+    iterator& operator++() {
+      if (++_index == _stream->_current.size()) {
+        _stream->advance();
+        _index = 0;
+      }
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+
+    friend bool operator==(const iterator& it, std::default_sentinel_t) {
+      return it._stream->exhausted();
+    }
+
+   private:
+    ChunkedNumericStream* _stream = nullptr;
+    std::size_t _index = 0;
+  };
+
+  /// Returns an iterator to the first element, starting the stream.
+  iterator begin() {
+    prime();
+    return iterator(this);
+  }
+  std::default_sentinel_t end() const { return {}; }
+
+  /// Returns the range of contiguous chunks.
+  ChunkRange chunks() { return ChunkRange(this); }
+
+  std::size_t chunk_size() const { return _chunk_size; }
+
+  /// Returns true once iteration has passed the last element.
+  bool exhausted() const { return _exhausted; }
+
+ private:
+#if defined(NUMERIC_CONCEPTS_HAS_FD_STREAMS)
+  std::unique_ptr<Detail::FdStreamBuf> _buffer;
+  std::unique_ptr<std::istream> _owned;
+#endif
+  std::istream* _in;
+  StreamFormat _format;
+  std::size_t _chunk_size;
+  std::size_t _read_ahead;
+
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::deque<Chunk> _filled;
+  std::vector<Chunk> _free;
+  std::size_t _allocated = 0;
+  bool _finished = false;
+  bool _stopped = false;
+  std::exception_ptr _error;
+  std::thread _reader;
+
+  Chunk _current;
+  bool _primed = false;
+  bool _exhausted = false;
+
+  static StreamFormat checked_format(StreamFormat format) {
+    if (format == StreamFormat::Text and !Detail::TextStreamable<T>) {
+      throw std::invalid_argument(
+          "ChunkedNumericStream: the element type cannot be read from text");
+    }
+    return format;
+  }
+
+  void start() { _reader = std::thread([this]() { read_loop(); }); }
+
+  void prime() {
+    if (!_primed) {
+      _primed = true;
+      advance();
+    }
+  }
+
+  /// Returns the current chunk for reuse and takes the next one.
+  void advance() {
+    auto lock = std::unique_lock(_mutex);
+    if (_current.capacity() > 0) {
+      _free.push_back(std::move(_current));
+      _current = Chunk{};
+      _cv.notify_all();
+    }
+    _cv.wait(lock, [&]() { return !_filled.empty() || _finished; });
+    if (!_filled.empty()) {
+      _current = std::move(_filled.front());
+      _filled.pop_front();
+      _cv.notify_all();
+    } else {
+      _exhausted = true;
+      if (_error) std::rethrow_exception(std::exchange(_error, nullptr));
+    }
+  }
+
+  void read_loop() {
+    try {
+      while (true) {
+        auto chunk = Chunk{};
+        {
+          auto lock = std::unique_lock(_mutex);
+          _cv.wait(lock, [&]() {
+            return _stopped || !_free.empty() || _allocated <= _read_ahead;
+          });
+          if (_stopped) break;
+          if (!_free.empty()) {
+            chunk = std::move(_free.back());
+            _free.pop_back();
+          } else {
+            ++_allocated;
+          }
+          _cv.wait(lock, [&]() {
+            return _stopped || _filled.size() < _read_ahead;
+          });
+          if (_stopped) break;
+        }
+        fill(chunk);
+        auto done = chunk.empty() || !*_in;
+        {
+          auto lock = std::scoped_lock(_mutex);
+          if (!chunk.empty()) _filled.push_back(std::move(chunk));
+          _finished = done;
+        }
+        _cv.notify_all();
+        if (done) return;
+      }
+    } catch (...) {
+      auto lock = std::scoped_lock(_mutex);
+      _error = std::current_exception();
+      _finished = true;
+    }
+    _cv.notify_all();
+  }
+
+  void fill(Chunk& chunk) {
+    chunk.resize(_chunk_size);
+    auto count = std::size_t{0};
+    if (_format == StreamFormat::Binary) {
+      _in->read(reinterpret_cast<char*>(chunk.data()),
+                static_cast<std::streamsize>(_chunk_size * sizeof(T)));
+      count = static_cast<std::size_t>(_in->gcount()) / sizeof(T);
+    } else if constexpr (Detail::TextStreamable<T>) {
+      while (count < _chunk_size && Detail::read_text(*_in, chunk[count])) {
+        ++count;
+      }
+    }
+    chunk.resize(count);
+  }
+};
+
+}  // namespace NumericConcepts
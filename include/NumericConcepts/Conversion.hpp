@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+#include "Simd.hpp"
+
+/**
+ * @file Conversion.hpp
+ * @brief Defines bulk conversion between numeric ranges of different
+ * precision.
+ * @details Conversions between contiguous float and double data, whether
+ * real or interleaved complex, use AVX2 or AVX-512 conversion instructions
+ * when the target supports them, as do conversions between `_Float16` and
+ * float on targets with F16C. All other conversions use a scalar loop.
+ */
+
+namespace NumericConcepts {
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Converts n values from one real type to another.
+ */
+template <typename From, typename To>
+void convert_kernel(const From* in, To* out, std::size_t n) {
+  for (auto i = std::size_t{0}; i < n; ++i) out[i] = static_cast<To>(in[i]);
+}
+
+#if !defined(NUMERIC_CONCEPTS_NO_SIMD) && defined(__AVX512F__)
+
+// The masked conversions give GCC 12 a defined source operand, where the
+// unmasked ones warn that theirs is uninitialized.
+inline void convert_kernel(const float* in, double* out, std::size_t n) {
+  auto i = std::size_t{0};
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(out + i,
+                     _mm512_mask_cvtps_pd(_mm512_setzero_pd(), 0xff,
+                                          _mm256_loadu_ps(in + i)));
+  }
+  for (; i < n; ++i) out[i] = in[i];
+}
+
+inline void convert_kernel(const double* in, float* out, std::size_t n) {
+  auto i = std::size_t{0};
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(out + i,
+                     _mm512_mask_cvtpd_ps(_mm256_setzero_ps(), 0xff,
+                                          _mm512_loadu_pd(in + i)));
+  }
+  for (; i < n; ++i) out[i] = static_cast<float>(in[i]);
+}
+
+#elif !defined(NUMERIC_CONCEPTS_NO_SIMD) && defined(__AVX2__)
+
+inline void convert_kernel(const float* in, double* out, std::size_t n) {
+  auto i = std::size_t{0};
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(out + i, _mm256_cvtps_pd(_mm_loadu_ps(in + i)));
+  }
+  for (; i < n; ++i) out[i] = in[i];
+}
+
+inline void convert_kernel(const double* in, float* out, std::size_t n) {
+  auto i = std::size_t{0};
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(out + i, _mm256_cvtpd_ps(_mm256_loadu_pd(in + i)));
+  }
+  for (; i < n; ++i) out[i] = static_cast<float>(in[i]);
+}
+
+#endif
+
+#if !defined(NUMERIC_CONCEPTS_NO_SIMD) && defined(__FLT16_MAX__) && \
+    defined(__F16C__) && (defined(__AVX512F__) || defined(__AVX2__))
+
+inline void convert_kernel(const _Float16* in, float* out, std::size_t n) {
+  auto i = std::size_t{0};
+  for (; i + 8 <= n; i += 8) {
+    auto half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(half));
+  }
+  for (; i < n; ++i) out[i] = static_cast<float>(in[i]);
+}
+
+inline void convert_kernel(const float* in, _Float16* out, std::size_t n) {
+  auto i = std::size_t{0};
+  for (; i + 8 <= n; i += 8) {
+    auto half = _mm256_cvtps_ph(_mm256_loadu_ps(in + i),
+                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), half);
+  }
+  for (; i < n; ++i) out[i] = static_cast<_Float16>(in[i]);
+}
+
+#endif
+
+/**
+ * @internal
+ * @brief Returns a pointer to the underlying real data of a contiguous range
+ * of reals or std::complex values, along with the number of reals.
+ */
+template <ContiguousRealOrComplexRange R>
+auto real_data(R&& range) {
+  using Real = RangePrecision<R>;
+  using Pointer = std::conditional_t<
+      std::is_const_v<std::remove_reference_t<
+          std::ranges::range_reference_t<R>>>,
+      const Real*, Real*>;
+  auto n = static_cast<std::size_t>(std::ranges::size(range));
+  if constexpr (ComplexRange<R>) n *= 2;
+  return std::pair{reinterpret_cast<Pointer>(std::ranges::data(range)), n};
+}
+
+/**
+ * @internal
+ * @brief Concept for a pair of ranges whose data can be converted by
+ * convert_kernel as flat arrays of reals.
+ */
+template <typename In, typename Out>
+concept FlatConvertible =
+    ContiguousRealOrComplexRange<In> and
+    ContiguousRealOrComplexWritableRange<Out> and
+    ((RealRange<In> and RealRange<Out>) or
+     (std::same_as<std::ranges::range_value_t<In>,
+                   std::complex<RangePrecision<In>>> and
+      std::same_as<std::ranges::range_value_t<Out>,
+                   std::complex<RangePrecision<Out>>>));
+
+}  // namespace Detail
+
+/**
+ * @brief Converts the elements of one numeric range to the precision of
+ * another.
+ * @details Elements are converted until either range is exhausted. A real
+ * range may be converted into a complex range, in which case the imaginary
+ * parts are set to zero, but not the other way around.
+ * @tparam In The RealOrComplexRange type of the input.
+ * @tparam Out The RealOrComplexWritableRange type of the output.
+ * @param in The range to read from.
+ * @param out The range to write to.
+ * @return The number of elements converted.
+ */
+template <RealOrComplexRange In, RealOrComplexWritableRange Out>
+  requires(RealRange<In> or ComplexRange<Out>)
+std::size_t convert(In&& in, Out&& out) {
+  if constexpr (Detail::FlatConvertible<In, Out>) {
+    auto [from, n] = Detail::real_data(in);
+    auto [to, m] = Detail::real_data(out);
+    auto count = std::min(n, m);
+    Detail::convert_kernel(from, to, count);
+    return ComplexRange<In> ? count / 2 : count;
+  } else if constexpr (SplitComplexRange<In> and
+                       SplitComplexWritableRange<Out>) {
+    auto count = std::min(static_cast<std::size_t>(std::ranges::size(in)),
+                          static_cast<std::size_t>(std::ranges::size(out)));
+    Detail::convert_kernel(in.real_data(), out.real_data(), count);
+    Detail::convert_kernel(in.imag_data(), out.imag_data(), count);
+    return count;
+  } else {
+    using Value = std::ranges::range_value_t<Out>;
+    using Precision = RangePrecision<Out>;
+    auto count = std::size_t{0};
+    auto ii = std::ranges::begin(in);
+    auto oi = std::ranges::begin(out);
+    for (; ii != std::ranges::end(in) && oi != std::ranges::end(out);
+         ++ii, ++oi, ++count) {
+      if constexpr (RealRange<In>) {
+        *oi = static_cast<Value>(static_cast<Precision>(*ii));
+      } else {
+        auto z = static_cast<std::complex<RangePrecision<In>>>(*ii);
+        *oi = Value(static_cast<Precision>(z.real()),
+                    static_cast<Precision>(z.imag()));
+      }
+    }
+    return count;
+  }
+}
+
+}  // namespace NumericConcepts
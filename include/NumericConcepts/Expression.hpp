@@ -0,0 +1,399 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+
+/**
+ * @file Expression.hpp
+ * @brief Defines lazy, fused element-wise arithmetic over real and complex
+ * ranges.
+ * @details Wrapping ranges with lazy() allows them to be combined with `+`,
+ * `-`, `*` and `/`, and with scalars, into a LazyExpression. No work is done
+ * until the expression is passed to assign(), which evaluates every element
+ * in a single pass without temporaries. For example,
+ * @code
+ * assign(out, lazy(a) + 2.0 * lazy(b) - lazy(c) * lazy(d));
+ * @endcode
+ * reads each input once and writes out once. The operands of an expression
+ * must have the same precision, as checked by SameRangePrecision. Real and
+ * complex operands of the same precision may be mixed, with the result being
+ * complex. Scalars are converted to the precision of the expression.
+ */
+
+namespace NumericConcepts {
+
+template <typename Node>
+class LazyExpression;
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Leaf node reading from contiguous memory.
+ */
+template <typename T>
+struct PointerNode {
+  using value_type = std::remove_cv_t<T>;
+  static constexpr bool sized = true;
+
+  T* data;
+  std::size_t count;
+
+  std::size_t size() const { return count; }
+  value_type operator[](std::size_t i) const { return data[i]; }
+};
+
+/**
+ * @internal
+ * @brief Leaf node reading from a random access view.
+ */
+template <typename V>
+struct ViewNode {
+  using value_type = std::ranges::range_value_t<V>;
+  static constexpr bool sized = true;
+
+  mutable V view;
+
+  std::size_t size() const {
+    return static_cast<std::size_t>(std::ranges::size(view));
+  }
+  value_type operator[](std::size_t i) const {
+    auto j = static_cast<std::ranges::range_difference_t<V>>(i);
+    return static_cast<value_type>(std::ranges::begin(view)[j]);
+  }
+};
+
+/**
+ * @internal
+ * @brief Leaf node holding a scalar that is broadcast to every element.
+ */
+template <typename T>
+struct ScalarNode {
+  using value_type = T;
+  static constexpr bool sized = false;
+
+  T value;
+
+  value_type operator[](std::size_t) const { return value; }
+};
+
+struct Add {
+  template <typename T, typename U>
+  auto operator()(const T& x, const U& y) const {
+    return x + y;
+  }
+};
+
+struct Subtract {
+  template <typename T, typename U>
+  auto operator()(const T& x, const U& y) const {
+    return x - y;
+  }
+};
+
+/**
+ * @internal
+ * @brief Multiplication, using the textbook formula for two complex values.
+ * @details std::complex multiplication checks for infinities and NaNs, which
+ * prevents the loop from being vectorized.
+ */
+struct Multiply {
+  template <typename T, typename U>
+  auto operator()(const T& x, const U& y) const {
+    if constexpr (Complex<T> and Complex<U>) {
+      return T(x.real() * y.real() - x.imag() * y.imag(),
+               x.real() * y.imag() + x.imag() * y.real());
+    } else {
+      return x * y;
+    }
+  }
+};
+
+struct Divide {
+  template <typename T, typename U>
+  auto operator()(const T& x, const U& y) const {
+    return x / y;
+  }
+};
+
+/**
+ * @internal
+ * @brief Interior node applying a binary operation element-wise.
+ */
+template <typename Op, typename L, typename R>
+struct BinaryNode {
+  using value_type =
+      PromotePrecision<typename L::value_type, typename R::value_type>;
+  static constexpr bool sized = L::sized or R::sized;
+
+  L left;
+  R right;
+
+  std::size_t size() const {
+    if constexpr (L::sized and R::sized) {
+      return std::min(left.size(), right.size());
+    } else if constexpr (L::sized) {
+      return left.size();
+    } else {
+      return right.size();
+    }
+  }
+  value_type operator[](std::size_t i) const {
+    return static_cast<value_type>(Op{}(left[i], right[i]));
+  }
+};
+
+/**
+ * @internal
+ * @brief Interior node negating its operand element-wise.
+ */
+template <typename A>
+struct NegateNode {
+  using value_type = typename A::value_type;
+  static constexpr bool sized = A::sized;
+
+  A operand;
+
+  std::size_t size() const { return operand.size(); }
+  value_type operator[](std::size_t i) const { return -operand[i]; }
+};
+
+template <typename T>
+struct IsLazyExpressionHelper : std::false_type {};
+
+template <typename Node>
+struct IsLazyExpressionHelper<LazyExpression<Node>> : std::true_type {};
+
+/**
+ * @internal
+ * @brief Concept for a LazyExpression.
+ */
+template <typename T>
+concept LazyExpressionType =
+    IsLazyExpressionHelper<std::remove_cvref_t<T>>::value;
+
+/**
+ * @internal
+ * @brief Concept for the operands of a binary expression: two expressions of
+ * the same precision, or an expression and a numeric scalar.
+ */
+template <typename L, typename R>
+concept LazyOperands =
+    (LazyExpressionType<L> and LazyExpressionType<R> and
+     SameRangePrecision<L, R>) or
+    (LazyExpressionType<L> and Numeric<R>) or
+    (Numeric<L> and LazyExpressionType<R>);
+
+/**
+ * @internal
+ * @brief Returns the node for an operand, converting scalars to precision P.
+ */
+template <typename P, typename T>
+auto lazy_operand(const T& x) {
+  if constexpr (LazyExpressionType<T>) {
+    return x.node();
+  } else if constexpr (Complex<T>) {
+    return ScalarNode<std::complex<P>>{
+        std::complex<P>(static_cast<P>(x.real()), static_cast<P>(x.imag()))};
+  } else {
+    return ScalarNode<P>{static_cast<P>(x)};
+  }
+}
+
+template <typename Op, typename L, typename R>
+auto lazy_combine(const L& l, const R& r) {
+  using P = RangePrecision<
+      std::conditional_t<LazyExpressionType<L>, L, R>>;
+  auto left = lazy_operand<P>(l);
+  auto right = lazy_operand<P>(r);
+  return LazyExpression(
+      BinaryNode<Op, decltype(left), decltype(right)>{left, right});
+}
+
+}  // namespace Detail
+
+/**
+ * @brief A lazily evaluated element-wise expression over real or complex
+ * ranges.
+ * @details The expression is itself a random access RealOrComplexView whose
+ * elements are computed on access. Its length is that of its shortest
+ * operand. The ranges it refers to must outlive it.
+ * @tparam Node The type of the root node of the expression.
+ */
+template <typename Node>
+class LazyExpression
+    : public std::ranges::view_interface<LazyExpression<Node>> {
+ public:
+  using value_type = typename Node::value_type;
+
+  class iterator {
+   public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = typename Node::value_type;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+    iterator(const Node* node, std::size_t index)
+        : _node{node}, _index{index} {}
+
+    value_type operator*() const { return (*_node)[_index]; }
+    value_type operator[](difference_type n) const {
+      return (*_node)[_index + static_cast<std::size_t>(n)];
+    }
+
+    iterator& operator++() {
+      ++_index;
+      return *this;
+    }
+    iterator operator++(int) { return iterator(_node, _index++); }
+    iterator& operator--() {
+      --_index;
+      return *this;
+    }
+    iterator operator--(int) { return iterator(_node, _index--); }
+    iterator& operator+=(difference_type n) {
+      _index += static_cast<std::size_t>(n);
+      return *this;
+    }
+    iterator& operator-=(difference_type n) {
+      _index -= static_cast<std::size_t>(n);
+      return *this;
+    }
+
+    friend iterator operator+(iterator it, difference_type n) {
+      return it += n;
+    }
+    friend iterator operator+(difference_type n, iterator it) {
+      return it += n;
+    }
+    friend iterator operator-(iterator it, difference_type n) {
+      return it -= n;
+    }
+    friend difference_type operator-(const iterator& a, const iterator& b) {
+      return static_cast<difference_type>(a._index) -
+             static_cast<difference_type>(b._index);
+    }
+    friend bool operator==(const iterator& a, const iterator& b) {
+      return a._index == b._index;
+    }
+    friend auto operator<=>(const iterator& a, const iterator& b) {
+      return a._index <=> b._index;
+    }
+
+   private:
+    const Node* _node = nullptr;
+    std::size_t _index = 0;
+  };
+
+  LazyExpression() = default;
+  explicit LazyExpression(Node node) : _node{std::move(node)} {}
+
+  iterator begin() const { return iterator(&_node, 0); }
+  iterator end() const { return iterator(&_node, size()); }
+  std::size_t size() const { return _node.size(); }
+  value_type operator[](std::size_t i) const { return _node[i]; }
+
+  /// Returns the root node of the expression.
+  const Node& node() const { return _node; }
+
+ private:
+  Node _node;
+};
+
+/**
+ * @brief Wraps a real or complex range as the leaf of a lazy expression.
+ * @details The range must be random access and sized, and is referred to
+ * rather than copied, so it must outlive any expression built from it.
+ * Temporary containers are therefore rejected.
+ * @param range The range.
+ * @return The expression reading the range.
+ */
+template <RealOrComplexRange R>
+  requires std::ranges::random_access_range<R> and
+           std::ranges::sized_range<R> and std::ranges::viewable_range<R> and
+           std::copyable<std::views::all_t<R>>
+auto lazy(R&& range) {
+  if constexpr (ContiguousRange<R> and std::ranges::borrowed_range<R>) {
+    using Element =
+        std::remove_reference_t<std::ranges::range_reference_t<R>>;
+    return LazyExpression(Detail::PointerNode<const Element>{
+        std::ranges::data(range),
+        static_cast<std::size_t>(std::ranges::size(range))});
+  } else {
+    return LazyExpression(Detail::ViewNode<std::views::all_t<R>>{
+        std::views::all(std::forward<R>(range))});
+  }
+}
+
+template <typename L, typename R>
+  requires Detail::LazyOperands<L, R>
+auto operator+(const L& l, const R& r) {
+  return Detail::lazy_combine<Detail::Add>(l, r);
+}
+
+template <typename L, typename R>
+  requires Detail::LazyOperands<L, R>
+auto operator-(const L& l, const R& r) {
+  return Detail::lazy_combine<Detail::Subtract>(l, r);
+}
+
+template <typename L, typename R>
+  requires Detail::LazyOperands<L, R>
+auto operator*(const L& l, const R& r) {
+  return Detail::lazy_combine<Detail::Multiply>(l, r);
+}
+
+template <typename L, typename R>
+  requires Detail::LazyOperands<L, R>
+auto operator/(const L& l, const R& r) {
+  return Detail::lazy_combine<Detail::Divide>(l, r);
+}
+
+template <typename Node>
+auto operator-(const LazyExpression<Node>& e) {
+  return LazyExpression(Detail::NegateNode<Node>{e.node()});
+}
+
+/**
+ * @brief Evaluates a lazy expression into a writable range in a single pass.
+ * @details Elements are written until either the range or the expression is
+ * exhausted. The output may also be an operand of the expression. The
+ * output must have the same precision as the expression, and a complex
+ * expression cannot be assigned to a real range.
+ * @param out The range to write to.
+ * @param expression The expression to evaluate.
+ * @return The number of elements written.
+ */
+template <RealOrComplexWritableRange Out, typename Node>
+  requires std::ranges::random_access_range<Out> and
+           std::ranges::sized_range<Out> and
+           SameRangePrecision<Out, LazyExpression<Node>> and
+           (ComplexRange<Out> or RealRange<LazyExpression<Node>>)
+std::size_t assign(Out&& out, const LazyExpression<Node>& expression) {
+  auto& node = expression.node();
+  auto n = std::min(static_cast<std::size_t>(std::ranges::size(out)),
+                    expression.size());
+  if constexpr (ContiguousRange<Out>) {
+    auto data = std::ranges::data(out);
+    for (auto i = std::size_t{0}; i < n; ++i) data[i] = node[i];
+  } else {
+    auto first = std::ranges::begin(out);
+    for (auto i = std::size_t{0}; i < n; ++i) {
+      first[static_cast<std::ranges::range_difference_t<Out>>(i)] = node[i];
+    }
+  }
+  return n;
+}
+
+}  // namespace NumericConcepts
@@ -0,0 +1,704 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <ranges>
+#include <shared_mutex>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <vector>
+
+#include "Algorithms.hpp"
+#include "Buffer.hpp"
+#include "MatrixProduct.hpp"
+#include "Numeric.hpp"
+#include "Parallel.hpp"
+#include "Ranges.hpp"
+#include "Tensor.hpp"
+#include "Threading.hpp"
+
+/**
+ * @file Fft.hpp
+ * @brief Defines fast Fourier transforms of complex and real ranges of any
+ * length, and batched and two-dimensional transforms of matrices.
+ * @details Lengths are factored into radices 4, 2, 3 and 5 and other small
+ * primes, each stage of which is applied by a self-sorting Stockham pass
+ * that needs no bit reversal. Lengths with a prime factor larger than
+ * FftMaxRadix are computed by Bluestein's algorithm, as a convolution of
+ * power-of-two length. Plans holding the factorization and twiddle factors
+ * are built once per length, precision and direction and kept in a
+ * thread-safe FftPlanCache. The forward transform is
+ * \f$X_k = \sum_j x_j e^{-2\pi i jk/n}\f$ and the inverse transform uses the
+ * opposite sign. Neither is normalized, so an inverse transform of a forward
+ * transform multiplies the data by n.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief The sign of the exponent of a Fourier transform.
+ */
+enum class FftDirection {
+  /// \f$e^{-2\pi i jk/n}\f$.
+  Forward,
+  /// \f$e^{+2\pi i jk/n}\f$.
+  Inverse
+};
+
+/**
+ * @brief The largest prime factor handled by a mixed-radix pass. Lengths with
+ * larger prime factors use Bluestein's algorithm.
+ */
+inline constexpr std::size_t FftMaxRadix = 31;
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Complex multiplication by the textbook formula, which vectorizes
+ * (see Multiply in Expression.hpp).
+ */
+template <typename T>
+std::complex<T> fft_multiply(const std::complex<T>& x,
+                             const std::complex<T>& y) {
+  return std::complex<T>(x.real() * y.real() - x.imag() * y.imag(),
+                         x.real() * y.imag() + x.imag() * y.real());
+}
+
+/**
+ * @internal
+ * @brief Returns exp(sign * 2 pi i k / n), computed in long double.
+ */
+template <typename T>
+std::complex<T> fft_root(long double sign, std::size_t k, std::size_t n) {
+  auto angle = sign * 2 * std::numbers::pi_v<long double> *
+               static_cast<long double>(k) / static_cast<long double>(n);
+  return std::complex<T>(static_cast<T>(std::cos(angle)),
+                         static_cast<T>(std::sin(angle)));
+}
+
+}  // namespace Detail
+
+/**
+ * @brief A precomputed complex-to-complex transform of a fixed length and
+ * direction.
+ * @details Plans are immutable once built, so one plan can be executed from
+ * several threads at once, each with its own work space.
+ * @tparam T The floating-point precision.
+ */
+template <std::floating_point T>
+class FftPlan {
+ public:
+  using value_type = std::complex<T>;
+
+  /**
+   * @brief Builds the plan.
+   * @param n The transform length.
+   * @param direction The sign of the exponent.
+   */
+  FftPlan(std::size_t n, FftDirection direction)
+      : _n{n}, _direction{direction} {
+    if (n <= 1) return;
+    auto radices = factor(n);
+    if (radices.back() > FftMaxRadix) {
+      build_bluestein();
+    } else {
+      build_stages(radices);
+    }
+  }
+
+  /// The transform length.
+  std::size_t size() const { return _n; }
+
+  FftDirection direction() const { return _direction; }
+
+  /// Whether the length is computed by Bluestein's algorithm.
+  bool bluestein() const { return _inner != nullptr; }
+
+  /// The number of elements of work space needed by execute().
+  std::size_t work_size() const {
+    return _inner ? _inner->size() + _inner->work_size() : _n;
+  }
+
+  /**
+   * @brief Transforms size() elements in place.
+   * @param data The elements.
+   * @param work Work space of at least work_size() elements, which must not
+   * overlap data.
+   */
+  void execute(value_type* data, value_type* work) const {
+    if (_inner) {
+      execute_bluestein(data, work);
+      return;
+    }
+    auto src = data, dst = work;
+    for (auto& stage : _stages) {
+      apply(stage, src, dst);
+      std::swap(src, dst);
+    }
+    if (src != data) std::copy_n(src, _n, data);
+  }
+
+ private:
+  struct Stage {
+    std::size_t radix;
+    std::size_t m;
+    std::size_t s;
+    std::size_t twiddles;
+    std::size_t roots;
+  };
+
+  std::size_t _n;
+  FftDirection _direction;
+  std::vector<Stage> _stages;
+  std::vector<value_type> _twiddles;
+  std::unique_ptr<const FftPlan> _inner;
+  std::vector<value_type> _chirp;
+  std::vector<value_type> _kernel;
+
+  long double sign() const {
+    return _direction == FftDirection::Forward ? -1.0L : 1.0L;
+  }
+
+  // Radices in the order applied: 4s, then primes in increasing order.
+  static std::vector<std::size_t> factor(std::size_t n) {
+    auto radices = std::vector<std::size_t>{};
+    while (n % 4 == 0) {
+      radices.push_back(4);
+      n /= 4;
+    }
+    for (auto p = std::size_t{2}; p * p <= n; ++p) {
+      while (n % p == 0) {
+        radices.push_back(p);
+        n /= p;
+      }
+    }
+    if (n > 1) radices.push_back(n);
+    return radices;
+  }
+
+  void build_stages(const std::vector<std::size_t>& radices) {
+    auto n = _n, s = std::size_t{1};
+    for (auto r : radices) {
+      auto m = n / r;
+      auto stage = Stage{r, m, s, _twiddles.size(), 0};
+      for (auto p = std::size_t{0}; p < m; ++p) {
+        for (auto u = std::size_t{1}; u < r; ++u) {
+          _twiddles.push_back(Detail::fft_root<T>(sign(), p * u, n));
+        }
+      }
+      stage.roots = _twiddles.size();
+      if (r > 5) {
+        for (auto k = std::size_t{0}; k < r; ++k) {
+          _twiddles.push_back(Detail::fft_root<T>(sign(), k, r));
+        }
+      }
+      _stages.push_back(stage);
+      n = m;
+      s *= r;
+    }
+  }
+
+  void build_bluestein() {
+    auto m = std::size_t{1};
+    while (m < 2 * _n - 1) m *= 2;
+    _inner = std::make_unique<const FftPlan>(m, FftDirection::Forward);
+    // The chirp exp(sign * pi i k^2 / n), with k^2 reduced mod 2n.
+    _chirp.resize(_n);
+    for (auto k = std::size_t{0}; k < _n; ++k) {
+      _chirp[k] = Detail::fft_root<T>(sign(), (k * k) % (2 * _n), 2 * _n);
+    }
+    // The transform of the conjugate chirp, scaled for the inverse pass.
+    _kernel.assign(m, value_type{0});
+    _kernel[0] = std::conj(_chirp[0]);
+    for (auto k = std::size_t{1}; k < _n; ++k) {
+      _kernel[k] = _kernel[m - k] = std::conj(_chirp[k]);
+    }
+    auto work = std::vector<value_type>(_inner->work_size());
+    _inner->execute(_kernel.data(), work.data());
+    for (auto& z : _kernel) z /= static_cast<T>(m);
+  }
+
+  void execute_bluestein(value_type* data, value_type* work) const {
+    auto m = _inner->size();
+    auto a = work, scratch = work + m;
+    for (auto k = std::size_t{0}; k < _n; ++k) {
+      a[k] = Detail::fft_multiply(data[k], _chirp[k]);
+    }
+    std::fill(a + _n, a + m, value_type{0});
+    _inner->execute(a, scratch);
+    // The inverse transform is the conjugate of the forward transform of the
+    // conjugate.
+    for (auto k = std::size_t{0}; k < m; ++k) {
+      a[k] = std::conj(Detail::fft_multiply(a[k], _kernel[k]));
+    }
+    _inner->execute(a, scratch);
+    for (auto k = std::size_t{0}; k < _n; ++k) {
+      data[k] = Detail::fft_multiply(std::conj(a[k]), _chirp[k]);
+    }
+  }
+
+  // Multiplies by -i for forward transforms and by i for inverse ones.
+  value_type rotate(const value_type& z) const {
+    if (_direction == FftDirection::Forward) {
+      return value_type(z.imag(), -z.real());
+    }
+    return value_type(-z.imag(), z.real());
+  }
+
+  // One Stockham pass: x[q + s (p + t m)] -> y[q + s (r p + u)].
+  void apply(const Stage& stage, const value_type* x, value_type* y) const {
+    auto r = stage.radix, m = stage.m, s = stage.s;
+    auto w = _twiddles.data() + stage.twiddles;
+    for (auto p = std::size_t{0}; p < m; ++p) {
+      auto wp = w + p * (r - 1);
+      auto in = x + s * p;
+      auto out = y + s * r * p;
+      if (r == 2) {
+        for (auto q = std::size_t{0}; q < s; ++q) {
+          auto a0 = in[q], a1 = in[q + s * m];
+          out[q] = a0 + a1;
+          out[q + s] = Detail::fft_multiply(a0 - a1, wp[0]);
+        }
+      } else if (r == 3) {
+        auto c = static_cast<T>(std::numbers::sqrt3_v<long double> / 2);
+        for (auto q = std::size_t{0}; q < s; ++q) {
+          auto a0 = in[q], a1 = in[q + s * m], a2 = in[q + 2 * s * m];
+          auto sum = a1 + a2;
+          auto mid = a0 - sum * T{0.5};
+          auto diff = rotate((a1 - a2) * c);
+          out[q] = a0 + sum;
+          out[q + s] = Detail::fft_multiply(mid + diff, wp[0]);
+          out[q + 2 * s] = Detail::fft_multiply(mid - diff, wp[1]);
+        }
+      } else if (r == 4) {
+        for (auto q = std::size_t{0}; q < s; ++q) {
+          auto a0 = in[q], a1 = in[q + s * m];
+          auto a2 = in[q + 2 * s * m], a3 = in[q + 3 * s * m];
+          auto b0 = a0 + a2, b1 = a0 - a2;
+          auto b2 = a1 + a3, b3 = rotate(a1 - a3);
+          out[q] = b0 + b2;
+          out[q + s] = Detail::fft_multiply(b1 + b3, wp[0]);
+          out[q + 2 * s] = Detail::fft_multiply(b0 - b2, wp[1]);
+          out[q + 3 * s] = Detail::fft_multiply(b1 - b3, wp[2]);
+        }
+      } else if (r == 5) {
+        auto pi = std::numbers::pi_v<long double>;
+        auto c1 = static_cast<T>(std::cos(0.4L * pi));
+        auto c2 = static_cast<T>(std::cos(0.8L * pi));
+        auto s1 = static_cast<T>(std::sin(0.4L * pi));
+        auto s2 = static_cast<T>(std::sin(0.8L * pi));
+        for (auto q = std::size_t{0}; q < s; ++q) {
+          auto a0 = in[q], a1 = in[q + s * m], a2 = in[q + 2 * s * m];
+          auto a3 = in[q + 3 * s * m], a4 = in[q + 4 * s * m];
+          auto t1 = a1 + a4, t2 = a2 + a3, t3 = a1 - a4, t4 = a2 - a3;
+          auto b1 = a0 + c1 * t1 + c2 * t2, b2 = a0 + c2 * t1 + c1 * t2;
+          auto d1 = rotate(s1 * t3 + s2 * t4), d2 = rotate(s2 * t3 - s1 * t4);
+          out[q] = a0 + t1 + t2;
+          out[q + s] = Detail::fft_multiply(b1 + d1, wp[0]);
+          out[q + 2 * s] = Detail::fft_multiply(b2 + d2, wp[1]);
+          out[q + 3 * s] = Detail::fft_multiply(b2 - d2, wp[2]);
+          out[q + 4 * s] = Detail::fft_multiply(b1 - d1, wp[3]);
+        }
+      } else {
+        auto roots = _twiddles.data() + stage.roots;
+        for (auto q = std::size_t{0}; q < s; ++q) {
+          for (auto u = std::size_t{0}; u < r; ++u) {
+            auto sum = in[q];
+            for (auto t = std::size_t{1}; t < r; ++t) {
+              sum += Detail::fft_multiply(in[q + t * s * m],
+                                          roots[(t * u) % r]);
+            }
+            out[q + u * s] =
+                u == 0 ? sum : Detail::fft_multiply(sum, wp[u - 1]);
+          }
+        }
+      }
+    }
+  }
+};
+
+/**
+ * @brief A precomputed transform of real data of a fixed length, producing
+ * the n / 2 + 1 non-redundant complex coefficients.
+ * @details Even lengths are computed as a complex transform of half the
+ * length, with the even and odd elements as real and imaginary parts.
+ * @tparam T The floating-point precision.
+ */
+template <std::floating_point T>
+class RealFftPlan {
+ public:
+  using value_type = std::complex<T>;
+
+  /**
+   * @brief Builds the plan.
+   * @param n The transform length.
+   * @param direction The sign of the exponent.
+   */
+  RealFftPlan(std::size_t n, FftDirection direction)
+      : _n{n},
+        _direction{direction},
+        _complex{n % 2 == 0 ? n / 2 : n, FftDirection::Forward} {
+    if (n % 2 == 0) {
+      for (auto k = std::size_t{0}; k <= n / 2; ++k) {
+        _twiddles.push_back(Detail::fft_root<T>(-1.0L, k, n));
+      }
+    }
+  }
+
+  /// The transform length.
+  std::size_t size() const { return _n; }
+
+  FftDirection direction() const { return _direction; }
+
+  /// The number of elements of work space needed by execute().
+  std::size_t work_size() const {
+    return _complex.size() + _complex.work_size();
+  }
+
+  /**
+   * @brief Transforms size() real values.
+   * @param in The real values.
+   * @param out The size() / 2 + 1 coefficients.
+   * @param work Work space of at least work_size() elements.
+   */
+  void execute(const T* in, value_type* out, value_type* work) const {
+    auto h = _complex.size();
+    auto z = work, scratch = work + h;
+    if (_n % 2 == 0) {
+      for (auto k = std::size_t{0}; k < h; ++k) {
+        z[k] = value_type(in[2 * k], in[2 * k + 1]);
+      }
+      _complex.execute(z, scratch);
+      for (auto k = std::size_t{0}; k <= h; ++k) {
+        auto zk = z[k % h], zr = std::conj(z[(h - k) % h]);
+        auto even = (zk + zr) * T{0.5};
+        auto odd = value_type(T{0}, T{-0.5}) * (zk - zr);
+        out[k] = even + Detail::fft_multiply(odd, _twiddles[k]);
+      }
+    } else {
+      for (auto k = std::size_t{0}; k < _n; ++k) z[k] = value_type(in[k]);
+      _complex.execute(z, scratch);
+      std::copy_n(z, _n / 2 + 1, out);
+    }
+    // The inverse transform of real data is the conjugate of the forward.
+    if (_direction == FftDirection::Inverse) {
+      for (auto k = std::size_t{0}; k <= _n / 2; ++k) {
+        out[k] = std::conj(out[k]);
+      }
+    }
+  }
+
+ private:
+  std::size_t _n;
+  FftDirection _direction;
+  FftPlan<T> _complex;
+  std::vector<value_type> _twiddles;
+};
+
+/**
+ * @brief A thread-safe cache of transform plans, keyed by the plan type,
+ * which fixes the precision, and by the length and direction.
+ */
+class FftPlanCache {
+ public:
+  FftPlanCache() = default;
+  FftPlanCache(const FftPlanCache&) = delete;
+  FftPlanCache& operator=(const FftPlanCache&) = delete;
+
+  /// The cache used by default.
+  static FftPlanCache& global() {
+    static auto cache = FftPlanCache();
+    return cache;
+  }
+
+  /**
+   * @brief Returns the plan for a length and direction, building it on first
+   * use.
+   * @tparam Plan FftPlan<T> or RealFftPlan<T>.
+   * @param n The transform length.
+   * @param direction The sign of the exponent.
+   */
+  template <typename Plan>
+    requires std::constructible_from<Plan, std::size_t, FftDirection>
+  std::shared_ptr<const Plan> plan(std::size_t n, FftDirection direction) {
+    auto key = Key{std::type_index(typeid(Plan)), n, direction};
+    {
+      auto lock = std::shared_lock(_mutex);
+      if (auto it = _plans.find(key); it != _plans.end()) {
+        return std::static_pointer_cast<const Plan>(it->second);
+      }
+    }
+    // Plans are built outside the lock. If two threads race, the first to
+    // insert wins and the other plan is discarded.
+    auto built = std::make_shared<const Plan>(n, direction);
+    auto lock = std::unique_lock(_mutex);
+    auto [it, inserted] = _plans.try_emplace(key, std::move(built));
+    return std::static_pointer_cast<const Plan>(it->second);
+  }
+
+  /// The number of cached plans.
+  std::size_t size() const {
+    auto lock = std::shared_lock(_mutex);
+    return _plans.size();
+  }
+
+  /// Removes all plans. Plans still in use remain valid.
+  void clear() {
+    auto lock = std::unique_lock(_mutex);
+    _plans.clear();
+  }
+
+ private:
+  using Key = std::tuple<std::type_index, std::size_t, FftDirection>;
+
+  mutable std::shared_mutex _mutex;
+  std::map<Key, std::shared_ptr<const void>> _plans;
+};
+
+/**
+ * @brief Options for the Fourier transforms.
+ */
+struct FftOptions {
+  /// The sign of the exponent.
+  FftDirection direction = FftDirection::Forward;
+  /// Rows or columns per task, and the pool, for matrix transforms.
+  ParallelOptions parallel = {.grain = 4};
+  /// The plan cache, null meaning FftPlanCache::global().
+  FftPlanCache* cache = nullptr;
+};
+
+namespace Detail {
+
+inline FftPlanCache& options_cache(const FftOptions& options) {
+  return options.cache ? *options.cache : FftPlanCache::global();
+}
+
+/**
+ * @internal
+ * @brief Concept for a range whose storage can be transformed in place.
+ */
+template <typename R, typename Z>
+concept FftStorage = ContiguousRange<R> and
+                     std::same_as<std::ranges::range_value_t<R>, Z> and
+                     std::is_same_v<std::ranges::range_reference_t<R>, Z&>;
+
+/**
+ * @internal
+ * @brief Transforms the rows [lo, hi) of a into the same rows of b, which
+ * may be the same matrix.
+ */
+template <typename Z, typename A, typename B>
+void fft_rows(const FftPlan<RemoveComplex<Z>>& plan, const MatrixAccess<A>& a,
+              const MatrixAccess<B>& b, std::size_t lo, std::size_t hi) {
+  using Value = TensorValue<B>;
+  auto n = plan.size();
+  auto buffer = NumericBuffer<Z>(n + plan.work_size(), Uninitialized);
+  for (auto i = lo; i < hi; ++i) {
+    for (auto j = std::size_t{0}; j < n; ++j) {
+      buffer[j] = numeric_cast<Z>(a(i, j));
+    }
+    plan.execute(buffer.data(), buffer.data() + n);
+    for (auto j = std::size_t{0}; j < n; ++j) {
+      b(i, j) = numeric_cast<Value>(buffer[j]);
+    }
+  }
+}
+
+/**
+ * @internal
+ * @brief Transforms the columns [lo, hi) of b in place, gathering a few
+ * columns at a time so that row-major data is read in short runs.
+ */
+template <typename Z, typename B>
+void fft_columns(const FftPlan<RemoveComplex<Z>>& plan,
+                 const MatrixAccess<B>& b, std::size_t lo, std::size_t hi) {
+  using Value = TensorValue<B>;
+  constexpr auto width = std::size_t{8};
+  auto n = plan.size();
+  auto buffer = NumericBuffer<Z>(width * n + plan.work_size(), Uninitialized);
+  auto work = buffer.data() + width * n;
+  for (auto j0 = lo; j0 < hi; j0 += width) {
+    auto w = std::min(width, hi - j0);
+    for (auto i = std::size_t{0}; i < n; ++i) {
+      for (auto c = std::size_t{0}; c < w; ++c) {
+        buffer[c * n + i] = numeric_cast<Z>(b(i, j0 + c));
+      }
+    }
+    for (auto c = std::size_t{0}; c < w; ++c) {
+      plan.execute(buffer.data() + c * n, work);
+    }
+    for (auto i = std::size_t{0}; i < n; ++i) {
+      for (auto c = std::size_t{0}; c < w; ++c) {
+        b(i, j0 + c) = numeric_cast<Value>(buffer[c * n + i]);
+      }
+    }
+  }
+}
+
+}  // namespace Detail
+
+/**
+ * @brief Computes the discrete Fourier transform of a complex range.
+ * @details The transform has the length of in, and out must have at least
+ * as many elements. in and out may be the same range.
+ * @param in The complex values.
+ * @param out The range to write the coefficients to.
+ * @param options The direction and plan cache.
+ * @throws std::invalid_argument if out is too short.
+ */
+template <ComplexRange In, ComplexWritableRange Out>
+  requires std::ranges::sized_range<In> and std::ranges::sized_range<Out> and
+           SameRangePrecision<In, Out>
+void fft(In&& in, Out&& out, const FftOptions& options = {}) {
+  using T = AccumulatorPrecision<RangePrecision<In>>;
+  using Z = std::complex<T>;
+  using Value = std::ranges::range_value_t<Out>;
+  auto n = static_cast<std::size_t>(std::ranges::size(in));
+  if (static_cast<std::size_t>(std::ranges::size(out)) < n) {
+    throw std::invalid_argument("fft: output too short");
+  }
+  if (n == 0) return;
+  auto plan = Detail::options_cache(options).plan<FftPlan<T>>(
+      n, options.direction);
+
+  if constexpr (Detail::FftStorage<Out, Z>) {
+    auto data = std::ranges::data(out);
+    auto same = false;
+    if constexpr (ContiguousRange<In>) {
+      same = static_cast<const void*>(std::ranges::data(in)) == data;
+    }
+    if (!same) {
+      auto it = std::ranges::begin(in);
+      for (auto k = std::size_t{0}; k < n; ++k, ++it) {
+        data[k] = Detail::numeric_cast<Z>(*it);
+      }
+    }
+    auto work = NumericBuffer<Z>(plan->work_size(), Uninitialized);
+    plan->execute(data, work.data());
+  } else {
+    auto buffer = NumericBuffer<Z>(n + plan->work_size(), Uninitialized);
+    auto it = std::ranges::begin(in);
+    for (auto k = std::size_t{0}; k < n; ++k, ++it) {
+      buffer[k] = Detail::numeric_cast<Z>(*it);
+    }
+    plan->execute(buffer.data(), buffer.data() + n);
+    auto oi = std::ranges::begin(out);
+    for (auto k = std::size_t{0}; k < n; ++k, ++oi) {
+      *oi = Detail::numeric_cast<Value>(buffer[k]);
+    }
+  }
+}
+
+/**
+ * @brief Computes the discrete Fourier transform of a real range.
+ * @details Only the n / 2 + 1 coefficients that do not follow from
+ * conjugate symmetry are written, where n is the length of in.
+ * @param in The real values.
+ * @param out The range to write the coefficients to.
+ * @param options The direction and plan cache.
+ * @throws std::invalid_argument if out is too short.
+ */
+template <RealRange In, ComplexWritableRange Out>
+  requires std::ranges::sized_range<In> and std::ranges::sized_range<Out> and
+           SameRangePrecision<In, Out>
+void rfft(In&& in, Out&& out, const FftOptions& options = {}) {
+  using T = AccumulatorPrecision<RangePrecision<In>>;
+  using Z = std::complex<T>;
+  using Value = std::ranges::range_value_t<Out>;
+  auto n = static_cast<std::size_t>(std::ranges::size(in));
+  auto m = n / 2 + 1;
+  if (n == 0) return;
+  if (static_cast<std::size_t>(std::ranges::size(out)) < m) {
+    throw std::invalid_argument("rfft: output too short");
+  }
+  auto plan = Detail::options_cache(options).plan<RealFftPlan<T>>(
+      n, options.direction);
+
+  auto work = NumericBuffer<Z>(plan->work_size() + m, Uninitialized);
+  auto coefficients = work.data() + plan->work_size();
+  if constexpr (ContiguousRange<In> and
+                std::same_as<std::ranges::range_value_t<In>, T>) {
+    plan->execute(std::ranges::data(in), coefficients, work.data());
+  } else {
+    auto values = NumericBuffer<T>(n, Uninitialized);
+    auto it = std::ranges::begin(in);
+    for (auto k = std::size_t{0}; k < n; ++k, ++it) {
+      values[k] = static_cast<T>(*it);
+    }
+    plan->execute(values.data(), coefficients, work.data());
+  }
+  auto oi = std::ranges::begin(out);
+  for (auto k = std::size_t{0}; k < m; ++k, ++oi) {
+    *oi = Detail::numeric_cast<Value>(coefficients[k]);
+  }
+}
+
+/**
+ * @brief Transforms each row of a complex matrix, in parallel.
+ * @details in and out must have the same extents, and may be the same
+ * matrix.
+ * @param in The matrix whose rows are transformed.
+ * @param out The matrix to write the transformed rows to.
+ * @param options The direction, rows per task, pool and plan cache.
+ * @throws std::invalid_argument if the extents differ.
+ */
+template <ComplexMatrix In, RealOrComplexWritableMatrix Out>
+  requires ComplexMatrix<Out> and SamePrecision<TensorValue<In>,
+                                                TensorValue<Out>>
+void fft_batch(In&& in, Out&& out, const FftOptions& options = {}) {
+  using T = AccumulatorPrecision<TensorValue<In>>;
+  using Z = std::complex<T>;
+  auto a = Detail::MatrixAccess<std::remove_cvref_t<In>>(in);
+  auto b = Detail::MatrixAccess<std::remove_cvref_t<Out>>(out);
+  if (a.rows() != b.rows() || a.cols() != b.cols()) {
+    throw std::invalid_argument("fft_batch: mismatched extents");
+  }
+  if (a.rows() == 0 || a.cols() == 0) return;
+  auto plan = Detail::options_cache(options).plan<FftPlan<T>>(
+      a.cols(), options.direction);
+  Detail::parallel_range(Detail::options_pool(options.parallel), a.rows(),
+                         options.parallel.grain,
+                         [&](std::size_t lo, std::size_t hi) {
+                           Detail::fft_rows<Z>(*plan, a, b, lo, hi);
+                         });
+}
+
+/**
+ * @brief Computes the two-dimensional transform of a complex matrix.
+ * @details The rows are transformed and then the columns, each in parallel.
+ * in and out must have the same extents, and may be the same matrix.
+ * @param in The matrix to transform.
+ * @param out The matrix to write the coefficients to.
+ * @param options The direction, rows or columns per task, pool and plan
+ * cache.
+ * @throws std::invalid_argument if the extents differ.
+ */
+template <ComplexMatrix In, RealOrComplexWritableMatrix Out>
+  requires ComplexMatrix<Out> and SamePrecision<TensorValue<In>,
+                                                TensorValue<Out>>
+void fft2(In&& in, Out&& out, const FftOptions& options = {}) {
+  using T = AccumulatorPrecision<TensorValue<In>>;
+  using Z = std::complex<T>;
+  fft_batch(in, out, options);
+  auto b = Detail::MatrixAccess<std::remove_cvref_t<Out>>(out);
+  if (b.rows() == 0 || b.cols() == 0) return;
+  auto plan = Detail::options_cache(options).plan<FftPlan<T>>(
+      b.rows(), options.direction);
+  Detail::parallel_range(Detail::options_pool(options.parallel), b.cols(),
+                         options.parallel.grain,
+                         [&](std::size_t lo, std::size_t hi) {
+                           Detail::fft_columns<Z>(*plan, b, lo, hi);
+                         });
+}
+
+}  // namespace NumericConcepts
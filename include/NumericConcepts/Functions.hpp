@@ -1,10 +1,13 @@
 #pragma once
 
+#include <complex>
 #include <concepts>
+#include <span>
 #include <system_error>
 #include <type_traits>
 
 #include "Numeric.hpp"
+#include "Ranges.hpp"
 
 /**
  * @file Functions.hpp
@@ -83,4 +86,114 @@ concept NumericFunction = requires() {
   requires Numeric<std::invoke_result_t<F, Args...>>;
 };
 
-}  // namespace NumericConcepts
\ No newline at end of file
+namespace Detail {
+
+/**
+ * @internal
+ * @brief The default output spans of batched functions with arguments of
+ * type T.
+ */
+template <typename T>
+struct BatchOutputHelper {
+  using real = std::span<T>;
+  using complex = std::span<std::complex<T>>;
+};
+
+template <RealOrComplex T>
+struct BatchOutputHelper<T> {
+  using real = std::span<RemoveComplex<T>>;
+  using complex = std::span<std::complex<RemoveComplex<T>>>;
+};
+
+}  // namespace Detail
+
+/**
+ * @brief Concept for a batched function returning real values.
+ * @details A batched function is called as `f(x, out)`, with x a contiguous
+ * span of arguments, and writes the value at each argument to the
+ * corresponding element of out, which has at least as many elements as x.
+ * Evaluating many points per call lets the function vectorize its loop and
+ * amortise any per-call setup.
+ * @tparam F The invocable type.
+ * @tparam T The Numeric argument type.
+ * @tparam Out The RealWritableRange type of the output, by default a span of
+ * the argument's precision.
+ */
+template <typename F, typename T,
+          typename Out = typename Detail::BatchOutputHelper<T>::real>
+concept BatchRealFunction = requires(F f, std::span<const T> x, Out out) {
+  requires Numeric<T>;
+  requires RealWritableRange<Out>;
+  f(x, out);
+};
+
+/**
+ * @brief Concept for a batched function returning complex values.
+ * @details See BatchRealFunction for the calling convention.
+ * @tparam F The invocable type.
+ * @tparam T The Numeric argument type.
+ * @tparam Out The ComplexWritableRange type of the output, by default a span
+ * of complex values of the argument's precision.
+ */
+template <typename F, typename T,
+          typename Out = typename Detail::BatchOutputHelper<T>::complex>
+concept BatchComplexFunction = requires(F f, std::span<const T> x, Out out) {
+  requires Numeric<T>;
+  requires ComplexWritableRange<Out>;
+  f(x, out);
+};
+
+/**
+ * @brief Concept for a batched function writing into a given real or
+ * complex output range.
+ * @details See BatchRealFunction for the calling convention.
+ * @tparam F The invocable type.
+ * @tparam T The Numeric argument type.
+ * @tparam Out The RealOrComplexWritableRange type of the output.
+ */
+template <typename F, typename T, typename Out>
+concept BatchRealOrComplexFunction = requires(F f, std::span<const T> x,
+                                              Out out) {
+  requires Numeric<T>;
+  requires RealOrComplexWritableRange<Out>;
+  f(x, out);
+};
+
+/**
+ * @brief Concept for the right-hand side of a system of ordinary
+ * differential equations.
+ * @details The function is called as `f(t, y, dydt)`, with y a contiguous
+ * span holding the state at time t, and writes the derivative of each
+ * element to the corresponding element of dydt, which has the same length.
+ * Writing into storage owned by the caller lets integrators evaluate the
+ * function without allocating.
+ * @tparam F The invocable type.
+ * @tparam T The Real type of the independent variable.
+ * @tparam V The RealOrComplex type of the state's elements.
+ */
+template <typename F, typename T, typename V>
+concept OdeFunction = requires(F f, T t, std::span<const V> y,
+                               std::span<V> dydt) {
+  requires Real<T>;
+  requires RealOrComplex<V>;
+  f(t, y, dydt);
+};
+
+/**
+ * @brief Concept for the right-hand side of one system of an ensemble of
+ * ordinary differential equations.
+ * @details The function is called as `f(t, y, dydt, i)`, with i the index
+ * of the system, and otherwise as for OdeFunction.
+ * @tparam F The invocable type.
+ * @tparam T The Real type of the independent variable.
+ * @tparam V The RealOrComplex type of the state's elements.
+ */
+template <typename F, typename T, typename V>
+concept OdeEnsembleFunction = requires(F f, T t, std::span<const V> y,
+                                       std::span<V> dydt, std::size_t i) {
+  requires Real<T>;
+  requires RealOrComplex<V>;
+  f(t, y, dydt, i);
+};
+
+}  // namespace NumericConcepts
@@ -0,0 +1,513 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Buffer.hpp"
+#include "Numeric.hpp"
+#include "Parallel.hpp"
+#include "Ranges.hpp"
+#include "Threading.hpp"
+
+/**
+ * @file IntegerAlgorithms.hpp
+ * @brief Defines parallel prefix sums, histograms, radix sorts and stream
+ * compaction over integral ranges.
+ * @details These are the building blocks for index arrays and sparse matrix
+ * structures. Random access sized ranges are divided into blocks of
+ * ParallelOptions::grain elements, so results never depend on the number of
+ * threads, and other ranges are processed sequentially on the calling
+ * thread.
+ */
+
+namespace NumericConcepts {
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief The start of part p when n elements are split into `parts` parts
+ * whose sizes differ by at most one.
+ */
+inline std::size_t part_start(std::size_t n, std::size_t parts,
+                              std::size_t p) {
+  return n / parts * p + n % parts * p / parts;
+}
+
+/**
+ * @internal
+ * @brief Computes an inclusive or exclusive prefix sum in three passes: the
+ * sums of each block, a sequential scan of the block sums, and a scan of
+ * each block starting from its offset.
+ * @details Reading element i before writing element i makes in-place scans
+ * safe.
+ */
+template <bool Inclusive, typename In, typename Out, typename T>
+std::size_t prefix_sum(In&& in, Out&& out, T init,
+                       const ParallelOptions& options) {
+  if constexpr (SplittableRange<In> and SplittableRange<Out>) {
+    auto n = std::min(static_cast<std::size_t>(std::ranges::size(in)),
+                      static_cast<std::size_t>(std::ranges::size(out)));
+    auto ii = std::ranges::begin(in);
+    auto oi = std::ranges::begin(out);
+    auto grain = std::max<std::size_t>(options.grain, 1);
+    auto blocks = (n + grain - 1) / grain;
+    auto& pool = options_pool(options);
+
+    auto offsets = std::vector<T>(blocks, init);
+    auto scan = [&](std::size_t b, T sum) {
+      auto stop = std::min(n, (b + 1) * grain);
+      for (auto i = b * grain; i < stop; ++i) {
+        auto j = static_cast<std::ptrdiff_t>(i);
+        auto value = static_cast<T>(ii[j]);
+        if constexpr (Inclusive) {
+          sum += value;
+          oi[j] = sum;
+        } else {
+          oi[j] = sum;
+          sum += value;
+        }
+      }
+      return sum;
+    };
+    if (blocks <= 1 || pool.concurrency() == 1) {
+      auto sum = init;
+      for (auto b = std::size_t{0}; b < blocks; ++b) sum = scan(b, sum);
+      return n;
+    }
+
+    parallel_range(pool, blocks, 1, [&](std::size_t lo, std::size_t hi) {
+      for (auto b = lo; b < hi; ++b) {
+        auto stop = std::min(n, (b + 1) * grain);
+        auto sum = T{0};
+        for (auto i = b * grain; i < stop; ++i) {
+          sum += static_cast<T>(ii[static_cast<std::ptrdiff_t>(i)]);
+        }
+        offsets[b] = sum;
+      }
+    });
+    auto carry = init;
+    for (auto& offset : offsets) carry += std::exchange(offset, carry);
+    parallel_range(pool, blocks, 1, [&](std::size_t lo, std::size_t hi) {
+      for (auto b = lo; b < hi; ++b) scan(b, offsets[b]);
+    });
+    return n;
+  } else {
+    auto count = std::size_t{0};
+    auto ii = std::ranges::begin(in);
+    auto oi = std::ranges::begin(out);
+    for (; ii != std::ranges::end(in) && oi != std::ranges::end(out);
+         ++ii, ++oi, ++count) {
+      auto value = static_cast<T>(*ii);
+      if constexpr (Inclusive) {
+        init += value;
+        *oi = init;
+      } else {
+        *oi = init;
+        init += value;
+      }
+    }
+    return count;
+  }
+}
+
+/**
+ * @internal
+ * @brief Gives a pointer to the elements of a random access range, staging
+ * them in a buffer unless the range is contiguous.
+ */
+template <typename R>
+class StagedRange {
+ public:
+  using Value = std::ranges::range_value_t<R>;
+
+  static constexpr bool direct =
+      std::ranges::contiguous_range<R> and
+      std::same_as<std::ranges::range_reference_t<R>, Value&>;
+
+  StagedRange(R& range, ThreadPool& pool, std::size_t grain)
+      : _range{range}, _pool{pool}, _grain{grain} {
+    auto n = static_cast<std::size_t>(std::ranges::size(range));
+    if constexpr (direct) {
+      _data = std::ranges::data(range);
+    } else {
+      _buffer = NumericBuffer<Value>(n, Uninitialized);
+      _data = _buffer.data();
+      auto first = std::ranges::begin(range);
+      parallel_range(pool, n, grain, [&](std::size_t lo, std::size_t hi) {
+        for (auto i = lo; i < hi; ++i) {
+          _data[i] = static_cast<Value>(first[static_cast<std::ptrdiff_t>(i)]);
+        }
+      });
+    }
+  }
+
+  Value* data() { return _data; }
+
+  /// Copies result, which holds the sorted elements, back to the range.
+  void store(const Value* result) {
+    if (direct && result == _data) return;
+    auto first = std::ranges::begin(_range);
+    auto n = static_cast<std::size_t>(std::ranges::size(_range));
+    parallel_range(_pool, n, _grain, [&](std::size_t lo, std::size_t hi) {
+      for (auto i = lo; i < hi; ++i) {
+        first[static_cast<std::ptrdiff_t>(i)] = result[i];
+      }
+    });
+  }
+
+ private:
+  R& _range;
+  ThreadPool& _pool;
+  std::size_t _grain;
+  Value* _data = nullptr;
+  NumericBuffer<Value> _buffer;
+};
+
+/**
+ * @internal
+ * @brief Sorts n keys, and values alongside them if WithValues, by a stable
+ * least significant digit radix sort on bytes.
+ * @details Each pass counts the digits of each block of elements, skips the
+ * pass if all keys share the digit, and otherwise scatters every block to
+ * its precomputed offsets. The arrays are swapped with the scratch arrays
+ * after each scatter.
+ * @return True if the sorted elements are in the scratch arrays.
+ */
+template <bool WithValues, typename Key, typename Value>
+bool radix_sort(Key* keys, Key* key_scratch, Value* values,
+                Value* value_scratch, std::size_t n, ThreadPool& pool,
+                std::size_t grain) {
+  using Unsigned = std::make_unsigned_t<Key>;
+  constexpr auto radix = std::size_t{256};
+  // Flipping the sign bit orders signed keys as unsigned ones.
+  constexpr auto bits = std::numeric_limits<Unsigned>::digits;
+  constexpr auto flip =
+      std::is_signed_v<Key> ? Unsigned(Unsigned{1} << (bits - 1)) : Unsigned{0};
+
+  grain = std::max<std::size_t>(grain, radix);
+  auto parts = std::clamp<std::size_t>(n / grain, 1, 4 * pool.concurrency());
+  auto bound = [&](std::size_t p) { return part_start(n, parts, p); };
+  auto counts = std::vector<std::size_t>(parts * radix);
+  auto swapped = false;
+
+  for (auto shift = 0; shift < bits; shift += 8) {
+    auto digit = [shift](Key key) {
+      return static_cast<std::size_t>(
+          static_cast<Unsigned>(static_cast<Unsigned>(key) ^ flip) >> shift &
+          0xff);
+    };
+    std::ranges::fill(counts, 0);
+    parallel_range(pool, parts, 1, [&](std::size_t lo, std::size_t hi) {
+      for (auto p = lo; p < hi; ++p) {
+        auto count = counts.data() + p * radix;
+        auto stop = bound(p + 1);
+        for (auto i = bound(p); i < stop; ++i) ++count[digit(keys[i])];
+      }
+    });
+
+    // Offsets are ordered by digit and then by block, keeping the sort
+    // stable. A digit holding every key leaves the order unchanged.
+    auto offset = std::size_t{0};
+    auto trivial = false;
+    for (auto d = std::size_t{0}; d < radix; ++d) {
+      auto start = offset;
+      for (auto p = std::size_t{0}; p < parts; ++p) {
+        offset += std::exchange(counts[p * radix + d], offset);
+      }
+      if (offset - start == n) trivial = true;
+    }
+    if (trivial) continue;
+
+    parallel_range(pool, parts, 1, [&](std::size_t lo, std::size_t hi) {
+      for (auto p = lo; p < hi; ++p) {
+        auto next = counts.data() + p * radix;
+        auto stop = bound(p + 1);
+        for (auto i = bound(p); i < stop; ++i) {
+          auto j = next[digit(keys[i])]++;
+          key_scratch[j] = keys[i];
+          if constexpr (WithValues) value_scratch[j] = values[i];
+        }
+      }
+    });
+    std::swap(keys, key_scratch);
+    if constexpr (WithValues) std::swap(values, value_scratch);
+    swapped = !swapped;
+  }
+  return swapped;
+}
+
+/**
+ * @internal
+ * @brief Concept for an integral type that can be radix sorted.
+ */
+template <typename T>
+concept RadixSortable = Integral<T> and not std::same_as<T, bool>;
+
+}  // namespace Detail
+
+/**
+ * @brief Computes the inclusive prefix sums of an integral range in
+ * parallel.
+ * @details Element i of out is the sum of elements 0 to i of in, computed in
+ * the value type of out. in and out may be the same range.
+ * @param in The input range.
+ * @param out The output range.
+ * @param options The grain size and thread pool.
+ * @return The number of elements written, the smaller of the two sizes.
+ */
+template <IntegralRange In, IntegralWritableRange Out>
+std::size_t parallel_inclusive_scan(In&& in, Out&& out,
+                                    const ParallelOptions& options = {}) {
+  using T = std::ranges::range_value_t<Out>;
+  return Detail::prefix_sum<true>(in, out, T{0}, options);
+}
+
+/**
+ * @brief Computes the exclusive prefix sums of an integral range in
+ * parallel.
+ * @details Element i of out is init plus the sum of elements 0 to i - 1 of
+ * in, computed in the value type of out. in and out may be the same range.
+ * Applied to the number of entries in each row, this gives the row offsets
+ * of a CsrMatrix.
+ * @param in The input range.
+ * @param out The output range.
+ * @param init The first output value.
+ * @param options The grain size and thread pool.
+ * @return The number of elements written, the smaller of the two sizes.
+ */
+template <IntegralRange In, IntegralWritableRange Out>
+std::size_t parallel_exclusive_scan(
+    In&& in, Out&& out, std::ranges::range_value_t<Out> init = 0,
+    const ParallelOptions& options = {}) {
+  return Detail::prefix_sum<false>(in, out, init, options);
+}
+
+/**
+ * @brief Counts the occurrences of each value of an integral range in
+ * parallel.
+ * @details counts[k] is set to the number of elements equal to k, for k
+ * below the size of counts. Other values are ignored. Each task counts into
+ * a private histogram, and the histograms are then summed, with fewer tasks
+ * when there are more bins than elements per task.
+ * @param keys The values to count.
+ * @param counts The histogram to write.
+ * @param options The grain size and thread pool.
+ * @return The number of elements that fell into a bin.
+ */
+template <IntegralRange In, IntegralWritableRange Out>
+  requires std::ranges::random_access_range<Out> and
+           std::ranges::sized_range<Out>
+std::size_t parallel_histogram(In&& keys, Out&& counts,
+                               const ParallelOptions& options = {}) {
+  using Key = std::ranges::range_value_t<In>;
+  using Count = std::ranges::range_value_t<Out>;
+  auto bins = static_cast<std::size_t>(std::ranges::size(counts));
+  auto bin = [bins](Key key) {
+    if constexpr (std::is_signed_v<Key>) {
+      if (key < 0) return bins;
+    }
+    auto k = static_cast<std::uintmax_t>(key);
+    return k < bins ? static_cast<std::size_t>(k) : bins;
+  };
+  auto& pool = Detail::options_pool(options);
+  auto grain = std::max<std::size_t>(options.grain, 1);
+
+  auto parts = std::size_t{1};
+  auto n = std::size_t{0};
+  if constexpr (Detail::SplittableRange<In>) {
+    n = static_cast<std::size_t>(std::ranges::size(keys));
+    parts = std::min((n + grain - 1) / grain, pool.concurrency());
+    parts = std::clamp<std::size_t>(parts, 1, n / std::max(bins, grain) + 1);
+  }
+  auto histograms = NumericBuffer<std::size_t>(parts * (bins + 1));
+  if constexpr (Detail::SplittableRange<In>) {
+    auto first = std::ranges::begin(keys);
+    Detail::parallel_range(pool, parts, 1, [&](std::size_t lo, std::size_t hi) {
+      for (auto p = lo; p < hi; ++p) {
+        auto count = histograms.data() + p * (bins + 1);
+        auto stop = Detail::part_start(n, parts, p + 1);
+        for (auto i = Detail::part_start(n, parts, p); i < stop; ++i) {
+          ++count[bin(first[static_cast<std::ptrdiff_t>(i)])];
+        }
+      }
+    });
+  } else {
+    for (auto&& key : keys) {
+      ++histograms[bin(static_cast<Key>(key))];
+      ++n;
+    }
+  }
+
+  // The last slot of each histogram collects the ignored values.
+  auto ignored = std::size_t{0};
+  for (auto p = std::size_t{0}; p < parts; ++p) {
+    ignored += histograms[p * (bins + 1) + bins];
+  }
+  auto out = std::ranges::begin(counts);
+  Detail::parallel_range(pool, bins, grain, [&](std::size_t lo,
+                                                std::size_t hi) {
+    for (auto k = lo; k < hi; ++k) {
+      auto sum = std::size_t{0};
+      for (auto p = std::size_t{0}; p < parts; ++p) {
+        sum += histograms[p * (bins + 1) + k];
+      }
+      out[static_cast<std::ptrdiff_t>(k)] = static_cast<Count>(sum);
+    }
+  });
+  return n - ignored;
+}
+
+/**
+ * @brief Sorts an integral range in parallel with a radix sort.
+ * @details Keys are sorted by a least significant digit radix sort on bytes,
+ * which takes at most sizeof(key) passes over the data, and skips bytes that
+ * are the same for every key. Signed keys are ordered as integers. Ranges
+ * that are not contiguous are sorted in a buffer and copied back.
+ * @param keys The range to sort.
+ * @param options The grain size and thread pool.
+ */
+template <IntegralWritableRange K>
+  requires std::ranges::random_access_range<K> and
+           std::ranges::sized_range<K> and
+           Detail::RadixSortable<std::ranges::range_value_t<K>>
+void parallel_radix_sort(K&& keys, const ParallelOptions& options = {}) {
+  using Key = std::ranges::range_value_t<K>;
+  auto n = static_cast<std::size_t>(std::ranges::size(keys));
+  if (n <= 256) {
+    std::ranges::sort(keys);
+    return;
+  }
+  auto& pool = Detail::options_pool(options);
+  auto staged = Detail::StagedRange<K>(keys, pool, options.grain);
+  auto scratch = NumericBuffer<Key>(n, Uninitialized);
+  auto swapped = Detail::radix_sort<false, Key, Key>(
+      staged.data(), scratch.data(), nullptr, nullptr, n, pool, options.grain);
+  staged.store(swapped ? scratch.data() : staged.data());
+}
+
+/**
+ * @brief Sorts an integral range of keys in parallel, permuting a range of
+ * values in the same way.
+ * @details The sort is stable, so values with equal keys keep their order.
+ * Sorting the column indices of a set of entries by row, for example, groups
+ * the entries of each row of a sparse matrix.
+ * @param keys The keys to sort.
+ * @param values The values, which may be any numeric range of the same size.
+ * @param options The grain size and thread pool.
+ * @throws std::invalid_argument if the sizes differ.
+ */
+template <IntegralWritableRange K, NumericWritableRange V>
+  requires std::ranges::random_access_range<K> and
+           std::ranges::sized_range<K> and
+           std::ranges::random_access_range<V> and
+           std::ranges::sized_range<V> and
+           Detail::RadixSortable<std::ranges::range_value_t<K>>
+void parallel_radix_sort(K&& keys, V&& values,
+                         const ParallelOptions& options = {}) {
+  using Key = std::ranges::range_value_t<K>;
+  using Value = std::ranges::range_value_t<V>;
+  auto n = static_cast<std::size_t>(std::ranges::size(keys));
+  if (static_cast<std::size_t>(std::ranges::size(values)) != n) {
+    throw std::invalid_argument("parallel_radix_sort: mismatched sizes");
+  }
+  if (n <= 1) return;
+  auto& pool = Detail::options_pool(options);
+  auto staged_keys = Detail::StagedRange<K>(keys, pool, options.grain);
+  auto staged_values = Detail::StagedRange<V>(values, pool, options.grain);
+  auto key_scratch = NumericBuffer<Key>(n, Uninitialized);
+  auto value_scratch = NumericBuffer<Value>(n, Uninitialized);
+  auto swapped = Detail::radix_sort<true>(
+      staged_keys.data(), key_scratch.data(), staged_values.data(),
+      value_scratch.data(), n, pool, options.grain);
+  staged_keys.store(swapped ? key_scratch.data() : staged_keys.data());
+  staged_values.store(swapped ? value_scratch.data() : staged_values.data());
+}
+
+/**
+ * @brief Copies the elements of a numeric range that satisfy a predicate, in
+ * order, in parallel.
+ * @details Random access sized ranges are processed in two passes, counting
+ * the selected elements of each block and then copying them to their
+ * offsets, so pred is called twice for each element and must give the same
+ * result both times.
+ * @param in The input range.
+ * @param out The output range.
+ * @param pred The predicate, invocable with the input's reference type.
+ * @param options The grain size and thread pool.
+ * @return The number of elements written.
+ * @throws std::invalid_argument if out is too small for the selected
+ * elements, in which case its contents are unspecified.
+ */
+template <NumericRange In, NumericWritableRange Out, typename Pred>
+  requires std::predicate<Pred&, std::ranges::range_reference_t<In>> and
+           std::indirectly_writable<std::ranges::iterator_t<Out>,
+                                    std::ranges::range_reference_t<In>>
+std::size_t parallel_compact(In&& in, Out&& out, Pred pred,
+                             const ParallelOptions& options = {}) {
+  if constexpr (Detail::SplittableRange<In> and
+                Detail::SplittableRange<Out>) {
+    auto n = static_cast<std::size_t>(std::ranges::size(in));
+    auto size = static_cast<std::size_t>(std::ranges::size(out));
+    auto ii = std::ranges::begin(in);
+    auto oi = std::ranges::begin(out);
+    auto grain = std::max<std::size_t>(options.grain, 1);
+    auto blocks = (n + grain - 1) / grain;
+    auto& pool = Detail::options_pool(options);
+    auto selected = [&](std::size_t i) -> bool {
+      return std::invoke(pred, ii[static_cast<std::ptrdiff_t>(i)]);
+    };
+
+    auto offsets = std::vector<std::size_t>(blocks);
+    Detail::parallel_range(pool, blocks, 1, [&](std::size_t lo,
+                                                std::size_t hi) {
+      for (auto b = lo; b < hi; ++b) {
+        auto stop = std::min(n, (b + 1) * grain);
+        auto count = std::size_t{0};
+        for (auto i = b * grain; i < stop; ++i) count += selected(i);
+        offsets[b] = count;
+      }
+    });
+    auto total = std::size_t{0};
+    for (auto& offset : offsets) total += std::exchange(offset, total);
+    if (total > size) {
+      throw std::invalid_argument("parallel_compact: output too small");
+    }
+    Detail::parallel_range(pool, blocks, 1, [&](std::size_t lo,
+                                                std::size_t hi) {
+      for (auto b = lo; b < hi; ++b) {
+        auto stop = std::min(n, (b + 1) * grain);
+        auto j = static_cast<std::ptrdiff_t>(offsets[b]);
+        for (auto i = b * grain; i < stop; ++i) {
+          if (selected(i)) oi[j++] = ii[static_cast<std::ptrdiff_t>(i)];
+        }
+      }
+    });
+    return total;
+  } else {
+    auto count = std::size_t{0};
+    auto oi = std::ranges::begin(out);
+    for (auto&& value : in) {
+      if (!std::invoke(pred, value)) continue;
+      if (oi == std::ranges::end(out)) {
+        throw std::invalid_argument("parallel_compact: output too small");
+      }
+      *oi = value;
+      ++oi;
+      ++count;
+    }
+    return count;
+  }
+}
+
+}  // namespace NumericConcepts
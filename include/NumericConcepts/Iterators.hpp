@@ -55,6 +55,54 @@ concept RealOrComplexIterator =
 template <typename T>
 concept NumericIterator = Iterator<T> && Numeric<std::iter_value_t<T>>;
 
+/**
+ * @brief Concept for a type that satisfies the std::contiguous_iterator
+ * requirements.
+ * @tparam T The type to check.
+ */
+template <typename T>
+concept ContiguousIterator = std::contiguous_iterator<T>;
+
+/**
+ * @brief Concept for a contiguous iterator whose value type is integral.
+ * @tparam T The iterator type to check.
+ */
+template <typename T>
+concept ContiguousIntegralIterator =
+    ContiguousIterator<T> && IntegralIterator<T>;
+
+/**
+ * @brief Concept for a contiguous iterator whose value type is real.
+ * @tparam T The iterator type to check.
+ */
+template <typename T>
+concept ContiguousRealIterator = ContiguousIterator<T> && RealIterator<T>;
+
+/**
+ * @brief Concept for a contiguous iterator whose value type is complex.
+ * @tparam T The iterator type to check.
+ */
+template <typename T>
+concept ContiguousComplexIterator =
+    ContiguousIterator<T> && ComplexIterator<T>;
+
+/**
+ * @brief Concept for a contiguous iterator whose value type is real or
+ * complex.
+ * @tparam T The iterator type to check.
+ */
+template <typename T>
+concept ContiguousRealOrComplexIterator =
+    ContiguousIterator<T> && RealOrComplexIterator<T>;
+
+/**
+ * @brief Concept for a contiguous iterator whose value type is numeric.
+ * @tparam T The iterator type to check.
+ */
+template <typename T>
+concept ContiguousNumericIterator =
+    ContiguousIterator<T> && NumericIterator<T>;
+
 /**
  * @brief Concept for a type that is a writable iterator.
  * @tparam T The iterator type to check.
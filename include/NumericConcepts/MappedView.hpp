@@ -0,0 +1,303 @@
+#pragma once
+
+#include <cerrno>
+#include <complex>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <ranges>
+#include <system_error>
+#include <type_traits>
+
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define NUMERIC_CONCEPTS_HAS_MMAP 1
+#endif
+
+/**
+ * @file MappedView.hpp
+ * @brief Defines zero-copy views of raw binary files of numeric values,
+ * backed by memory mapping.
+ * @details The views satisfy the view concepts in Ranges.hpp, such as
+ * RealView, ComplexView and NumericWritableView, so files can be passed to
+ * concept-constrained code without first being read into memory. Copies of
+ * a view share the same mapping, which is unmapped when the last copy is
+ * destroyed. This header is only available on POSIX systems, where
+ * `NUMERIC_CONCEPTS_HAS_MMAP` is defined.
+ */
+
+#if defined(NUMERIC_CONCEPTS_HAS_MMAP)
+
+namespace NumericConcepts {
+
+/**
+ * @brief Expected pattern of access to a mapped file, passed to the kernel
+ * through madvise as a hint. The kernel may ignore it.
+ */
+enum class MappedAccess { Normal, Sequential, Random, WillNeed };
+
+/**
+ * @brief Options for mapping a file.
+ */
+struct MappingOptions {
+  /// The expected access pattern.
+  MappedAccess access = MappedAccess::Sequential;
+  /// Request transparent huge pages for the mapping. This is best-effort:
+  /// Linux only backs anonymous and shmem memory with transparent huge
+  /// pages, so the request is ignored for files on ordinary file systems,
+  /// and a refusal is not reported.
+  bool huge_pages = false;
+  /// Pre-fault the whole mapping when it is created.
+  bool populate = false;
+  /// Offset in bytes of the first element within the file.
+  std::size_t offset = 0;
+};
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Owns a memory mapping of a file.
+ */
+class FileMapping {
+ public:
+  FileMapping(const std::filesystem::path& path, bool writable,
+              const MappingOptions& options) {
+    auto fd = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+    if (fd < 0) throw_error(errno, "open");
+
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+      auto error = errno;
+      ::close(fd);
+      throw_error(error, "fstat");
+    }
+    auto file_size = static_cast<std::size_t>(info.st_size);
+    if (options.offset > file_size) {
+      ::close(fd);
+      throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                              "mapping offset beyond end of file");
+    }
+
+    auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto start = options.offset / page * page;
+    _skip = options.offset - start;
+    _length = file_size - start;
+    _bytes = file_size - options.offset;
+
+    if (_length > 0) {
+      auto protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+      auto flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+      if (options.populate) flags |= MAP_POPULATE;
+#endif
+      _base = ::mmap(nullptr, _length, protection, flags, fd,
+                     static_cast<off_t>(start));
+      if (_base == MAP_FAILED) {
+        auto error = errno;
+        _base = nullptr;
+        ::close(fd);
+        throw_error(error, "mmap");
+      }
+      advise(options.access);
+#if defined(MADV_HUGEPAGE)
+      // Best-effort, see MappingOptions::huge_pages.
+      if (options.huge_pages) {
+        static_cast<void>(::madvise(_base, _length, MADV_HUGEPAGE));
+      }
+#endif
+    }
+    ::close(fd);
+  }
+
+  FileMapping(const FileMapping&) = delete;
+  FileMapping& operator=(const FileMapping&) = delete;
+
+  ~FileMapping() {
+    if (_base) ::munmap(_base, _length);
+  }
+
+  std::byte* data() const { return static_cast<std::byte*>(_base) + _skip; }
+  std::size_t bytes() const { return _bytes; }
+
+  void advise(MappedAccess access) const {
+    if (!_base) return;
+    auto advice = MADV_NORMAL;
+    switch (access) {
+      case MappedAccess::Normal:
+        advice = MADV_NORMAL;
+        break;
+      case MappedAccess::Sequential:
+        advice = MADV_SEQUENTIAL;
+        break;
+      case MappedAccess::Random:
+        advice = MADV_RANDOM;
+        break;
+      case MappedAccess::WillNeed:
+        advice = MADV_WILLNEED;
+        break;
+    }
+    static_cast<void>(::madvise(_base, _length, advice));
+  }
+
+  void sync() const {
+    if (_base && ::msync(_base, _length, MS_SYNC) != 0) {
+      throw_error(errno, "msync");
+    }
+  }
+
+ private:
+  void* _base = nullptr;
+  std::size_t _length = 0;
+  std::size_t _skip = 0;
+  std::size_t _bytes = 0;
+
+  [[noreturn]] static void throw_error(int error, const char* what) {
+    throw std::system_error(error, std::generic_category(), what);
+  }
+};
+
+}  // namespace Detail
+
+/**
+ * @brief A view of the numeric values stored in a memory-mapped binary file.
+ * @details The file is interpreted as a packed array of T in native byte
+ * order, starting at MappingOptions::offset. Any trailing bytes that do not
+ * make up a whole element are ignored.
+ * @tparam T The Numeric element type.
+ * @tparam Writable If true, the file is mapped for writing and writes through
+ * the view are stored to the file.
+ */
+template <Numeric T, bool Writable = false>
+class BasicMappedView
+    : public std::ranges::view_interface<BasicMappedView<T, Writable>> {
+ public:
+  using value_type = T;
+  using element_type = std::conditional_t<Writable, T, const T>;
+  using iterator = element_type*;
+
+  BasicMappedView() = default;
+
+  /**
+   * @brief Maps an existing file.
+   * @param path The path of the file.
+   * @param options The mapping options. The offset must be a multiple of
+   * alignof(T).
+   * @throws std::system_error if the file cannot be opened or mapped.
+   */
+  explicit BasicMappedView(const std::filesystem::path& path,
+                           const MappingOptions& options = {})
+      : _mapping{std::make_shared<Detail::FileMapping>(
+            path, Writable, checked_options(options))} {
+    _data = reinterpret_cast<element_type*>(_mapping->data());
+    _size = _mapping->bytes() / sizeof(T);
+  }
+
+  /**
+   * @brief Creates (or truncates) a file holding n elements and maps it.
+   * @param path The path of the file.
+   * @param n The number of elements.
+   * @param options The mapping options. The offset must be zero.
+   * @return The writable view of the new file.
+   * @throws std::system_error if the file cannot be created or mapped.
+   */
+  static BasicMappedView create(const std::filesystem::path& path,
+                                std::size_t n,
+                                const MappingOptions& options = {})
+    requires Writable
+  {
+    auto fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "open");
+    if (::ftruncate(fd, static_cast<off_t>(n * sizeof(T))) != 0) {
+      auto error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "ftruncate");
+    }
+    ::close(fd);
+    return BasicMappedView(path, options);
+  }
+
+  iterator begin() const { return _data; }
+  iterator end() const { return _data + _size; }
+  element_type* data() const { return _data; }
+  std::size_t size() const { return _size; }
+
+  /// Changes the access pattern hint for the mapping.
+  void advise(MappedAccess access) const {
+    if (_mapping) _mapping->advise(access);
+  }
+
+  /// Flushes writes to the file.
+  void sync() const
+    requires Writable
+  {
+    if (_mapping) _mapping->sync();
+  }
+
+ private:
+  // Returns the options once the offset is known to be aligned, so that a
+  // misaligned offset is reported before the file is opened.
+  static const MappingOptions& checked_options(const MappingOptions& options) {
+    if (options.offset % alignof(T) != 0) {
+      throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                              "mapping offset is not aligned for the element");
+    }
+    return options;
+  }
+
+  std::shared_ptr<Detail::FileMapping> _mapping;
+  element_type* _data = nullptr;
+  std::size_t _size = 0;
+};
+
+/**
+ * @brief A read-only mapped view of a file of numeric values.
+ * @tparam T The Numeric element type.
+ */
+template <Numeric T>
+using MappedView = BasicMappedView<T, false>;
+
+/**
+ * @brief A writable mapped view of a file of numeric values.
+ * @tparam T The Numeric element type.
+ */
+template <Numeric T>
+using MappedWritableView = BasicMappedView<T, true>;
+
+/**
+ * @brief A read-only mapped view of a file of real values.
+ * @tparam T The Real element type.
+ */
+template <Real T>
+using MappedRealView = MappedView<T>;
+
+/**
+ * @brief A writable mapped view of a file of real values.
+ * @tparam T The Real element type.
+ */
+template <Real T>
+using MappedRealWritableView = MappedWritableView<T>;
+
+/**
+ * @brief A read-only mapped view of a file of interleaved complex values.
+ * @tparam T The Real precision of the complex elements.
+ */
+template <Real T>
+using MappedComplexView = MappedView<std::complex<T>>;
+
+/**
+ * @brief A writable mapped view of a file of interleaved complex values.
+ * @tparam T The Real precision of the complex elements.
+ */
+template <Real T>
+using MappedComplexWritableView = MappedWritableView<std::complex<T>>;
+
+}  // namespace NumericConcepts
+
+#endif
@@ -0,0 +1,499 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Algorithms.hpp"
+#include "Buffer.hpp"
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+#include "Tensor.hpp"
+#include "Threading.hpp"
+
+/**
+ * @file MatrixProduct.hpp
+ * @brief Defines BLAS level-2 and level-3 style matrix-vector and
+ * matrix-matrix products over real and complex matrices.
+ * @details The matrices may be any types satisfying the Tensor concepts,
+ * such as TensorSpan or `std::mdspan`, in row-major, column-major or strided
+ * layout, and need not share a layout. gemm() copies blocks of its operands
+ * into contiguous panels sized for the caches, and computes each small tile
+ * of the result in registers, with the tiles shared among the threads of a
+ * pool. Products too small to benefit are computed by plain loops whose
+ * order is chosen from the layouts. Accumulation is in the
+ * AccumulatorPrecision of the output, so 16-bit data is summed in float.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief Options for the matrix products.
+ */
+struct MatrixProductOptions {
+  /// The approximate number of multiply-adds in each parallel task. Products
+  /// with fewer multiply-adds are computed on the calling thread.
+  std::size_t grain = std::size_t{1} << 15;
+  /// The pool to run on, null meaning ThreadPool::global().
+  ThreadPool* pool = nullptr;
+};
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Block sizes for the packed product in compute type P.
+ * @details A tile of mr by nr accumulators is held in registers, a kc by nr
+ * panel of B stays in L1, an mc by kc block of A in L2 and a kc by nc block
+ * of B in L3.
+ */
+template <typename P>
+struct GemmBlocking {
+  static constexpr std::size_t mr = 4;
+  static constexpr std::size_t nr = sizeof(P) <= 4   ? 16
+                                    : sizeof(P) <= 8 ? 8
+                                                     : 4;
+  static constexpr std::size_t kc = 256;
+  static constexpr std::size_t mc = 128;
+  static constexpr std::size_t nc = 2048;
+};
+
+/**
+ * @internal
+ * @brief The type in which products of matrices with value types Ts are
+ * accumulated into an output of value type Out.
+ */
+template <typename Out, typename... Ts>
+using ProductType =
+    ReplacePrecision<PromotePrecision<Out, Ts...>, AccumulatorPrecision<Out>>;
+
+/**
+ * @internal
+ * @brief Element access to a matrix, with the unit stride of row-major and
+ * column-major layouts known at compile time.
+ */
+template <typename M>
+class MatrixAccess {
+ public:
+  using Element = typename std::remove_cvref_t<M>::element_type;
+
+  explicit MatrixAccess(const M& m)
+      : _data{m.data_handle()},
+        _rows{static_cast<std::size_t>(m.extent(0))},
+        _cols{static_cast<std::size_t>(m.extent(1))},
+        _row_stride{static_cast<std::size_t>(m.stride(0))},
+        _col_stride{static_cast<std::size_t>(m.stride(1))} {}
+
+  std::size_t rows() const { return _rows; }
+  std::size_t cols() const { return _cols; }
+
+  std::size_t row_stride() const {
+    if constexpr (LayoutLeftTensor<M>) {
+      return 1;
+    } else {
+      return _row_stride;
+    }
+  }
+
+  std::size_t col_stride() const {
+    if constexpr (LayoutRightTensor<M>) {
+      return 1;
+    } else {
+      return _col_stride;
+    }
+  }
+
+  Element& operator()(std::size_t i, std::size_t j) const {
+    return _data[i * row_stride() + j * col_stride()];
+  }
+
+ private:
+  Element* _data;
+  std::size_t _rows;
+  std::size_t _cols;
+  std::size_t _row_stride;
+  std::size_t _col_stride;
+};
+
+/**
+ * @internal
+ * @brief Computes acc += a * b, using the textbook formula for complex
+ * values so that the loops vectorize (see Multiply in Expression.hpp).
+ */
+template <typename P>
+void multiply_add(P& acc, const P& a, const P& b) {
+  if constexpr (Complex<P>) {
+    acc = P(acc.real() + a.real() * b.real() - a.imag() * b.imag(),
+            acc.imag() + a.real() * b.imag() + a.imag() * b.real());
+  } else {
+    acc += a * b;
+  }
+}
+
+/**
+ * @internal
+ * @brief Sets c = beta * c, writing zeros when beta is zero so that NaNs in
+ * c are not propagated.
+ */
+template <typename P, typename C>
+void scale_matrix(P beta, const MatrixAccess<C>& c) {
+  using Value = TensorValue<C>;
+  if (beta == P{1}) return;
+  auto update = [&](std::size_t i, std::size_t j) {
+    auto& e = c(i, j);
+    e = beta == P{0} ? Value{0}
+                     : numeric_cast<Value>(beta * numeric_cast<P>(e));
+  };
+  if constexpr (LayoutLeftTensor<C>) {
+    for (auto j = std::size_t{0}; j < c.cols(); ++j) {
+      for (auto i = std::size_t{0}; i < c.rows(); ++i) update(i, j);
+    }
+  } else {
+    for (auto i = std::size_t{0}; i < c.rows(); ++i) {
+      for (auto j = std::size_t{0}; j < c.cols(); ++j) update(i, j);
+    }
+  }
+}
+
+/**
+ * @internal
+ * @brief Computes c += alpha * a * b with loops ordered for the layouts.
+ * @details Row-major c and b are updated a row at a time and column-major c
+ * and a a column at a time, so that the inner loop has unit stride. Other
+ * layouts are computed as dot products.
+ */
+template <typename P, typename A, typename B, typename C>
+void gemm_unblocked(P alpha, const MatrixAccess<A>& a,
+                    const MatrixAccess<B>& b, const MatrixAccess<C>& c) {
+  using Value = TensorValue<C>;
+  auto m = c.rows(), n = c.cols(), k = a.cols();
+  if constexpr (LayoutRightTensor<C> and LayoutRightTensor<B>) {
+    auto row = NumericBuffer<P>(n);
+    for (auto i = std::size_t{0}; i < m; ++i) {
+      std::ranges::fill(row, P{0});
+      for (auto p = std::size_t{0}; p < k; ++p) {
+        auto aip = alpha * numeric_cast<P>(a(i, p));
+        for (auto j = std::size_t{0}; j < n; ++j) {
+          multiply_add(row[j], aip, numeric_cast<P>(b(p, j)));
+        }
+      }
+      for (auto j = std::size_t{0}; j < n; ++j) {
+        auto& e = c(i, j);
+        e = numeric_cast<Value>(numeric_cast<P>(e) + row[j]);
+      }
+    }
+  } else if constexpr (LayoutLeftTensor<C> and LayoutLeftTensor<A>) {
+    auto column = NumericBuffer<P>(m);
+    for (auto j = std::size_t{0}; j < n; ++j) {
+      std::ranges::fill(column, P{0});
+      for (auto p = std::size_t{0}; p < k; ++p) {
+        auto bpj = alpha * numeric_cast<P>(b(p, j));
+        for (auto i = std::size_t{0}; i < m; ++i) {
+          multiply_add(column[i], numeric_cast<P>(a(i, p)), bpj);
+        }
+      }
+      for (auto i = std::size_t{0}; i < m; ++i) {
+        auto& e = c(i, j);
+        e = numeric_cast<Value>(numeric_cast<P>(e) + column[i]);
+      }
+    }
+  } else {
+    for (auto i = std::size_t{0}; i < m; ++i) {
+      for (auto j = std::size_t{0}; j < n; ++j) {
+        auto sum = P{0};
+        for (auto p = std::size_t{0}; p < k; ++p) {
+          multiply_add(sum, numeric_cast<P>(a(i, p)), numeric_cast<P>(b(p, j)));
+        }
+        auto& e = c(i, j);
+        e = numeric_cast<Value>(numeric_cast<P>(e) + alpha * sum);
+      }
+    }
+  }
+}
+
+/**
+ * @internal
+ * @brief Packs rows [i0, i0 + rows) and columns [p0, p0 + kc) of a into a
+ * panel of MR-row slivers, each stored column by column and padded with
+ * zeros.
+ */
+template <typename P, std::size_t MR, typename A>
+void pack_a(const MatrixAccess<A>& a, std::size_t i0, std::size_t rows,
+            std::size_t p0, std::size_t kc, P* pack) {
+  for (auto ir = std::size_t{0}; ir < rows; ir += MR) {
+    auto sliver = pack + ir * kc;
+    auto height = std::min(MR, rows - ir);
+    if constexpr (LayoutRightTensor<A>) {
+      for (auto i = std::size_t{0}; i < height; ++i) {
+        for (auto p = std::size_t{0}; p < kc; ++p) {
+          sliver[p * MR + i] = numeric_cast<P>(a(i0 + ir + i, p0 + p));
+        }
+      }
+    } else {
+      for (auto p = std::size_t{0}; p < kc; ++p) {
+        for (auto i = std::size_t{0}; i < height; ++i) {
+          sliver[p * MR + i] = numeric_cast<P>(a(i0 + ir + i, p0 + p));
+        }
+      }
+    }
+    for (auto p = std::size_t{0}; p < kc; ++p) {
+      for (auto i = height; i < MR; ++i) sliver[p * MR + i] = P{0};
+    }
+  }
+}
+
+/**
+ * @internal
+ * @brief Packs rows [p0, p0 + kc) and columns [j0, j0 + cols) of b, with
+ * cols at most NR, into a sliver stored row by row and padded with zeros.
+ */
+template <typename P, std::size_t NR, typename B>
+void pack_b(const MatrixAccess<B>& b, std::size_t p0, std::size_t kc,
+            std::size_t j0, std::size_t cols, P* sliver) {
+  if constexpr (LayoutLeftTensor<B>) {
+    for (auto j = std::size_t{0}; j < cols; ++j) {
+      for (auto p = std::size_t{0}; p < kc; ++p) {
+        sliver[p * NR + j] = numeric_cast<P>(b(p0 + p, j0 + j));
+      }
+    }
+  } else {
+    for (auto p = std::size_t{0}; p < kc; ++p) {
+      for (auto j = std::size_t{0}; j < cols; ++j) {
+        sliver[p * NR + j] = numeric_cast<P>(b(p0 + p, j0 + j));
+      }
+    }
+  }
+  for (auto p = std::size_t{0}; p < kc; ++p) {
+    for (auto j = cols; j < NR; ++j) sliver[p * NR + j] = P{0};
+  }
+}
+
+/**
+ * @internal
+ * @brief Computes the MR by NR tile acc = a * b from packed slivers.
+ */
+template <typename P, std::size_t MR, std::size_t NR>
+void gemm_tile(std::size_t kc, const P* a, const P* b, P (&acc)[MR][NR]) {
+  for (auto i = std::size_t{0}; i < MR; ++i) {
+    for (auto j = std::size_t{0}; j < NR; ++j) acc[i][j] = P{0};
+  }
+  for (auto p = std::size_t{0}; p < kc; ++p) {
+    for (auto i = std::size_t{0}; i < MR; ++i) {
+      auto ai = a[p * MR + i];
+      for (auto j = std::size_t{0}; j < NR; ++j) {
+        multiply_add(acc[i][j], ai, b[p * NR + j]);
+      }
+    }
+  }
+}
+
+/**
+ * @internal
+ * @brief Computes c += alpha * a * b by packing blocks of a and b and
+ * computing register tiles of c in parallel.
+ */
+template <typename P, typename A, typename B, typename C>
+void gemm_blocked(P alpha, const MatrixAccess<A>& a, const MatrixAccess<B>& b,
+                  const MatrixAccess<C>& c, std::size_t grain,
+                  ThreadPool& pool) {
+  using Value = TensorValue<C>;
+  using Blocking = GemmBlocking<P>;
+  constexpr auto mr = Blocking::mr;
+  constexpr auto nr = Blocking::nr;
+  auto m = c.rows(), n = c.cols(), k = a.cols();
+  auto round_up = [](std::size_t x, std::size_t r) {
+    return (x + r - 1) / r * r;
+  };
+
+  auto kc_max = std::min(Blocking::kc, k);
+  auto a_pack = NumericBuffer<P>(
+      round_up(std::min(Blocking::mc, m), mr) * kc_max, Uninitialized);
+  auto b_pack = NumericBuffer<P>(
+      round_up(std::min(Blocking::nc, n), nr) * kc_max, Uninitialized);
+
+  for (auto jc = std::size_t{0}; jc < n; jc += Blocking::nc) {
+    auto nb = std::min(Blocking::nc, n - jc);
+    auto n_slivers = (nb + nr - 1) / nr;
+    for (auto pc = std::size_t{0}; pc < k; pc += Blocking::kc) {
+      auto kb = std::min(Blocking::kc, k - pc);
+      auto tile_grain = std::max<std::size_t>(1, grain / (mr * nr * kb));
+      parallel_range(pool, n_slivers, tile_grain,
+                     [&](std::size_t lo, std::size_t hi) {
+                       for (auto q = lo; q < hi; ++q) {
+                         pack_b<P, nr>(b, pc, kb, jc + q * nr,
+                                       std::min(nr, nb - q * nr),
+                                       b_pack.data() + q * nr * kb);
+                       }
+                     });
+      for (auto ic = std::size_t{0}; ic < m; ic += Blocking::mc) {
+        auto mb = std::min(Blocking::mc, m - ic);
+        auto m_slivers = (mb + mr - 1) / mr;
+        parallel_range(pool, m_slivers, tile_grain,
+                       [&](std::size_t lo, std::size_t hi) {
+                         pack_a<P, mr>(a, ic + lo * mr,
+                                       std::min(hi * mr, mb) - lo * mr, pc, kb,
+                                       a_pack.data() + lo * mr * kb);
+                       });
+
+        // Tiles sharing a sliver of b are adjacent, so each task reuses it.
+        parallel_range(
+            pool, m_slivers * n_slivers, tile_grain,
+            [&](std::size_t lo, std::size_t hi) {
+              P acc[mr][nr];
+              for (auto t = lo; t < hi; ++t) {
+                auto ir = t % m_slivers, jr = t / m_slivers;
+                gemm_tile<P, mr, nr>(kb, a_pack.data() + ir * mr * kb,
+                                     b_pack.data() + jr * nr * kb, acc);
+                auto i0 = ic + ir * mr, j0 = jc + jr * nr;
+                auto height = std::min(mr, m - i0);
+                auto width = std::min(nr, n - j0);
+                for (auto i = std::size_t{0}; i < height; ++i) {
+                  for (auto j = std::size_t{0}; j < width; ++j) {
+                    auto& e = c(i0 + i, j0 + j);
+                    e = numeric_cast<Value>(numeric_cast<P>(e) +
+                                            alpha * acc[i][j]);
+                  }
+                }
+              }
+            });
+      }
+    }
+  }
+}
+
+}  // namespace Detail
+
+/**
+ * @brief Computes the matrix product c = alpha * a * b + beta * c.
+ * @details a is m by k, b is k by n and c is m by n. The matrices must have
+ * the same precision, and a complex product can only be written to a
+ * complex c. When beta is zero the initial contents of c are ignored. c
+ * must not overlap a or b.
+ * @param alpha The scalar multiplying the product.
+ * @param a The left matrix.
+ * @param b The right matrix.
+ * @param beta The scalar multiplying c.
+ * @param c The matrix to update.
+ * @param options The grain size and thread pool.
+ * @throws std::invalid_argument if the extents do not match.
+ */
+template <typename S, RealOrComplexMatrix A, RealOrComplexMatrix B,
+          typename T, RealOrComplexWritableMatrix C>
+  requires SamePrecision<TensorValue<A>, TensorValue<B>, TensorValue<C>> and
+           (ComplexMatrix<C> or (RealMatrix<A> and RealMatrix<B>)) and
+           std::convertible_to<S, TensorValue<C>> and
+           std::convertible_to<T, TensorValue<C>>
+void gemm(S alpha, A&& a, B&& b, T beta, C&& c,
+          const MatrixProductOptions& options = {}) {
+  using P = Detail::ProductType<TensorValue<C>, TensorValue<A>,
+                                TensorValue<B>>;
+  auto ma = Detail::MatrixAccess<std::remove_cvref_t<A>>(a);
+  auto mb = Detail::MatrixAccess<std::remove_cvref_t<B>>(b);
+  auto mc = Detail::MatrixAccess<std::remove_cvref_t<C>>(c);
+  auto m = mc.rows(), n = mc.cols(), k = ma.cols();
+  if (ma.rows() != m || mb.cols() != n || mb.rows() != k) {
+    throw std::invalid_argument("gemm: mismatched extents");
+  }
+
+  auto scale = Detail::numeric_cast<P>(static_cast<TensorValue<C>>(alpha));
+  Detail::scale_matrix(
+      Detail::numeric_cast<P>(static_cast<TensorValue<C>>(beta)), mc);
+  if (m == 0 || n == 0 || k == 0) return;
+
+  if (m * n * k <= options.grain) {
+    Detail::gemm_unblocked(scale, ma, mb, mc);
+  } else {
+    auto& pool = options.pool ? *options.pool : ThreadPool::global();
+    Detail::gemm_blocked(scale, ma, mb, mc, options.grain, pool);
+  }
+}
+
+/**
+ * @brief Computes the matrix-vector product y = alpha * a * x + beta * y.
+ * @details a is m by n, x has n elements and y has m elements. The operands
+ * must have the same precision, and a complex product can only be written to
+ * a complex y. When beta is zero the initial contents of y are ignored.
+ * Blocks of rows are computed in parallel, each a row at a time for
+ * row-major or strided a and a column at a time for column-major a.
+ * @param alpha The scalar multiplying the product.
+ * @param a The matrix.
+ * @param x The vector to multiply.
+ * @param beta The scalar multiplying y.
+ * @param y The vector to update, which must not overlap a or x.
+ * @param options The grain size and thread pool.
+ * @throws std::invalid_argument if the sizes do not match.
+ */
+template <typename S, RealOrComplexMatrix A, RealOrComplexRange X,
+          typename T, RealOrComplexWritableRange Y>
+  requires std::ranges::sized_range<X> and
+           std::ranges::random_access_range<Y> and
+           std::ranges::sized_range<Y> and
+           SamePrecision<TensorValue<A>, std::ranges::range_value_t<X>,
+                         std::ranges::range_value_t<Y>> and
+           (ComplexRange<Y> or (RealMatrix<A> and RealRange<X>)) and
+           std::convertible_to<S, std::ranges::range_value_t<Y>> and
+           std::convertible_to<T, std::ranges::range_value_t<Y>>
+void gemv(S alpha, A&& a, X&& x, T beta, Y&& y,
+          const MatrixProductOptions& options = {}) {
+  using Value = std::ranges::range_value_t<Y>;
+  using P = Detail::ProductType<Value, TensorValue<A>,
+                                std::ranges::range_value_t<X>>;
+  using Difference = std::ranges::range_difference_t<Y>;
+  auto ma = Detail::MatrixAccess<std::remove_cvref_t<A>>(a);
+  auto m = ma.rows(), n = ma.cols();
+  if (static_cast<std::size_t>(std::ranges::size(x)) != n ||
+      static_cast<std::size_t>(std::ranges::size(y)) != m) {
+    throw std::invalid_argument("gemv: mismatched sizes");
+  }
+
+  // x is scaled by alpha once, in the compute type.
+  auto scale = Detail::numeric_cast<P>(static_cast<Value>(alpha));
+  auto beta_p = Detail::numeric_cast<P>(static_cast<Value>(beta));
+  auto xs = NumericBuffer<P>(n, Uninitialized);
+  auto xi = std::ranges::begin(x);
+  for (auto j = std::size_t{0}; j < n; ++j, ++xi) {
+    xs[j] = scale * Detail::numeric_cast<P>(*xi);
+  }
+
+  auto first = std::ranges::begin(y);
+  auto rows = [&](std::size_t lo, std::size_t hi) {
+    auto acc = NumericBuffer<P>(hi - lo);
+    if constexpr (LayoutLeftTensor<A>) {
+      for (auto j = std::size_t{0}; j < n; ++j) {
+        auto xj = xs[j];
+        for (auto i = lo; i < hi; ++i) {
+          Detail::multiply_add(acc[i - lo], Detail::numeric_cast<P>(ma(i, j)),
+                               xj);
+        }
+      }
+    } else {
+      for (auto i = lo; i < hi; ++i) {
+        auto sum = P{0};
+        for (auto j = std::size_t{0}; j < n; ++j) {
+          Detail::multiply_add(sum, Detail::numeric_cast<P>(ma(i, j)), xs[j]);
+        }
+        acc[i - lo] = sum;
+      }
+    }
+    for (auto i = lo; i < hi; ++i) {
+      decltype(auto) yi = first[static_cast<Difference>(i)];
+      auto value = beta_p == P{0}
+                       ? acc[i - lo]
+                       : beta_p * Detail::numeric_cast<P>(
+                                      static_cast<Value>(yi)) +
+                             acc[i - lo];
+      yi = Detail::numeric_cast<Value>(value);
+    }
+  };
+
+  auto per_row = std::max<std::size_t>(n, 1);
+  auto grain = std::max<std::size_t>(1, options.grain / per_row);
+  auto& pool = options.pool ? *options.pool : ThreadPool::global();
+  Detail::parallel_range(pool, m, grain, rows);
+}
+
+}  // namespace NumericConcepts
@@ -0,0 +1,424 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Functions.hpp"
+#include "Numeric.hpp"
+
+/**
+ * @file Memoize.hpp
+ * @brief Defines a thread-safe memoizing wrapper for numeric functions.
+ * @details memoize() wraps a function in a callable that caches its results
+ * in a hash table keyed on the arguments. The table is split into shards,
+ * each with its own lock, so threads looking up different arguments rarely
+ * contend. Each shard holds a bounded number of entries, derived from a
+ * memory cap, and evicts entries under a policy given by the caller.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief Options for a memoized function.
+ */
+struct MemoizeOptions {
+  /// Approximate upper bound on the memory used by cached entries, in bytes.
+  std::size_t max_bytes = std::size_t{64} << 20;
+  /// The number of independently locked shards.
+  std::size_t shards = 16;
+};
+
+/**
+ * @brief Counters describing the use of a memoized function's cache.
+ */
+struct CacheStatistics {
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  std::size_t evictions = 0;
+  std::size_t entries = 0;
+};
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Hashes a numeric argument, including complex values.
+ */
+template <typename T>
+std::size_t hash_value(const T& value) {
+  if constexpr (Complex<T>) {
+    auto h = hash_value(value.real());
+    return h ^ (hash_value(value.imag()) + 0x9e3779b97f4a7c15ULL + (h << 6) +
+                (h >> 2));
+  } else {
+    return std::hash<T>{}(value);
+  }
+}
+
+/**
+ * @internal
+ * @brief Hash for a tuple of arguments.
+ */
+struct ArgumentHash {
+  template <typename... Args>
+  std::size_t operator()(const std::tuple<Args...>& key) const {
+    auto h = std::size_t{0};
+    std::apply(
+        [&](const auto&... args) {
+          ((h ^= hash_value(args) + 0x9e3779b97f4a7c15ULL + (h << 6) +
+                 (h >> 2)),
+           ...);
+        },
+        key);
+    return h;
+  }
+};
+
+}  // namespace Detail
+
+/**
+ * @brief Cache policy evicting the least recently used entry.
+ * @details Every hit reorders the shard's recency list, so lookups take the
+ * shard's lock exclusively.
+ */
+struct LruCache {
+  template <typename Key, typename Value, typename Hash>
+  class Shard {
+   public:
+    bool find(const Key& key, Value& value) {
+      auto lock = std::scoped_lock(_mutex);
+      auto it = _index.find(key);
+      if (it == _index.end()) return false;
+      _entries.splice(_entries.begin(), _entries, it->second);
+      value = it->second->second;
+      return true;
+    }
+
+    std::size_t insert(const Key& key, const Value& value,
+                       std::size_t capacity) {
+      auto lock = std::scoped_lock(_mutex);
+      if (_index.contains(key)) return 0;
+      auto evicted = std::size_t{0};
+      while (!_entries.empty() && _entries.size() >= capacity) {
+        _index.erase(_entries.back().first);
+        _entries.pop_back();
+        ++evicted;
+      }
+      _entries.emplace_front(key, value);
+      _index.emplace(key, _entries.begin());
+      return evicted;
+    }
+
+    std::size_t size() {
+      auto lock = std::scoped_lock(_mutex);
+      return _entries.size();
+    }
+
+    void clear() {
+      auto lock = std::scoped_lock(_mutex);
+      _index.clear();
+      _entries.clear();
+    }
+
+    /// Approximate memory used per entry, in bytes.
+    static constexpr std::size_t entry_bytes =
+        2 * sizeof(Key) + sizeof(Value) + 6 * sizeof(void*);
+
+   private:
+    using List = std::list<std::pair<Key, Value>>;
+
+    std::mutex _mutex;
+    List _entries;
+    std::unordered_map<Key, typename List::iterator, Hash> _index;
+  };
+};
+
+/**
+ * @brief Cache policy using the CLOCK approximation to LRU.
+ * @details A hit only sets the entry's reference bit, so lookups share the
+ * shard's lock and do not contend with each other. On insertion into a full
+ * shard, a hand sweeps the entries, clearing reference bits, and evicts the
+ * first entry whose bit is already clear.
+ */
+struct ClockCache {
+  template <typename Key, typename Value, typename Hash>
+  class Shard {
+   public:
+    bool find(const Key& key, Value& value) {
+      auto lock = std::shared_lock(_mutex);
+      auto it = _index.find(key);
+      if (it == _index.end()) return false;
+      auto& slot = _slots[it->second];
+      slot.referenced.store(true, std::memory_order_relaxed);
+      value = slot.value;
+      return true;
+    }
+
+    std::size_t insert(const Key& key, const Value& value,
+                       std::size_t capacity) {
+      auto lock = std::unique_lock(_mutex);
+      if (_index.contains(key)) return 0;
+      if (_slots.size() < capacity) {
+        _slots.emplace_back(key, value);
+        _index.emplace(key, _slots.size() - 1);
+        return 0;
+      }
+      while (true) {
+        auto& slot = _slots[_hand];
+        auto index = _hand;
+        _hand = (_hand + 1) % _slots.size();
+        if (slot.referenced.exchange(false, std::memory_order_relaxed)) {
+          continue;
+        }
+        _index.erase(slot.key);
+        slot.key = key;
+        slot.value = value;
+        _index.emplace(key, index);
+        return 1;
+      }
+    }
+
+    std::size_t size() {
+      auto lock = std::shared_lock(_mutex);
+      return _slots.size();
+    }
+
+    void clear() {
+      auto lock = std::unique_lock(_mutex);
+      _index.clear();
+      _slots.clear();
+      _hand = 0;
+    }
+
+    /// Approximate memory used per entry, in bytes.
+    static constexpr std::size_t entry_bytes =
+        2 * sizeof(Key) + sizeof(Value) + 4 * sizeof(void*);
+
+   private:
+    struct Slot {
+      Slot(const Key& k, const Value& v) : key{k}, value{v} {}
+
+      Key key;
+      Value value;
+      std::atomic<bool> referenced{false};
+    };
+
+    std::shared_mutex _mutex;
+    std::deque<Slot> _slots;
+    std::unordered_map<Key, std::size_t, Hash> _index;
+    std::size_t _hand = 0;
+  };
+};
+
+/**
+ * @brief Concept for a cache policy for keys of type Key and values of type
+ * Value.
+ * @tparam P The policy type to check.
+ */
+template <typename P, typename Key, typename Value>
+concept CachePolicy = requires(
+    typename P::template Shard<Key, Value, Detail::ArgumentHash> shard,
+    const Key& key, Value& value, std::size_t capacity) {
+  { shard.find(key, value) } -> std::same_as<bool>;
+  { shard.insert(key, value, capacity) } -> std::convertible_to<std::size_t>;
+  { shard.size() } -> std::convertible_to<std::size_t>;
+  shard.clear();
+  {
+    P::template Shard<Key, Value, Detail::ArgumentHash>::entry_bytes
+  } -> std::convertible_to<std::size_t>;
+};
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Deduces the argument types of a function pointer or of a type with
+ * a single, non-template call operator.
+ */
+template <typename F>
+struct CallArguments {};
+
+template <typename F>
+  requires requires() { &F::operator(); }
+struct CallArguments<F> : CallArguments<decltype(&F::operator())> {};
+
+template <typename R, typename... Args>
+struct CallArguments<R (*)(Args...)> {
+  using type = std::tuple<std::remove_cvref_t<Args>...>;
+};
+
+template <typename R, typename C, typename... Args>
+struct CallArguments<R (C::*)(Args...)> : CallArguments<R (*)(Args...)> {};
+
+template <typename R, typename C, typename... Args>
+struct CallArguments<R (C::*)(Args...) const>
+    : CallArguments<R (*)(Args...)> {};
+
+template <typename R, typename C, typename... Args>
+struct CallArguments<R (C::*)(Args...) noexcept>
+    : CallArguments<R (*)(Args...)> {};
+
+template <typename R, typename C, typename... Args>
+struct CallArguments<R (C::*)(Args...) const noexcept>
+    : CallArguments<R (*)(Args...)> {};
+
+template <typename R, typename... Args>
+struct CallArguments<R (*)(Args...) noexcept>
+    : CallArguments<R (*)(Args...)> {};
+
+/**
+ * @internal
+ * @brief Concept for a function whose argument types can be deduced.
+ */
+template <typename F>
+concept DeducibleArguments =
+    requires() { typename CallArguments<std::decay_t<F>>::type; };
+
+}  // namespace Detail
+
+/**
+ * @brief A function wrapped with a sharded cache of its results.
+ * @details Copies share the same cache. The wrapped function may be called
+ * from several threads at once and must be safe to call concurrently. A
+ * value missing from the cache is computed without holding any lock, so two
+ * threads that miss on the same arguments at the same time may both call
+ * the function. Arguments that do not compare equal to themselves, such as
+ * NaN, are never cached.
+ * @tparam F The wrapped function type.
+ * @tparam P The CachePolicy, LruCache or ClockCache.
+ * @tparam Args The argument types.
+ */
+template <typename F, typename P, typename... Args>
+  requires NumericFunction<const F&, const Args&...>
+class Memoized {
+ public:
+  using result_type =
+      std::remove_cvref_t<std::invoke_result_t<const F&, const Args&...>>;
+
+  Memoized(F f, const MemoizeOptions& options)
+      : _state{std::make_shared<State>(std::move(f), options)} {}
+
+  result_type operator()(const Args&... args) const {
+    auto key = Key(args...);
+    if (!(key == key)) return std::invoke(_state->f, args...);
+
+    auto& shard = _state->shard(key);
+    auto value = result_type{};
+    if (shard.cache.find(key, value)) {
+      shard.hits.fetch_add(1, std::memory_order_relaxed);
+      return value;
+    }
+    shard.misses.fetch_add(1, std::memory_order_relaxed);
+    value = std::invoke(_state->f, args...);
+    auto evicted = shard.cache.insert(key, value, _state->capacity);
+    if (evicted > 0) {
+      shard.evictions.fetch_add(evicted, std::memory_order_relaxed);
+    }
+    return value;
+  }
+
+  /// Returns the cache counters summed over all shards.
+  CacheStatistics statistics() const {
+    auto stats = CacheStatistics{};
+    for (auto& shard : _state->shards) {
+      stats.hits += shard.hits.load(std::memory_order_relaxed);
+      stats.misses += shard.misses.load(std::memory_order_relaxed);
+      stats.evictions += shard.evictions.load(std::memory_order_relaxed);
+      stats.entries += shard.cache.size();
+    }
+    return stats;
+  }
+
+  std::size_t hits() const { return statistics().hits; }
+  std::size_t misses() const { return statistics().misses; }
+
+  /// The maximum number of cached entries.
+  std::size_t capacity() const {
+    return _state->capacity * _state->shards.size();
+  }
+
+  /// Removes all cached entries. The counters are not reset.
+  void clear() const {
+    for (auto& shard : _state->shards) shard.cache.clear();
+  }
+
+ private:
+  using Key = std::tuple<Args...>;
+  using Cache =
+      typename P::template Shard<Key, result_type, Detail::ArgumentHash>;
+
+  struct alignas(64) Shard {
+    Cache cache;
+    std::atomic<std::size_t> hits{0};
+    std::atomic<std::size_t> misses{0};
+    std::atomic<std::size_t> evictions{0};
+  };
+
+  struct State {
+    State(F function, const MemoizeOptions& options)
+        : f{std::move(function)},
+          shards(std::max<std::size_t>(options.shards, 1)),
+          capacity{std::max<std::size_t>(
+              options.max_bytes / (Cache::entry_bytes * shards.size()), 1)} {}
+
+    Shard& shard(const Key& key) {
+      // Mix the high bits in, as std::hash of an integer is the identity.
+      auto h = Detail::ArgumentHash{}(key);
+      return shards[(h ^ (h >> 29) ^ (h >> 47)) % shards.size()];
+    }
+
+    F f;
+    std::vector<Shard> shards;
+    std::size_t capacity;
+  };
+
+  std::shared_ptr<State> _state;
+};
+
+/**
+ * @brief Wraps a numeric function with a thread-safe, bounded cache.
+ * @details The argument types are given explicitly, e.g.,
+ * `memoize<double>(f)`, or deduced when f is a function pointer or has a
+ * single, non-template call operator.
+ * @tparam Args The argument types, which must be hashable and equality
+ * comparable.
+ * @param f The function, which must be safe to call concurrently.
+ * @param policy The CachePolicy, LruCache (default) or ClockCache.
+ * @param options The memory cap and number of shards.
+ * @return The memoized function, which satisfies the same function concepts
+ * as f for these argument types.
+ */
+template <typename... Args, typename F, typename P = LruCache>
+  requires(sizeof...(Args) > 0) and
+          NumericFunction<const F&, const Args&...> and
+          CachePolicy<P, std::tuple<Args...>,
+                      std::remove_cvref_t<
+                          std::invoke_result_t<const F&, const Args&...>>>
+auto memoize(F f, P policy = {}, const MemoizeOptions& options = {}) {
+  static_cast<void>(policy);
+  return Memoized<F, P, Args...>(std::move(f), options);
+}
+
+template <typename F, typename P = LruCache>
+  requires Detail::DeducibleArguments<F>
+auto memoize(F f, P policy = {}, const MemoizeOptions& options = {}) {
+  return [&]<typename... Args>(std::tuple<Args...>*) {
+    return memoize<Args...>(std::move(f), policy, options);
+  }(static_cast<typename Detail::CallArguments<F>::type*>(nullptr));
+}
+
+}  // namespace NumericConcepts
@@ -2,10 +2,20 @@
 
 #include <complex>
 #include <concepts>
+#include <type_traits>
+
+#if __cplusplus > 202002L && __has_include(<stdfloat>)
+#include <stdfloat>
+#endif
 
 /**
  * @file Numeric.hpp
  * @brief Defines concepts for fundamental numeric types.
+ * @details Besides the standard floating-point types, the extended types
+ * `_Float16` (`std::float16_t`), `std::bfloat16_t`, and `__float128`
+ * (`std::float128_t`) are treated as Real wherever the compiler provides
+ * them. They are not admitted as the value type of std::complex, which is
+ * only specified for float, double and long double.
  */
 
 namespace NumericConcepts {
@@ -18,11 +28,76 @@ template <typename T>
 concept Integral = std::integral<T>;
 
 /**
- * @brief Concept for floating-point types.
+ * @brief Concept for half-precision floating-point types (`_Float16`, which
+ * is also `std::float16_t`).
+ * @details This is false on platforms without such a type.
+ * @tparam T The type to check.
+ */
+template <typename T>
+concept Half =
+#if defined(__FLT16_MAX__)
+    std::same_as<T, _Float16>;
+#else
+    false;
+#endif
+
+/**
+ * @brief Concept for brain floating-point types (`std::bfloat16_t`).
+ * @details This is false on platforms without such a type.
+ * @tparam T The type to check.
+ */
+template <typename T>
+concept BFloat16 =
+#if defined(__STDCPP_BFLOAT16_T__)
+    std::same_as<T, std::bfloat16_t>;
+#else
+    false;
+#endif
+
+/**
+ * @brief Concept for quadruple-precision floating-point types (`__float128`
+ * or `std::float128_t`).
+ * @details This is false on platforms without such a type.
  * @tparam T The type to check.
  */
 template <typename T>
-concept Real = std::floating_point<T>;
+concept Quad = false
+#if defined(__SIZEOF_FLOAT128__)
+               or std::same_as<T, __float128>
+#endif
+#if defined(__STDCPP_FLOAT128_T__)
+               or std::same_as<T, std::float128_t>
+#endif
+    ;
+
+/**
+ * @brief Concept for the extended floating-point types that are not covered
+ * by std::floating_point.
+ * @tparam T The type to check.
+ */
+template <typename T>
+concept ExtendedReal = Half<std::remove_cv_t<T>> or
+                       BFloat16<std::remove_cv_t<T>> or
+                       Quad<std::remove_cv_t<T>>;
+
+/**
+ * @brief Trait to determine if a type is a real (floating-point) type.
+ * @details This is the customization point for the Real concept. It is true
+ * for the standard and extended floating-point types, and may be specialized
+ * to admit other types.
+ * @tparam T The type to check.
+ */
+template <typename T>
+struct RealType
+    : public std::bool_constant<std::floating_point<T> or ExtendedReal<T>> {};
+
+/**
+ * @brief Concept for floating-point types, including the extended types
+ * described by ExtendedReal.
+ * @tparam T The type to check.
+ */
+template <typename T>
+concept Real = RealType<T>::value;
 
 /**
  * @brief Concept for single-precision floating-point types (float).
@@ -46,23 +121,31 @@ template <typename T>
 concept LongDouble = std::same_as<T, long double>;
 
 /**
- * @internal
- * @brief Helper struct to determine if a type is a std::complex specialization.
+ * @brief Trait to determine if a type is a complex number type.
+ * @details This is the customization point for the Complex concept. A
+ * user-defined complex type, or a proxy reference to one, can be admitted by
+ * specializing this struct to derive from std::true_type and to define a
+ * `value_type` member giving the underlying real type.
  * @tparam T The type to check.
  */
 template <typename T>
 struct ComplexType : public std::false_type {};
 
 /**
- * @internal
  * @brief Specialization of ComplexType for std::complex types.
+ * @details Only the standard floating-point types are admitted, since the
+ * effect of instantiating std::complex for any other type is unspecified.
  * @tparam T The underlying floating-point type.
  */
 template <typename T>
-struct ComplexType<std::complex<T>> : public std::bool_constant<Real<T>> {};
+struct ComplexType<std::complex<T>>
+    : public std::bool_constant<Float<T> or Double<T> or LongDouble<T>> {
+  using value_type = T;
+};
 
 /**
- * @brief Concept for complex number types (specializations of std::complex).
+ * @brief Concept for complex number types (specializations of std::complex,
+ * or types registered through ComplexType).
  * @tparam T The type to check.
  */
 template <typename T>
@@ -95,18 +178,19 @@ struct RemoveComplexHelper {
 
 /**
  * @internal
- * @brief Specialization of RemoveComplexHelper for std::complex types.
- * @tparam T The underlying floating-point type of the complex number.
+ * @brief Specialization of RemoveComplexHelper for complex types.
+ * @tparam T The Complex type.
  */
-template <RealOrComplex T>
-struct RemoveComplexHelper<std::complex<T>> {
-  using value_type = T;
+template <Complex T>
+struct RemoveComplexHelper<T> {
+  using value_type = typename ComplexType<T>::value_type;
 };
 
 /**
  * @brief Extracts the underlying floating-point precision type from a
  * RealOrComplex type.
  * @details For a complex type `std::complex<T>`, this alias resolves to `T`.
+ * For other complex types it resolves to `ComplexType<T>::value_type`.
  * For a real type `T`, this alias resolves to `T`.
  * @tparam T The RealOrComplex type.
  */
@@ -124,4 +208,187 @@ template <typename T, typename... Ts>
 concept SamePrecision =
     (std::same_as<RemoveComplex<T>, RemoveComplex<Ts>> && ...);
 
+/**
+ * @internal
+ * @brief Helper struct to form a type with the complexness of T and the
+ * precision P.
+ * @tparam T The RealOrComplex type whose complexness is kept.
+ * @tparam P The Real precision of the result.
+ */
+template <RealOrComplex T, Real P>
+struct ReplacePrecisionHelper {
+  using value_type = P;
+};
+
+/**
+ * @internal
+ * @brief Specialization of ReplacePrecisionHelper for complex types.
+ * @tparam T The Complex type.
+ * @tparam P The Real precision of the result.
+ */
+template <Complex T, Real P>
+struct ReplacePrecisionHelper<T, P> {
+  static_assert(Float<P> or Double<P> or LongDouble<P>,
+                "ReplacePrecision: std::complex needs a standard precision");
+  using value_type = std::complex<P>;
+};
+
+/**
+ * @brief Forms the real or complex type with the complexness of T and the
+ * precision P.
+ * @details For example, `ReplacePrecision<std::complex<float>, double>` is
+ * `std::complex<double>`.
+ * @tparam T The RealOrComplex type whose complexness is kept.
+ * @tparam P The Real precision of the result.
+ */
+template <RealOrComplex T, Real P>
+using ReplacePrecision = typename ReplacePrecisionHelper<T, P>::value_type;
+
+/**
+ * @internal
+ * @brief Helper struct for PromotePrecision.
+ * @tparam T The first RealOrComplex type.
+ * @tparam Ts The other RealOrComplex types.
+ */
+template <RealOrComplex T, RealOrComplex... Ts>
+struct PromotePrecisionHelper {
+  using precision = std::common_type_t<RemoveComplex<T>, RemoveComplex<Ts>...>;
+  static constexpr bool is_complex = (Complex<T> or ... or Complex<Ts>);
+  // A type with the complexness of the result, whose precision is replaced.
+  using kind = std::conditional_t<is_complex, std::complex<float>, float>;
+};
+
+/**
+ * @brief The type to which a list of RealOrComplex types promote.
+ * @details The precision of the result is the widest of the precisions of the
+ * arguments, and the result is complex if any of the arguments is complex.
+ * For example, `PromotePrecision<float, std::complex<double>>` is
+ * `std::complex<double>`. A complex result must have a standard precision,
+ * so `PromotePrecision<std::complex<float>, __float128>` is not formed.
+ * @tparam T The first type.
+ * @tparam Ts The other types.
+ */
+template <RealOrComplex T, RealOrComplex... Ts>
+  requires(not PromotePrecisionHelper<T, Ts...>::is_complex) or
+          Complex<std::complex<
+              typename PromotePrecisionHelper<T, Ts...>::precision>>
+using PromotePrecision =
+    ReplacePrecision<typename PromotePrecisionHelper<T, Ts...>::kind,
+                     typename PromotePrecisionHelper<T, Ts...>::precision>;
+
+/**
+ * @internal
+ * @brief Helper struct giving the next wider real type.
+ * @details Types without a wider standard type map to themselves.
+ * @tparam T The Real type.
+ */
+template <Real T>
+struct WidenPrecisionHelper {
+  using value_type = T;
+};
+
+template <Real T>
+  requires Half<T> or BFloat16<T>
+struct WidenPrecisionHelper<T> {
+  using value_type = float;
+};
+
+template <>
+struct WidenPrecisionHelper<float> {
+  using value_type = double;
+};
+
+template <>
+struct WidenPrecisionHelper<double> {
+  using value_type = long double;
+};
+
+/**
+ * @internal
+ * @brief Helper struct giving the next narrower real type.
+ * @details Types without a narrower standard type map to themselves.
+ * @tparam T The Real type.
+ */
+template <Real T>
+struct NarrowPrecisionHelper {
+  using value_type = T;
+};
+
+template <>
+struct NarrowPrecisionHelper<double> {
+  using value_type = float;
+};
+
+template <>
+struct NarrowPrecisionHelper<long double> {
+  using value_type = double;
+};
+
+/**
+ * @brief The real or complex type of the next wider precision.
+ * @details For example, `WidenPrecision<std::complex<float>>` is
+ * `std::complex<double>`, `WidenPrecision<_Float16>` is `float`, and
+ * `WidenPrecision<long double>` is `long double`.
+ * @tparam T The RealOrComplex type.
+ */
+template <RealOrComplex T>
+using WidenPrecision = ReplacePrecision<
+    T, typename WidenPrecisionHelper<RemoveComplex<T>>::value_type>;
+
+/**
+ * @brief The real or complex type of the next narrower precision.
+ * @details For example, `NarrowPrecision<double>` is `float`, and
+ * `NarrowPrecision<float>` is `float`.
+ * @tparam T The RealOrComplex type.
+ */
+template <RealOrComplex T>
+using NarrowPrecision = ReplacePrecision<
+    T, typename NarrowPrecisionHelper<RemoveComplex<T>>::value_type>;
+
+/**
+ * @internal
+ * @brief Helper struct giving the type in which elements of type T are
+ * accumulated.
+ * @details For real and complex types this is the precision of the type,
+ * widened to float for 16-bit types, and for integral types it is the
+ * promoted type.
+ * @tparam T The Numeric type.
+ */
+template <Numeric T>
+struct AccumulatorPrecisionHelper {
+  using value_type = decltype(T{} + T{});
+};
+
+/**
+ * @internal
+ * @brief Specialization of AccumulatorPrecisionHelper for real and complex
+ * types.
+ * @tparam T The RealOrComplex type.
+ */
+template <RealOrComplex T>
+struct AccumulatorPrecisionHelper<T> {
+  using value_type = RemoveComplex<T>;
+};
+
+/**
+ * @internal
+ * @brief Specialization of AccumulatorPrecisionHelper for real and complex
+ * types stored in fewer bits than float.
+ * @tparam T The RealOrComplex type.
+ */
+template <RealOrComplex T>
+  requires(sizeof(RemoveComplex<T>) < sizeof(float))
+struct AccumulatorPrecisionHelper<T> {
+  using value_type = float;
+};
+
+/**
+ * @brief The type in which elements of type T are accumulated.
+ * @details For example, this is `double` for `std::complex<double>` and
+ * `float` for `_Float16`.
+ * @tparam T The Numeric type.
+ */
+template <Numeric T>
+using AccumulatorPrecision = typename AccumulatorPrecisionHelper<T>::value_type;
+
 }  // namespace NumericConcepts
\ No newline at end of file
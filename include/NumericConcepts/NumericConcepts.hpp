@@ -9,4 +9,5 @@
 #include "Functions.hpp"
 #include "Iterators.hpp"
 #include "Numeric.hpp"
-#include "Ranges.hpp"
\ No newline at end of file
+#include "Ranges.hpp"
+#include "Tensor.hpp"
\ No newline at end of file
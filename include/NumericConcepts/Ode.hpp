@@ -0,0 +1,1172 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Buffer.hpp"
+#include "Functions.hpp"
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+#include "Threading.hpp"
+
+/**
+ * @file Ode.hpp
+ * @brief Defines integrators for systems of ordinary differential equations
+ * whose state is a range of real or complex numbers.
+ * @details The right-hand side is an OdeFunction, called as
+ * `f(t, y, dydt)` with spans over the stepper's own storage. Each stepper
+ * allocates the state, its stages and any history and Jacobian once on
+ * construction, so that start() and step() never allocate and a stepper can
+ * be reused for any number of systems of the same size.
+ *
+ * The methods are the classical fourth-order Runge-Kutta method with a fixed
+ * step (Rk4), the adaptive Dormand-Prince 5(4) pair with its continuous
+ * extension (DormandPrince54), and the backward differentiation formulas of
+ * orders one to five with step size control (Bdf), for stiff problems.
+ * integrate() advances a single system, integrate_at() records the state at
+ * given times using the continuous extension where available, and
+ * integrate_ensemble() integrates many independent systems over a
+ * ThreadPool with one stepper per task.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief Options for the integrators.
+ */
+struct OdeOptions {
+  /// Absolute error tolerance of the adaptive methods.
+  double abs_tolerance = 1e-8;
+  /// Relative error tolerance of the adaptive methods.
+  double rel_tolerance = 1e-6;
+  /// The step of Rk4, or the initial step of the adaptive methods; zero
+  /// meaning a hundredth of the interval for Rk4 and an automatic choice
+  /// otherwise.
+  double step = 0;
+  /// The maximum number of steps for each system.
+  std::size_t max_steps = 100000;
+  /// The maximum order of Bdf, from one to five.
+  std::size_t max_order = 5;
+  /// The maximum number of systems in each parallel task of
+  /// integrate_ensemble().
+  std::size_t grain = 16;
+  /// The pool to run on, null meaning ThreadPool::global().
+  ThreadPool* pool = nullptr;
+};
+
+/**
+ * @brief Summary of an integration.
+ */
+struct OdeResult {
+  /// The number of systems integrated.
+  std::size_t systems = 0;
+  /// The number of systems that reached the final time.
+  std::size_t completed = 0;
+  /// The number of accepted steps.
+  std::size_t steps = 0;
+  /// The number of rejected steps.
+  std::size_t rejected = 0;
+  /// The number of evaluations of the right-hand side.
+  std::size_t evaluations = 0;
+  /// The number of Jacobians formed by Bdf.
+  std::size_t jacobians = 0;
+};
+
+/**
+ * @brief The classical fourth-order Runge-Kutta method with a fixed step.
+ */
+struct Rk4 {};
+
+/**
+ * @brief The explicit Runge-Kutta pair of Dormand and Prince of orders five
+ * and four, with local extrapolation, error control and a continuous
+ * extension of order four.
+ */
+struct DormandPrince54 {};
+
+/**
+ * @brief The backward differentiation formulas, with the order raised one
+ * step at a time up to OdeOptions::max_order and the step size controlled by
+ * the difference between corrector and predictor.
+ * @details Each step solves the implicit formula by a modified Newton
+ * iteration with a Jacobian formed by finite differences, which is only
+ * refreshed when the iteration fails to converge. The step size is changed
+ * by interpolating the solution history onto the new spacing.
+ */
+struct Bdf {};
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief The storage and counters shared by the steppers.
+ * @details The vectors are consecutive slices of a single buffer, so a
+ * stepper makes one allocation for its state and stages.
+ */
+template <RealOrComplex V>
+class OdeStepperBase {
+ public:
+  using value_type = V;
+  using time_type = RemoveComplex<V>;
+
+  OdeStepperBase(const OdeStepperBase&) = delete;
+  OdeStepperBase& operator=(const OdeStepperBase&) = delete;
+  OdeStepperBase(OdeStepperBase&&) = default;
+  OdeStepperBase& operator=(OdeStepperBase&&) = default;
+
+  /// The number of equations.
+  std::size_t size() const { return _n; }
+
+  /// The current time.
+  time_type time() const { return _t; }
+
+  /// The step the next call to step() attempts, signed by the direction of
+  /// integration.
+  time_type step_size() const { return _h; }
+
+  /// The state at the current time.
+  std::span<const V> state() const { return _y; }
+
+  /// The counters accumulated since the last call to start().
+  const OdeResult& statistics() const { return _statistics; }
+
+ protected:
+  using T = time_type;
+
+  OdeStepperBase(std::size_t n, std::size_t vectors,
+                 const OdeOptions& options,
+                 std::pmr::memory_resource* resource)
+      : _n{n},
+        _buffer(n * vectors, Uninitialized, resource),
+        _abs_tolerance{static_cast<T>(options.abs_tolerance)},
+        _rel_tolerance{static_cast<T>(options.rel_tolerance)} {}
+
+  std::span<V> vector(std::size_t i) {
+    return {_buffer.data() + i * _n, _n};
+  }
+
+  template <typename R>
+  void reset(T t, R&& y0, T h) {
+    auto i = std::size_t{0};
+    for (auto it = std::ranges::begin(y0);
+         i < _n && it != std::ranges::end(y0); ++it, ++i) {
+      _y[i] = static_cast<V>(*it);
+    }
+    if (i != _n) {
+      throw std::invalid_argument(
+          "OdeStepper::start: the initial state has the wrong size");
+    }
+    _t = t;
+    _h = h;
+    _statistics = {};
+  }
+
+  /// The step towards t_end, shortened to land on t_end when it is within
+  /// slightly more than the current step.
+  T step_towards(T t_end) const {
+    auto remaining = t_end - _t;
+    return std::abs(remaining) <= T(1.01) * std::abs(_h) ? remaining : _h;
+  }
+
+  T weight(V a, V b) const {
+    return _abs_tolerance +
+           _rel_tolerance * std::max(std::abs(a), std::abs(b));
+  }
+
+  /// The root-mean-square norm of e, weighted by the tolerances at a and b.
+  T error_norm(std::span<const V> e, std::span<const V> a,
+               std::span<const V> b) const {
+    auto sum = T{0};
+    for (auto i = std::size_t{0}; i < _n; ++i) {
+      auto scaled = std::abs(e[i]) / weight(a[i], b[i]);
+      sum += scaled * scaled;
+    }
+    return _n == 0 ? T{0} : std::sqrt(sum / static_cast<T>(_n));
+  }
+
+  /// The initial step of Hairer, Norsett and Wanner for a method of the
+  /// given order, given the derivative dy at the start and two scratch
+  /// vectors.
+  template <typename F>
+  T initial_step(F& f, T t_end, std::span<const V> dy, std::span<V> y1,
+                 std::span<V> dy1, int order) {
+    if (t_end == _t) return 0;
+    auto d0 = error_norm(_y, _y, _y);
+    auto d1 = error_norm(dy, _y, _y);
+    auto h0 = d0 < T(1e-5) || d1 < T(1e-5) ? T(1e-6) : T(0.01) * d0 / d1;
+    h0 = std::min(h0, std::abs(t_end - _t));
+    auto direction = t_end < _t ? T{-1} : T{1};
+    for (auto i = std::size_t{0}; i < _n; ++i) {
+      y1[i] = _y[i] + direction * h0 * dy[i];
+    }
+    f(_t + direction * h0, std::span<const V>(y1), dy1);
+    ++_statistics.evaluations;
+    for (auto i = std::size_t{0}; i < _n; ++i) y1[i] = dy1[i] - dy[i];
+    auto d2 = error_norm(y1, _y, _y) / h0;
+    auto d = std::max(d1, d2);
+    auto h1 = d <= T(1e-15)
+                  ? std::max(T(1e-6), h0 * T(1e-3))
+                  : std::pow(T(0.01) / d, T{1} / static_cast<T>(order + 1));
+    return direction *
+           std::min({T(100) * h0, h1, std::abs(t_end - _t)});
+  }
+
+  bool too_small(T h) const {
+    return std::abs(h) <=
+           16 * std::numeric_limits<T>::epsilon() * std::abs(_t);
+  }
+
+  std::size_t _n;
+  NumericBuffer<V> _buffer;
+  std::span<V> _y;
+  T _t = 0;
+  T _h = 0;
+  T _abs_tolerance;
+  T _rel_tolerance;
+  OdeResult _statistics;
+};
+
+}  // namespace Detail
+
+/**
+ * @brief Stepper for the classical fourth-order Runge-Kutta method.
+ * @tparam V The RealOrComplex type of the state's elements.
+ */
+template <RealOrComplex V>
+class Rk4Stepper : public Detail::OdeStepperBase<V> {
+  using Base = Detail::OdeStepperBase<V>;
+  using typename Base::T;
+  using Base::_h;
+  using Base::_n;
+  using Base::_statistics;
+  using Base::_t;
+  using Base::_y;
+
+ public:
+  /**
+   * @brief Allocates a stepper for n equations.
+   * @param n The number of equations.
+   * @param options The options, of which none are used.
+   * @param resource The memory resource for the stepper's storage.
+   */
+  explicit Rk4Stepper(
+      std::size_t n, const OdeOptions& options = {},
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : Base(n, 6, options, resource) {
+    _y = this->vector(0);
+    _k = {this->vector(1), this->vector(2), this->vector(3), this->vector(4)};
+    _stage = this->vector(5);
+  }
+
+  /**
+   * @brief Sets the time, state and step.
+   * @param f The right-hand side.
+   * @param t The initial time.
+   * @param y0 A range holding the initial state.
+   * @param h The step, signed by the direction of integration.
+   */
+  template <typename F, typename R>
+  void start(F&, T t, R&& y0, T h) {
+    this->reset(t, y0, h);
+  }
+
+  /**
+   * @brief Takes one step, shortened so as not to pass t_end.
+   * @return True, as a fixed step cannot fail.
+   */
+  template <OdeFunction<T, V> F>
+  bool step(F& f, T t_end) {
+    auto h = this->step_towards(t_end);
+    auto y = std::span<const V>(_y);
+    auto stage = std::span<const V>(_stage);
+    f(_t, y, _k[0]);
+    for (auto i = std::size_t{0}; i < _n; ++i) {
+      _stage[i] = _y[i] + h / 2 * _k[0][i];
+    }
+    f(_t + h / 2, stage, _k[1]);
+    for (auto i = std::size_t{0}; i < _n; ++i) {
+      _stage[i] = _y[i] + h / 2 * _k[1][i];
+    }
+    f(_t + h / 2, stage, _k[2]);
+    for (auto i = std::size_t{0}; i < _n; ++i) {
+      _stage[i] = _y[i] + h * _k[2][i];
+    }
+    f(_t + h, stage, _k[3]);
+    for (auto i = std::size_t{0}; i < _n; ++i) {
+      _y[i] += h / 6 * (_k[0][i] + T{2} * (_k[1][i] + _k[2][i]) + _k[3][i]);
+    }
+    _t = h == t_end - _t ? t_end : _t + h;
+    _statistics.evaluations += 4;
+    ++_statistics.steps;
+    return true;
+  }
+
+ private:
+  std::array<std::span<V>, 4> _k;
+  std::span<V> _stage;
+};
+
+/**
+ * @brief Stepper for the adaptive Dormand-Prince 5(4) pair.
+ * @details Each call to step() takes one accepted step, retrying with a
+ * smaller step after each rejection. The derivative at the end of a step is
+ * reused as the first stage of the next, so an accepted step costs six
+ * evaluations.
+ * @tparam V The RealOrComplex type of the state's elements.
+ */
+template <RealOrComplex V>
+class DormandPrince54Stepper : public Detail::OdeStepperBase<V> {
+  using Base = Detail::OdeStepperBase<V>;
+  using typename Base::T;
+  using Base::_h;
+  using Base::_n;
+  using Base::_statistics;
+  using Base::_t;
+  using Base::_y;
+
+ public:
+  /**
+   * @brief Allocates a stepper for n equations.
+   * @param n The number of equations.
+   * @param options The options, of which the tolerances are used.
+   * @param resource The memory resource for the stepper's storage.
+   */
+  explicit DormandPrince54Stepper(
+      std::size_t n, const OdeOptions& options = {},
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : Base(n, 15, options, resource) {
+    _y = this->vector(0);
+    _y_new = this->vector(1);
+    _stage = this->vector(2);
+    for (auto j = std::size_t{0}; j < 7; ++j) _k[j] = this->vector(3 + j);
+    for (auto j = std::size_t{0}; j < 5; ++j) _dense[j] = this->vector(10 + j);
+  }
+
+  /**
+   * @brief Sets the time and state, and evaluates the first stage.
+   * @param f The right-hand side.
+   * @param t The initial time.
+   * @param y0 A range holding the initial state.
+   * @param h The initial step, signed by the direction of integration, or
+   * zero to choose it from the problem heading towards t_end.
+   * @param t_end The time the integration heads towards.
+   */
+  template <OdeFunction<T, V> F, typename R>
+  void start(F& f, T t, R&& y0, T h, T t_end) {
+    this->reset(t, y0, h);
+    f(_t, std::span<const V>(_y), _k[0]);
+    ++_statistics.evaluations;
+    if (h == 0) _h = this->initial_step(f, t_end, _k[0], _k[1], _k[2], 4);
+    _t_old = _t;
+    _h_old = 0;
+  }
+
+  /**
+   * @brief Takes one accepted step, shortened so as not to pass t_end.
+   * @return False if the step underflowed or the error was not finite.
+   */
+  template <OdeFunction<T, V> F>
+  bool step(F& f, T t_end) {
+    constexpr auto a21 = T{1} / 5;
+    constexpr auto a31 = T{3} / 40, a32 = T{9} / 40;
+    constexpr auto a41 = T{44} / 45, a42 = T{-56} / 15, a43 = T{32} / 9;
+    constexpr auto a51 = T{19372} / 6561, a52 = T{-25360} / 2187,
+                   a53 = T{64448} / 6561, a54 = T{-212} / 729;
+    constexpr auto a61 = T{9017} / 3168, a62 = T{-355} / 33,
+                   a63 = T{46732} / 5247, a64 = T{49} / 176,
+                   a65 = T{-5103} / 18656;
+    constexpr auto b1 = T{35} / 384, b3 = T{500} / 1113, b4 = T{125} / 192,
+                   b5 = T{-2187} / 6784, b6 = T{11} / 84;
+    constexpr auto e1 = T{71} / 57600, e3 = T{-71} / 16695,
+                   e4 = T{71} / 1920, e5 = T{-17253} / 339200,
+                   e6 = T{22} / 525, e7 = T{-1} / 40;
+    auto& k = _k;
+    auto stage = std::span<const V>(_stage);
+    for (;;) {
+      auto h = this->step_towards(t_end);
+      if (this->too_small(h)) return false;
+      auto evaluate = [&](std::size_t j, T c) {
+        f(_t + c * h, stage, k[j]);
+      };
+      for (auto i = std::size_t{0}; i < _n; ++i) {
+        _stage[i] = _y[i] + h * (a21 * k[0][i]);
+      }
+      evaluate(1, T{1} / 5);
+      for (auto i = std::size_t{0}; i < _n; ++i) {
+        _stage[i] = _y[i] + h * (a31 * k[0][i] + a32 * k[1][i]);
+      }
+      evaluate(2, T{3} / 10);
+      for (auto i = std::size_t{0}; i < _n; ++i) {
+        _stage[i] =
+            _y[i] + h * (a41 * k[0][i] + a42 * k[1][i] + a43 * k[2][i]);
+      }
+      evaluate(3, T{4} / 5);
+      for (auto i = std::size_t{0}; i < _n; ++i) {
+        _stage[i] = _y[i] + h * (a51 * k[0][i] + a52 * k[1][i] +
+                                 a53 * k[2][i] + a54 * k[3][i]);
+      }
+      evaluate(4, T{8} / 9);
+      for (auto i = std::size_t{0}; i < _n; ++i) {
+        _stage[i] = _y[i] + h * (a61 * k[0][i] + a62 * k[1][i] +
+                                 a63 * k[2][i] + a64 * k[3][i] +
+                                 a65 * k[4][i]);
+      }
+      evaluate(5, T{1});
+      for (auto i = std::size_t{0}; i < _n; ++i) {
+        _y_new[i] = _y[i] + h * (b1 * k[0][i] + b3 * k[2][i] +
+                                 b4 * k[3][i] + b5 * k[4][i] + b6 * k[5][i]);
+      }
+      f(_t + h, std::span<const V>(_y_new), k[6]);
+      _statistics.evaluations += 6;
+
+      auto sum = T{0};
+      for (auto i = std::size_t{0}; i < _n; ++i) {
+        auto e = h * (e1 * k[0][i] + e3 * k[2][i] + e4 * k[3][i] +
+                      e5 * k[4][i] + e6 * k[5][i] + e7 * k[6][i]);
+        auto scaled = std::abs(e) / this->weight(_y[i], _y_new[i]);
+        sum += scaled * scaled;
+      }
+      auto error = _n == 0 ? T{0} : std::sqrt(sum / static_cast<T>(_n));
+      if (!std::isfinite(error)) return false;
+      if (error <= 1) {
+        set_dense(h);
+        auto clipped = h != _h;
+        _t_old = _t;
+        _h_old = h;
+        _t = h == t_end - _t ? t_end : _t + h;
+        std::swap(_y, _y_new);
+        std::swap(k[0], k[6]);
+        auto factor = error == 0 ? T(5) : T(0.9) * std::pow(error, T(-0.2));
+        if (!clipped) _h = h * std::clamp(factor, T(0.2), T(5));
+        ++_statistics.steps;
+        return true;
+      }
+      _h = h * std::max(T(0.2), T(0.9) * std::pow(error, T(-0.2)));
+      ++_statistics.rejected;
+    }
+  }
+
+  /**
+   * @brief Writes the continuous extension of the last step at time t,
+   * which should lie within that step.
+   * @param t The time.
+   * @param out The span to write the state to.
+   */
+  void interpolate(T t, std::span<V> out) const {
+    if (_h_old == 0) {
+      std::ranges::copy(_y, out.begin());
+      return;
+    }
+    auto theta = (t - _t_old) / _h_old;
+    auto theta1 = 1 - theta;
+    for (auto i = std::size_t{0}; i < _n; ++i) {
+      out[i] = _dense[0][i] +
+               theta * (_dense[1][i] +
+                        theta1 * (_dense[2][i] +
+                                  theta * (_dense[3][i] +
+                                           theta1 * _dense[4][i])));
+    }
+  }
+
+ private:
+  // The coefficients of Hairer's continuous extension, formed before the
+  // state and stages are swapped at the end of an accepted step.
+  void set_dense(T h) {
+    constexpr auto d1 = T(-12715105075.0) / T(11282082432.0),
+                   d3 = T(87487479700.0) / T(32700410799.0),
+                   d4 = T(-10690763975.0) / T(1880347072.0),
+                   d5 = T(701980252875.0) / T(199316789632.0),
+                   d6 = T(-1453857185.0) / T(822651844.0),
+                   d7 = T(69997945.0) / T(29380423.0);
+    auto& k = _k;
+    for (auto i = std::size_t{0}; i < _n; ++i) {
+      auto difference = _y_new[i] - _y[i];
+      auto spline = h * k[0][i] - difference;
+      _dense[0][i] = _y[i];
+      _dense[1][i] = difference;
+      _dense[2][i] = spline;
+      _dense[3][i] = difference - h * k[6][i] - spline;
+      _dense[4][i] = h * (d1 * k[0][i] + d3 * k[2][i] + d4 * k[3][i] +
+                          d5 * k[4][i] + d6 * k[5][i] + d7 * k[6][i]);
+    }
+  }
+
+  std::span<V> _y_new;
+  std::span<V> _stage;
+  std::array<std::span<V>, 7> _k;
+  std::array<std::span<V>, 5> _dense;
+  T _t_old = 0;
+  T _h_old = 0;
+};
+
+/**
+ * @brief Stepper for the backward differentiation formulas.
+ * @details The solution history is kept at equal spacing, starting with the
+ * current state. A step of order k predicts the new state by extrapolating
+ * the polynomial through the last k + 1 states, and the local error is
+ * estimated as the difference between corrector and predictor divided by
+ * k + 1. The first step uses the derivative at the initial time for the
+ * predictor. After a rejection the step is reduced, and the polynomial
+ * through the history is evaluated on the new spacing. A successful step
+ * raises the order if the history allows, and enlarges the step by up to a
+ * factor of two only if the error estimate permits a growth of at least a
+ * fifth and the last k + 1 steps had the same size.
+ * @tparam V The RealOrComplex type of the state's elements.
+ */
+template <RealOrComplex V>
+class BdfStepper : public Detail::OdeStepperBase<V> {
+  using Base = Detail::OdeStepperBase<V>;
+  using typename Base::T;
+  using Base::_h;
+  using Base::_n;
+  using Base::_statistics;
+  using Base::_t;
+  using Base::_y;
+
+  static constexpr std::size_t MaxOrder = 5;
+
+ public:
+  /**
+   * @brief Allocates a stepper for n equations.
+   * @param n The number of equations.
+   * @param options The options, of which the tolerances and maximum order
+   * are used.
+   * @param resource The memory resource for the stepper's storage.
+   */
+  explicit BdfStepper(
+      std::size_t n, const OdeOptions& options = {},
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : Base(n, 2 * (MaxOrder + 1) + 6, options, resource),
+        _max_order{options.max_order},
+        _matrix(2 * n * n, Uninitialized, resource),
+        _pivots(n, Uninitialized, resource) {
+    if (_max_order < 1 || _max_order > MaxOrder) {
+      throw std::invalid_argument(
+          "BdfStepper: max_order must be between 1 and 5");
+    }
+    for (auto j = std::size_t{0}; j <= MaxOrder; ++j) {
+      _history[j] = this->vector(j);
+      _scratch[j] = this->vector(MaxOrder + 1 + j);
+    }
+    auto next = 2 * (MaxOrder + 1);
+    _predicted = this->vector(next);
+    _psi = this->vector(next + 1);
+    _derivative = this->vector(next + 2);
+    _delta = this->vector(next + 3);
+    _f = this->vector(next + 4);
+    _column = this->vector(next + 5);
+    _y = _history[0];
+  }
+
+  /**
+   * @brief Sets the time and state, and evaluates the derivative there.
+   * @param f The right-hand side.
+   * @param t The initial time.
+   * @param y0 A range holding the initial state.
+   * @param h The initial step, signed by the direction of integration, or
+   * zero to choose it from the problem heading towards t_end.
+   * @param t_end The time the integration heads towards.
+   */
+  template <OdeFunction<T, V> F, typename R>
+  void start(F& f, T t, R&& y0, T h, T t_end) {
+    _y = _history[0];
+    this->reset(t, y0, h);
+    f(_t, std::span<const V>(_y), _derivative);
+    ++_statistics.evaluations;
+    if (h == 0) _h = this->initial_step(f, t_end, _derivative, _f, _delta, 1);
+    _points = 1;
+    _order = 1;
+    _constant = 0;
+    _jacobian_current = false;
+    _factored = 0;
+    _statistics.jacobians = 0;
+  }
+
+  /**
+   * @brief Takes one accepted step, shortened so as not to pass t_end.
+   * @return False if the step underflowed.
+   */
+  template <OdeFunction<T, V> F>
+  bool step(F& f, T t_end) {
+    _jacobian_current = false;
+    for (;;) {
+      auto h = this->step_towards(t_end);
+      if (this->too_small(h)) return false;
+      if (h != _h) rescale(h / _h);
+      auto k = _points == 1 ? std::size_t{1} : _order;
+      predict(k);
+      if (!correct(f, k)) {
+        if (!_jacobian_current) {
+          jacobian(f);
+          continue;
+        }
+        rescale(T(0.25));
+        ++_statistics.rejected;
+        continue;
+      }
+      auto error = this->error_norm(_delta, _history[0], _scratch[0]) /
+                   static_cast<T>(k + 1);
+      auto exponent = T{-1} / static_cast<T>(k + 1);
+      if (!(error <= 1)) {
+        auto factor = std::isfinite(error)
+                          ? std::clamp(T(0.9) * std::pow(error, exponent),
+                                       T(0.1), T(0.9))
+                          : T(0.25);
+        rescale(factor);
+        ++_statistics.rejected;
+        continue;
+      }
+      accept(h == t_end - _t ? t_end : _t + h);
+      auto factor =
+          error == 0 ? T(2) : T(0.9) * std::pow(error, exponent);
+      if (h == _h && factor >= T(1.2) && _constant > k) {
+        rescale(std::min(factor, T(2)));
+      }
+      return true;
+    }
+  }
+
+  /**
+   * @brief Writes the interpolating polynomial of the solution history at
+   * time t, which should lie within the last step.
+   * @param t The time.
+   * @param out The span to write the state to.
+   */
+  void interpolate(T t, std::span<V> out) const {
+    auto s = (_t - t) / _h;
+    for (auto i = std::size_t{0}; i < _n; ++i) out[i] = V{0};
+    for (auto j = std::size_t{0}; j < _points; ++j) {
+      auto weight = lagrange(j, s, _points);
+      for (auto i = std::size_t{0}; i < _n; ++i) {
+        out[i] += weight * _history[j][i];
+      }
+    }
+  }
+
+  /// The order of the next step.
+  std::size_t order() const { return _points == 1 ? 1 : _order; }
+
+ private:
+  // The coefficients alpha_1, ..., alpha_k of the formulas normalised to
+  // alpha_0 = 1, and beta_k.
+  static constexpr std::array<std::array<double, MaxOrder>, MaxOrder> Alpha{
+      {{-1.0, 0, 0, 0, 0},
+       {-4.0 / 3, 1.0 / 3, 0, 0, 0},
+       {-18.0 / 11, 9.0 / 11, -2.0 / 11, 0, 0},
+       {-48.0 / 25, 36.0 / 25, -16.0 / 25, 3.0 / 25, 0},
+       {-300.0 / 137, 300.0 / 137, -200.0 / 137, 75.0 / 137, -12.0 / 137}}};
+  static constexpr std::array<double, MaxOrder> Beta{
+      1.0, 2.0 / 3, 6.0 / 11, 12.0 / 25, 60.0 / 137};
+
+  // The Lagrange basis polynomial of node j among nodes 0, ..., m - 1,
+  // at s.
+  static T lagrange(std::size_t j, T s, std::size_t m) {
+    auto weight = T{1};
+    for (auto l = std::size_t{0}; l < m; ++l) {
+      if (l == j) continue;
+      weight *= (s - static_cast<T>(l)) /
+                (static_cast<T>(j) - static_cast<T>(l));
+    }
+    return weight;
+  }
+
+  // Evaluates the polynomial through the history on the spacing ratio * h.
+  void rescale(T ratio) {
+    _h *= ratio;
+    _constant = 0;
+    if (_points == 1 || ratio == 1) return;
+    for (auto j = std::size_t{1}; j < _points; ++j) {
+      auto s = static_cast<T>(j) * ratio;
+      for (auto i = std::size_t{0}; i < _n; ++i) _scratch[j][i] = V{0};
+      for (auto l = std::size_t{0}; l < _points; ++l) {
+        auto weight = lagrange(l, s, _points);
+        for (auto i = std::size_t{0}; i < _n; ++i) {
+          _scratch[j][i] += weight * _history[l][i];
+        }
+      }
+    }
+    for (auto j = std::size_t{1}; j < _points; ++j) {
+      std::swap(_history[j], _scratch[j]);
+    }
+  }
+
+  // Extrapolates the history to the next step, and forms the constant part
+  // psi of the corrector.
+  void predict(std::size_t k) {
+    if (_points == 1) {
+      for (auto i = std::size_t{0}; i < _n; ++i) {
+        _predicted[i] = _y[i] + _h * _derivative[i];
+      }
+    } else {
+      auto binomial = T{1};
+      auto sign = T{1};
+      for (auto i = std::size_t{0}; i < _n; ++i) _predicted[i] = V{0};
+      for (auto j = std::size_t{0}; j <= k; ++j) {
+        // binomial is C(k + 1, j + 1).
+        binomial = j == 0 ? static_cast<T>(k + 1)
+                          : binomial * static_cast<T>(k + 1 - j) /
+                                static_cast<T>(j + 1);
+        for (auto i = std::size_t{0}; i < _n; ++i) {
+          _predicted[i] += sign * binomial * _history[j][i];
+        }
+        sign = -sign;
+      }
+    }
+    for (auto i = std::size_t{0}; i < _n; ++i) _psi[i] = V{0};
+    for (auto j = std::size_t{0}; j < k; ++j) {
+      auto alpha = static_cast<T>(Alpha[k - 1][j]);
+      for (auto i = std::size_t{0}; i < _n; ++i) {
+        _psi[i] -= alpha * _history[j][i];
+      }
+    }
+  }
+
+  // Solves y = psi + h beta f(t + h, y) by a modified Newton iteration
+  // from the prediction. On success _scratch[0] holds y and _delta its
+  // difference from the prediction.
+  template <typename F>
+  bool correct(F& f, std::size_t k) {
+    auto hb = _h * static_cast<T>(Beta[k - 1]);
+    if (_statistics.jacobians == 0) jacobian(f);
+    if (_factored != hb && !factor(hb)) return false;
+    auto y = _scratch[0];
+    std::ranges::copy(_predicted, y.begin());
+    auto previous = std::numeric_limits<T>::infinity();
+    for (auto iteration = 0; iteration < 5; ++iteration) {
+      f(_t + _h, std::span<const V>(y), _f);
+      ++_statistics.evaluations;
+      for (auto i = std::size_t{0}; i < _n; ++i) {
+        _column[i] = _psi[i] + hb * _f[i] - y[i];
+      }
+      solve(_column);
+      for (auto i = std::size_t{0}; i < _n; ++i) y[i] += _column[i];
+      auto change = this->error_norm(_column, y, y);
+      if (!std::isfinite(change) || change > 2 * previous) return false;
+      previous = change;
+      if (change <= T(0.01)) {
+        for (auto i = std::size_t{0}; i < _n; ++i) {
+          _delta[i] = y[i] - _predicted[i];
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Forms the Jacobian at the current state by forward differences.
+  template <typename F>
+  void jacobian(F& f) {
+    auto y = _scratch[0];
+    std::ranges::copy(_y, y.begin());
+    f(_t, std::span<const V>(y), _f);
+    for (auto j = std::size_t{0}; j < _n; ++j) {
+      auto d = std::sqrt(std::numeric_limits<T>::epsilon()) *
+               std::max(std::abs(_y[j]), T{1});
+      y[j] = _y[j] + d;
+      f(_t, std::span<const V>(y), _column);
+      y[j] = _y[j];
+      for (auto i = std::size_t{0}; i < _n; ++i) {
+        _jacobian_begin()[i * _n + j] = (_column[i] - _f[i]) / d;
+      }
+    }
+    _statistics.evaluations += _n + 1;
+    ++_statistics.jacobians;
+    _jacobian_current = true;
+    _factored = 0;
+  }
+
+  // The Jacobian follows the factored matrix in the same storage.
+  V* _jacobian_begin() { return _matrix.data() + _n * _n; }
+
+  // Factors I - hb J with partial pivoting.
+  bool factor(T hb) {
+    auto a = _matrix.data();
+    auto jacobian = _jacobian_begin();
+    for (auto i = std::size_t{0}; i < _n * _n; ++i) {
+      a[i] = -hb * jacobian[i];
+    }
+    for (auto i = std::size_t{0}; i < _n; ++i) a[i * _n + i] += T{1};
+    for (auto c = std::size_t{0}; c < _n; ++c) {
+      auto pivot = c;
+      for (auto r = c + 1; r < _n; ++r) {
+        if (std::abs(a[r * _n + c]) > std::abs(a[pivot * _n + c])) {
+          pivot = r;
+        }
+      }
+      _pivots[c] = pivot;
+      if (a[pivot * _n + c] == V{0}) return false;
+      if (pivot != c) {
+        std::swap_ranges(a + c * _n, a + (c + 1) * _n, a + pivot * _n);
+      }
+      for (auto r = c + 1; r < _n; ++r) {
+        auto m = a[r * _n + c] / a[c * _n + c];
+        a[r * _n + c] = m;
+        for (auto j = c + 1; j < _n; ++j) a[r * _n + j] -= m * a[c * _n + j];
+      }
+    }
+    _factored = hb;
+    return true;
+  }
+
+  // Solves the factored system in place.
+  void solve(std::span<V> b) const {
+    auto a = _matrix.data();
+    for (auto c = std::size_t{0}; c < _n; ++c) {
+      std::swap(b[c], b[_pivots[c]]);
+      for (auto r = c + 1; r < _n; ++r) b[r] -= a[r * _n + c] * b[c];
+    }
+    for (auto c = _n; c-- > 0;) {
+      for (auto j = c + 1; j < _n; ++j) b[c] -= a[c * _n + j] * b[j];
+      b[c] /= a[c * _n + c];
+    }
+  }
+
+  // Shifts the history and makes the corrected state current.
+  void accept(T t) {
+    auto capacity = _max_order + 1;
+    auto last = std::min(_points, capacity - 1);
+    auto oldest = _history[last];
+    for (auto j = last; j > 0; --j) _history[j] = _history[j - 1];
+    _history[0] = _scratch[0];
+    _scratch[0] = oldest;
+    _y = _history[0];
+    _points = std::min(_points + 1, capacity);
+    if (_points > 2 && _order < _max_order) ++_order;
+    ++_constant;
+    _t = t;
+    ++_statistics.steps;
+  }
+
+  std::size_t _max_order;
+  NumericBuffer<V> _matrix;
+  NumericBuffer<std::size_t> _pivots;
+  std::array<std::span<V>, MaxOrder + 1> _history;
+  std::array<std::span<V>, MaxOrder + 1> _scratch;
+  std::span<V> _predicted;
+  std::span<V> _psi;
+  std::span<V> _derivative;
+  std::span<V> _delta;
+  std::span<V> _f;
+  std::span<V> _column;
+  std::size_t _points = 1;
+  std::size_t _order = 1;
+  std::size_t _constant = 0;
+  bool _jacobian_current = false;
+  T _factored = 0;
+};
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Trait mapping a method tag and element type to its stepper.
+ */
+template <typename M, typename V>
+struct OdeStepperHelper;
+
+template <typename V>
+struct OdeStepperHelper<Rk4, V> {
+  using type = Rk4Stepper<V>;
+};
+
+template <typename V>
+struct OdeStepperHelper<DormandPrince54, V> {
+  using type = DormandPrince54Stepper<V>;
+};
+
+template <typename V>
+struct OdeStepperHelper<Bdf, V> {
+  using type = BdfStepper<V>;
+};
+
+template <typename M, typename V>
+using OdeStepper = typename OdeStepperHelper<M, V>::type;
+
+/**
+ * @internal
+ * @brief Concept for the integration method tags.
+ */
+template <typename M>
+concept OdeMethod = std::same_as<M, Rk4> or std::same_as<M, DormandPrince54> or
+                    std::same_as<M, Bdf>;
+
+/**
+ * @internal
+ * @brief Concept for the steppers with a continuous extension.
+ */
+template <typename S>
+concept OdeDenseStepper =
+    requires(const S& stepper, typename S::time_type t,
+             std::span<typename S::value_type> out) {
+      stepper.interpolate(t, out);
+    };
+
+/**
+ * @internal
+ * @brief Starts a stepper for the interval from t0 to t1, dividing the
+ * interval into equal steps for Rk4.
+ */
+template <typename S, typename F, typename R, typename T>
+void start_stepper(S& stepper, F& f, R&& y0, T t0, T t1,
+                   const OdeOptions& options) {
+  auto h = static_cast<T>(options.step);
+  if constexpr (std::same_as<S, Rk4Stepper<typename S::value_type>>) {
+    auto steps = h > 0 ? std::ceil(std::abs(t1 - t0) / h) : T(100);
+    stepper.start(f, t0, y0, (t1 - t0) / std::max(steps, T{1}));
+  } else {
+    stepper.start(f, t0, y0, t1 < t0 ? -h : h, t1);
+  }
+}
+
+/**
+ * @internal
+ * @brief Takes one step towards t_end within the step limit.
+ */
+template <typename S, typename F, typename T>
+bool step_within_limit(S& stepper, F& f, T t_end,
+                       const OdeOptions& options) {
+  return stepper.statistics().steps < options.max_steps &&
+         stepper.step(f, t_end);
+}
+
+/**
+ * @internal
+ * @brief Steps until t_end is reached, returning false if a step fails or
+ * the step limit is reached first.
+ */
+template <typename S, typename F, typename T>
+bool advance(S& stepper, F& f, T t_end, const OdeOptions& options) {
+  while (stepper.time() != t_end) {
+    if (!step_within_limit(stepper, f, t_end, options)) return false;
+  }
+  return true;
+}
+
+/**
+ * @internal
+ * @brief Adds the counters of one integration to a total.
+ */
+inline void add_statistics(OdeResult& total, const OdeResult& result,
+                           bool completed) {
+  ++total.systems;
+  total.completed += completed ? 1 : 0;
+  total.steps += result.steps;
+  total.rejected += result.rejected;
+  total.evaluations += result.evaluations;
+  total.jacobians += result.jacobians;
+}
+
+/**
+ * @internal
+ * @brief Concept for the flat ranges of states integrate_ensemble()
+ * integrates in place.
+ */
+template <typename R>
+concept OdeEnsembleRange = RealOrComplexWritableRange<R> and
+                           std::ranges::random_access_range<R> and
+                           std::ranges::sized_range<R>;
+
+}  // namespace Detail
+
+/**
+ * @brief Integrates a system of ordinary differential equations from t0 to
+ * t1, in place.
+ * @details The state is copied into a stepper allocated for its size, which
+ * then steps without allocating, and the final state is copied back, also
+ * when the integration stops early.
+ * @param f The right-hand side, called as `f(t, y, dydt)`.
+ * @param y The initial state, overwritten by the final state.
+ * @param t0 The initial time.
+ * @param t1 The final time, which may precede t0.
+ * @param method The method: DormandPrince54 (default), Rk4 or Bdf.
+ * @param options The tolerances, steps and step limit.
+ * @return The counters, with one system that completed unless a step failed
+ * or the step limit was reached.
+ */
+template <typename F, RealOrComplexWritableRange State,
+          typename Method = DormandPrince54>
+  requires Detail::OdeMethod<Method> and
+           OdeFunction<F&, RangePrecision<State>,
+                       std::ranges::range_value_t<State>>
+OdeResult integrate(F&& f, State&& y, RangePrecision<State> t0,
+                    RangePrecision<State> t1, Method = {},
+                    const OdeOptions& options = {}) {
+  using V = std::ranges::range_value_t<State>;
+  auto n = static_cast<std::size_t>(std::ranges::distance(y));
+  auto stepper = Detail::OdeStepper<Method, V>(n, options);
+  Detail::start_stepper(stepper, f, y, t0, t1, options);
+  auto completed = Detail::advance(stepper, f, t1, options);
+  std::ranges::copy(stepper.state(), std::ranges::begin(y));
+  auto result = OdeResult{};
+  Detail::add_statistics(result, stepper.statistics(), completed);
+  return result;
+}
+
+/**
+ * @brief Integrates a system of ordinary differential equations from t0,
+ * writing the state at each of a sequence of times.
+ * @details The times should be monotonic, heading away from t0. The
+ * adaptive methods step towards the last time and evaluate their
+ * continuous extension at the times in between, while Rk4 shortens its steps
+ * to land on each time. The states are written one after another to out,
+ * which should hold the number of times multiplied by the size of the
+ * state.
+ * @param f The right-hand side, called as `f(t, y, dydt)`.
+ * @param y The initial state, overwritten by the final state.
+ * @param t0 The initial time.
+ * @param times The times at which to record the state.
+ * @param out The range to write the states to.
+ * @param method The method: DormandPrince54 (default), Rk4 or Bdf.
+ * @param options The tolerances, steps and step limit.
+ * @return The counters, with one system that completed unless a step failed
+ * or the step limit was reached, in which case the later states are not
+ * written.
+ */
+template <typename F, RealOrComplexWritableRange State, RealRange Times,
+          RealOrComplexWritableRange Out, typename Method = DormandPrince54>
+  requires Detail::OdeMethod<Method> and std::ranges::forward_range<Times> and
+           OdeFunction<F&, RangePrecision<State>,
+                       std::ranges::range_value_t<State>>
+OdeResult integrate_at(F&& f, State&& y, RangePrecision<State> t0,
+                       Times&& times, Out&& out, Method = {},
+                       const OdeOptions& options = {}) {
+  using T = RangePrecision<State>;
+  using V = std::ranges::range_value_t<State>;
+  auto n = static_cast<std::size_t>(std::ranges::distance(y));
+  auto last = t0;
+  for (auto&& time : times) last = static_cast<T>(time);
+
+  auto stepper = Detail::OdeStepper<Method, V>(n, options);
+  constexpr auto dense = Detail::OdeDenseStepper<decltype(stepper)>;
+  auto row = NumericBuffer<V>(dense ? n : 0, Uninitialized);
+  Detail::start_stepper(stepper, f, y, t0, last, options);
+  auto forward = t0 <= last;
+  auto completed = true;
+  auto oi = std::ranges::begin(out);
+  auto write = [&](std::span<const V> state) {
+    for (auto i = std::size_t{0}; i < n && oi != std::ranges::end(out);
+         ++i, ++oi) {
+      *oi = state[i];
+    }
+  };
+  for (auto&& time : times) {
+    auto t = static_cast<T>(time);
+    auto target = dense ? last : t;
+    while (completed &&
+           (forward ? stepper.time() < t : stepper.time() > t)) {
+      completed = Detail::step_within_limit(stepper, f, target, options);
+    }
+    if (!completed) break;
+    if constexpr (dense) {
+      if (stepper.time() != t) {
+        stepper.interpolate(t, row);
+        write(row);
+        continue;
+      }
+    }
+    write(stepper.state());
+  }
+  std::ranges::copy(stepper.state(), std::ranges::begin(y));
+  auto result = OdeResult{};
+  Detail::add_statistics(result, stepper.statistics(), completed);
+  return result;
+}
+
+/**
+ * @brief Integrates an ensemble of independent systems of ordinary
+ * differential equations of the same size from t0 to t1, in place.
+ * @details The states are stored one system after another in a single
+ * range. Systems are distributed over a ThreadPool, and each task allocates
+ * one stepper that it reuses for all of its systems. The right-hand side may
+ * take the index of the system as a fourth argument, and may be called
+ * concurrently.
+ * @param f The right-hand side, called as `f(t, y, dydt)` or
+ * `f(t, y, dydt, i)`.
+ * @param states The initial states, overwritten by the final states.
+ * @param system_size The number of equations in each system.
+ * @param t0 The initial time.
+ * @param t1 The final time, which may precede t0.
+ * @param method The method: DormandPrince54 (default), Rk4 or Bdf.
+ * @param options The tolerances, steps, step limit, grain size and thread
+ * pool.
+ * @return The counters summed over the systems.
+ * @throws std::invalid_argument If the number of states is not a multiple of
+ * a non-zero system_size.
+ */
+template <typename F, Detail::OdeEnsembleRange States,
+          typename Method = DormandPrince54>
+  requires Detail::OdeMethod<Method> and
+           (OdeFunction<F&, RangePrecision<States>,
+                        std::ranges::range_value_t<States>> or
+            OdeEnsembleFunction<F&, RangePrecision<States>,
+                                std::ranges::range_value_t<States>>)
+OdeResult integrate_ensemble(F&& f, States&& states, std::size_t system_size,
+                             RangePrecision<States> t0,
+                             RangePrecision<States> t1, Method = {},
+                             const OdeOptions& options = {}) {
+  using T = RangePrecision<States>;
+  using V = std::ranges::range_value_t<States>;
+  auto size = static_cast<std::size_t>(std::ranges::size(states));
+  if (system_size == 0 || size % system_size != 0) {
+    throw std::invalid_argument(
+        "integrate_ensemble: the number of states is not a multiple of "
+        "system_size");
+  }
+  auto total = OdeResult{};
+  auto completed = std::atomic<std::size_t>{0};
+  auto steps = std::atomic<std::size_t>{0};
+  auto rejected = std::atomic<std::size_t>{0};
+  auto evaluations = std::atomic<std::size_t>{0};
+  auto jacobians = std::atomic<std::size_t>{0};
+  auto systems = size / system_size;
+  auto& pool = options.pool ? *options.pool : ThreadPool::global();
+  Detail::parallel_range(
+      pool, systems, options.grain, [&](std::size_t lo, std::size_t hi) {
+        auto stepper = Detail::OdeStepper<Method, V>(system_size, options);
+        auto counters = OdeResult{};
+        for (auto s = lo; s < hi; ++s) {
+          auto first = std::ranges::begin(states) +
+                       static_cast<std::ptrdiff_t>(s * system_size);
+          auto state = std::ranges::subrange(
+              first, first + static_cast<std::ptrdiff_t>(system_size));
+          auto system = [&f, s](T t, std::span<const V> y,
+                                std::span<V> dydt) {
+            if constexpr (OdeEnsembleFunction<F&, T, V>) {
+              f(t, y, dydt, s);
+            } else {
+              f(t, y, dydt);
+            }
+          };
+          Detail::start_stepper(stepper, system, state, t0, t1, options);
+          auto done = Detail::advance(stepper, system, t1, options);
+          std::ranges::copy(stepper.state(), first);
+          Detail::add_statistics(counters, stepper.statistics(), done);
+        }
+        completed += counters.completed;
+        steps += counters.steps;
+        rejected += counters.rejected;
+        evaluations += counters.evaluations;
+        jacobians += counters.jacobians;
+      });
+  total.systems = systems;
+  total.completed = completed.load();
+  total.steps = steps.load();
+  total.rejected = rejected.load();
+  total.evaluations = evaluations.load();
+  total.jacobians = jacobians.load();
+  return total;
+}
+
+}  // namespace NumericConcepts
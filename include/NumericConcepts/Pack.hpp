@@ -0,0 +1,584 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <type_traits>
+
+#if __has_include(<experimental/simd>) && !defined(NUMERIC_CONCEPTS_NO_SIMD)
+// The AVX-512 intrinsics of GCC 12 start from undefined registers, which
+// the inlined simd math functions report as uninitialized reads.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 13
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <experimental/simd>
+#pragma GCC diagnostic pop
+#else
+#include <experimental/simd>
+#endif
+#define NUMERIC_CONCEPTS_STD_SIMD
+#endif
+
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+
+/**
+ * @file Pack.hpp
+ * @brief Defines concepts admitting SIMD packs alongside the scalar real and
+ * complex types, and a split complex pack.
+ * @details Real and Complex describe single values, so kernels constrained
+ * on them cannot be instantiated with a SIMD vector. The concepts here form
+ * an opt-in layer on top: RealLike accepts Real types and the packs
+ * registered through RealPackType, which include
+ * `std::experimental::simd` where the standard library provides it, and
+ * ComplexLike accepts Complex types and SplitComplexPack. A kernel written
+ * once against these concepts, e.g.,
+ *
+ * @code
+ * template <RealLike T>
+ * T gaussian(T x) {
+ *   using std::exp;
+ *   return exp(-x * x / 2);
+ * }
+ * @endcode
+ *
+ * compiles both to scalar code and to code processing a pack of lanes per
+ * call, and pack_transform() applies such a kernel to a range a pack at a
+ * time. Kernels should call the math functions unqualified after a
+ * using-declaration, so that the overloads for packs are found by ADL, and
+ * must not branch on values, which differ between lanes.
+ *
+ * Defining `NUMERIC_CONCEPTS_NO_SIMD` leaves the concepts in place but makes
+ * NativePack a scalar type, so pack_transform() calls the kernel on single
+ * values.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief Trait to determine if a type is a pack of real values.
+ * @details This is the customization point for the RealPack concept. A
+ * specialization derives from std::true_type and defines `value_type`, the
+ * Real type of the lanes, `size`, the number of lanes, and static `load` and
+ * `store` functions copying the lanes from and to contiguous memory. The
+ * pack must be constructible from a `value_type`, which is broadcast to all
+ * lanes, support the arithmetic operators, and give the value of lane `i` as
+ * `p[i]`.
+ * @tparam T The type to check.
+ */
+template <typename T>
+struct RealPackType : public std::false_type {};
+
+#ifdef NUMERIC_CONCEPTS_STD_SIMD
+
+/**
+ * @brief Specialization of RealPackType for `std::experimental::simd`.
+ * @tparam T The lane type.
+ * @tparam Abi The ABI tag fixing the number of lanes.
+ */
+template <typename T, typename Abi>
+struct RealPackType<std::experimental::simd<T, Abi>>
+    : public std::bool_constant<Real<T>> {
+  using value_type = T;
+  static constexpr std::size_t size = std::experimental::simd_size_v<T, Abi>;
+
+  static std::experimental::simd<T, Abi> load(const T* p) {
+    return {p, std::experimental::element_aligned};
+  }
+
+  static void store(const std::experimental::simd<T, Abi>& a, T* p) {
+    a.copy_to(p, std::experimental::element_aligned);
+  }
+};
+
+#endif
+
+/**
+ * @brief Concept for packs of real values registered through RealPackType.
+ * @tparam T The type to check.
+ */
+template <typename T>
+concept RealPack = RealPackType<T>::value;
+
+/**
+ * @brief Trait to determine if a type is a pack of complex values.
+ * @details This is the customization point for the ComplexPack concept. As
+ * for ComplexType, a specialization derives from std::true_type and defines
+ * `value_type`, which here is the RealPack holding each component. It also
+ * defines `size` and static `load` and `store` functions for contiguous
+ * arrays of `std::complex`.
+ * @tparam T The type to check.
+ */
+template <typename T>
+struct ComplexPackType : public std::false_type {};
+
+/**
+ * @brief Concept for packs of complex values registered through
+ * ComplexPackType.
+ * @tparam T The type to check.
+ */
+template <typename T>
+concept ComplexPack = ComplexPackType<T>::value;
+
+/**
+ * @brief Concept for real types and packs of real values.
+ * @tparam T The type to check.
+ */
+template <typename T>
+concept RealLike = Real<T> or RealPack<T>;
+
+/**
+ * @brief Concept for complex types and packs of complex values.
+ * @tparam T The type to check.
+ */
+template <typename T>
+concept ComplexLike = Complex<T> or ComplexPack<T>;
+
+/**
+ * @brief Concept for types that are RealLike or ComplexLike.
+ * @tparam T The type to check.
+ */
+template <typename T>
+concept RealOrComplexLike = RealLike<T> or ComplexLike<T>;
+
+/**
+ * @brief A pack of complex values stored as packs of real and imaginary
+ * parts.
+ * @details The split layout keeps each component in a single register, so
+ * complex arithmetic is a handful of lane-wise real operations. Operations
+ * mix freely with real packs and, through the pack's broadcast constructor,
+ * with scalars. Division uses the textbook formula without the rescaling
+ * performed by `std::complex`, and so overflows when the squared magnitude of
+ * the divisor does.
+ * @tparam P The RealPack type of each component.
+ */
+template <RealPack P>
+class SplitComplexPack {
+ public:
+  using real_type = P;
+  using lane_type = std::complex<typename RealPackType<P>::value_type>;
+  static constexpr std::size_t size = RealPackType<P>::size;
+
+  SplitComplexPack() = default;
+
+  /// Constructs the pack from its real and imaginary parts.
+  SplitComplexPack(P real, P imag = P(0))
+      : _real{std::move(real)}, _imag{std::move(imag)} {}
+
+  /// Broadcasts a complex value to all lanes.
+  SplitComplexPack(const lane_type& z) : _real(z.real()), _imag(z.imag()) {}
+
+  /// Loads size values from contiguous memory.
+  static SplitComplexPack load(const lane_type* p) {
+    using T = typename RealPackType<P>::value_type;
+    auto real = std::array<T, size>{};
+    auto imag = std::array<T, size>{};
+    for (auto i = std::size_t{0}; i < size; ++i) {
+      real[i] = p[i].real();
+      imag[i] = p[i].imag();
+    }
+    return {RealPackType<P>::load(real.data()),
+            RealPackType<P>::load(imag.data())};
+  }
+
+  /// Stores the lanes to contiguous memory.
+  void store(lane_type* p) const {
+    using T = typename RealPackType<P>::value_type;
+    auto real = std::array<T, size>{};
+    auto imag = std::array<T, size>{};
+    RealPackType<P>::store(_real, real.data());
+    RealPackType<P>::store(_imag, imag.data());
+    for (auto i = std::size_t{0}; i < size; ++i) p[i] = {real[i], imag[i]};
+  }
+
+  const P& real() const { return _real; }
+  const P& imag() const { return _imag; }
+
+  /// Returns the value of lane i.
+  lane_type operator[](std::size_t i) const { return {_real[i], _imag[i]}; }
+
+  SplitComplexPack operator-() const { return {-_real, -_imag}; }
+
+  SplitComplexPack& operator+=(const SplitComplexPack& b) {
+    _real += b._real;
+    _imag += b._imag;
+    return *this;
+  }
+
+  SplitComplexPack& operator-=(const SplitComplexPack& b) {
+    _real -= b._real;
+    _imag -= b._imag;
+    return *this;
+  }
+
+  SplitComplexPack& operator*=(const SplitComplexPack& b) {
+    return *this = *this * b;
+  }
+
+  SplitComplexPack& operator/=(const SplitComplexPack& b) {
+    return *this = *this / b;
+  }
+
+  friend SplitComplexPack operator+(SplitComplexPack a,
+                                    const SplitComplexPack& b) {
+    return a += b;
+  }
+
+  friend SplitComplexPack operator+(SplitComplexPack a, const P& b) {
+    a._real += b;
+    return a;
+  }
+
+  friend SplitComplexPack operator+(const P& a, SplitComplexPack b) {
+    b._real += a;
+    return b;
+  }
+
+  friend SplitComplexPack operator-(SplitComplexPack a,
+                                    const SplitComplexPack& b) {
+    return a -= b;
+  }
+
+  friend SplitComplexPack operator-(SplitComplexPack a, const P& b) {
+    a._real -= b;
+    return a;
+  }
+
+  friend SplitComplexPack operator-(const P& a, const SplitComplexPack& b) {
+    return {a - b._real, -b._imag};
+  }
+
+  friend SplitComplexPack operator*(const SplitComplexPack& a,
+                                    const SplitComplexPack& b) {
+    return {a._real * b._real - a._imag * b._imag,
+            a._real * b._imag + a._imag * b._real};
+  }
+
+  friend SplitComplexPack operator*(const SplitComplexPack& a, const P& b) {
+    return {a._real * b, a._imag * b};
+  }
+
+  friend SplitComplexPack operator*(const P& a, const SplitComplexPack& b) {
+    return {a * b._real, a * b._imag};
+  }
+
+  friend SplitComplexPack operator/(const SplitComplexPack& a,
+                                    const SplitComplexPack& b) {
+    auto d = norm(b);
+    return {(a._real * b._real + a._imag * b._imag) / d,
+            (a._imag * b._real - a._real * b._imag) / d};
+  }
+
+  friend SplitComplexPack operator/(const SplitComplexPack& a, const P& b) {
+    return {a._real / b, a._imag / b};
+  }
+
+  friend SplitComplexPack operator/(const P& a, const SplitComplexPack& b) {
+    auto d = norm(b);
+    return {a * b._real / d, -a * b._imag / d};
+  }
+
+  friend P real(const SplitComplexPack& z) { return z._real; }
+  friend P imag(const SplitComplexPack& z) { return z._imag; }
+
+  friend SplitComplexPack conj(const SplitComplexPack& z) {
+    return {z._real, -z._imag};
+  }
+
+  friend P norm(const SplitComplexPack& z) {
+    return z._real * z._real + z._imag * z._imag;
+  }
+
+  friend P abs(const SplitComplexPack& z) {
+    using std::hypot;
+    return hypot(z._real, z._imag);
+  }
+
+  friend P arg(const SplitComplexPack& z) {
+    using std::atan2;
+    return atan2(z._imag, z._real);
+  }
+
+  friend SplitComplexPack exp(const SplitComplexPack& z) {
+    using std::cos;
+    using std::exp;
+    using std::sin;
+    auto r = exp(z._real);
+    return {r * cos(z._imag), r * sin(z._imag)};
+  }
+
+ private:
+  P _real;
+  P _imag;
+};
+
+/**
+ * @brief Registers SplitComplexPack as a complex pack.
+ * @tparam P The RealPack type of each component.
+ */
+template <RealPack P>
+struct ComplexPackType<SplitComplexPack<P>> : public std::true_type {
+  using value_type = P;
+  static constexpr std::size_t size = RealPackType<P>::size;
+
+  static SplitComplexPack<P> load(
+      const typename SplitComplexPack<P>::lane_type* p) {
+    return SplitComplexPack<P>::load(p);
+  }
+
+  static void store(const SplitComplexPack<P>& a,
+                    typename SplitComplexPack<P>::lane_type* p) {
+    a.store(p);
+  }
+};
+
+/**
+ * @internal
+ * @brief Helper struct to extract the real counterpart of a RealOrComplexLike
+ * type.
+ * @tparam T The RealOrComplexLike type.
+ */
+template <RealOrComplexLike T>
+struct RemoveComplexLikeHelper {
+  using value_type = T;
+};
+
+template <Complex T>
+struct RemoveComplexLikeHelper<T> {
+  using value_type = RemoveComplex<T>;
+};
+
+template <ComplexPack T>
+struct RemoveComplexLikeHelper<T> {
+  using value_type = typename ComplexPackType<T>::value_type;
+};
+
+/**
+ * @brief The real counterpart of a RealOrComplexLike type.
+ * @details This is RemoveComplex for scalar types, the pack of the
+ * components for complex packs, and the type itself for real packs. For
+ * example, `RemoveComplexLike<SplitComplexPack<P>>` is `P`.
+ * @tparam T The RealOrComplexLike type.
+ */
+template <RealOrComplexLike T>
+using RemoveComplexLike = typename RemoveComplexLikeHelper<T>::value_type;
+
+/**
+ * @internal
+ * @brief Helper struct to extract the precision of the lanes of a
+ * RealOrComplexLike type.
+ * @tparam T The RealOrComplexLike type.
+ */
+template <RealOrComplexLike T>
+struct LanePrecisionHelper {
+  using value_type = RemoveComplex<T>;
+  static constexpr std::size_t size = 1;
+};
+
+template <RealOrComplexLike T>
+  requires RealPack<RemoveComplexLike<T>>
+struct LanePrecisionHelper<T> {
+  using value_type = typename RealPackType<RemoveComplexLike<T>>::value_type;
+  static constexpr std::size_t size = RealPackType<RemoveComplexLike<T>>::size;
+};
+
+/**
+ * @brief The Real precision of the lanes of a RealOrComplexLike type.
+ * @details For scalar types this is RemoveComplex. For example,
+ * `LanePrecision<std::experimental::native_simd<float>>` and
+ * `LanePrecision<std::complex<float>>` are both `float`.
+ * @tparam T The RealOrComplexLike type.
+ */
+template <RealOrComplexLike T>
+using LanePrecision = typename LanePrecisionHelper<T>::value_type;
+
+/**
+ * @brief The number of lanes of a RealOrComplexLike type, which is one for
+ * scalar types.
+ * @tparam T The RealOrComplexLike type.
+ */
+template <RealOrComplexLike T>
+inline constexpr std::size_t lane_count = LanePrecisionHelper<T>::size;
+
+/**
+ * @internal
+ * @brief Helper struct giving the native pack for a RealOrComplex type.
+ * @details Types without a native pack map to themselves.
+ * @tparam T The RealOrComplex type.
+ */
+template <RealOrComplex T>
+struct NativePackHelper {
+  using value_type = T;
+};
+
+#ifdef NUMERIC_CONCEPTS_STD_SIMD
+
+template <RealOrComplex T>
+  requires std::floating_point<RemoveComplex<T>>
+struct NativePackHelper<T> {
+  using real_pack = std::experimental::native_simd<RemoveComplex<T>>;
+  using value_type = std::conditional_t<Complex<T>,
+                                        SplitComplexPack<real_pack>, real_pack>;
+};
+
+#endif
+
+/**
+ * @brief The pack filling a native SIMD register with lanes of type T.
+ * @details For real T this is `std::experimental::native_simd<T>` and for
+ * complex T it is the SplitComplexPack of those. When no pack is available,
+ * as for extended floating-point types or when `NUMERIC_CONCEPTS_NO_SIMD` is
+ * defined, it is T itself.
+ * @tparam T The RealOrComplex type.
+ */
+template <RealOrComplex T>
+using NativePack = typename NativePackHelper<T>::value_type;
+
+/**
+ * @brief Concept for a function that returns a RealLike value.
+ * @tparam F The invocable type.
+ * @tparam Args The argument types.
+ */
+template <typename F, typename... Args>
+concept RealLikeFunction = requires() {
+  requires std::invocable<F, Args...>;
+  requires RealLike<std::invoke_result_t<F, Args...>>;
+};
+
+/**
+ * @brief Concept for a function that returns a ComplexLike value.
+ * @tparam F The invocable type.
+ * @tparam Args The argument types.
+ */
+template <typename F, typename... Args>
+concept ComplexLikeFunction = requires() {
+  requires std::invocable<F, Args...>;
+  requires ComplexLike<std::invoke_result_t<F, Args...>>;
+};
+
+/**
+ * @brief Concept for a function that returns a RealOrComplexLike value.
+ * @tparam F The invocable type.
+ * @tparam Args The argument types.
+ */
+template <typename F, typename... Args>
+concept RealOrComplexLikeFunction = requires() {
+  requires std::invocable<F, Args...>;
+  requires RealOrComplexLike<std::invoke_result_t<F, Args...>>;
+};
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Loads a RealOrComplexLike value from contiguous memory.
+ */
+template <RealOrComplexLike P, typename T>
+P pack_load(const T* p) {
+  if constexpr (RealPack<P>) {
+    return RealPackType<P>::load(p);
+  } else if constexpr (ComplexPack<P>) {
+    return ComplexPackType<P>::load(p);
+  } else {
+    return *p;
+  }
+}
+
+/**
+ * @internal
+ * @brief Stores a RealOrComplexLike value to contiguous memory.
+ */
+template <RealOrComplexLike P, typename T>
+void pack_store(const P& a, T* p) {
+  if constexpr (RealPack<P>) {
+    RealPackType<P>::store(a, p);
+  } else if constexpr (ComplexPack<P>) {
+    ComplexPackType<P>::store(a, p);
+  } else {
+    *p = a;
+  }
+}
+
+/**
+ * @internal
+ * @brief The scalar type whose arrays a RealOrComplexLike type is loaded
+ * from and stored to.
+ */
+template <RealOrComplexLike P>
+using PackLane = std::conditional_t<ComplexLike<P>,
+                                    std::complex<LanePrecision<P>>,
+                                    LanePrecision<P>>;
+
+/**
+ * @internal
+ * @brief Concept for a kernel that pack_transform() can call on both values
+ * of type T and the native packs of T, writing elements of type W.
+ */
+template <typename F, typename T, typename W>
+concept PackKernel = requires() {
+  requires RealOrComplexLikeFunction<F, T>;
+  requires RealOrComplexLikeFunction<F, NativePack<T>>;
+  requires std::assignable_from<W&, std::invoke_result_t<F, T>>;
+  requires lane_count<std::invoke_result_t<F, NativePack<T>>> ==
+               lane_count<NativePack<T>>;
+  requires std::convertible_to<
+      PackLane<std::invoke_result_t<F, NativePack<T>>>, W>;
+};
+
+}  // namespace Detail
+
+/**
+ * @brief Applies a kernel to each element of a range, a native pack of
+ * elements per call.
+ * @details The kernel is called with `NativePack<T>`, for T the value type
+ * of the input, on whole packs of elements and with single values on the
+ * remainder, so it must accept both, as kernels written against RealLike or
+ * ComplexLike do. Results whose lane type differs from the output's value
+ * type are converted element by element. Evaluation stops when either range
+ * is exhausted.
+ * @param f The kernel.
+ * @param in The contiguous input range.
+ * @param out The contiguous range to write the results to.
+ * @return The number of values written.
+ */
+template <typename F, ContiguousRealOrComplexRange In,
+          ContiguousRealOrComplexWritableRange Out>
+  requires std::ranges::sized_range<In> and std::ranges::sized_range<Out> and
+           Detail::PackKernel<F&, std::ranges::range_value_t<In>,
+                              std::ranges::range_value_t<Out>>
+std::size_t pack_transform(F&& f, In&& in, Out&& out) {
+  using T = std::ranges::range_value_t<In>;
+  using W = std::ranges::range_value_t<Out>;
+  using P = NativePack<T>;
+  using R = std::invoke_result_t<F&, P>;
+  using Lane = Detail::PackLane<R>;
+  constexpr auto lanes = lane_count<P>;
+
+  auto n = std::min(static_cast<std::size_t>(std::ranges::size(in)),
+                    static_cast<std::size_t>(std::ranges::size(out)));
+  auto x = std::ranges::data(in);
+  auto y = std::ranges::data(out);
+  auto i = std::size_t{0};
+  if constexpr (lanes > 1) {
+    for (; i + lanes <= n; i += lanes) {
+      auto r = std::invoke(f, Detail::pack_load<P>(x + i));
+      if constexpr (std::same_as<Lane, W>) {
+        Detail::pack_store(r, y + i);
+      } else {
+        auto staged = std::array<Lane, lanes>{};
+        Detail::pack_store(r, staged.data());
+        std::ranges::copy(staged, y + i);
+      }
+    }
+  }
+  for (; i < n; ++i) y[i] = std::invoke(f, x[i]);
+  return n;
+}
+
+}  // namespace NumericConcepts
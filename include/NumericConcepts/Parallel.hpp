@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+#include "Functions.hpp"
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+#include "Threading.hpp"
+
+/**
+ * @file Parallel.hpp
+ * @brief Defines parallel element-wise algorithms over numeric ranges.
+ * @details Random access sized ranges are split recursively into tasks of at
+ * most ParallelOptions::grain elements, which run on a work-stealing
+ * ThreadPool. Other ranges are processed sequentially on the calling thread.
+ * Functions and operations passed to these algorithms may be called
+ * concurrently from several threads.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief The default number of elements processed by each parallel task.
+ */
+inline constexpr std::size_t ParallelGrainSize = 4096;
+
+/**
+ * @brief Options for the parallel algorithms.
+ */
+struct ParallelOptions {
+  /// The maximum number of elements in each task.
+  std::size_t grain = ParallelGrainSize;
+  /// The pool to run on, null meaning ThreadPool::global().
+  ThreadPool* pool = nullptr;
+};
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Concept for a range that can be split into independent subranges.
+ */
+template <typename R>
+concept SplittableRange =
+    std::ranges::random_access_range<R> and std::ranges::sized_range<R>;
+
+inline ThreadPool& options_pool(const ParallelOptions& options) {
+  return options.pool ? *options.pool : ThreadPool::global();
+}
+
+}  // namespace Detail
+
+/**
+ * @brief Calls a function on each element of a numeric range in parallel.
+ * @details Elements are passed by reference, so f may modify the elements
+ * of a NumericWritableRange.
+ * @param range The range.
+ * @param f The function, invocable with the range's reference type.
+ * @param options The grain size and thread pool.
+ */
+template <NumericRange R, typename F>
+  requires std::invocable<F&, std::ranges::range_reference_t<R>>
+void parallel_for_each(R&& range, F f, const ParallelOptions& options = {}) {
+  if constexpr (Detail::SplittableRange<R>) {
+    using Difference = std::ranges::range_difference_t<R>;
+    auto first = std::ranges::begin(range);
+    auto n = static_cast<std::size_t>(std::ranges::size(range));
+    Detail::parallel_range(
+        Detail::options_pool(options), n, options.grain,
+        [&](std::size_t lo, std::size_t hi) {
+          for (auto i = lo; i < hi; ++i) {
+            std::invoke(f, first[static_cast<Difference>(i)]);
+          }
+        });
+  } else {
+    for (auto&& value : range) std::invoke(f, value);
+  }
+}
+
+/**
+ * @brief Applies a function to each element of a numeric range in parallel,
+ * writing the results to another range.
+ * @details Elements are transformed until either range is exhausted.
+ * @param in The input range.
+ * @param out The output range.
+ * @param f The function, returning a numeric value for each input element.
+ * @param options The grain size and thread pool.
+ * @return The number of elements written.
+ */
+template <NumericRange In, NumericWritableRange Out, typename F>
+  requires NumericFunction<F&, std::ranges::range_reference_t<In>> and
+           std::indirectly_writable<
+               std::ranges::iterator_t<Out>,
+               std::invoke_result_t<F&, std::ranges::range_reference_t<In>>>
+std::size_t parallel_transform(In&& in, Out&& out, F f,
+                               const ParallelOptions& options = {}) {
+  if constexpr (Detail::SplittableRange<In> and
+                Detail::SplittableRange<Out>) {
+    auto n = std::min(static_cast<std::size_t>(std::ranges::size(in)),
+                      static_cast<std::size_t>(std::ranges::size(out)));
+    auto ii = std::ranges::begin(in);
+    auto oi = std::ranges::begin(out);
+    Detail::parallel_range(
+        Detail::options_pool(options), n, options.grain,
+        [&](std::size_t lo, std::size_t hi) {
+          for (auto i = lo; i < hi; ++i) {
+            auto j = static_cast<std::ptrdiff_t>(i);
+            oi[j] = std::invoke(f, ii[j]);
+          }
+        });
+    return n;
+  } else {
+    auto count = std::size_t{0};
+    auto ii = std::ranges::begin(in);
+    auto oi = std::ranges::begin(out);
+    for (; ii != std::ranges::end(in) && oi != std::ranges::end(out);
+         ++ii, ++oi, ++count) {
+      *oi = std::invoke(f, *ii);
+    }
+    return count;
+  }
+}
+
+/**
+ * @brief Reduces a numeric range in parallel with an associative operation.
+ * @details The range is divided into blocks of ParallelOptions::grain
+ * elements. Each block is reduced in order, and the block results are then
+ * combined pairwise in a fixed order before being combined with init. The
+ * result therefore depends on the grain size but not on the number of
+ * threads, even for floating-point operations.
+ * @param range The range.
+ * @param init The initial value.
+ * @param op The associative binary operation.
+ * @param options The grain size and thread pool.
+ * @return The reduction of init and the elements of the range.
+ */
+template <NumericRange R, Numeric T, typename Op = std::plus<>>
+  requires std::convertible_to<std::ranges::range_value_t<R>, T> and
+           std::convertible_to<std::invoke_result_t<Op&, T, T>, T>
+T parallel_reduce(R&& range, T init, Op op = {},
+                  const ParallelOptions& options = {}) {
+  if constexpr (Detail::SplittableRange<R>) {
+    using Difference = std::ranges::range_difference_t<R>;
+    auto first = std::ranges::begin(range);
+    auto n = static_cast<std::size_t>(std::ranges::size(range));
+    auto grain = std::max<std::size_t>(options.grain, 1);
+    auto blocks = std::vector<T>((n + grain - 1) / grain);
+    Detail::parallel_range(
+        Detail::options_pool(options), blocks.size(), 1,
+        [&](std::size_t lo, std::size_t hi) {
+          for (auto b = lo; b < hi; ++b) {
+            auto start = b * grain;
+            auto stop = std::min(n, start + grain);
+            auto value = static_cast<T>(first[static_cast<Difference>(start)]);
+            for (auto i = start + 1; i < stop; ++i) {
+              value = std::invoke(
+                  op, value,
+                  static_cast<T>(first[static_cast<Difference>(i)]));
+            }
+            blocks[b] = value;
+          }
+        });
+    for (auto stride = std::size_t{1}; stride < blocks.size(); stride *= 2) {
+      for (auto i = std::size_t{0}; i + stride < blocks.size();
+           i += 2 * stride) {
+        blocks[i] = std::invoke(op, blocks[i], blocks[i + stride]);
+      }
+    }
+    return blocks.empty() ? init : std::invoke(op, init, blocks.front());
+  } else {
+    for (auto&& value : range) {
+      init = std::invoke(op, init, static_cast<T>(value));
+    }
+    return init;
+  }
+}
+
+}  // namespace NumericConcepts
@@ -0,0 +1,512 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numbers>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "Functions.hpp"
+#include "Numeric.hpp"
+#include "Threading.hpp"
+
+/**
+ * @file Quadrature.hpp
+ * @brief Defines adaptive numerical integration of real and complex
+ * functions of a real variable.
+ * @details The Gauss–Kronrod rules integrate adaptively: subintervals wait
+ * on a priority queue ordered by their error estimates, and every thread of
+ * the pool repeatedly takes the worst subinterval, bisects it and evaluates
+ * both halves. The tanh-sinh rule instead halves its step size over the
+ * whole interval, evaluating the new nodes of each level in parallel, and
+ * copes well with integrable singularities at the end points. Error
+ * estimates are of type `RemoveComplex` of the function's value type. The
+ * integrand may be called concurrently from several threads.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief Options for numerical integration.
+ */
+struct QuadratureOptions {
+  /// Absolute error tolerance.
+  double abs_tolerance = 0;
+  /// Relative error tolerance, zero meaning the square root of the machine
+  /// epsilon of the argument type.
+  double rel_tolerance = 0;
+  /// The maximum number of subintervals, or of levels for tanh-sinh up to
+  /// TanhSinh::max_levels.
+  std::size_t max_intervals = 1000;
+  /// The pool to run on, null meaning ThreadPool::global().
+  ThreadPool* pool = nullptr;
+};
+
+/**
+ * @brief The result of a numerical integration.
+ * @tparam V The real or complex value type.
+ */
+template <RealOrComplex V>
+struct QuadratureResult {
+  /// The estimate of the integral.
+  V value{0};
+  /// The estimate of the absolute error.
+  RemoveComplex<V> error{0};
+  /// The number of function evaluations.
+  std::size_t evaluations = 0;
+  /// The number of subintervals, or of levels for tanh-sinh.
+  std::size_t intervals = 0;
+  /// Whether the requested tolerance was met.
+  bool converged = false;
+};
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief The integral and error estimates of a rule on one interval.
+ */
+template <typename T, typename V>
+struct IntervalEstimate {
+  V value;
+  T error;
+};
+
+/**
+ * @internal
+ * @brief A Gauss–Kronrod rule with K non-negative Kronrod nodes, given in
+ * decreasing order and ending with zero. The Gauss weights are zero at
+ * nodes that are not Gauss nodes.
+ */
+template <std::size_t K>
+struct GaussKronrodRule {
+  static constexpr std::size_t evaluations = 2 * K - 1;
+
+  template <typename T, typename V, typename F, typename Table>
+  static IntervalEstimate<T, V> apply(const F& f, T a, T b,
+                                      const Table& table) {
+    auto& [nodes, kronrod, gauss] = table;
+    auto center = (a + b) / 2;
+    auto half = (b - a) / 2;
+
+    // The nodes in the order center - dx, center + dx for each node, then
+    // the center, evaluated in one call when f is batched.
+    auto values = std::array<V, 2 * K - 1>{};
+    if constexpr (BatchRealOrComplexFunction<const F&, T, std::span<V>>) {
+      auto x = std::array<T, 2 * K - 1>{};
+      for (auto i = std::size_t{0}; i + 1 < K; ++i) {
+        auto dx = half * static_cast<T>(nodes[i]);
+        x[2 * i] = center - dx;
+        x[2 * i + 1] = center + dx;
+      }
+      x[2 * K - 2] = center;
+      f(std::span<const T>(x), std::span<V>(values));
+    } else {
+      for (auto i = std::size_t{0}; i + 1 < K; ++i) {
+        auto dx = half * static_cast<T>(nodes[i]);
+        values[2 * i] = static_cast<V>(std::invoke(f, center - dx));
+        values[2 * i + 1] = static_cast<V>(std::invoke(f, center + dx));
+      }
+      values[2 * K - 2] = static_cast<V>(std::invoke(f, center));
+    }
+
+    auto fc = values[2 * K - 2];
+    auto result_k = fc * static_cast<T>(kronrod[K - 1]);
+    auto result_g = fc * static_cast<T>(gauss[K - 1]);
+    auto result_abs = std::abs(result_k);
+    for (auto i = std::size_t{0}; i + 1 < K; ++i) {
+      auto sum = values[2 * i] + values[2 * i + 1];
+      result_k += sum * static_cast<T>(kronrod[i]);
+      result_g += sum * static_cast<T>(gauss[i]);
+      result_abs += static_cast<T>(kronrod[i]) *
+                    (std::abs(values[2 * i]) + std::abs(values[2 * i + 1]));
+    }
+    auto mean = result_k / T{2};
+    auto result_asc = static_cast<T>(kronrod[K - 1]) * std::abs(fc - mean);
+    for (auto i = std::size_t{0}; i + 1 < K; ++i) {
+      result_asc += static_cast<T>(kronrod[i]) *
+                    (std::abs(values[2 * i] - mean) +
+                     std::abs(values[2 * i + 1] - mean));
+    }
+
+    // The error estimate of QUADPACK.
+    auto scale = std::abs(half);
+    auto error = std::abs((result_k - result_g) * half);
+    result_asc *= scale;
+    result_abs *= scale;
+    if (result_asc != 0 && error != 0) {
+      error = result_asc * std::min(T{1}, std::pow(200 * error / result_asc,
+                                                   T{1.5}));
+    }
+    constexpr auto eps = std::numeric_limits<T>::epsilon();
+    if (result_abs > std::numeric_limits<T>::min() / (50 * eps)) {
+      error = std::max(eps * 50 * result_abs, error);
+    }
+    return {result_k * half, error};
+  }
+};
+
+}  // namespace Detail
+
+/**
+ * @brief The 15-point Gauss–Kronrod rule, with the 7-point Gauss rule
+ * giving the error estimate.
+ */
+struct GaussKronrod15 : Detail::GaussKronrodRule<8> {
+  static constexpr std::array<long double, 8> nodes = {
+      0.991455371120812639206854697526329L,
+      0.949107912342758524526189684047851L,
+      0.864864423359769072789712788640926L,
+      0.741531185599394439863864773280788L,
+      0.586087235467691130294144845693013L,
+      0.405845151377397166906606412076961L,
+      0.207784955007898467600689403773245L,
+      0.0L};
+  static constexpr std::array<long double, 8> kronrod_weights = {
+      0.022935322010529224963732008058970L,
+      0.063092092629978553290700663189204L,
+      0.104790010322250183839876322541518L,
+      0.140653259715525918745189590510238L,
+      0.169004726639267902826583426598550L,
+      0.190350578064785409913256402421014L,
+      0.204432940075298892414161999234649L,
+      0.209482141084727828012999174891714L};
+  static constexpr std::array<long double, 8> gauss_weights = {
+      0.0L,
+      0.129484966168869693270611432679082L,
+      0.0L,
+      0.279705391489276667901467771423780L,
+      0.0L,
+      0.381830050505118944950369775488975L,
+      0.0L,
+      0.417959183673469387755102040816327L};
+
+  template <typename T, typename V, typename F>
+  static Detail::IntervalEstimate<T, V> estimate(const F& f, T a, T b) {
+    return apply<T, V>(f, a, b,
+                       std::tie(nodes, kronrod_weights, gauss_weights));
+  }
+};
+
+/**
+ * @brief The 21-point Gauss–Kronrod rule, with the 10-point Gauss rule
+ * giving the error estimate. This is the default rule.
+ */
+struct GaussKronrod21 : Detail::GaussKronrodRule<11> {
+  static constexpr std::array<long double, 11> nodes = {
+      0.995657163025808080735527280689003L,
+      0.973906528517171720077964012084452L,
+      0.930157491355708226001207180059508L,
+      0.865063366688984510732096688423493L,
+      0.780817726586416897063717578345042L,
+      0.679409568299024406234327365114874L,
+      0.562757134668604683339000099272694L,
+      0.433395394129247190799265943165784L,
+      0.294392862701460198131126603103866L,
+      0.148874338981631210884826001129720L,
+      0.0L};
+  static constexpr std::array<long double, 11> kronrod_weights = {
+      0.011694638867371874278064396062192L,
+      0.032558162307964727478818972459390L,
+      0.054755896574351996031381300244580L,
+      0.075039674810919952767043140916190L,
+      0.093125454583697605535065465083366L,
+      0.109387158802297641899210590325805L,
+      0.123491976262065851077208965310343L,
+      0.134709217311473325928054001771707L,
+      0.142775938577060080797094273138717L,
+      0.147739104901338491374841515972068L,
+      0.149445554002916905664936468389821L};
+  static constexpr std::array<long double, 11> gauss_weights = {
+      0.0L,
+      0.066671344308688137593568809893332L,
+      0.0L,
+      0.149451349150580593145776339657697L,
+      0.0L,
+      0.219086362515982043995534934228163L,
+      0.0L,
+      0.269266719309996355091226921569469L,
+      0.0L,
+      0.295524224714752870173892994651338L,
+      0.0L};
+
+  template <typename T, typename V, typename F>
+  static Detail::IntervalEstimate<T, V> estimate(const F& f, T a, T b) {
+    return apply<T, V>(f, a, b,
+                       std::tie(nodes, kronrod_weights, gauss_weights));
+  }
+};
+
+/**
+ * @brief The tanh-sinh (double exponential) rule.
+ * @details The nodes cluster doubly exponentially towards the end points,
+ * which are never evaluated, so integrands with integrable end point
+ * singularities converge rapidly.
+ */
+struct TanhSinh {
+  /// The maximum number of times the step size is halved.
+  static constexpr std::size_t max_levels = 12;
+};
+
+/**
+ * @brief Concept for an adaptive quadrature rule.
+ * @tparam R The rule type to check.
+ */
+template <typename R>
+concept AdaptiveQuadratureRule = requires(double (*f)(double)) {
+  { R::evaluations } -> std::convertible_to<std::size_t>;
+  R::template estimate<double, double>(f, 0.0, 1.0);
+};
+
+namespace Detail {
+
+template <typename T>
+T quadrature_tolerance(const QuadratureOptions& options, T value_abs) {
+  auto rel = options.rel_tolerance > 0
+                 ? static_cast<T>(options.rel_tolerance)
+                 : std::sqrt(std::numeric_limits<T>::epsilon());
+  return std::max(static_cast<T>(options.abs_tolerance), rel * value_abs);
+}
+
+/**
+ * @internal
+ * @brief Adaptive bisection driven by a priority queue shared by all
+ * threads of the pool.
+ */
+template <typename Rule, typename T, typename V, typename F>
+QuadratureResult<V> integrate_adaptive(const F& f, T a, T b,
+                                       const QuadratureOptions& options) {
+  struct Interval {
+    T a, b;
+    V value;
+    T error;
+    bool operator<(const Interval& other) const { return error < other.error; }
+  };
+
+  auto result = QuadratureResult<V>{};
+  auto first = Rule::template estimate<T, V>(f, a, b);
+  auto queue = std::priority_queue<Interval>{};
+  queue.push({a, b, first.value, first.error});
+  auto finished = std::vector<Interval>{};
+  auto value = first.value;
+  auto error = first.error;
+  result.evaluations = Rule::evaluations;
+  result.intervals = 1;
+
+  auto mutex = std::mutex{};
+  auto cv = std::condition_variable{};
+  auto active = std::size_t{0};
+  auto active_error = T{0};
+  auto stop = false;
+  auto max_intervals = std::max<std::size_t>(options.max_intervals, 1);
+  auto tolerance = [&]() {
+    return quadrature_tolerance(options, std::abs(value));
+  };
+  // Intervals being refined by other threads may bring the error within
+  // tolerance, so the queue is only refined while it alone exceeds it.
+  auto ready = [&]() {
+    return stop || active == 0 ||
+           (!queue.empty() && error - active_error > tolerance());
+  };
+
+  auto& pool = options.pool ? *options.pool : ThreadPool::global();
+  auto worker = [&]() {
+    auto lock = std::unique_lock(mutex);
+    while (true) {
+      // Run queued tasks, which may be the integrand's own, while waiting,
+      // and only sleep while none are queued.
+      while (!ready()) {
+        lock.unlock();
+        auto ran = pool.run_pending();
+        lock.lock();
+        if (!ran && !ready()) cv.wait(lock);
+      }
+      if (stop) return;
+      if (error <= tolerance() || result.intervals >= max_intervals ||
+          queue.empty()) {
+        stop = true;
+        cv.notify_all();
+        return;
+      }
+      auto parent = queue.top();
+      queue.pop();
+      auto mid = parent.a + (parent.b - parent.a) / 2;
+      if (!(parent.a < mid && mid < parent.b)) {
+        // The interval cannot be bisected further.
+        finished.push_back(parent);
+        continue;
+      }
+      ++active;
+      active_error += parent.error;
+      ++result.intervals;
+      lock.unlock();
+      auto left = IntervalEstimate<T, V>{};
+      auto right = IntervalEstimate<T, V>{};
+      try {
+        left = Rule::template estimate<T, V>(f, parent.a, mid);
+        right = Rule::template estimate<T, V>(f, mid, parent.b);
+      } catch (...) {
+        lock.lock();
+        stop = true;
+        cv.notify_all();
+        throw;
+      }
+      lock.lock();
+      --active;
+      active_error = active > 0 ? active_error - parent.error : T{0};
+      value += left.value + right.value - parent.value;
+      error += left.error + right.error - parent.error;
+      result.evaluations += 2 * Rule::evaluations;
+      queue.push({parent.a, mid, left.value, left.error});
+      queue.push({mid, parent.b, right.value, right.error});
+      cv.notify_all();
+    }
+  };
+
+  auto group = TaskGroup(pool);
+  for (auto t = std::size_t{1}; t < pool.concurrency(); ++t) group.run(worker);
+  group.call(worker);
+  group.wait();
+
+  // Sum the intervals afresh to remove the drift of the running totals.
+  result.value = V{0};
+  result.error = T{0};
+  for (; !queue.empty(); queue.pop()) finished.push_back(queue.top());
+  std::ranges::sort(finished, {}, &Interval::a);
+  for (auto& interval : finished) {
+    result.value += interval.value;
+    result.error += interval.error;
+  }
+  result.converged = result.error <=
+                     quadrature_tolerance(options, std::abs(result.value));
+  return result;
+}
+
+/**
+ * @internal
+ * @brief Tanh-sinh quadrature, halving the step size until successive
+ * estimates agree.
+ */
+template <typename T, typename V, typename F>
+QuadratureResult<V> integrate_tanh_sinh(const F& f, T a, T b,
+                                        const QuadratureOptions& options) {
+  constexpr auto pi_2 = std::numbers::pi_v<T> / 2;
+  // Beyond this abscissa the weights underflow.
+  auto t_max =
+      std::asinh(-std::log(std::numeric_limits<T>::min()) / 3 / pi_2);
+  auto center = (a + b) / 2;
+  auto half = (b - a) / 2;
+  auto& pool = options.pool ? *options.pool : ThreadPool::global();
+
+  // Returns the weighted sum of f at the nodes t = k h for k = first,
+  // first + stride, ... up to t_max.
+  auto level_sum = [&](T h, std::size_t first, std::size_t stride) {
+    auto count = static_cast<std::size_t>(t_max / h) / stride + 1;
+    auto sums = std::vector<V>(count, V{0});
+    parallel_range(pool, count, 16, [&](std::size_t lo, std::size_t hi) {
+      for (auto i = lo; i < hi; ++i) {
+        auto t = h * static_cast<T>(first + i * stride);
+        auto u = pi_2 * std::sinh(t);
+        auto c = std::cosh(u);
+        auto weight = pi_2 * std::cosh(t) / (c * c);
+        if (t == 0) {
+          sums[i] = weight * static_cast<V>(std::invoke(f, center));
+          continue;
+        }
+        // Distance from the end points, computed without cancellation.
+        auto delta = half * std::exp(-u) / c;
+        auto left = a + delta;
+        auto right = b - delta;
+        auto sum = V{0};
+        if (left > a) sum += static_cast<V>(std::invoke(f, left));
+        if (right < b) sum += static_cast<V>(std::invoke(f, right));
+        sums[i] = weight * sum;
+      }
+    });
+    auto total = V{0};
+    for (auto& s : sums) total += s;
+    return std::pair{total, 2 * count - (first == 0 ? 1 : 0)};
+  };
+
+  auto result = QuadratureResult<V>{};
+  auto h = T{1};
+  auto [sum, evaluations] = level_sum(h, 0, 1);
+  result.evaluations = evaluations;
+  result.value = half * h * sum;
+  result.intervals = 1;
+  auto max_levels = std::clamp<std::size_t>(options.max_intervals, 2,
+                                            TanhSinh::max_levels);
+  for (auto level = std::size_t{1}; level < max_levels; ++level) {
+    h /= 2;
+    auto [fresh, count] = level_sum(h, 1, 2);
+    sum += fresh;
+    result.evaluations += count;
+    result.intervals = level + 1;
+    auto previous = result.value;
+    result.value = half * h * sum;
+    result.error = std::abs(result.value - previous);
+    if (level >= 3 && result.error <= quadrature_tolerance(
+                                          options, std::abs(result.value))) {
+      result.converged = true;
+      break;
+    }
+  }
+  return result;
+}
+
+}  // namespace Detail
+
+/**
+ * @brief Integrates a real or complex function over a finite interval.
+ * @details The function may be called concurrently from the threads of the
+ * pool, so it must be safe to call from several threads, and may itself run
+ * work on the same pool. If f also satisfies BatchRealFunction or
+ * BatchComplexFunction, the Gauss–Kronrod rules pass it all the nodes of an
+ * interval in one call. The result reports whether the tolerance
+ * max(abs_tolerance, rel_tolerance * |value|) was met.
+ * @param f The integrand.
+ * @param a The lower limit.
+ * @param b The upper limit.
+ * @param rule The rule: GaussKronrod21 (default), GaussKronrod15 or
+ * TanhSinh.
+ * @param options The tolerances, limits and thread pool.
+ * @return The integral, error estimate and counters.
+ */
+template <std::floating_point T, typename F, typename Rule = GaussKronrod21>
+  requires RealOrComplexFunction<const F&, T> and
+           (AdaptiveQuadratureRule<Rule> or std::same_as<Rule, TanhSinh>)
+auto integrate(F f, T a, T b, Rule rule = {},
+               const QuadratureOptions& options = {}) {
+  using V = ReplacePrecision<
+      std::remove_cvref_t<std::invoke_result_t<const F&, T>>, T>;
+  static_cast<void>(rule);
+  if (a == b) {
+    auto result = QuadratureResult<V>{};
+    result.converged = true;
+    return result;
+  }
+  if (b < a) {
+    auto result = integrate(std::move(f), b, a, rule, options);
+    result.value = -result.value;
+    return result;
+  }
+  if constexpr (std::same_as<Rule, TanhSinh>) {
+    return Detail::integrate_tanh_sinh<T, V>(f, a, b, options);
+  } else {
+    return Detail::integrate_adaptive<Rule, T, V>(f, a, b, options);
+  }
+}
+
+}  // namespace NumericConcepts
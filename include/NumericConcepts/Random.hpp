@@ -0,0 +1,627 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <numbers>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+#include "Threading.hpp"
+#include "VectorMath.hpp"
+
+/**
+ * @file Random.hpp
+ * @brief Defines parallel fills of numeric ranges with random numbers from
+ * counter-based generators.
+ * @details A counter-based generator is a keyed bijection applied to a
+ * counter, so the n-th output of a stream is computed directly rather than
+ * by advancing a state n times. random_fill() derives element i from the
+ * counter holding `(offset + i) / per_block`, so the elements can be
+ * generated in any order and on any number of threads with bit-identical
+ * results, and a range filled in pieces with successive offsets matches the
+ * range filled at once.
+ *
+ * The generators are Philox4x32-10 and Threefry4x64-20 of Salmon et al.,
+ * which pass the BigCrush tests and reproduce the known-answer vectors of
+ * their Random123 implementations. Blocks of RandomLaneCount counters are
+ * evaluated with the same SSE4.2, AVX2 or AVX-512 dispatch as VectorMath.hpp,
+ * and the normal and exponential transforms use its vectorized logarithm,
+ * square root, sine and cosine. The raw bits, and hence the uniform and
+ * integer variates, are identical on every instruction set, while the other
+ * variates can differ in the last place between instruction sets.
+ *
+ * Float elements are drawn from 32-bit words with 24 random bits, and double
+ * and wider elements from 64-bit words with 53 random bits. Complex elements
+ * take two draws, for the real and imaginary parts.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief The Philox4x32-10 generator, which turns 128-bit counters into four
+ * 32-bit words with ten rounds of multiplications.
+ */
+struct Philox4x32 {};
+
+/**
+ * @brief The Threefry4x64-20 generator, which turns 256-bit counters into
+ * four 64-bit words with twenty rounds of additions, rotations and
+ * exclusive ors.
+ */
+struct Threefry4x64 {};
+
+/**
+ * @brief The uniform distribution on `[lower, upper)`.
+ */
+struct Uniform {
+  double lower = 0;
+  double upper = 1;
+};
+
+/**
+ * @brief The normal distribution, sampled by the Box-Muller transform.
+ */
+struct Normal {
+  double mean = 0;
+  double stddev = 1;
+};
+
+/**
+ * @brief The exponential distribution with the given rate.
+ */
+struct Exponential {
+  double rate = 1;
+};
+
+/**
+ * @brief The uniform distribution on the integers `[lower, upper]`.
+ * @details Each variate is the high word of the product of a 64-bit draw and
+ * the number of integers, without rejection, so that every element takes a
+ * single draw. The bias is below the number of integers divided by 2^64.
+ */
+struct UniformInteger {
+  std::int64_t lower;
+  std::int64_t upper;
+};
+
+/**
+ * @brief Uniformly random bits filling the width of an integral type.
+ */
+struct RandomBits {};
+
+/**
+ * @brief Options for random_fill().
+ */
+struct RandomOptions {
+  /// The key of the generator.
+  std::uint64_t seed = 0;
+  /// The stream, giving independent sequences for the same seed.
+  std::uint64_t stream = 0;
+  /// The index in the stream of the first draw.
+  std::uint64_t offset = 0;
+  /// The maximum number of elements in each parallel task.
+  std::size_t grain = std::size_t{1} << 16;
+  /// The widest instruction set for the generators and transforms.
+  VectorMathOptions vector_math = {};
+  /// The pool to run on, null meaning ThreadPool::global().
+  ThreadPool* pool = nullptr;
+};
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief The number of counters evaluated together by the kernels.
+ */
+inline constexpr std::size_t RandomLaneCount = 16;
+
+/**
+ * @internal
+ * @brief The number of draws transformed together.
+ */
+inline constexpr std::size_t RandomBatch = 256;
+
+using PhiloxCounter = std::array<std::uint32_t, 4>;
+using PhiloxKey = std::array<std::uint32_t, 2>;
+using ThreefryCounter = std::array<std::uint64_t, 4>;
+using ThreefryKey = std::array<std::uint64_t, 4>;
+
+inline constexpr int PhiloxRounds = 10;
+inline constexpr std::array<std::uint64_t, 2> PhiloxMultipliers = {
+    0xD2511F53, 0xCD9E8D57};
+inline constexpr std::array<std::uint32_t, 2> PhiloxWeyl = {0x9E3779B9,
+                                                            0xBB67AE85};
+
+inline constexpr int ThreefryRounds = 20;
+inline constexpr std::array<std::array<int, 2>, 8> ThreefryRotations = {{
+    {14, 16},
+    {52, 57},
+    {23, 40},
+    {5, 37},
+    {25, 33},
+    {46, 12},
+    {58, 22},
+    {32, 32},
+}};
+
+/**
+ * @internal
+ * @brief The key followed by the Skein parity word.
+ */
+inline std::array<std::uint64_t, 5> threefry_schedule(const ThreefryKey& key) {
+  return {key[0], key[1], key[2], key[3],
+          0x1BD11BDAA9FC1A22 ^ key[0] ^ key[1] ^ key[2] ^ key[3]};
+}
+
+/**
+ * @internal
+ * @brief The Philox4x32-10 bijection of a single counter.
+ */
+inline PhiloxCounter philox4x32(PhiloxCounter x, PhiloxKey key) {
+  for (auto round = 0; round < PhiloxRounds; ++round) {
+    auto p0 = PhiloxMultipliers[0] * x[0];
+    auto p1 = PhiloxMultipliers[1] * x[2];
+    x = {static_cast<std::uint32_t>(p1 >> 32) ^ x[1] ^ key[0],
+         static_cast<std::uint32_t>(p1),
+         static_cast<std::uint32_t>(p0 >> 32) ^ x[3] ^ key[1],
+         static_cast<std::uint32_t>(p0)};
+    key[0] += PhiloxWeyl[0];
+    key[1] += PhiloxWeyl[1];
+  }
+  return x;
+}
+
+/**
+ * @internal
+ * @brief The Threefry4x64-20 bijection of a single counter.
+ */
+inline ThreefryCounter threefry4x64(ThreefryCounter x,
+                                    const ThreefryKey& key) {
+  auto schedule = threefry_schedule(key);
+  auto rotate = [](std::uint64_t w, int r) {
+    return (w << r) | (w >> (64 - r));
+  };
+  for (auto w = std::size_t{0}; w < 4; ++w) x[w] += schedule[w];
+  for (auto round = 0; round < ThreefryRounds; ++round) {
+    auto& rotation = ThreefryRotations[round % 8];
+    auto a = round % 2 == 0 ? 1 : 3;
+    auto b = round % 2 == 0 ? 3 : 1;
+    x[0] += x[a];
+    x[a] = rotate(x[a], rotation[0]) ^ x[0];
+    x[2] += x[b];
+    x[b] = rotate(x[b], rotation[1]) ^ x[2];
+    if (round % 4 == 3) {
+      auto s = static_cast<std::size_t>(round / 4 + 1);
+      for (auto w = std::size_t{0}; w < 4; ++w) x[w] += schedule[(s + w) % 5];
+      x[3] += s;
+    }
+  }
+  return x;
+}
+
+}  // namespace Detail
+
+}  // namespace NumericConcepts
+
+#ifdef NUMERIC_CONCEPTS_VECTOR_MATH_DISPATCH
+
+#pragma GCC push_options
+#pragma GCC target("sse4.2")
+#define NUMERIC_CONCEPTS_VECTOR_BYTES 16
+namespace NumericConcepts::Detail::Sse42 {
+#include "RandomKernels.hpp"
+}
+#undef NUMERIC_CONCEPTS_VECTOR_BYTES
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#define NUMERIC_CONCEPTS_VECTOR_BYTES 32
+namespace NumericConcepts::Detail::Avx2 {
+#include "RandomKernels.hpp"
+}
+#undef NUMERIC_CONCEPTS_VECTOR_BYTES
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#define NUMERIC_CONCEPTS_VECTOR_BYTES 64
+namespace NumericConcepts::Detail::Avx512 {
+#include "RandomKernels.hpp"
+}
+#undef NUMERIC_CONCEPTS_VECTOR_BYTES
+#pragma GCC pop_options
+
+#endif
+
+namespace NumericConcepts {
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Traits of the generators: the number of 32-bit words in each
+ * output block, and the kernels writing RandomLaneCount consecutive blocks.
+ */
+template <typename G>
+struct RandomGeneratorTraits;
+
+template <>
+struct RandomGeneratorTraits<Philox4x32> {
+  static constexpr std::size_t words = 4;
+
+  static void blocks(std::uint64_t first, const RandomOptions& options,
+                     std::uint32_t* out) {
+    auto counter = PhiloxCounter{static_cast<std::uint32_t>(first),
+                                 static_cast<std::uint32_t>(first >> 32),
+                                 static_cast<std::uint32_t>(options.stream),
+                                 static_cast<std::uint32_t>(options.stream >>
+                                                            32)};
+    auto key = PhiloxKey{static_cast<std::uint32_t>(options.seed),
+                         static_cast<std::uint32_t>(options.seed >> 32)};
+#ifdef NUMERIC_CONCEPTS_VECTOR_MATH_DISPATCH
+    switch (vector_math_isa(options.vector_math)) {
+      case InstructionSet::Avx512:
+        return Avx512::philox_blocks(counter, key, out);
+      case InstructionSet::Avx2:
+        return Avx2::philox_blocks(counter, key, out);
+      case InstructionSet::Sse42:
+        return Sse42::philox_blocks(counter, key, out);
+      case InstructionSet::Scalar:
+        break;
+    }
+#endif
+    for (auto l = std::size_t{0}; l < RandomLaneCount; ++l) {
+      auto c = first + l;
+      counter[0] = static_cast<std::uint32_t>(c);
+      counter[1] = static_cast<std::uint32_t>(c >> 32);
+      std::ranges::copy(philox4x32(counter, key), out + words * l);
+    }
+  }
+};
+
+template <>
+struct RandomGeneratorTraits<Threefry4x64> {
+  static constexpr std::size_t words = 8;
+
+  static void blocks(std::uint64_t first, const RandomOptions& options,
+                     std::uint32_t* out) {
+    auto counter = ThreefryCounter{first, options.stream, 0, 0};
+    auto key = ThreefryKey{options.seed, 0, 0, 0};
+#ifdef NUMERIC_CONCEPTS_VECTOR_MATH_DISPATCH
+    switch (vector_math_isa(options.vector_math)) {
+      case InstructionSet::Avx512:
+        return Avx512::threefry_blocks(counter, key, out);
+      case InstructionSet::Avx2:
+        return Avx2::threefry_blocks(counter, key, out);
+      case InstructionSet::Sse42:
+        return Sse42::threefry_blocks(counter, key, out);
+      case InstructionSet::Scalar:
+        break;
+    }
+#endif
+    for (auto l = std::size_t{0}; l < RandomLaneCount; ++l) {
+      counter[0] = first + l;
+      auto x = threefry4x64(counter, key);
+      for (auto w = std::size_t{0}; w < 4; ++w) {
+        out[words * l + 2 * w] = static_cast<std::uint32_t>(x[w]);
+        out[words * l + 2 * w + 1] = static_cast<std::uint32_t>(x[w] >> 32);
+      }
+    }
+  }
+};
+
+/**
+ * @internal
+ * @brief Concept for the generator tags.
+ */
+template <typename G>
+concept RandomGenerator =
+    std::same_as<G, Philox4x32> or std::same_as<G, Threefry4x64>;
+
+/**
+ * @internal
+ * @brief Writes draws [first, first + count) of the stream as words W of 32
+ * or 64 bits, a 64-bit draw joining two consecutive 32-bit words.
+ */
+template <typename G, typename W>
+void random_words(std::uint64_t first, std::size_t count,
+                  const RandomOptions& options, W* out) {
+  using Traits = RandomGeneratorTraits<G>;
+  constexpr auto per_block = Traits::words * 4 / sizeof(W);
+  constexpr auto per_batch = per_block * RandomLaneCount;
+  auto words = std::array<std::uint32_t, Traits::words * RandomLaneCount>{};
+  auto draw = first;
+  auto end = first + count;
+  while (draw != end) {
+    auto batch = draw / per_batch;
+    Traits::blocks(batch * RandomLaneCount, options, words.data());
+    auto j = static_cast<std::size_t>(draw - batch * per_batch);
+    auto stop = static_cast<std::size_t>(
+        std::min<std::uint64_t>(end - batch * per_batch, per_batch));
+    for (; j < stop; ++j, ++out, ++draw) {
+      if constexpr (sizeof(W) == 4) {
+        *out = words[j];
+      } else {
+        *out = words[2 * j] | std::uint64_t{words[2 * j + 1]} << 32;
+      }
+    }
+  }
+}
+
+/**
+ * @internal
+ * @brief The floating-point type in which variates for T are drawn.
+ */
+template <typename T>
+using RandomPrecision =
+    std::conditional_t<Float<T> or sizeof(T) < sizeof(float), float,
+                       double>;
+
+/**
+ * @internal
+ * @brief Writes uniform variates on [0, 1) from draws [first, first +
+ * count), with count at most RandomBatch + 2.
+ */
+template <typename G, typename T>
+void random_uniforms(std::uint64_t first, std::size_t count,
+                     const RandomOptions& options, T* out) {
+  if constexpr (Float<T>) {
+    auto bits = std::array<std::uint32_t, RandomBatch + 2>{};
+    random_words<G>(first, count, options, bits.data());
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      out[i] = static_cast<float>(bits[i] >> 8) * 0x1p-24f;
+    }
+  } else {
+    auto bits = std::array<std::uint64_t, RandomBatch + 2>{};
+    random_words<G>(first, count, options, bits.data());
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      out[i] = static_cast<double>(bits[i] >> 11) * 0x1p-53;
+    }
+  }
+}
+
+/**
+ * @internal
+ * @brief Writes the variates of draws [first, first + count), with count at
+ * most RandomBatch.
+ */
+template <typename G, typename T>
+void random_values(const Uniform& d, std::uint64_t first, std::size_t count,
+                   const RandomOptions& options, T* out) {
+  random_uniforms<G>(first, count, options, out);
+  auto lower = static_cast<T>(d.lower);
+  auto width = static_cast<T>(d.upper - d.lower);
+  for (auto i = std::size_t{0}; i < count; ++i) out[i] = lower + width * out[i];
+}
+
+template <typename G, typename T>
+void random_values(const Exponential& d, std::uint64_t first,
+                   std::size_t count, const RandomOptions& options, T* out) {
+  random_uniforms<G>(first, count, options, out);
+  // 1 - u is exact and lies in (0, 1].
+  for (auto i = std::size_t{0}; i < count; ++i) out[i] = 1 - out[i];
+  auto values = std::span<T>(out, count);
+  vector_log(values, values, options.vector_math);
+  auto scale = static_cast<T>(-1 / d.rate);
+  for (auto i = std::size_t{0}; i < count; ++i) out[i] *= scale;
+}
+
+// Draws 2p and 2p + 1 form the pair giving the radius and angle of two
+// normal variates, so a batch is widened to whole pairs.
+template <typename G, typename T>
+void random_values(const Normal& d, std::uint64_t first, std::size_t count,
+                   const RandomOptions& options, T* out) {
+  constexpr auto pairs_max = RandomBatch / 2 + 1;
+  auto start = first & ~std::uint64_t{1};
+  auto pairs = static_cast<std::size_t>(first + count - start + 1) / 2;
+  auto u = std::array<T, 2 * pairs_max>{};
+  random_uniforms<G>(start, 2 * pairs, options, u.data());
+  auto radius = std::array<T, pairs_max>{};
+  auto angle = std::array<T, pairs_max>{};
+  auto cosine = std::array<T, pairs_max>{};
+  for (auto p = std::size_t{0}; p < pairs; ++p) {
+    radius[p] = 1 - u[2 * p];
+    angle[p] = 2 * std::numbers::pi_v<T> * u[2 * p + 1];
+  }
+  auto r = std::span<T>(radius.data(), pairs);
+  auto a = std::span<T>(angle.data(), pairs);
+  vector_log(r, r, options.vector_math);
+  for (auto& value : r) value *= -2;
+  vector_sqrt(r, r, options.vector_math);
+  vector_cos(a, std::span<T>(cosine.data(), pairs), options.vector_math);
+  vector_sin(a, a, options.vector_math);
+  auto mean = static_cast<T>(d.mean);
+  auto stddev = static_cast<T>(d.stddev);
+  for (auto i = std::size_t{0}; i < count; ++i) {
+    auto k = static_cast<std::size_t>(first - start) + i;
+    auto p = k / 2;
+    out[i] = mean + stddev * radius[p] * (k % 2 == 0 ? cosine[p] : angle[p]);
+  }
+}
+
+template <typename G, typename I>
+void random_values(const RandomBits&, std::uint64_t first, std::size_t count,
+                   const RandomOptions& options, I* out) {
+  using W = std::conditional_t<sizeof(I) <= 4, std::uint32_t, std::uint64_t>;
+  auto bits = std::array<W, RandomBatch>{};
+  random_words<G>(first, count, options, bits.data());
+  for (auto i = std::size_t{0}; i < count; ++i) {
+    out[i] = static_cast<I>(bits[i]);
+  }
+}
+
+/**
+ * @internal
+ * @brief The high word of the 128-bit product of a and b.
+ */
+inline std::uint64_t multiply_high(std::uint64_t a, std::uint64_t b) {
+  constexpr auto low = std::uint64_t{0xffffffff};
+  auto lo_lo = (a & low) * (b & low);
+  auto hi_lo = (a >> 32) * (b & low);
+  auto lo_hi = (a & low) * (b >> 32);
+  auto cross = (lo_lo >> 32) + (hi_lo & low) + lo_hi;
+  return (a >> 32) * (b >> 32) + (hi_lo >> 32) + (cross >> 32);
+}
+
+template <typename G, typename I>
+void random_values(const UniformInteger& d, std::uint64_t first,
+                   std::size_t count, const RandomOptions& options, I* out) {
+  auto bits = std::array<std::uint64_t, RandomBatch>{};
+  random_words<G>(first, count, options, bits.data());
+  auto lower = static_cast<std::uint64_t>(d.lower);
+  // Zero for the full range of 2^64 integers.
+  auto size = static_cast<std::uint64_t>(d.upper) - lower + 1;
+  for (auto i = std::size_t{0}; i < count; ++i) {
+    auto offset = size == 0 ? bits[i] : multiply_high(bits[i], size);
+    out[i] = static_cast<I>(static_cast<std::int64_t>(lower + offset));
+  }
+}
+
+/**
+ * @internal
+ * @brief The type in which the values of elements E are generated: E itself
+ * for integral types, and otherwise the RandomPrecision of the real type.
+ */
+template <typename E>
+struct RandomValueHelper {
+  using type = RandomPrecision<RemoveComplex<E>>;
+};
+
+template <Integral E>
+struct RandomValueHelper<E> {
+  using type = E;
+};
+
+/**
+ * @internal
+ * @brief Concept for a distribution D that can fill a range R.
+ */
+template <typename D, typename R>
+concept RandomDistribution =
+    ((std::same_as<D, Uniform> or std::same_as<D, Normal> or
+      std::same_as<D, Exponential>) and
+     (RealWritableRange<R> or ComplexWritableRange<R>)) or
+    ((std::same_as<D, UniformInteger> or std::same_as<D, RandomBits>) and
+     IntegralWritableRange<R>);
+
+/**
+ * @internal
+ * @brief Generates elements [lo, hi) of type E and passes each to write in
+ * order, as `write(i, value)`.
+ */
+template <typename G, typename E, typename D, typename Write>
+void random_elements(const D& distribution, std::size_t lo, std::size_t hi,
+                     const RandomOptions& options, Write&& write) {
+  constexpr auto draws = std::size_t{Complex<E> ? 2 : 1};
+  constexpr auto per_batch = RandomBatch / draws;
+  using T = typename RandomValueHelper<E>::type;
+  auto values = std::array<T, RandomBatch>{};
+  for (auto first = lo; first < hi; first += per_batch) {
+    auto m = std::min(per_batch, hi - first);
+    random_values<G>(distribution, options.offset + first * draws, m * draws,
+                     options, values.data());
+    for (auto j = std::size_t{0}; j < m; ++j) {
+      if constexpr (Complex<E>) {
+        using R = RemoveComplex<E>;
+        write(first + j, E{static_cast<R>(values[2 * j]),
+                           static_cast<R>(values[2 * j + 1])});
+      } else {
+        write(first + j, static_cast<E>(values[j]));
+      }
+    }
+  }
+}
+
+}  // namespace Detail
+
+/**
+ * @brief Fills a range with random numbers from a distribution.
+ * @details Element i takes draw `offset + i`, or draws `offset + 2i` and
+ * `offset + 2i + 1` for complex elements, so the result does not depend on
+ * the thread pool or grain, and a fill continuing from the previous one's
+ * last draw extends its sequence. Random access sized ranges are filled in
+ * parallel, and others in order on the calling thread. Real and complex
+ * ranges take Uniform, Normal or Exponential variates, and integral ranges
+ * take UniformInteger or RandomBits. The continuous distributions are not
+ * offered for integral ranges, since truncating their variates would give a
+ * different, discrete distribution whose rounding callers should choose.
+ * @param out The range to fill.
+ * @param distribution The distribution.
+ * @param generator The generator: Philox4x32 (default) or Threefry4x64.
+ * @param options The seed, stream, offset, grain size, instruction set and
+ * thread pool.
+ * @return The number of elements written.
+ * @throws std::invalid_argument If an Exponential rate is not positive, a
+ * Normal standard deviation is negative, or a UniformInteger interval is
+ * empty or has a bound outside the range of the element type.
+ */
+template <NumericWritableRange Out, typename Distribution,
+          typename Generator = Philox4x32>
+  requires Detail::RandomDistribution<Distribution, Out> and
+           Detail::RandomGenerator<Generator>
+std::size_t random_fill(Out&& out, Distribution distribution,
+                        Generator = {}, const RandomOptions& options = {}) {
+  using E = std::ranges::range_value_t<Out>;
+  if constexpr (std::same_as<Distribution, Exponential>) {
+    if (!(distribution.rate > 0)) {
+      throw std::invalid_argument("random_fill: rate must be positive");
+    }
+  } else if constexpr (std::same_as<Distribution, Normal>) {
+    if (!(distribution.stddev >= 0)) {
+      throw std::invalid_argument("random_fill: stddev must be non-negative");
+    }
+  } else if constexpr (std::same_as<Distribution, UniformInteger>) {
+    if (distribution.lower > distribution.upper) {
+      throw std::invalid_argument("random_fill: lower exceeds upper");
+    }
+    auto representable = [](std::int64_t value) {
+      if constexpr (std::is_signed_v<E>) {
+        return value >= std::numeric_limits<E>::min() &&
+               value <= std::numeric_limits<E>::max();
+      } else {
+        return value >= 0 && static_cast<std::uint64_t>(value) <=
+                                 std::numeric_limits<E>::max();
+      }
+    };
+    if (!representable(distribution.lower) ||
+        !representable(distribution.upper)) {
+      throw std::invalid_argument(
+          "random_fill: bounds not representable in the element type");
+    }
+  }
+  if constexpr (std::ranges::random_access_range<Out> and
+                std::ranges::sized_range<Out>) {
+    auto n = static_cast<std::size_t>(std::ranges::size(out));
+    auto oi = std::ranges::begin(out);
+    auto& pool = options.pool ? *options.pool : ThreadPool::global();
+    Detail::parallel_range(
+        pool, n, options.grain, [&](std::size_t lo, std::size_t hi) {
+          Detail::random_elements<Generator, E>(
+              distribution, lo, hi, options, [&](std::size_t i, E value) {
+                oi[static_cast<std::ptrdiff_t>(i)] = value;
+              });
+        });
+    return n;
+  } else {
+    auto n = static_cast<std::size_t>(std::ranges::distance(out));
+    auto oi = std::ranges::begin(out);
+    Detail::random_elements<Generator, E>(distribution, 0, n, options,
+                                          [&](std::size_t, E value) {
+                                            *oi = value;
+                                            ++oi;
+                                          });
+    return n;
+  }
+}
+
+}  // namespace NumericConcepts
@@ -0,0 +1,148 @@
+// No include guard: Random.hpp includes this file once for each instruction
+// set, inside a namespace and a `#pragma GCC target` region, with
+// NUMERIC_CONCEPTS_VECTOR_BYTES defined as the width of its registers.
+
+/**
+ * @file RandomKernels.hpp
+ * @internal
+ * @brief Defines the vector kernels behind Random.hpp for one instruction
+ * set.
+ * @details Each kernel evaluates RandomLaneCount consecutive counters at
+ * once. The 32-bit words of Philox are held in the low halves of 64-bit
+ * lanes, so that its widening multiplications map onto `pmuludq`.
+ */
+
+/**
+ * @internal
+ * @brief A register of 64-bit words.
+ */
+typedef std::uint64_t RandomWords
+    __attribute__((vector_size(NUMERIC_CONCEPTS_VECTOR_BYTES)));
+
+inline constexpr std::size_t random_word_lanes =
+    sizeof(RandomWords) / sizeof(std::uint64_t);
+
+inline constexpr std::size_t random_vectors =
+    RandomLaneCount / random_word_lanes;
+
+// The full products of the low 32 bits of each lane and of b.
+inline RandomWords multiply_low_words(RandomWords a, std::uint64_t b) {
+  auto m = RandomWords{} + b;
+#if NUMERIC_CONCEPTS_VECTOR_BYTES == 64
+  // Merging into a avoids _mm512_mul_epu32's undefined source register.
+  return (RandomWords)_mm512_mask_mul_epu32((__m512i)a, 0xff, (__m512i)a,
+                                            (__m512i)m);
+#elif NUMERIC_CONCEPTS_VECTOR_BYTES == 32
+  return (RandomWords)_mm256_mul_epu32((__m256i)a, (__m256i)m);
+#else
+  return (RandomWords)_mm_mul_epu32((__m128i)a, (__m128i)m);
+#endif
+}
+
+// The consecutive words first, first + 1, ... in the lanes. Copying them
+// in avoids GCC's spurious -Wmaybe-uninitialized for lane assignments.
+inline RandomWords counter_words(std::uint64_t first) {
+  std::uint64_t words[random_word_lanes];
+  for (auto l = std::size_t{0}; l < random_word_lanes; ++l) {
+    words[l] = first + l;
+  }
+  auto x = RandomWords{};
+  std::memcpy(&x, words, sizeof(x));
+  return x;
+}
+
+inline RandomWords rotate_words(RandomWords x, int r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+/**
+ * @internal
+ * @brief Writes the Philox4x32-10 outputs of RandomLaneCount counters, the
+ * first given and the others incrementing its low 64 bits.
+ */
+inline void philox_blocks(const PhiloxCounter& counter, const PhiloxKey& key,
+                          std::uint32_t* out) {
+  constexpr auto low = std::uint64_t{0xffffffff};
+  auto base = counter[0] | std::uint64_t{counter[1]} << 32;
+  RandomWords x0[random_vectors], x1[random_vectors], x2[random_vectors],
+      x3[random_vectors];
+  for (auto v = std::size_t{0}; v < random_vectors; ++v) {
+    auto c = counter_words(base + v * random_word_lanes);
+    x0[v] = c & low;
+    x1[v] = c >> 32;
+    x2[v] = RandomWords{} + counter[2];
+    x3[v] = RandomWords{} + counter[3];
+  }
+  auto k0 = key[0];
+  auto k1 = key[1];
+  for (auto round = 0; round < PhiloxRounds; ++round) {
+    for (auto v = std::size_t{0}; v < random_vectors; ++v) {
+      auto p0 = multiply_low_words(x0[v], PhiloxMultipliers[0]);
+      auto p1 = multiply_low_words(x2[v], PhiloxMultipliers[1]);
+      x0[v] = (p1 >> 32) ^ x1[v] ^ k0;
+      x1[v] = p1 & low;
+      x2[v] = (p0 >> 32) ^ x3[v] ^ k1;
+      x3[v] = p0 & low;
+    }
+    k0 += PhiloxWeyl[0];
+    k1 += PhiloxWeyl[1];
+  }
+  for (auto v = std::size_t{0}; v < random_vectors; ++v) {
+    for (auto l = std::size_t{0}; l < random_word_lanes; ++l) {
+      auto o = out + 4 * (v * random_word_lanes + l);
+      o[0] = static_cast<std::uint32_t>(x0[v][l]);
+      o[1] = static_cast<std::uint32_t>(x1[v][l]);
+      o[2] = static_cast<std::uint32_t>(x2[v][l]);
+      o[3] = static_cast<std::uint32_t>(x3[v][l]);
+    }
+  }
+}
+
+/**
+ * @internal
+ * @brief Writes the Threefry4x64-20 outputs of RandomLaneCount counters,
+ * the first given and the others incrementing its first word, as 32-bit
+ * words with the low half of each output word first.
+ */
+inline void threefry_blocks(const ThreefryCounter& counter,
+                            const ThreefryKey& key, std::uint32_t* out) {
+  auto schedule = threefry_schedule(key);
+  RandomWords x[4][random_vectors];
+  for (auto v = std::size_t{0}; v < random_vectors; ++v) {
+    x[0][v] = counter_words(counter[0] + v * random_word_lanes);
+    for (auto w = std::size_t{0}; w < 4; ++w) {
+      if (w > 0) x[w][v] = RandomWords{} + counter[w];
+      x[w][v] += schedule[w];
+    }
+  }
+  for (auto round = 0; round < ThreefryRounds; ++round) {
+    auto& rotation = ThreefryRotations[round % 8];
+    // Even rounds mix words (0, 1) and (2, 3), odd rounds (0, 3) and (2, 1).
+    auto a = round % 2 == 0 ? 1 : 3;
+    auto b = round % 2 == 0 ? 3 : 1;
+    for (auto v = std::size_t{0}; v < random_vectors; ++v) {
+      x[0][v] += x[a][v];
+      x[a][v] = rotate_words(x[a][v], rotation[0]) ^ x[0][v];
+      x[2][v] += x[b][v];
+      x[b][v] = rotate_words(x[b][v], rotation[1]) ^ x[2][v];
+    }
+    if (round % 4 == 3) {
+      auto s = static_cast<std::size_t>(round / 4 + 1);
+      for (auto v = std::size_t{0}; v < random_vectors; ++v) {
+        for (auto w = std::size_t{0}; w < 4; ++w) {
+          x[w][v] += schedule[(s + w) % 5];
+        }
+        x[3][v] += s;
+      }
+    }
+  }
+  for (auto v = std::size_t{0}; v < random_vectors; ++v) {
+    for (auto l = std::size_t{0}; l < random_word_lanes; ++l) {
+      auto o = out + 8 * (v * random_word_lanes + l);
+      for (auto w = std::size_t{0}; w < 4; ++w) {
+        o[2 * w] = static_cast<std::uint32_t>(x[w][v][l]);
+        o[2 * w + 1] = static_cast<std::uint32_t>(x[w][v][l] >> 32);
+      }
+    }
+  }
+}
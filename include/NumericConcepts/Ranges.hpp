@@ -1,5 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+
 #include "Numeric.hpp"
 
 /**
@@ -172,6 +177,195 @@ concept RealOrComplexWritableView =
 template <typename T>
 concept NumericWritableView = NumericWritableRange<T> and std::ranges::view<T>;
 
+/**
+ * @brief Concept for a range whose elements are stored contiguously in memory.
+ * @tparam T The range type to check.
+ */
+template <typename T>
+concept ContiguousRange = std::ranges::contiguous_range<T>;
+
+/**
+ * @brief Concept for a contiguous range whose value type is integral.
+ * @tparam T The range type to check.
+ */
+template <typename T>
+concept ContiguousIntegralRange = IntegralRange<T> and ContiguousRange<T>;
+
+/**
+ * @brief Concept for a contiguous range whose value type is real.
+ * @details This is satisfied by `std::vector<double>` and `std::span<float>`,
+ * but not by `std::list<double>` or `std::deque<double>`.
+ * @tparam T The range type to check.
+ */
+template <typename T>
+concept ContiguousRealRange = RealRange<T> and ContiguousRange<T>;
+
+/**
+ * @brief Concept for a contiguous range whose value type is complex.
+ * @tparam T The range type to check.
+ */
+template <typename T>
+concept ContiguousComplexRange = ComplexRange<T> and ContiguousRange<T>;
+
+/**
+ * @brief Concept for a contiguous range whose value type is real or complex.
+ * @tparam T The range type to check.
+ */
+template <typename T>
+concept ContiguousRealOrComplexRange =
+    RealOrComplexRange<T> and ContiguousRange<T>;
+
+/**
+ * @brief Concept for a contiguous range whose value type is numeric.
+ * @tparam T The range type to check.
+ */
+template <typename T>
+concept ContiguousNumericRange = NumericRange<T> and ContiguousRange<T>;
+
+/**
+ * @brief Concept for a contiguous writable range whose value type is integral.
+ * @tparam T The range type to check.
+ */
+template <typename T>
+concept ContiguousIntegralWritableRange =
+    IntegralWritableRange<T> and ContiguousRange<T>;
+
+/**
+ * @brief Concept for a contiguous writable range whose value type is real.
+ * @tparam T The range type to check.
+ */
+template <typename T>
+concept ContiguousRealWritableRange =
+    RealWritableRange<T> and ContiguousRange<T>;
+
+/**
+ * @brief Concept for a contiguous writable range whose value type is complex.
+ * @tparam T The range type to check.
+ */
+template <typename T>
+concept ContiguousComplexWritableRange =
+    ComplexWritableRange<T> and ContiguousRange<T>;
+
+/**
+ * @brief Concept for a contiguous writable range whose value type is real or
+ * complex.
+ * @tparam T The range type to check.
+ */
+template <typename T>
+concept ContiguousRealOrComplexWritableRange =
+    RealOrComplexWritableRange<T> and ContiguousRange<T>;
+
+/**
+ * @brief Concept for a contiguous writable range whose value type is numeric.
+ * @tparam T The range type to check.
+ */
+template <typename T>
+concept ContiguousNumericWritableRange =
+    NumericWritableRange<T> and ContiguousRange<T>;
+
+/**
+ * @internal
+ * @brief Helper struct giving the alignment, in bytes, that a contiguous
+ * range guarantees for its data pointer.
+ * @details By default this is the alignment of the value type. A container
+ * that over-aligns its storage can advertise this with a
+ * `static constexpr std::size_t alignment` member, or by specializing this
+ * struct.
+ * @tparam T The ContiguousRange type.
+ */
+template <ContiguousRange T>
+struct RangeAlignmentHelper
+    : public std::integral_constant<
+          std::size_t, alignof(std::ranges::range_value_t<T>)> {};
+
+/**
+ * @internal
+ * @brief Specialization of RangeAlignmentHelper for ranges with an
+ * `alignment` member.
+ * @tparam T The ContiguousRange type.
+ */
+template <ContiguousRange T>
+  requires requires() {
+    { std::remove_cvref_t<T>::alignment } -> std::convertible_to<std::size_t>;
+  }
+struct RangeAlignmentHelper<T>
+    : public std::integral_constant<std::size_t,
+                                    std::remove_cvref_t<T>::alignment> {};
+
+/**
+ * @brief The alignment, in bytes, guaranteed for the data of a contiguous
+ * range.
+ * @tparam T The ContiguousRange type.
+ */
+template <ContiguousRange T>
+inline constexpr std::size_t RangeAlignment = RangeAlignmentHelper<T>::value;
+
+/**
+ * @brief Concept for a contiguous range whose data is guaranteed at compile
+ * time to be aligned to at least N bytes.
+ * @details Standard containers only guarantee the alignment of their value
+ * type, so `AlignedRange<std::vector<double>, 64>` is false. Use
+ * `is_aligned` to test the alignment of a particular range at run time.
+ * @tparam T The range type to check.
+ * @tparam N The required alignment in bytes.
+ */
+template <typename T, std::size_t N>
+concept AlignedRange = ContiguousRange<T> and (RangeAlignment<T> >= N);
+
+/**
+ * @brief Checks at run time whether the data of a contiguous range is aligned
+ * to N bytes.
+ * @tparam N The required alignment in bytes.
+ * @tparam T The ContiguousRange type.
+ * @param range The range to check.
+ * @return True if the data pointer of the range is a multiple of N.
+ */
+template <std::size_t N, ContiguousRange T>
+bool is_aligned(T&& range) {
+  if constexpr (AlignedRange<T, N>) {
+    return true;
+  } else {
+    auto address = reinterpret_cast<std::uintptr_t>(std::ranges::data(range));
+    return address % N == 0;
+  }
+}
+
+/**
+ * @brief Concept for a complex range stored in split (structure of arrays)
+ * layout.
+ * @details The range must be sized and provide `real_data()` and
+ * `imag_data()` members returning pointers to contiguous arrays holding the
+ * real and imaginary parts of its elements.
+ * @tparam T The range type to check.
+ */
+template <typename T>
+concept SplitComplexRange = requires(T& range) {
+  requires ComplexRange<T>;
+  requires std::ranges::sized_range<T>;
+  {
+    range.real_data()
+  } -> std::convertible_to<const RemoveComplex<std::ranges::range_value_t<T>>*>;
+  {
+    range.imag_data()
+  } -> std::convertible_to<const RemoveComplex<std::ranges::range_value_t<T>>*>;
+};
+
+/**
+ * @brief Concept for a writable complex range stored in split layout.
+ * @tparam T The range type to check.
+ */
+template <typename T>
+concept SplitComplexWritableRange = requires(T& range) {
+  requires SplitComplexRange<T>;
+  requires ComplexWritableRange<T>;
+  {
+    range.real_data()
+  } -> std::same_as<RemoveComplex<std::ranges::range_value_t<T>>*>;
+  {
+    range.imag_data()
+  } -> std::same_as<RemoveComplex<std::ranges::range_value_t<T>>*>;
+};
+
 /**
  * @brief Concept to check if a list of ranges have the same value type.
  * @tparam T The first range type to compare.
@@ -192,6 +386,19 @@ concept SameRangeValueType = requires() {
 template <RealOrComplexRange T>
 using RangePrecision = RemoveComplex<std::ranges::range_value_t<T>>;
 
+/**
+ * @brief Type alias for the type to which the value types of a list of real
+ * or complex ranges promote.
+ * @details For example, this is `std::complex<double>` for a
+ * `std::vector<float>` and a `std::vector<std::complex<double>>`.
+ * @tparam T The first RealOrComplexRange type.
+ * @tparam Ts The other RealOrComplexRange types.
+ */
+template <RealOrComplexRange T, RealOrComplexRange... Ts>
+using RangePromotePrecision =
+    PromotePrecision<std::ranges::range_value_t<T>,
+                     std::ranges::range_value_t<Ts>...>;
+
 /**
  * @brief Concept to check if a list of real or complex ranges are the exact
  * same type.
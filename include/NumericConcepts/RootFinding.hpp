@@ -0,0 +1,732 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+#include "Functions.hpp"
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+#include "Threading.hpp"
+
+/**
+ * @file RootFinding.hpp
+ * @brief Defines bracketing root finders that solve many independent
+ * equations at once.
+ * @details find_roots() solves `f(x, p) = 0` for each parameter p of a range
+ * within the corresponding bracket. Rather than running a scalar solver per
+ * equation, blocks of RootLaneCount equations advance in lock step: each
+ * iteration computes the next iterate of every active lane with branch-free
+ * selects, evaluates the function over the lanes in a single loop, and then
+ * retires the lanes that converged by moving the last active lane into their
+ * slot, so the active lanes always stay contiguous. Blocks are distributed
+ * over a ThreadPool. The function may be called concurrently from several
+ * threads.
+ *
+ * The methods are Brent's method (Brent), the interpolate-truncate-project
+ * method of Oliveira and Takahashi (Itp), and Newton's method safeguarded by
+ * bisection (Newton), which also takes the derivative.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief The number of equations solved together by each block.
+ */
+inline constexpr std::size_t RootLaneCount = 64;
+
+/**
+ * @brief Options for the root finders.
+ */
+struct RootFindingOptions {
+  /// Absolute tolerance on the root.
+  double abs_tolerance = 0;
+  /// Relative tolerance on the root, zero meaning twice the machine epsilon
+  /// of the argument type.
+  double rel_tolerance = 0;
+  /// The maximum number of iterations for each equation.
+  std::size_t max_iterations = 100;
+  /// The maximum number of equations in each parallel task.
+  std::size_t grain = 1024;
+  /// The pool to run on, null meaning ThreadPool::global().
+  ThreadPool* pool = nullptr;
+};
+
+/**
+ * @brief Summary of a call to find_roots().
+ */
+struct RootFindingResult {
+  /// The number of roots written.
+  std::size_t roots = 0;
+  /// The number of roots located to the tolerance.
+  std::size_t converged = 0;
+  /// The number of brackets whose end points have values of the same sign,
+  /// for which NaN is written.
+  std::size_t unbracketed = 0;
+  /// The number of evaluations of the function and of any derivative.
+  std::size_t evaluations = 0;
+};
+
+/**
+ * @brief Brent's method, combining inverse quadratic interpolation, the
+ * secant method and bisection.
+ */
+struct Brent {};
+
+/**
+ * @brief The interpolate-truncate-project method, which needs at most one
+ * iteration more than bisection while converging superlinearly on smooth
+ * functions.
+ * @details The parameters are those recommended by Oliveira and Takahashi:
+ * `k1 = 0.2 / (b - a)`, `k2 = 2` and `n0 = 1`.
+ */
+struct Itp {};
+
+/**
+ * @brief Newton's method, falling back to bisection whenever a step would
+ * leave the bracket or would not halve the previous step.
+ * @tparam D The type of the derivative, called as `derivative(x, p)`.
+ */
+template <typename D>
+struct Newton {
+  /// The derivative of the function with respect to x.
+  D derivative;
+};
+
+template <typename D>
+Newton(D) -> Newton<D>;
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Trait recognising the Newton method tags.
+ */
+template <typename M>
+struct IsNewtonMethod : std::false_type {};
+
+template <typename D>
+struct IsNewtonMethod<Newton<D>> : std::true_type {};
+
+/**
+ * @internal
+ * @brief Concept for a root finding method applicable to a function F of an
+ * argument T and a parameter P.
+ */
+template <typename M, typename F, typename T, typename P>
+concept RootFindingMethod =
+    RealFunction<const F&, T, const P&> and
+    (std::same_as<M, Brent> or std::same_as<M, Itp> or
+     (IsNewtonMethod<M>::value and
+      RealFunction<const decltype(M::derivative)&, T, const P&>));
+
+/**
+ * @internal
+ * @brief The tolerance on a root near x.
+ */
+template <typename T>
+struct RootTolerance {
+  T rel;
+  T half_abs;
+
+  explicit RootTolerance(const RootFindingOptions& options)
+      : rel{options.rel_tolerance > 0
+                ? static_cast<T>(options.rel_tolerance)
+                : 2 * std::numeric_limits<T>::epsilon()},
+        half_abs{static_cast<T>(options.abs_tolerance) / 2} {}
+
+  T operator()(T x) const {
+    return std::max(rel * std::abs(x) + half_abs,
+                    std::numeric_limits<T>::min());
+  }
+};
+
+/**
+ * @internal
+ * @brief Counters accumulated by a block of lanes.
+ */
+struct RootCounters {
+  std::size_t converged = 0;
+  std::size_t unbracketed = 0;
+  std::size_t evaluations = 0;
+};
+
+/**
+ * @internal
+ * @brief The state shared by the lanes of all methods: the bracket, its
+ * function values, each lane's parameter and the index of its equation.
+ */
+template <typename T, typename P>
+struct RootLanes {
+  std::array<T, RootLaneCount> a;
+  std::array<T, RootLaneCount> b;
+  std::array<T, RootLaneCount> fa;
+  std::array<T, RootLaneCount> fb;
+  std::array<P, RootLaneCount> param;
+  std::array<std::size_t, RootLaneCount> index;
+  std::array<bool, RootLaneCount> done;
+
+  void copy_lane(std::size_t to, std::size_t from) {
+    a[to] = a[from];
+    b[to] = b[from];
+    fa[to] = fa[from];
+    fb[to] = fb[from];
+    param[to] = param[from];
+    index[to] = index[from];
+    done[to] = done[from];
+  }
+};
+
+/**
+ * @internal
+ * @brief Calls retire(k) for each of the first m lanes that is done and
+ * fills its slot with the last active lane.
+ * @return The number of active lanes left.
+ */
+template <typename Lanes, typename Retire>
+std::size_t retire_lanes(Lanes& lanes, std::size_t m, Retire&& retire) {
+  auto k = std::size_t{0};
+  while (k < m) {
+    if (lanes.done[k]) {
+      retire(k);
+      if (k != --m) lanes.copy_lane(k, m);
+    } else {
+      ++k;
+    }
+  }
+  return m;
+}
+
+/**
+ * @internal
+ * @brief Evaluates the function at the end points of the first m lanes'
+ * brackets and retires the lanes with a root at an end point or without a
+ * sign change.
+ * @return The number of active lanes left.
+ */
+template <typename T, typename P, typename Lanes, typename F, typename Write>
+std::size_t start_lanes(Lanes& lanes, std::size_t m, const F& f,
+                        Write& write, RootCounters& counters) {
+  for (auto k = std::size_t{0}; k < m; ++k) {
+    lanes.fa[k] = static_cast<T>(std::invoke(f, lanes.a[k], lanes.param[k]));
+  }
+  for (auto k = std::size_t{0}; k < m; ++k) {
+    lanes.fb[k] = static_cast<T>(std::invoke(f, lanes.b[k], lanes.param[k]));
+  }
+  counters.evaluations += 2 * m;
+  for (auto k = std::size_t{0}; k < m; ++k) {
+    auto fa = lanes.fa[k], fb = lanes.fb[k];
+    // Compare signs rather than the sign of fa * fb, which can underflow.
+    lanes.done[k] =
+        fa == 0 || fb == 0 || !((fa < 0 && fb > 0) || (fa > 0 && fb < 0));
+  }
+  return retire_lanes(lanes, m, [&](std::size_t k) {
+    if (lanes.fa[k] == 0 || lanes.fb[k] == 0) {
+      write(lanes.index[k], lanes.fa[k] == 0 ? lanes.a[k] : lanes.b[k]);
+      ++counters.converged;
+    } else {
+      write(lanes.index[k], std::numeric_limits<T>::quiet_NaN());
+      ++counters.unbracketed;
+    }
+  });
+}
+
+/**
+ * @internal
+ * @brief The lanes of Brent's method, with c the previous iterate, d the
+ * latest step and e the step before it.
+ */
+template <typename T, typename P>
+struct BrentLanes : RootLanes<T, P> {
+  std::array<T, RootLaneCount> c;
+  std::array<T, RootLaneCount> fc;
+  std::array<T, RootLaneCount> d;
+  std::array<T, RootLaneCount> e;
+
+  void copy_lane(std::size_t to, std::size_t from) {
+    RootLanes<T, P>::copy_lane(to, from);
+    c[to] = c[from];
+    fc[to] = fc[from];
+    d[to] = d[from];
+    e[to] = e[from];
+  }
+};
+
+/**
+ * @internal
+ * @brief Solves the first m lanes with Brent's method, following the
+ * zeroin algorithm with each branch replaced by a select.
+ */
+template <typename T, typename P, typename F, typename Write>
+void solve_lanes(const Brent&, BrentLanes<T, P>& lanes, std::size_t m,
+                 const F& f, Write& write, const RootFindingOptions& options,
+                 RootCounters& counters) {
+  auto tolerance = RootTolerance<T>(options);
+  m = start_lanes<T, P>(lanes, m, f, write, counters);
+  for (auto k = std::size_t{0}; k < m; ++k) {
+    lanes.c[k] = lanes.b[k];
+    lanes.fc[k] = lanes.fb[k];
+    lanes.d[k] = lanes.e[k] = lanes.b[k] - lanes.a[k];
+  }
+
+  for (auto iteration = std::size_t{0};
+       m > 0 && iteration < options.max_iterations; ++iteration) {
+    for (auto k = std::size_t{0}; k < m; ++k) {
+      auto a = lanes.a[k], b = lanes.b[k], c = lanes.c[k];
+      auto fa = lanes.fa[k], fb = lanes.fb[k], fc = lanes.fc[k];
+      auto d = lanes.d[k], e = lanes.e[k];
+
+      // Keep the root between b and c.
+      auto same = (fb > 0) == (fc > 0);
+      c = same ? a : c;
+      fc = same ? fa : fc;
+      d = same ? b - a : d;
+      e = same ? b - a : e;
+
+      // Make b the best estimate.
+      auto swap = std::abs(fc) < std::abs(fb);
+      a = swap ? b : a;
+      fa = swap ? fb : fa;
+      b = swap ? c : b;
+      fb = swap ? fc : fb;
+      c = swap ? a : c;
+      fc = swap ? fa : fc;
+
+      auto tol = tolerance(b);
+      auto xm = (c - b) / 2;
+      auto done = std::abs(xm) <= tol || fb == 0;
+
+      // Inverse quadratic interpolation, or the secant method if a == c.
+      auto s = fb / fa;
+      auto secant = a == c;
+      auto q0 = fa / fc;
+      auto r = fb / fc;
+      auto p = secant ? 2 * xm * s
+                      : s * (2 * xm * q0 * (q0 - r) - (b - a) * (r - 1));
+      auto q = secant ? 1 - s : (q0 - 1) * (r - 1) * (s - 1);
+      q = p > 0 ? -q : q;
+      p = std::abs(p);
+      auto interpolate =
+          std::abs(e) >= tol && std::abs(fa) > std::abs(fb) &&
+          2 * p < std::min(3 * xm * q - std::abs(tol * q), std::abs(e * q));
+      e = interpolate ? d : xm;
+      d = interpolate ? p / q : xm;
+
+      lanes.a[k] = b;
+      lanes.fa[k] = fb;
+      lanes.b[k] =
+          done ? b : b + (std::abs(d) > tol ? d : std::copysign(tol, xm));
+      lanes.fb[k] = fb;
+      lanes.c[k] = c;
+      lanes.fc[k] = fc;
+      lanes.d[k] = d;
+      lanes.e[k] = e;
+      lanes.done[k] = done;
+    }
+    m = retire_lanes(lanes, m, [&](std::size_t k) {
+      write(lanes.index[k], lanes.b[k]);
+      ++counters.converged;
+    });
+    for (auto k = std::size_t{0}; k < m; ++k) {
+      lanes.fb[k] = static_cast<T>(std::invoke(f, lanes.b[k], lanes.param[k]));
+    }
+    counters.evaluations += m;
+  }
+  for (auto k = std::size_t{0}; k < m; ++k) write(lanes.index[k], lanes.b[k]);
+}
+
+/**
+ * @internal
+ * @brief The lanes of the ITP method, with x the latest iterate, fx its
+ * value, k1 the truncation scale, w0 the initial bracket width and j the
+ * iteration count of the projection.
+ */
+template <typename T, typename P>
+struct ItpLanes : RootLanes<T, P> {
+  std::array<T, RootLaneCount> x;
+  std::array<T, RootLaneCount> fx;
+  std::array<T, RootLaneCount> k1;
+  std::array<T, RootLaneCount> w0;
+  std::array<int, RootLaneCount> j;
+
+  void copy_lane(std::size_t to, std::size_t from) {
+    RootLanes<T, P>::copy_lane(to, from);
+    x[to] = x[from];
+    fx[to] = fx[from];
+    k1[to] = k1[from];
+    w0[to] = w0[from];
+    j[to] = j[from];
+  }
+};
+
+/**
+ * @internal
+ * @brief Solves the first m lanes with the ITP method.
+ */
+template <typename T, typename P, typename F, typename Write>
+void solve_lanes(const Itp&, ItpLanes<T, P>& lanes, std::size_t m,
+                 const F& f, Write& write, const RootFindingOptions& options,
+                 RootCounters& counters) {
+  auto tolerance = RootTolerance<T>(options);
+  m = start_lanes<T, P>(lanes, m, f, write, counters);
+  for (auto k = std::size_t{0}; k < m; ++k) {
+    if (lanes.b[k] < lanes.a[k]) {
+      std::swap(lanes.a[k], lanes.b[k]);
+      std::swap(lanes.fa[k], lanes.fb[k]);
+    }
+    lanes.w0[k] = lanes.b[k] - lanes.a[k];
+    lanes.k1[k] = T{0.2} / lanes.w0[k];
+    lanes.j[k] = 0;
+  }
+
+  for (auto iteration = std::size_t{0};
+       m > 0 && iteration < options.max_iterations; ++iteration) {
+    for (auto k = std::size_t{0}; k < m; ++k) {
+      auto a = lanes.a[k], b = lanes.b[k];
+      auto fa = lanes.fa[k], fb = lanes.fb[k];
+
+      // Replace the end point whose value has the sign of f(x).
+      if (iteration > 0) {
+        auto x = lanes.x[k], fx = lanes.fx[k];
+        auto zero = fx == 0;
+        auto to_a = (fx > 0) == (fa > 0) || zero;
+        auto to_b = (fx > 0) == (fb > 0) || zero;
+        a = to_a ? x : a;
+        fa = to_a ? fx : fa;
+        b = to_b ? x : b;
+        fb = to_b ? fx : fb;
+      }
+
+      auto half = (a + b) / 2;
+      auto width = b - a;
+      auto done = width / 2 <= tolerance(half);
+
+      // Interpolate with regula falsi, truncate towards the midpoint and
+      // project into the minmax interval. The radius keeps the next bracket
+      // no wider than w0 / 2^j, one halving behind bisection (n0 = 1),
+      // whatever the tolerance at the current midpoint.
+      auto r = std::ldexp(lanes.w0[k] / 2, 1 - lanes.j[k]) - width / 2;
+      auto delta = lanes.k1[k] * width * width;
+      auto xf = (fb * a - fa * b) / (fb - fa);
+      auto sigma = std::copysign(T{1}, half - xf);
+      auto xt = delta <= std::abs(half - xf) ? xf + sigma * delta : half;
+      auto x = std::abs(xt - half) <= r ? xt : half - sigma * r;
+
+      lanes.a[k] = a;
+      lanes.b[k] = b;
+      lanes.fa[k] = fa;
+      lanes.fb[k] = fb;
+      lanes.x[k] = done ? half : x;
+      lanes.j[k] += 1;
+      lanes.done[k] = done;
+    }
+    m = retire_lanes(lanes, m, [&](std::size_t k) {
+      write(lanes.index[k], lanes.x[k]);
+      ++counters.converged;
+    });
+    for (auto k = std::size_t{0}; k < m; ++k) {
+      lanes.fx[k] = static_cast<T>(std::invoke(f, lanes.x[k], lanes.param[k]));
+    }
+    counters.evaluations += m;
+  }
+  for (auto k = std::size_t{0}; k < m; ++k) write(lanes.index[k], lanes.x[k]);
+}
+
+/**
+ * @internal
+ * @brief The lanes of Newton's method, with a the end point at which f is
+ * negative, x the iterate, fx and dfx the values of f and its derivative,
+ * and dx and dx_old the last two steps.
+ */
+template <typename T, typename P>
+struct NewtonLanes : RootLanes<T, P> {
+  std::array<T, RootLaneCount> x;
+  std::array<T, RootLaneCount> fx;
+  std::array<T, RootLaneCount> dfx;
+  std::array<T, RootLaneCount> dx;
+  std::array<T, RootLaneCount> dx_old;
+
+  void copy_lane(std::size_t to, std::size_t from) {
+    RootLanes<T, P>::copy_lane(to, from);
+    x[to] = x[from];
+    fx[to] = fx[from];
+    dfx[to] = dfx[from];
+    dx[to] = dx[from];
+    dx_old[to] = dx_old[from];
+  }
+};
+
+/**
+ * @internal
+ * @brief Evaluates the function and its derivative at the iterates of the
+ * first m lanes.
+ */
+template <typename T, typename P, typename F, typename D>
+void evaluate_newton_lanes(NewtonLanes<T, P>& lanes, std::size_t m,
+                           const F& f, const D& df, RootCounters& counters) {
+  for (auto k = std::size_t{0}; k < m; ++k) {
+    lanes.fx[k] = static_cast<T>(std::invoke(f, lanes.x[k], lanes.param[k]));
+  }
+  for (auto k = std::size_t{0}; k < m; ++k) {
+    lanes.dfx[k] =
+        static_cast<T>(std::invoke(df, lanes.x[k], lanes.param[k]));
+  }
+  counters.evaluations += 2 * m;
+}
+
+/**
+ * @internal
+ * @brief Solves the first m lanes with Newton's method safeguarded by
+ * bisection, following the rtsafe algorithm with each branch replaced by a
+ * select.
+ */
+template <typename T, typename P, typename D, typename F, typename Write>
+void solve_lanes(const Newton<D>& method, NewtonLanes<T, P>& lanes,
+                 std::size_t m, const F& f, Write& write,
+                 const RootFindingOptions& options, RootCounters& counters) {
+  auto tolerance = RootTolerance<T>(options);
+  m = start_lanes<T, P>(lanes, m, f, write, counters);
+  for (auto k = std::size_t{0}; k < m; ++k) {
+    if (lanes.fa[k] > 0) std::swap(lanes.a[k], lanes.b[k]);
+    lanes.x[k] = (lanes.a[k] + lanes.b[k]) / 2;
+    lanes.dx[k] = lanes.dx_old[k] = std::abs(lanes.b[k] - lanes.a[k]);
+  }
+  evaluate_newton_lanes(lanes, m, f, method.derivative, counters);
+
+  for (auto iteration = std::size_t{0};
+       m > 0 && iteration < options.max_iterations; ++iteration) {
+    for (auto k = std::size_t{0}; k < m; ++k) {
+      auto x = lanes.x[k], fx = lanes.fx[k], dfx = lanes.dfx[k];
+
+      // Shrink the bracket to the side of x holding the root.
+      auto lo = fx < 0 ? x : lanes.a[k];
+      auto hi = fx < 0 ? lanes.b[k] : x;
+
+      auto newton = ((x - hi) * dfx - fx) * ((x - lo) * dfx - fx) <= 0 &&
+                    std::abs(2 * fx) <= std::abs(lanes.dx_old[k] * dfx);
+      auto dx = newton ? fx / dfx : (hi - lo) / 2;
+      auto next = newton ? x - dx : lo + dx;
+      auto done = fx == 0 || std::abs(dx) <= tolerance(next);
+
+      lanes.a[k] = lo;
+      lanes.b[k] = hi;
+      lanes.dx_old[k] = lanes.dx[k];
+      lanes.dx[k] = dx;
+      lanes.x[k] = fx == 0 ? x : next;
+      lanes.done[k] = done;
+    }
+    m = retire_lanes(lanes, m, [&](std::size_t k) {
+      write(lanes.index[k], lanes.x[k]);
+      ++counters.converged;
+    });
+    evaluate_newton_lanes(lanes, m, f, method.derivative, counters);
+  }
+  for (auto k = std::size_t{0}; k < m; ++k) write(lanes.index[k], lanes.x[k]);
+}
+
+/**
+ * @internal
+ * @brief The lane state used by a method.
+ */
+template <typename M, typename T, typename P>
+struct RootLanesHelper {
+  using type = BrentLanes<T, P>;
+};
+
+template <typename T, typename P>
+struct RootLanesHelper<Itp, T, P> {
+  using type = ItpLanes<T, P>;
+};
+
+template <typename D, typename T, typename P>
+struct RootLanesHelper<Newton<D>, T, P> {
+  using type = NewtonLanes<T, P>;
+};
+
+/**
+ * @internal
+ * @brief Solves equations [0, n), reading the parameters and brackets and
+ * writing the roots through index-based accessors.
+ */
+template <typename T, typename M, typename F, typename Param, typename Lower,
+          typename Upper, typename Write>
+RootFindingResult solve_roots(const M& method, const F& f, std::size_t n,
+                              Param&& param, Lower&& lower, Upper&& upper,
+                              Write&& write,
+                              const RootFindingOptions& options) {
+  using P = std::remove_cvref_t<decltype(param(std::size_t{0}))>;
+  using Lanes = typename RootLanesHelper<M, T, P>::type;
+
+  auto converged = std::atomic<std::size_t>{0};
+  auto unbracketed = std::atomic<std::size_t>{0};
+  auto evaluations = std::atomic<std::size_t>{0};
+  auto& pool = options.pool ? *options.pool : ThreadPool::global();
+  parallel_range(pool, n, options.grain, [&](std::size_t lo, std::size_t hi) {
+    auto counters = RootCounters{};
+    auto lanes = Lanes{};
+    for (auto first = lo; first < hi; first += RootLaneCount) {
+      auto m = std::min(RootLaneCount, hi - first);
+      for (auto k = std::size_t{0}; k < m; ++k) {
+        lanes.index[k] = first + k;
+        lanes.param[k] = param(first + k);
+        lanes.a[k] = static_cast<T>(lower(first + k));
+        lanes.b[k] = static_cast<T>(upper(first + k));
+      }
+      solve_lanes(method, lanes, m, f, write, options, counters);
+    }
+    converged += counters.converged;
+    unbracketed += counters.unbracketed;
+    evaluations += counters.evaluations;
+  });
+  return {.roots = n,
+          .converged = converged.load(),
+          .unbracketed = unbracketed.load(),
+          .evaluations = evaluations.load()};
+}
+
+/**
+ * @internal
+ * @brief Concept for the ranges find_roots() reads and writes by index.
+ */
+template <typename R>
+concept RootIndexedRange =
+    std::ranges::random_access_range<R> and std::ranges::sized_range<R>;
+
+}  // namespace Detail
+
+/**
+ * @brief Finds a root of `f(x, p)` for each parameter p within the
+ * corresponding bracket.
+ * @details Each bracket must have end points at which f takes values of
+ * opposite signs, or a root at an end point. A root is accepted once it is
+ * known to within `rel_tolerance * |x| + abs_tolerance / 2`. Equations that
+ * reach the iteration limit receive their latest estimate, and brackets
+ * without a sign change receive NaN. The number of equations is the length
+ * of the shortest range. Random access sized ranges are read and written in
+ * place, and others are copied to and from vectors.
+ * @param f The function, called as `f(x, p)`, possibly concurrently.
+ * @param params The parameters, one per equation.
+ * @param lower The lower end points of the brackets.
+ * @param upper The upper end points of the brackets.
+ * @param out The range to write the roots to.
+ * @param method The method: Brent (default), Itp, or Newton with the
+ * derivative.
+ * @param options The tolerances, iteration limit, grain size and thread
+ * pool.
+ * @return The numbers of roots written, converged and unbracketed, and of
+ * evaluations.
+ */
+template <typename F, NumericRange Params, RealRange Lower, RealRange Upper,
+          RealWritableRange Out, typename Method = Brent>
+  requires std::floating_point<RangePromotePrecision<Lower, Upper>> and
+           Detail::RootFindingMethod<
+               Method, F, RangePromotePrecision<Lower, Upper>,
+               std::ranges::range_value_t<Params>>
+RootFindingResult find_roots(const F& f, Params&& params, Lower&& lower,
+                             Upper&& upper, Out&& out, Method method = {},
+                             const RootFindingOptions& options = {}) {
+  using T = RangePromotePrecision<Lower, Upper>;
+  using P = std::ranges::range_value_t<Params>;
+  using W = std::ranges::range_value_t<Out>;
+  if constexpr (Detail::RootIndexedRange<Params> and
+                Detail::RootIndexedRange<Lower> and
+                Detail::RootIndexedRange<Upper> and
+                Detail::RootIndexedRange<Out>) {
+    auto n = std::min({static_cast<std::size_t>(std::ranges::size(params)),
+                       static_cast<std::size_t>(std::ranges::size(lower)),
+                       static_cast<std::size_t>(std::ranges::size(upper)),
+                       static_cast<std::size_t>(std::ranges::size(out))});
+    auto pi = std::ranges::begin(params);
+    auto li = std::ranges::begin(lower);
+    auto ui = std::ranges::begin(upper);
+    auto oi = std::ranges::begin(out);
+    using Difference = std::ptrdiff_t;
+    return Detail::solve_roots<T>(
+        method, f, n,
+        [&](std::size_t i) -> P { return pi[static_cast<Difference>(i)]; },
+        [&](std::size_t i) { return li[static_cast<Difference>(i)]; },
+        [&](std::size_t i) { return ui[static_cast<Difference>(i)]; },
+        [&](std::size_t i, T x) {
+          oi[static_cast<Difference>(i)] = static_cast<W>(x);
+        },
+        options);
+  } else {
+    auto p = std::vector<P>();
+    auto lo = std::vector<T>();
+    auto hi = std::vector<T>();
+    for (auto&& value : params) p.push_back(value);
+    for (auto&& value : lower) lo.push_back(static_cast<T>(value));
+    for (auto&& value : upper) hi.push_back(static_cast<T>(value));
+    auto roots = std::vector<T>(std::min({p.size(), lo.size(), hi.size()}));
+    auto result = find_roots(f, p, lo, hi, roots, method, options);
+    auto count = std::size_t{0};
+    auto oi = std::ranges::begin(out);
+    for (; count < roots.size() && oi != std::ranges::end(out);
+         ++count, ++oi) {
+      *oi = static_cast<W>(roots[count]);
+    }
+    result.roots = count;
+    return result;
+  }
+}
+
+/**
+ * @brief Finds a root of `f(x, p)` for each parameter p within a common
+ * bracket.
+ * @details As the overload taking ranges of end points.
+ * @param f The function, called as `f(x, p)`, possibly concurrently.
+ * @param params The parameters, one per equation.
+ * @param lower The lower end point of the brackets.
+ * @param upper The upper end point of the brackets.
+ * @param out The range to write the roots to.
+ * @param method The method: Brent (default), Itp, or Newton with the
+ * derivative.
+ * @param options The tolerances, iteration limit, grain size and thread
+ * pool.
+ * @return The numbers of roots written, converged and unbracketed, and of
+ * evaluations.
+ */
+template <typename F, NumericRange Params, std::floating_point T,
+          RealWritableRange Out, typename Method = Brent>
+  requires Detail::RootFindingMethod<Method, F, T,
+                                     std::ranges::range_value_t<Params>>
+RootFindingResult find_roots(const F& f, Params&& params, T lower, T upper,
+                             Out&& out, Method method = {},
+                             const RootFindingOptions& options = {}) {
+  using P = std::ranges::range_value_t<Params>;
+  using W = std::ranges::range_value_t<Out>;
+  if constexpr (Detail::RootIndexedRange<Params> and
+                Detail::RootIndexedRange<Out>) {
+    auto n = std::min(static_cast<std::size_t>(std::ranges::size(params)),
+                      static_cast<std::size_t>(std::ranges::size(out)));
+    auto pi = std::ranges::begin(params);
+    auto oi = std::ranges::begin(out);
+    using Difference = std::ptrdiff_t;
+    return Detail::solve_roots<T>(
+        method, f, n,
+        [&](std::size_t i) -> P { return pi[static_cast<Difference>(i)]; },
+        [&](std::size_t) { return lower; },
+        [&](std::size_t) { return upper; },
+        [&](std::size_t i, T x) {
+          oi[static_cast<Difference>(i)] = static_cast<W>(x);
+        },
+        options);
+  } else {
+    auto p = std::vector<P>();
+    for (auto&& value : params) p.push_back(value);
+    auto lo = std::vector<T>(p.size(), lower);
+    auto hi = std::vector<T>(p.size(), upper);
+    return find_roots(f, p, lo, hi, out, method, options);
+  }
+}
+
+}  // namespace NumericConcepts
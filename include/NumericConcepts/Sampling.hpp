@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "Functions.hpp"
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+
+/**
+ * @file Sampling.hpp
+ * @brief Defines an adaptor that lifts scalar functions to batched form, and
+ * an evaluator that samples a function on a grid of points.
+ * @details Functions satisfying BatchRealFunction or BatchComplexFunction
+ * are called once per block of points rather than once per point, which
+ * lets them vectorize their inner loop and amortise per-call setup. sample()
+ * uses the batched form whenever the callable provides one and falls back to
+ * a scalar loop otherwise, so call sites need not know which kind of
+ * function they were given.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief Adaptor giving a scalar function the batched calling convention.
+ * @details The batched call evaluates the function over the whole input in a
+ * single loop, writing through a pointer when the output is contiguous so
+ * that the compiler can vectorize it. The scalar call is forwarded, so the
+ * adaptor satisfies the same function concepts as the wrapped function.
+ * @tparam F The type of the scalar function.
+ */
+template <typename F>
+class BatchFunction {
+ public:
+  BatchFunction() = default;
+  explicit BatchFunction(F f) : _f{std::move(f)} {}
+
+  /// Evaluates the function at a single point.
+  template <typename... Args>
+    requires std::invocable<const F&, Args...>
+  decltype(auto) operator()(Args&&... args) const {
+    return std::invoke(_f, std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Evaluates the function at each point of x.
+   * @param x The points.
+   * @param out The range to write the values to, with at least x.size()
+   * elements.
+   */
+  template <Numeric T, RealOrComplexWritableRange Out>
+    requires std::invocable<const F&, T> and
+             std::indirectly_writable<std::ranges::iterator_t<Out>,
+                                      std::invoke_result_t<const F&, T>>
+  void operator()(std::span<const T> x, Out&& out) const {
+    auto n = x.size();
+    if constexpr (ContiguousRange<Out>) {
+      auto data = std::ranges::data(out);
+      for (auto i = std::size_t{0}; i < n; ++i) {
+        data[i] = std::invoke(_f, x[i]);
+      }
+    } else {
+      auto it = std::ranges::begin(out);
+      for (auto i = std::size_t{0}; i < n; ++i, ++it) {
+        *it = std::invoke(_f, x[i]);
+      }
+    }
+  }
+
+  /// Returns the wrapped function.
+  const F& function() const { return _f; }
+
+ private:
+  F _f;
+};
+
+/**
+ * @brief Lifts a scalar function to the batched calling convention.
+ * @param f The function.
+ * @return The BatchFunction wrapping f.
+ */
+template <typename F>
+auto as_batch(F f) {
+  return BatchFunction<F>(std::move(f));
+}
+
+namespace Detail {
+
+/// @internal The number of points passed per call when staging is needed.
+inline constexpr std::size_t SampleBlockSize = 256;
+
+/**
+ * @internal
+ * @brief Concept for a function that sample() can evaluate at arguments of
+ * type T into elements of type W, through either calling convention.
+ */
+template <typename F, typename T, typename W>
+concept SampleFunction =
+    BatchRealOrComplexFunction<F, T, std::span<W>> or
+    (std::invocable<F, T> and
+     std::assignable_from<W&, std::invoke_result_t<F, T>>);
+
+}  // namespace Detail
+
+/**
+ * @brief Evaluates a function at each point of a grid.
+ * @details If f satisfies BatchRealFunction or BatchComplexFunction for the
+ * grid's value type, it is called with contiguous spans: directly on the
+ * grid and output storage when both are contiguous, and otherwise through
+ * blocks of Detail::SampleBlockSize points copied into local buffers. Other
+ * callables are evaluated one point at a time. Evaluation stops when either
+ * range is exhausted, and no point is read or evaluated beyond the length of
+ * out unless out is neither sized nor a forward range.
+ * @param f The scalar or batched function.
+ * @param grid The points.
+ * @param out The range to write the values to.
+ * @return The number of values written.
+ */
+template <typename F, NumericRange Grid, RealOrComplexWritableRange Out>
+  requires Detail::SampleFunction<F&, std::ranges::range_value_t<Grid>,
+                                  std::ranges::range_value_t<Out>>
+std::size_t sample(F&& f, Grid&& grid, Out&& out) {
+  using T = std::ranges::range_value_t<Grid>;
+  using W = std::ranges::range_value_t<Out>;
+
+  if constexpr (BatchRealOrComplexFunction<F&, T, std::span<W>>) {
+    if constexpr (ContiguousRange<Grid> and ContiguousRange<Out> and
+                  std::ranges::sized_range<Grid> and
+                  std::ranges::sized_range<Out> and
+                  std::same_as<std::ranges::range_value_t<Out>,
+                               std::remove_reference_t<
+                                   std::ranges::range_reference_t<Out>>>) {
+      auto n = std::min(static_cast<std::size_t>(std::ranges::size(grid)),
+                        static_cast<std::size_t>(std::ranges::size(out)));
+      f(std::span<const T>(std::ranges::data(grid), n),
+        std::span<W>(std::ranges::data(out), n));
+      return n;
+    } else {
+      T x[Detail::SampleBlockSize];
+      W y[Detail::SampleBlockSize];
+      auto gi = std::ranges::begin(grid);
+      auto oi = std::ranges::begin(out);
+      auto count = std::size_t{0};
+      // The number of elements of out that the next block may fill.
+      auto room = [&]() {
+        constexpr auto block = Detail::SampleBlockSize;
+        if constexpr (std::ranges::sized_range<Out>) {
+          return std::min(
+              block, static_cast<std::size_t>(std::ranges::size(out)) - count);
+        } else if constexpr (std::ranges::forward_range<Out>) {
+          using D = std::ranges::range_difference_t<Out>;
+          auto last = std::ranges::next(oi, D(block), std::ranges::end(out));
+          return static_cast<std::size_t>(std::ranges::distance(oi, last));
+        } else {
+          return block;
+        }
+      };
+      while (gi != std::ranges::end(grid) && oi != std::ranges::end(out)) {
+        auto limit = room();
+        auto m = std::size_t{0};
+        for (; m < limit && gi != std::ranges::end(grid); ++m, ++gi) {
+          x[m] = *gi;
+        }
+        f(std::span<const T>(x, m), std::span<W>(y, m));
+        auto j = std::size_t{0};
+        for (; j < m && oi != std::ranges::end(out); ++j, ++oi) *oi = y[j];
+        count += j;
+      }
+      return count;
+    }
+  } else {
+    auto gi = std::ranges::begin(grid);
+    auto oi = std::ranges::begin(out);
+    auto count = std::size_t{0};
+    for (; gi != std::ranges::end(grid) && oi != std::ranges::end(out);
+         ++gi, ++oi, ++count) {
+      *oi = std::invoke(f, *gi);
+    }
+    return count;
+  }
+}
+
+}  // namespace NumericConcepts
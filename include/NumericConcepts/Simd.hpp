@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstddef>
+
+#if !defined(NUMERIC_CONCEPTS_NO_SIMD) && \
+    (defined(__AVX512F__) || defined(__AVX2__))
+#include <immintrin.h>
+#endif
+
+/**
+ * @file Simd.hpp
+ * @brief Defines a minimal wrapper over the SIMD instruction sets used by the
+ * library's kernels.
+ * @details The instruction set is chosen at compile time from the target
+ * flags: AVX-512 when `__AVX512F__` is defined, AVX2 when `__AVX2__` is
+ * defined, and a one-lane scalar fallback otherwise. Defining
+ * `NUMERIC_CONCEPTS_NO_SIMD` forces the scalar fallback.
+ */
+
+namespace NumericConcepts::Detail {
+
+/**
+ * @internal
+ * @brief Scalar fallback for a SIMD register of T.
+ * @details Kernels written against this interface compile to plain loops for
+ * any type without a vector specialization, e.g., long double.
+ * @tparam T The element type.
+ */
+template <typename T>
+struct Simd {
+  using type = T;
+  static constexpr bool vectorized = false;
+  static constexpr std::size_t width = 1;
+
+  static type load(const T* p) { return *p; }
+  static void store(T* p, type a) { *p = a; }
+  static type zero() { return T{0}; }
+  static type set1(T a) { return a; }
+  static type add(type a, type b) { return a + b; }
+  static type sub(type a, type b) { return a - b; }
+  static type mul(type a, type b) { return a * b; }
+  static type fma(type a, type b, type c) { return a * b + c; }
+  static type abs(type a) { return a < T{0} ? -a : a; }
+  static T reduce_add(type a) { return a; }
+};
+
+#if !defined(NUMERIC_CONCEPTS_NO_SIMD) && defined(__AVX512F__)
+
+/**
+ * @internal
+ * @brief Returns the low (I = 0) or high (I = 1) half of a register.
+ * @details The masked form gives the extraction a defined source operand,
+ * avoiding the spurious -Wuninitialized warnings of GCC 12 for
+ * _mm512_extractf64x4_pd, _mm512_castpd512_pd256 and the reductions built
+ * on them.
+ */
+template <int I>
+inline __m256d avx512_half(__m512d a) {
+  return _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xf, a, I);
+}
+
+/**
+ * @internal
+ * @brief AVX-512 specialization for double.
+ */
+template <>
+struct Simd<double> {
+  using type = __m512d;
+  static constexpr bool vectorized = true;
+  static constexpr std::size_t width = 8;
+
+  static type load(const double* p) { return _mm512_loadu_pd(p); }
+  static void store(double* p, type a) { _mm512_storeu_pd(p, a); }
+  static type zero() { return _mm512_setzero_pd(); }
+  static type set1(double a) { return _mm512_set1_pd(a); }
+  static type add(type a, type b) { return _mm512_add_pd(a, b); }
+  static type sub(type a, type b) { return _mm512_sub_pd(a, b); }
+  static type mul(type a, type b) { return _mm512_mul_pd(a, b); }
+  static type fma(type a, type b, type c) { return _mm512_fmadd_pd(a, b, c); }
+  static type abs(type a) { return _mm512_abs_pd(a); }
+  static double reduce_add(type a) {
+    auto h = _mm256_add_pd(avx512_half<0>(a), avx512_half<1>(a));
+    auto b = _mm_add_pd(_mm256_castpd256_pd128(h), _mm256_extractf128_pd(h, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(b, _mm_unpackhi_pd(b, b)));
+  }
+};
+
+/**
+ * @internal
+ * @brief AVX-512 specialization for float.
+ */
+template <>
+struct Simd<float> {
+  using type = __m512;
+  static constexpr bool vectorized = true;
+  static constexpr std::size_t width = 16;
+
+  static type load(const float* p) { return _mm512_loadu_ps(p); }
+  static void store(float* p, type a) { _mm512_storeu_ps(p, a); }
+  static type zero() { return _mm512_setzero_ps(); }
+  static type set1(float a) { return _mm512_set1_ps(a); }
+  static type add(type a, type b) { return _mm512_add_ps(a, b); }
+  static type sub(type a, type b) { return _mm512_sub_ps(a, b); }
+  static type mul(type a, type b) { return _mm512_mul_ps(a, b); }
+  static type fma(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c); }
+  static type abs(type a) { return _mm512_abs_ps(a); }
+  static float reduce_add(type a) {
+    auto x = _mm512_castps_pd(a);
+    auto h = _mm256_add_ps(_mm256_castpd_ps(avx512_half<0>(x)),
+                           _mm256_castpd_ps(avx512_half<1>(x)));
+    auto b = _mm_add_ps(_mm256_castps256_ps128(h), _mm256_extractf128_ps(h, 1));
+    b = _mm_add_ps(b, _mm_movehl_ps(b, b));
+    return _mm_cvtss_f32(_mm_add_ss(b, _mm_movehdup_ps(b)));
+  }
+};
+
+#elif !defined(NUMERIC_CONCEPTS_NO_SIMD) && defined(__AVX2__)
+
+/**
+ * @internal
+ * @brief AVX2 specialization for double.
+ */
+template <>
+struct Simd<double> {
+  using type = __m256d;
+  static constexpr bool vectorized = true;
+  static constexpr std::size_t width = 4;
+
+  static type load(const double* p) { return _mm256_loadu_pd(p); }
+  static void store(double* p, type a) { _mm256_storeu_pd(p, a); }
+  static type zero() { return _mm256_setzero_pd(); }
+  static type set1(double a) { return _mm256_set1_pd(a); }
+  static type add(type a, type b) { return _mm256_add_pd(a, b); }
+  static type sub(type a, type b) { return _mm256_sub_pd(a, b); }
+  static type mul(type a, type b) { return _mm256_mul_pd(a, b); }
+  static type fma(type a, type b, type c) {
+#if defined(__FMA__)
+    return _mm256_fmadd_pd(a, b, c);
+#else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+  }
+  static type abs(type a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+  static double reduce_add(type a) {
+    auto b = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(b, _mm_unpackhi_pd(b, b)));
+  }
+};
+
+/**
+ * @internal
+ * @brief AVX2 specialization for float.
+ */
+template <>
+struct Simd<float> {
+  using type = __m256;
+  static constexpr bool vectorized = true;
+  static constexpr std::size_t width = 8;
+
+  static type load(const float* p) { return _mm256_loadu_ps(p); }
+  static void store(float* p, type a) { _mm256_storeu_ps(p, a); }
+  static type zero() { return _mm256_setzero_ps(); }
+  static type set1(float a) { return _mm256_set1_ps(a); }
+  static type add(type a, type b) { return _mm256_add_ps(a, b); }
+  static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+  static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+  static type fma(type a, type b, type c) {
+#if defined(__FMA__)
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+  }
+  static type abs(type a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+  static float reduce_add(type a) {
+    auto b = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+    b = _mm_add_ps(b, _mm_movehl_ps(b, b));
+    return _mm_cvtss_f32(_mm_add_ss(b, _mm_movehdup_ps(b)));
+  }
+};
+
+#endif
+
+}  // namespace NumericConcepts::Detail
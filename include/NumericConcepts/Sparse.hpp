@@ -0,0 +1,637 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Algorithms.hpp"
+#include "Buffer.hpp"
+#include "MatrixProduct.hpp"
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+#include "Tensor.hpp"
+#include "Threading.hpp"
+
+/**
+ * @file Sparse.hpp
+ * @brief Defines concepts for sparse vectors and matrices, compressed sparse
+ * row and column matrices, and parallel sparse matrix products.
+ * @details A sparse vector is any range of (index, value) pairs, such as a
+ * `std::vector<std::pair<int, double>>` or a `std::map<int, double>`. A
+ * compressed sparse matrix stores, for each row (CSR) or column (CSC), the
+ * offsets of its entries in parallel arrays of indices and values. spmv()
+ * and spmm() split CSR matrices into blocks of rows holding roughly equal
+ * numbers of entries, so that rows of very different lengths do not leave
+ * threads idle. Their options are the MatrixProductOptions of the dense
+ * products.
+ */
+
+namespace NumericConcepts {
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Concept for a pair-like type holding an integral index and a
+ * numeric value.
+ */
+template <typename E>
+concept SparseEntry = requires {
+  requires std::tuple_size<E>::value == 2;
+  requires Integral<std::remove_cvref_t<std::tuple_element_t<0, E>>>;
+  requires Numeric<std::remove_cvref_t<std::tuple_element_t<1, E>>>;
+};
+
+}  // namespace Detail
+
+/**
+ * @brief Concept for a sparse vector: a range of (index, value) pairs.
+ * @tparam R The type to check.
+ */
+template <typename R>
+concept SparseRange = std::ranges::input_range<R> and
+                      Detail::SparseEntry<std::ranges::range_value_t<R>>;
+
+/**
+ * @brief The index type of a sparse range.
+ * @tparam R The SparseRange type.
+ */
+template <SparseRange R>
+using SparseIndex = std::remove_cvref_t<
+    std::tuple_element_t<0, std::ranges::range_value_t<R>>>;
+
+/**
+ * @brief The value type of a sparse range.
+ * @tparam R The SparseRange type.
+ */
+template <SparseRange R>
+using SparseValue = std::remove_cvref_t<
+    std::tuple_element_t<1, std::ranges::range_value_t<R>>>;
+
+/**
+ * @brief Concept for a sparse range of real values.
+ * @tparam R The type to check.
+ */
+template <typename R>
+concept SparseRealRange = SparseRange<R> and Real<SparseValue<R>>;
+
+/**
+ * @brief Concept for a sparse range of complex values.
+ * @tparam R The type to check.
+ */
+template <typename R>
+concept SparseComplexRange = SparseRange<R> and Complex<SparseValue<R>>;
+
+/**
+ * @brief Concept for a sparse range of real or complex values.
+ * @tparam R The type to check.
+ */
+template <typename R>
+concept SparseRealOrComplexRange =
+    SparseRealRange<R> or SparseComplexRange<R>;
+
+/**
+ * @brief The storage orders of a compressed sparse matrix.
+ */
+enum class SparseFormat {
+  /// Compressed sparse row: entries are grouped by row.
+  Csr,
+  /// Compressed sparse column: entries are grouped by column.
+  Csc
+};
+
+/**
+ * @brief Concept for a compressed sparse matrix.
+ * @details The matrix has `rows()` and `cols()`, a static `format`, and
+ * `offsets()`, `indices()` and `values()` ranges. Entries of row (or column)
+ * k occupy positions `offsets()[k]` to `offsets()[k + 1]` of `indices()`,
+ * holding their column (or row) indices, and of `values()`.
+ * @tparam M The type to check.
+ */
+template <typename M>
+concept CompressedSparseMatrix =
+    requires(const std::remove_cvref_t<M>& m) {
+      { std::remove_cvref_t<M>::format } -> std::convertible_to<SparseFormat>;
+      { m.rows() } -> std::convertible_to<std::size_t>;
+      { m.cols() } -> std::convertible_to<std::size_t>;
+      { m.offsets() } -> IntegralRange;
+      { m.indices() } -> IntegralRange;
+      { m.values() } -> RealOrComplexRange;
+    } and
+    std::ranges::random_access_range<
+        decltype(std::declval<const std::remove_cvref_t<M>&>().offsets())>;
+
+/**
+ * @brief The value type of a compressed sparse matrix.
+ * @tparam M The CompressedSparseMatrix type.
+ */
+template <CompressedSparseMatrix M>
+using SparseMatrixValue = std::ranges::range_value_t<
+    decltype(std::declval<const std::remove_cvref_t<M>&>().values())>;
+
+/**
+ * @brief Concept for a compressed sparse row matrix.
+ * @tparam M The type to check.
+ */
+template <typename M>
+concept CsrSparseMatrix = CompressedSparseMatrix<M> and
+                          std::remove_cvref_t<M>::format == SparseFormat::Csr;
+
+/**
+ * @brief Concept for a compressed sparse column matrix.
+ * @tparam M The type to check.
+ */
+template <typename M>
+concept CscSparseMatrix = CompressedSparseMatrix<M> and
+                          std::remove_cvref_t<M>::format == SparseFormat::Csc;
+
+/**
+ * @brief A compressed sparse matrix owning its arrays.
+ * @details Offsets are stored as `std::size_t`, so the number of entries is
+ * not limited by the index type, which only needs to hold the row or column
+ * count. Indices within each row (or column) are sorted and unique when the
+ * matrix is built by from_triplets(), but need not be otherwise.
+ * @tparam T The real or complex value type.
+ * @tparam I The integral index type.
+ * @tparam F The storage order.
+ */
+template <RealOrComplex T, Integral I = std::int32_t,
+          SparseFormat F = SparseFormat::Csr>
+class CompressedMatrix {
+ public:
+  using value_type = T;
+  using index_type = I;
+  static constexpr SparseFormat format = F;
+
+  CompressedMatrix() = default;
+
+  /**
+   * @brief Constructs a matrix from its compressed arrays.
+   * @param rows The number of rows.
+   * @param cols The number of columns.
+   * @param offsets The offsets of each row (or column), one more than the
+   * number of rows (or columns).
+   * @param indices The column (or row) index of each entry.
+   * @param values The value of each entry.
+   * @throws std::invalid_argument if the arrays are inconsistent.
+   */
+  CompressedMatrix(std::size_t rows, std::size_t cols,
+                   std::vector<std::size_t> offsets, std::vector<I> indices,
+                   std::vector<T> values)
+      : _rows{rows},
+        _cols{cols},
+        _offsets{std::move(offsets)},
+        _indices{std::move(indices)},
+        _values{std::move(values)} {
+    if (_offsets.size() != outer_size() + 1 || _offsets.front() != 0 ||
+        _offsets.back() != _values.size() ||
+        _indices.size() != _values.size() ||
+        !std::ranges::is_sorted(_offsets)) {
+      throw std::invalid_argument("CompressedMatrix: inconsistent arrays");
+    }
+    auto inner = static_cast<std::uintmax_t>(inner_size());
+    for (auto index : _indices) {
+      if constexpr (std::signed_integral<I>) {
+        if (index < 0) {
+          throw std::invalid_argument("CompressedMatrix: index out of range");
+        }
+      }
+      if (static_cast<std::uintmax_t>(index) >= inner) {
+        throw std::invalid_argument("CompressedMatrix: index out of range");
+      }
+    }
+  }
+
+  /**
+   * @brief Builds a matrix from (row, column, value) triplets.
+   * @details The triplets may be in any order, and the values of repeated
+   * positions are summed.
+   * @param rows The number of rows.
+   * @param cols The number of columns.
+   * @param triplets A range of tuple-like (row, column, value) elements.
+   * @throws std::invalid_argument if a position is out of range, or its
+   * column (or row) index is not representable in I.
+   */
+  template <std::ranges::input_range R>
+  static CompressedMatrix from_triplets(std::size_t rows, std::size_t cols,
+                                        R&& triplets) {
+    auto outer = F == SparseFormat::Csr ? rows : cols;
+    auto entries = std::vector<std::tuple<std::size_t, std::size_t, T>>{};
+    for (auto&& triplet : triplets) {
+      auto i = static_cast<std::size_t>(std::get<0>(triplet));
+      auto j = static_cast<std::size_t>(std::get<1>(triplet));
+      if (i >= rows || j >= cols) {
+        throw std::invalid_argument("from_triplets: position out of range");
+      }
+      constexpr auto index_max =
+          static_cast<std::uintmax_t>(std::numeric_limits<I>::max());
+      if ((F == SparseFormat::Csr ? j : i) > index_max) {
+        throw std::invalid_argument(
+            "from_triplets: index not representable in the index type");
+      }
+      auto value = Detail::numeric_cast<T>(std::get<2>(triplet));
+      if constexpr (F == SparseFormat::Csr) {
+        entries.emplace_back(i, j, value);
+      } else {
+        entries.emplace_back(j, i, value);
+      }
+    }
+    std::ranges::sort(entries, {}, [](auto& e) {
+      return std::pair(std::get<0>(e), std::get<1>(e));
+    });
+
+    auto offsets = std::vector<std::size_t>(outer + 1, 0);
+    auto indices = std::vector<I>{};
+    auto values = std::vector<T>{};
+    for (auto k = std::size_t{0}; k < entries.size(); ++k) {
+      auto [o, i, value] = entries[k];
+      if (k > 0 && std::get<0>(entries[k - 1]) == o &&
+          std::get<1>(entries[k - 1]) == i) {
+        values.back() += value;
+        continue;
+      }
+      ++offsets[o + 1];
+      indices.push_back(static_cast<I>(i));
+      values.push_back(value);
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    return CompressedMatrix(rows, cols, std::move(offsets), std::move(indices),
+                            std::move(values));
+  }
+
+  std::size_t rows() const { return _rows; }
+  std::size_t cols() const { return _cols; }
+
+  /// The number of stored entries.
+  std::size_t nonzeros() const { return _values.size(); }
+
+  /// The number of rows for CSR, or of columns for CSC.
+  std::size_t outer_size() const {
+    return F == SparseFormat::Csr ? _rows : _cols;
+  }
+
+  /// The number of columns for CSR, or of rows for CSC.
+  std::size_t inner_size() const {
+    return F == SparseFormat::Csr ? _cols : _rows;
+  }
+
+  std::span<const std::size_t> offsets() const { return _offsets; }
+  std::span<const I> indices() const { return _indices; }
+  std::span<const T> values() const { return _values; }
+
+  /// The values, which may be modified without changing the pattern.
+  std::span<T> values() { return _values; }
+
+  /**
+   * @brief Returns the transpose, which has the other storage order and the
+   * same arrays.
+   */
+  auto transpose() const& {
+    return CompressedMatrix<T, I, Other>(_cols, _rows, _offsets, _indices,
+                                         _values);
+  }
+
+  /// Returns the transpose, moving the arrays.
+  auto transpose() && {
+    return CompressedMatrix<T, I, Other>(_cols, _rows, std::move(_offsets),
+                                         std::move(_indices),
+                                         std::move(_values));
+  }
+
+ private:
+  static constexpr SparseFormat Other =
+      F == SparseFormat::Csr ? SparseFormat::Csc : SparseFormat::Csr;
+
+  std::size_t _rows = 0;
+  std::size_t _cols = 0;
+  std::vector<std::size_t> _offsets = std::vector<std::size_t>(1, 0);
+  std::vector<I> _indices;
+  std::vector<T> _values;
+};
+
+/**
+ * @brief A compressed sparse row matrix.
+ * @tparam T The real or complex value type.
+ * @tparam I The integral index type.
+ */
+template <RealOrComplex T, Integral I = std::int32_t>
+using CsrMatrix = CompressedMatrix<T, I, SparseFormat::Csr>;
+
+/**
+ * @brief A compressed sparse column matrix.
+ * @tparam T The real or complex value type.
+ * @tparam I The integral index type.
+ */
+template <RealOrComplex T, Integral I = std::int32_t>
+using CscMatrix = CompressedMatrix<T, I, SparseFormat::Csc>;
+
+/**
+ * @brief Computes the unconjugated dot product of a sparse and a dense
+ * vector.
+ * @details Every index of x must be a valid position in y.
+ * @param x The sparse vector.
+ * @param y The dense vector.
+ * @return The sum of value * y[index] over the entries of x, in the
+ * AccumulatorPrecision of the operands.
+ */
+template <SparseRealOrComplexRange X, RealOrComplexRange Y>
+  requires std::ranges::random_access_range<Y> and
+           SamePrecision<SparseValue<X>, std::ranges::range_value_t<Y>>
+auto sparse_dot(X&& x, Y&& y) {
+  using V = PromotePrecision<SparseValue<X>, std::ranges::range_value_t<Y>>;
+  using P = ReplacePrecision<V, AccumulatorPrecision<V>>;
+  using Difference = std::ranges::range_difference_t<Y>;
+  auto first = std::ranges::begin(y);
+  auto sum = P{0};
+  for (auto&& entry : x) {
+    auto j = static_cast<Difference>(std::get<0>(entry));
+    sum += Detail::numeric_cast<P>(std::get<1>(entry)) *
+           Detail::numeric_cast<P>(first[j]);
+  }
+  return sum;
+}
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Splits [0, count) into at most `parts` blocks of roughly equal
+ * weight, where block [a, b) weighs offsets[b] - offsets[a] + b - a.
+ * @return The block boundaries, starting at zero and ending at count.
+ */
+template <typename Offsets>
+std::vector<std::size_t> balanced_partition(const Offsets& offsets,
+                                            std::size_t count,
+                                            std::size_t parts) {
+  auto first = std::ranges::begin(offsets);
+  auto weight = [&](std::size_t i) {
+    return static_cast<std::size_t>(first[static_cast<std::ptrdiff_t>(i)]) + i;
+  };
+  auto total = weight(count);
+  auto bounds = std::vector<std::size_t>{0};
+  for (auto t = std::size_t{1}; t < parts; ++t) {
+    auto target = total / parts * t + total % parts * t / parts;
+    auto rows = std::views::iota(bounds.back(), count);
+    auto b = *std::ranges::partition_point(
+        rows, [&](std::size_t i) { return weight(i) < target; });
+    if (b > bounds.back()) bounds.push_back(b);
+  }
+  if (bounds.back() < count) bounds.push_back(count);
+  return bounds;
+}
+
+/**
+ * @internal
+ * @brief The number of blocks to split work over, given its multiply-adds.
+ */
+inline std::size_t sparse_parts(std::size_t work, std::size_t count,
+                                const MatrixProductOptions& options,
+                                ThreadPool& pool) {
+  auto parts = work / std::max<std::size_t>(options.grain, 1);
+  parts = std::min({parts, count, 8 * pool.concurrency()});
+  return std::max<std::size_t>(parts, 1);
+}
+
+/**
+ * @internal
+ * @brief Runs f(lo, hi) over the given block boundaries in parallel.
+ */
+template <typename F>
+void run_blocks(ThreadPool& pool, const std::vector<std::size_t>& bounds,
+                F&& f) {
+  parallel_range(pool, bounds.size() - 1, 1,
+                 [&](std::size_t lo, std::size_t hi) {
+                   for (auto b = lo; b < hi; ++b) f(bounds[b], bounds[b + 1]);
+                 });
+}
+
+}  // namespace Detail
+
+/**
+ * @brief Computes the sparse matrix-vector product y = alpha * a * x + beta *
+ * y.
+ * @details a is m by n, x has n elements and y has m elements. The operands
+ * must have the same precision, and a complex product can only be written to
+ * a complex y. When beta is zero the initial contents of y are ignored. CSR
+ * matrices are split into blocks of rows with roughly equal numbers of
+ * entries. CSC matrices are split into blocks of columns, each accumulated
+ * into a separate vector, and the vectors are then summed.
+ * @param alpha The scalar multiplying the product.
+ * @param a The sparse matrix.
+ * @param x The vector to multiply.
+ * @param beta The scalar multiplying y.
+ * @param y The vector to update, which must not overlap x.
+ * @param options The grain size and thread pool.
+ * @throws std::invalid_argument if the sizes do not match.
+ */
+template <typename S, CompressedSparseMatrix A, RealOrComplexRange X,
+          typename T, RealOrComplexWritableRange Y>
+  requires std::ranges::sized_range<X> and
+           std::ranges::random_access_range<Y> and
+           std::ranges::sized_range<Y> and
+           SamePrecision<SparseMatrixValue<A>, std::ranges::range_value_t<X>,
+                         std::ranges::range_value_t<Y>> and
+           (ComplexRange<Y> or
+            (Real<SparseMatrixValue<A>> and RealRange<X>)) and
+           std::convertible_to<S, std::ranges::range_value_t<Y>> and
+           std::convertible_to<T, std::ranges::range_value_t<Y>>
+void spmv(S alpha, const A& a, X&& x, T beta, Y&& y,
+          const MatrixProductOptions& options = {}) {
+  using Value = std::ranges::range_value_t<Y>;
+  using P = Detail::ProductType<Value, SparseMatrixValue<A>,
+                                std::ranges::range_value_t<X>>;
+  using Difference = std::ranges::range_difference_t<Y>;
+  auto m = static_cast<std::size_t>(a.rows());
+  auto n = static_cast<std::size_t>(a.cols());
+  if (static_cast<std::size_t>(std::ranges::size(x)) != n ||
+      static_cast<std::size_t>(std::ranges::size(y)) != m) {
+    throw std::invalid_argument("spmv: mismatched sizes");
+  }
+
+  auto scale = Detail::numeric_cast<P>(static_cast<Value>(alpha));
+  auto beta_p = Detail::numeric_cast<P>(static_cast<Value>(beta));
+  auto xs = NumericBuffer<P>(n, Uninitialized);
+  auto xi = std::ranges::begin(x);
+  for (auto j = std::size_t{0}; j < n; ++j, ++xi) {
+    xs[j] = scale * Detail::numeric_cast<P>(*xi);
+  }
+
+  auto offsets = std::ranges::begin(a.offsets());
+  auto indices = std::ranges::begin(a.indices());
+  auto values = std::ranges::begin(a.values());
+  auto offset = [&](std::size_t k) {
+    return static_cast<std::size_t>(offsets[static_cast<std::ptrdiff_t>(k)]);
+  };
+  auto entry = [&](std::size_t e) {
+    auto d = static_cast<std::ptrdiff_t>(e);
+    return std::pair(static_cast<std::size_t>(indices[d]),
+                     Detail::numeric_cast<P>(values[d]));
+  };
+  auto first = std::ranges::begin(y);
+  auto update = [&](std::size_t i, P sum) {
+    decltype(auto) yi = first[static_cast<Difference>(i)];
+    auto value = beta_p == P{0}
+                     ? sum
+                     : beta_p * Detail::numeric_cast<P>(
+                                    static_cast<Value>(yi)) +
+                           sum;
+    yi = Detail::numeric_cast<Value>(value);
+  };
+
+  auto& pool = options.pool ? *options.pool : ThreadPool::global();
+  auto outer = CsrSparseMatrix<A> ? m : n;
+  auto parts =
+      Detail::sparse_parts(offset(outer) + outer, outer, options, pool);
+  auto bounds = Detail::balanced_partition(a.offsets(), outer, parts);
+
+  if constexpr (CsrSparseMatrix<A>) {
+    Detail::run_blocks(pool, bounds, [&](std::size_t lo, std::size_t hi) {
+      for (auto i = lo; i < hi; ++i) {
+        auto sum = P{0};
+        for (auto e = offset(i); e < offset(i + 1); ++e) {
+          auto [j, v] = entry(e);
+          Detail::multiply_add(sum, v, xs[j]);
+        }
+        update(i, sum);
+      }
+    });
+  } else {
+    // Each block of columns scatters into its own slice of partial.
+    auto blocks = bounds.size() - 1;
+    auto partial = NumericBuffer<P>(blocks * m);
+    auto scatter = [&](std::size_t lo, std::size_t hi) {
+      for (auto b = lo; b < hi; ++b) {
+        auto acc = partial.data() + b * m;
+        for (auto j = bounds[b]; j < bounds[b + 1]; ++j) {
+          for (auto e = offset(j); e < offset(j + 1); ++e) {
+            auto [i, v] = entry(e);
+            Detail::multiply_add(acc[i], v, xs[j]);
+          }
+        }
+      }
+    };
+    Detail::parallel_range(pool, blocks, 1, scatter);
+    auto reduce = [&](std::size_t lo, std::size_t hi) {
+      for (auto i = lo; i < hi; ++i) {
+        auto sum = P{0};
+        for (auto b = std::size_t{0}; b < blocks; ++b) {
+          sum += partial[b * m + i];
+        }
+        update(i, sum);
+      }
+    };
+    auto grain = std::max<std::size_t>(1, options.grain / (blocks + 1));
+    Detail::parallel_range(pool, m, grain, reduce);
+  }
+}
+
+/**
+ * @brief Computes the product c = alpha * a * b + beta * c of a sparse
+ * matrix and a dense matrix.
+ * @details a is m by k, b is k by n and c is m by n, with b and c any
+ * Tensor types. The operands must have the same precision, and a complex
+ * product can only be written to a complex c. When beta is zero the initial
+ * contents of c are ignored. CSR matrices are split into blocks of rows with
+ * roughly equal numbers of entries, and CSC matrices into blocks of columns
+ * of c.
+ * @param alpha The scalar multiplying the product.
+ * @param a The sparse matrix.
+ * @param b The dense matrix.
+ * @param beta The scalar multiplying c.
+ * @param c The dense matrix to update, which must not overlap b.
+ * @param options The grain size and thread pool.
+ * @throws std::invalid_argument if the extents do not match.
+ */
+template <typename S, CompressedSparseMatrix A, RealOrComplexMatrix B,
+          typename T, RealOrComplexWritableMatrix C>
+  requires SamePrecision<SparseMatrixValue<A>, TensorValue<B>,
+                         TensorValue<C>> and
+           (ComplexMatrix<C> or
+            (Real<SparseMatrixValue<A>> and RealMatrix<B>)) and
+           std::convertible_to<S, TensorValue<C>> and
+           std::convertible_to<T, TensorValue<C>>
+void spmm(S alpha, const A& a, B&& b, T beta, C&& c,
+          const MatrixProductOptions& options = {}) {
+  using Value = TensorValue<C>;
+  using P = Detail::ProductType<Value, SparseMatrixValue<A>, TensorValue<B>>;
+  auto mb = Detail::MatrixAccess<std::remove_cvref_t<B>>(b);
+  auto mc = Detail::MatrixAccess<std::remove_cvref_t<C>>(c);
+  auto m = static_cast<std::size_t>(a.rows());
+  auto k = static_cast<std::size_t>(a.cols());
+  auto n = mc.cols();
+  if (mc.rows() != m || mb.rows() != k || mb.cols() != n) {
+    throw std::invalid_argument("spmm: mismatched extents");
+  }
+
+  auto scale = Detail::numeric_cast<P>(static_cast<Value>(alpha));
+  auto beta_p = Detail::numeric_cast<P>(static_cast<Value>(beta));
+  auto offsets = std::ranges::begin(a.offsets());
+  auto indices = std::ranges::begin(a.indices());
+  auto values = std::ranges::begin(a.values());
+  auto offset = [&](std::size_t i) {
+    return static_cast<std::size_t>(offsets[static_cast<std::ptrdiff_t>(i)]);
+  };
+  auto entry = [&](std::size_t e) {
+    auto d = static_cast<std::ptrdiff_t>(e);
+    return std::pair(static_cast<std::size_t>(indices[d]),
+                     scale * Detail::numeric_cast<P>(values[d]));
+  };
+  auto& pool = options.pool ? *options.pool : ThreadPool::global();
+  if (m == 0 || n == 0) return;
+
+  if constexpr (CsrSparseMatrix<A>) {
+    auto parts = Detail::sparse_parts((offset(m) + m) * n, m, options, pool);
+    auto bounds = Detail::balanced_partition(a.offsets(), m, parts);
+    Detail::run_blocks(pool, bounds, [&](std::size_t lo, std::size_t hi) {
+      auto row = NumericBuffer<P>(n);
+      for (auto i = lo; i < hi; ++i) {
+        std::ranges::fill(row, P{0});
+        for (auto e = offset(i); e < offset(i + 1); ++e) {
+          auto [p, v] = entry(e);
+          for (auto j = std::size_t{0}; j < n; ++j) {
+            Detail::multiply_add(row[j], v, Detail::numeric_cast<P>(mb(p, j)));
+          }
+        }
+        for (auto j = std::size_t{0}; j < n; ++j) {
+          auto& e = mc(i, j);
+          e = Detail::numeric_cast<Value>(
+              beta_p == P{0}
+                  ? row[j]
+                  : beta_p * Detail::numeric_cast<P>(e) + row[j]);
+        }
+      }
+    });
+  } else {
+    Detail::scale_matrix(beta_p, mc);
+    auto work = (offset(k) + k) * n;
+    auto columns = std::max<std::size_t>(
+        1, n / Detail::sparse_parts(work, n, options, pool));
+    Detail::parallel_range(
+        pool, n, columns, [&](std::size_t lo, std::size_t hi) {
+          for (auto p = std::size_t{0}; p < k; ++p) {
+            for (auto e = offset(p); e < offset(p + 1); ++e) {
+              auto [i, v] = entry(e);
+              for (auto j = lo; j < hi; ++j) {
+                auto& target = mc(i, j);
+                target = Detail::numeric_cast<Value>(
+                    Detail::numeric_cast<P>(target) +
+                    v * Detail::numeric_cast<P>(mb(p, j)));
+              }
+            }
+          }
+        });
+  }
+}
+
+}  // namespace NumericConcepts
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+
+/**
+ * @file SplitComplex.hpp
+ * @brief Defines a complex vector that stores real and imaginary parts in
+ * separate arrays.
+ * @details The iterators of SplitComplexVector have value type
+ * `std::complex<T>` and yield SplitComplexReference proxies. The proxy is
+ * registered through ComplexType, and common references with
+ * `std::complex<T>` are provided, so the container satisfies ComplexRange,
+ * ComplexWritableRange and SplitComplexRange.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief Proxy reference to an element of a split complex array.
+ * @details Reading converts to `std::complex<std::remove_const_t<T>>`.
+ * Assignment writes through to the referenced real and imaginary parts
+ * and is only available when T is not const.
+ * @tparam T The (possibly const) underlying floating-point type.
+ */
+template <typename T>
+class SplitComplexReference {
+ public:
+  using value_type = std::complex<std::remove_const_t<T>>;
+
+  SplitComplexReference(T* real, T* imag) : _real{real}, _imag{imag} {}
+
+  SplitComplexReference(const SplitComplexReference&) = default;
+
+  /// Conversion from a mutable to a const proxy.
+  template <typename U>
+    requires std::same_as<const U, T> && (!std::same_as<U, T>)
+  SplitComplexReference(const SplitComplexReference<U>& other)
+      : _real{&other.real_ref()}, _imag{&other.imag_ref()} {}
+
+  /// Assigns a value to the referenced element.
+  const SplitComplexReference& operator=(const value_type& value) const
+    requires(!std::is_const_v<T>)
+  {
+    *_real = value.real();
+    *_imag = value.imag();
+    return *this;
+  }
+
+  /// Assigns the value of another element to the referenced element.
+  const SplitComplexReference& operator=(
+      const SplitComplexReference& other) const
+    requires(!std::is_const_v<T>)
+  {
+    return *this = static_cast<value_type>(other);
+  }
+
+  operator value_type() const { return {*_real, *_imag}; }
+
+  auto real() const { return *_real; }
+  auto imag() const { return *_imag; }
+
+  T& real_ref() const { return *_real; }
+  T& imag_ref() const { return *_imag; }
+
+  friend bool operator==(const SplitComplexReference& a, const value_type& b) {
+    return static_cast<value_type>(a) == b;
+  }
+
+ private:
+  T* _real;
+  T* _imag;
+};
+
+/**
+ * @brief Registers SplitComplexReference as a complex type.
+ * @tparam T The (possibly const) underlying floating-point type.
+ */
+template <typename T>
+struct ComplexType<SplitComplexReference<T>>
+    : public std::bool_constant<Real<std::remove_const_t<T>>> {
+  using value_type = std::remove_const_t<T>;
+};
+
+/**
+ * @brief Random access iterator over split complex arrays.
+ * @tparam T The (possibly const) underlying floating-point type.
+ */
+template <typename T>
+class SplitComplexIterator {
+ public:
+  using iterator_concept = std::random_access_iterator_tag;
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::complex<std::remove_const_t<T>>;
+  using difference_type = std::ptrdiff_t;
+  using reference = SplitComplexReference<T>;
+
+  SplitComplexIterator() = default;
+  SplitComplexIterator(T* real, T* imag) : _real{real}, _imag{imag} {}
+
+  /// Conversion from a mutable to a const iterator.
+  template <typename U>
+    requires std::same_as<const U, T> && (!std::same_as<U, T>)
+  SplitComplexIterator(const SplitComplexIterator<U>& other)
+      : _real{other.real_data()}, _imag{other.imag_data()} {}
+
+  reference operator*() const { return {_real, _imag}; }
+  reference operator[](difference_type n) const {
+    return {_real + n, _imag + n};
+  }
+
+  SplitComplexIterator& operator++() {
+    ++_real;
+    ++_imag;
+    return *this;
+  }
+  SplitComplexIterator operator++(int) {
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  SplitComplexIterator& operator--() {
+    --_real;
+    --_imag;
+    return *this;
+  }
+  SplitComplexIterator operator--(int) {
+    auto tmp = *this;
+    --*this;
+    return tmp;
+  }
+  SplitComplexIterator& operator+=(difference_type n) {
+    _real += n;
+    _imag += n;
+    return *this;
+  }
+  SplitComplexIterator& operator-=(difference_type n) { return *this += -n; }
+
+  friend SplitComplexIterator operator+(SplitComplexIterator it,
+                                        difference_type n) {
+    return it += n;
+  }
+  friend SplitComplexIterator operator+(difference_type n,
+                                        SplitComplexIterator it) {
+    return it += n;
+  }
+  friend SplitComplexIterator operator-(SplitComplexIterator it,
+                                        difference_type n) {
+    return it -= n;
+  }
+  friend difference_type operator-(const SplitComplexIterator& a,
+                                   const SplitComplexIterator& b) {
+    return a._real - b._real;
+  }
+  friend bool operator==(const SplitComplexIterator& a,
+                         const SplitComplexIterator& b) {
+    return a._real == b._real;
+  }
+  friend auto operator<=>(const SplitComplexIterator& a,
+                          const SplitComplexIterator& b) {
+    return a._real <=> b._real;
+  }
+
+  T* real_data() const { return _real; }
+  T* imag_data() const { return _imag; }
+
+ private:
+  T* _real = nullptr;
+  T* _imag = nullptr;
+};
+
+/**
+ * @brief A complex vector whose real and imaginary parts are held in separate
+ * arrays aligned to SplitComplexVector::alignment bytes.
+ * @details This layout lets elementwise complex kernels load real and
+ * imaginary parts directly into SIMD registers without shuffles.
+ * @tparam T The underlying floating-point type.
+ */
+template <Real T>
+class SplitComplexVector {
+ public:
+  using value_type = std::complex<T>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = SplitComplexReference<T>;
+  using const_reference = SplitComplexReference<const T>;
+  using iterator = SplitComplexIterator<T>;
+  using const_iterator = SplitComplexIterator<const T>;
+
+  /// Alignment in bytes of the real and imaginary arrays.
+  static constexpr std::size_t alignment = 64;
+
+  SplitComplexVector() = default;
+
+  explicit SplitComplexVector(size_type n, const value_type& value = {})
+      : SplitComplexVector() {
+    allocate(n);
+    std::fill_n(_real, n, value.real());
+    std::fill_n(_imag, n, value.imag());
+  }
+
+  SplitComplexVector(std::initializer_list<value_type> values)
+      : SplitComplexVector(values.begin(), values.end()) {}
+
+  template <std::input_iterator I, std::sentinel_for<I> S>
+  SplitComplexVector(I first, S last) : SplitComplexVector() {
+    if constexpr (std::forward_iterator<I>) {
+      allocate(static_cast<size_type>(std::ranges::distance(first, last)));
+      std::ranges::copy(first, last, begin());
+    } else {
+      for (; first != last; ++first) push_back(*first);
+    }
+  }
+
+  template <ComplexRange R>
+  explicit SplitComplexVector(R&& range)
+      : SplitComplexVector(std::ranges::begin(range), std::ranges::end(range)) {
+  }
+
+  SplitComplexVector(const SplitComplexVector& other) : SplitComplexVector() {
+    allocate(other._size);
+    std::copy_n(other._real, _size, _real);
+    std::copy_n(other._imag, _size, _imag);
+  }
+
+  SplitComplexVector(SplitComplexVector&& other) noexcept
+      : _real{std::exchange(other._real, nullptr)},
+        _imag{std::exchange(other._imag, nullptr)},
+        _size{std::exchange(other._size, 0)},
+        _capacity{std::exchange(other._capacity, 0)} {}
+
+  SplitComplexVector& operator=(SplitComplexVector other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~SplitComplexVector() { deallocate(); }
+
+  void swap(SplitComplexVector& other) noexcept {
+    std::swap(_real, other._real);
+    std::swap(_imag, other._imag);
+    std::swap(_size, other._size);
+    std::swap(_capacity, other._capacity);
+  }
+
+  size_type size() const { return _size; }
+  size_type capacity() const { return _capacity; }
+  bool empty() const { return _size == 0; }
+
+  /// Pointer to the contiguous array of real parts.
+  T* real_data() { return _real; }
+  const T* real_data() const { return _real; }
+
+  /// Pointer to the contiguous array of imaginary parts.
+  T* imag_data() { return _imag; }
+  const T* imag_data() const { return _imag; }
+
+  reference operator[](size_type i) { return {_real + i, _imag + i}; }
+  const_reference operator[](size_type i) const {
+    return {_real + i, _imag + i};
+  }
+
+  iterator begin() { return {_real, _imag}; }
+  iterator end() { return {_real + _size, _imag + _size}; }
+  const_iterator begin() const { return {_real, _imag}; }
+  const_iterator end() const { return {_real + _size, _imag + _size}; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  void reserve(size_type n) {
+    if (n <= _capacity) return;
+    auto other = SplitComplexVector{};
+    other.allocate(n);
+    other._size = _size;
+    std::copy_n(_real, _size, other._real);
+    std::copy_n(_imag, _size, other._imag);
+    swap(other);
+  }
+
+  void resize(size_type n, const value_type& value = {}) {
+    reserve(n);
+    if (n > _size) {
+      std::fill(_real + _size, _real + n, value.real());
+      std::fill(_imag + _size, _imag + n, value.imag());
+    }
+    _size = n;
+  }
+
+  void push_back(const value_type& value) {
+    if (_size == _capacity) reserve(std::max<size_type>(16, 2 * _capacity));
+    _real[_size] = value.real();
+    _imag[_size] = value.imag();
+    ++_size;
+  }
+
+  void clear() { _size = 0; }
+
+ private:
+  T* _real = nullptr;
+  T* _imag = nullptr;
+  size_type _size = 0;
+  size_type _capacity = 0;
+
+  void allocate(size_type n) {
+    deallocate();
+    if (n == 0) return;
+    _real = static_cast<T*>(
+        ::operator new(n * sizeof(T), std::align_val_t{alignment}));
+    try {
+      _imag = static_cast<T*>(
+          ::operator new(n * sizeof(T), std::align_val_t{alignment}));
+    } catch (...) {
+      ::operator delete(_real, std::align_val_t{alignment});
+      _real = nullptr;
+      throw;
+    }
+    _size = n;
+    _capacity = n;
+  }
+
+  void deallocate() {
+    if (_real) ::operator delete(_real, std::align_val_t{alignment});
+    if (_imag) ::operator delete(_imag, std::align_val_t{alignment});
+    _real = _imag = nullptr;
+    _size = _capacity = 0;
+  }
+};
+
+}  // namespace NumericConcepts
+
+/**
+ * @brief Common reference between a split complex proxy and std::complex.
+ * @details These specializations allow the proxy iterators to model
+ * std::indirectly_readable.
+ */
+template <typename T, typename U, template <typename> typename TQual,
+          template <typename> typename UQual>
+  requires std::same_as<std::remove_const_t<T>, U>
+struct std::basic_common_reference<NumericConcepts::SplitComplexReference<T>,
+                                   std::complex<U>, TQual, UQual> {
+  using type = std::complex<U>;
+};
+
+template <typename T, typename U, template <typename> typename TQual,
+          template <typename> typename UQual>
+  requires std::same_as<std::remove_const_t<T>, U>
+struct std::basic_common_reference<
+    std::complex<U>, NumericConcepts::SplitComplexReference<T>, TQual, UQual> {
+  using type = std::complex<U>;
+};
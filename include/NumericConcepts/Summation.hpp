@@ -0,0 +1,300 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+#include "Threading.hpp"
+
+/**
+ * @file Summation.hpp
+ * @brief Defines accurate and parallel summation of numeric ranges.
+ * @details The range is split into blocks of a fixed number of elements that
+ * does not depend on the number of threads. Each block is summed on its own
+ * and the block sums are then combined pairwise in a fixed order, so the
+ * result is bit-for-bit identical for any thread count. Ranges that are not
+ * random access and sized are summed on the calling thread using the same
+ * blocks, and so give the same result as well.
+ *
+ * Compensated summation relies on strict IEEE arithmetic and will not work
+ * if the code is compiled with `-ffast-math` or similar options.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief The number of elements in each independently summed block.
+ */
+inline constexpr std::size_t SummationBlockSize = 8192;
+
+/**
+ * @brief Summation policy that adds the elements in order.
+ * @details This is the fastest policy, with an error bound that grows
+ * linearly with the number of elements.
+ */
+struct NaiveSum {
+  template <typename T>
+  struct Accumulator {
+    T sum{0};
+
+    void add(T value) { sum += value; }
+    void merge(const Accumulator& other) { sum += other.sum; }
+    T result() const { return sum; }
+  };
+};
+
+/**
+ * @brief Summation policy that adds the elements by pairwise (cascade)
+ * summation.
+ * @details Elements are added naively in short runs, and the run sums are
+ * then combined as a binary tree. The error bound grows logarithmically with
+ * the number of elements at nearly the cost of naive summation.
+ */
+struct PairwiseSum {
+  template <typename T>
+  struct Accumulator {
+    static constexpr std::size_t run = 64;
+
+    std::array<T, 64> partials{};
+    std::size_t occupied = 0;
+    T current{0};
+    std::size_t count = 0;
+
+    void add(T value) {
+      current += value;
+      if (++count == run) {
+        push(current);
+        current = T{0};
+        count = 0;
+      }
+    }
+
+    void merge(const Accumulator& other) { push(other.result()); }
+
+    T result() const {
+      auto sum = current;
+      for (auto level = std::size_t{0}; level < partials.size(); ++level) {
+        if (occupied & (std::size_t{1} << level)) sum += partials[level];
+      }
+      return sum;
+    }
+
+   private:
+    void push(T value) {
+      auto level = std::size_t{0};
+      while (occupied & (std::size_t{1} << level)) {
+        value = partials[level] + value;
+        occupied &= ~(std::size_t{1} << level);
+        ++level;
+      }
+      partials[level] = value;
+      occupied |= std::size_t{1} << level;
+    }
+  };
+};
+
+/**
+ * @brief Summation policy using Kahan compensated summation.
+ * @details The rounding error of each addition is carried into the next one,
+ * giving an error bound independent of the number of elements provided the
+ * elements are small relative to the running sum.
+ */
+struct KahanSum {
+  template <typename T>
+  struct Accumulator {
+    T sum{0};
+    T compensation{0};
+
+    void add(T value) {
+      auto y = value - compensation;
+      auto t = sum + y;
+      compensation = (t - sum) - y;
+      sum = t;
+    }
+
+    void merge(const Accumulator& other) {
+      add(other.sum);
+      add(-other.compensation);
+    }
+
+    T result() const { return sum - compensation; }
+  };
+};
+
+/**
+ * @brief Summation policy using Neumaier's improved compensated summation.
+ * @details Unlike KahanSum, the error is captured correctly when an element
+ * is larger in magnitude than the running sum. This is the default policy.
+ */
+struct NeumaierSum {
+  template <typename T>
+  struct Accumulator {
+    T sum{0};
+    T compensation{0};
+
+    void add(T value) {
+      auto t = sum + value;
+      if (std::abs(sum) >= std::abs(value)) {
+        compensation += (sum - t) + value;
+      } else {
+        compensation += (value - t) + sum;
+      }
+      sum = t;
+    }
+
+    void merge(const Accumulator& other) {
+      add(other.sum);
+      compensation += other.compensation;
+    }
+
+    T result() const { return sum + compensation; }
+  };
+};
+
+/**
+ * @brief Concept for a summation policy over real values of type T.
+ * @tparam P The policy type to check.
+ * @tparam T The Real type being summed.
+ */
+template <typename P, typename T>
+concept SummationPolicy = requires(typename P::template Accumulator<T> a,
+                                   const typename P::template Accumulator<T> b,
+                                   T value) {
+  requires Real<T>;
+  a.add(value);
+  a.merge(b);
+  { b.result() } -> std::convertible_to<T>;
+};
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Accumulator for a range with value type T under policy P.
+ * @details Complex values are summed as independent real and imaginary parts,
+ * and integral values in 64-bit integers of the same signedness.
+ */
+template <typename P, Numeric T>
+struct SumAccumulator {
+  using Value = std::conditional_t<std::is_signed_v<T>, std::int64_t,
+                                   std::uint64_t>;
+
+  Value sum{0};
+
+  void add(T value) { sum += static_cast<Value>(value); }
+  void merge(const SumAccumulator& other) { sum += other.sum; }
+  Value result() const { return sum; }
+};
+
+template <typename P, Real T>
+struct SumAccumulator<P, T> {
+  using Precision = AccumulatorPrecision<T>;
+  using Value = Precision;
+
+  typename P::template Accumulator<Precision> accumulator;
+
+  void add(T value) { accumulator.add(static_cast<Precision>(value)); }
+  void merge(const SumAccumulator& other) {
+    accumulator.merge(other.accumulator);
+  }
+  Value result() const { return accumulator.result(); }
+};
+
+template <typename P, Complex T>
+struct SumAccumulator<P, T> {
+  using Precision = AccumulatorPrecision<T>;
+  using Value = std::complex<Precision>;
+
+  typename P::template Accumulator<Precision> real;
+  typename P::template Accumulator<Precision> imag;
+
+  void add(const T& value) {
+    real.add(static_cast<Precision>(value.real()));
+    imag.add(static_cast<Precision>(value.imag()));
+  }
+  void merge(const SumAccumulator& other) {
+    real.merge(other.real);
+    imag.merge(other.imag);
+  }
+  Value result() const { return {real.result(), imag.result()}; }
+};
+
+/**
+ * @internal
+ * @brief Merges block accumulators as a binary tree in a fixed order.
+ */
+template <typename A>
+A merge_pairwise(std::vector<A>& blocks) {
+  if (blocks.empty()) return A{};
+  for (auto stride = std::size_t{1}; stride < blocks.size(); stride *= 2) {
+    for (auto i = std::size_t{0}; i + stride < blocks.size(); i += 2 * stride) {
+      blocks[i].merge(blocks[i + stride]);
+    }
+  }
+  return blocks.front();
+}
+
+}  // namespace Detail
+
+/**
+ * @brief Sums the elements of a numeric range.
+ * @details Random access sized ranges are summed in parallel. The result does
+ * not depend on the number of threads used. Real and complex values are
+ * accumulated in `AccumulatorPrecision` of the value type, so that 16-bit
+ * types are summed in float. Integral values are summed in `std::int64_t`
+ * or, if unsigned, `std::uint64_t`, which is exact unless the sum itself
+ * overflows that type.
+ * @tparam R The NumericRange type.
+ * @tparam P The summation policy.
+ * @param range The range to sum.
+ * @param policy The summation policy, e.g., NaiveSum, PairwiseSum, KahanSum,
+ * or NeumaierSum.
+ * @param threads The maximum number of threads, zero meaning the default.
+ * @return The sum.
+ */
+template <NumericRange R, typename P = NeumaierSum>
+  requires(Integral<std::ranges::range_value_t<R>> or
+           SummationPolicy<P, AccumulatorPrecision<RangePrecision<R>>>)
+auto sum(R&& range, P policy = {}, std::size_t threads = 0) {
+  using Accumulator = Detail::SumAccumulator<P, std::ranges::range_value_t<R>>;
+  static_cast<void>(policy);
+
+  auto blocks = std::vector<Accumulator>{};
+  if constexpr (std::ranges::random_access_range<R> and
+                std::ranges::sized_range<R>) {
+    auto n = static_cast<std::size_t>(std::ranges::size(range));
+    auto first = std::ranges::begin(range);
+    blocks.resize((n + SummationBlockSize - 1) / SummationBlockSize);
+    Detail::parallel_for(blocks.size(), threads, [&](std::size_t b) {
+      auto start = b * SummationBlockSize;
+      auto stop = std::min(n, start + SummationBlockSize);
+      auto& block = blocks[b];
+      for (auto i = start; i < stop; ++i) {
+        block.add(first[static_cast<std::ranges::range_difference_t<R>>(i)]);
+      }
+    });
+  } else {
+    auto count = SummationBlockSize;
+    for (auto&& value : range) {
+      if (count == SummationBlockSize) {
+        blocks.emplace_back();
+        count = 0;
+      }
+      blocks.back().add(value);
+      ++count;
+    }
+  }
+  return Detail::merge_pairwise(blocks).result();
+}
+
+}  // namespace NumericConcepts
@@ -0,0 +1,353 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <version>
+
+#if defined(__cpp_lib_mdspan)
+#include <mdspan>
+#endif
+
+#include "Numeric.hpp"
+
+/**
+ * @file Tensor.hpp
+ * @brief Defines concepts for multidimensional arrays of numeric values, and
+ * a lightweight non-owning TensorSpan that satisfies them.
+ * @details The concepts are structural and follow the interface of
+ * `std::mdspan`: a tensor has `element_type` and `layout_type` members, a
+ * static `rank()`, and `extent(r)`, `stride(r)` and `data_handle()`
+ * members, the last returning a pointer to the elements. `std::mdspan` with
+ * the default accessor, its reference implementations, and TensorSpan all
+ * satisfy them. The memory layout is identified from `layout_type` through
+ * the LayoutTraits customization point, which recognizes the layout tags
+ * defined here and, where available, those of `std::mdspan`.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief The memory layouts distinguished by the tensor algorithms.
+ */
+enum class LayoutKind {
+  /// Row-major: the last index varies fastest, with no padding.
+  Right,
+  /// Column-major: the first index varies fastest, with no padding.
+  Left,
+  /// Arbitrary strides, as reported by `stride(r)`.
+  Strided
+};
+
+/// Layout tag for row-major tensors.
+struct LayoutRight {};
+
+/// Layout tag for column-major tensors.
+struct LayoutLeft {};
+
+/// Layout tag for tensors with arbitrary strides.
+struct LayoutStride {};
+
+/**
+ * @brief Trait giving the LayoutKind of a layout policy.
+ * @details Unrecognized layouts are treated as strided. Specialize this
+ * trait, with a static `kind` member, to register other layout policies.
+ * @tparam Layout The layout policy type.
+ */
+template <typename Layout>
+struct LayoutTraits {
+  static constexpr LayoutKind kind = LayoutKind::Strided;
+};
+
+template <>
+struct LayoutTraits<LayoutRight> {
+  static constexpr LayoutKind kind = LayoutKind::Right;
+};
+
+template <>
+struct LayoutTraits<LayoutLeft> {
+  static constexpr LayoutKind kind = LayoutKind::Left;
+};
+
+#if defined(__cpp_lib_mdspan)
+template <>
+struct LayoutTraits<std::layout_right> {
+  static constexpr LayoutKind kind = LayoutKind::Right;
+};
+
+template <>
+struct LayoutTraits<std::layout_left> {
+  static constexpr LayoutKind kind = LayoutKind::Left;
+};
+#endif
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief The structural requirements of a tensor, on a non-reference type.
+ */
+template <typename M>
+concept TensorHelper = requires(const M& m, std::size_t r) {
+  typename M::element_type;
+  typename M::layout_type;
+  { M::rank() } -> std::convertible_to<std::size_t>;
+  { m.extent(r) } -> std::convertible_to<std::size_t>;
+  { m.stride(r) } -> std::convertible_to<std::size_t>;
+  { m.data_handle() } -> std::convertible_to<typename M::element_type*>;
+};
+
+}  // namespace Detail
+
+/**
+ * @brief Concept for an `std::mdspan`-like multidimensional view.
+ * @tparam M The type to check, possibly a reference.
+ */
+template <typename M>
+concept Tensor = Detail::TensorHelper<std::remove_cvref_t<M>>;
+
+/**
+ * @brief The value type of a tensor, its element type without cv-qualifiers.
+ * @tparam M The Tensor type.
+ */
+template <Tensor M>
+using TensorValue =
+    std::remove_cv_t<typename std::remove_cvref_t<M>::element_type>;
+
+/**
+ * @brief The LayoutKind of a tensor.
+ * @tparam M The Tensor type.
+ */
+template <Tensor M>
+inline constexpr LayoutKind TensorLayout =
+    LayoutTraits<typename std::remove_cvref_t<M>::layout_type>::kind;
+
+/**
+ * @brief Concept for a tensor of rank N.
+ * @tparam M The type to check.
+ * @tparam N The required rank.
+ */
+template <typename M, std::size_t N>
+concept TensorOfRank =
+    Tensor<M> and (std::remove_cvref_t<M>::rank() == N);
+
+/**
+ * @brief Concept for a tensor whose elements can be written.
+ * @tparam M The type to check.
+ */
+template <typename M>
+concept WritableTensor =
+    Tensor<M> and
+    not std::is_const_v<typename std::remove_cvref_t<M>::element_type>;
+
+/**
+ * @brief Concept for a rank N tensor of real values.
+ * @tparam M The type to check.
+ * @tparam N The required rank.
+ */
+template <typename M, std::size_t N>
+concept RealTensor = TensorOfRank<M, N> and Real<TensorValue<M>>;
+
+/**
+ * @brief Concept for a rank N tensor of complex values.
+ * @tparam M The type to check.
+ * @tparam N The required rank.
+ */
+template <typename M, std::size_t N>
+concept ComplexTensor = TensorOfRank<M, N> and Complex<TensorValue<M>>;
+
+/**
+ * @brief Concept for a rank N tensor of real or complex values.
+ * @tparam M The type to check.
+ * @tparam N The required rank.
+ */
+template <typename M, std::size_t N>
+concept RealOrComplexTensor = RealTensor<M, N> or ComplexTensor<M, N>;
+
+/**
+ * @brief Concept for a writable rank N tensor of real or complex values.
+ * @tparam M The type to check.
+ * @tparam N The required rank.
+ */
+template <typename M, std::size_t N>
+concept RealOrComplexWritableTensor =
+    RealOrComplexTensor<M, N> and WritableTensor<M>;
+
+/**
+ * @brief Concept for a matrix of real values.
+ * @tparam M The type to check.
+ */
+template <typename M>
+concept RealMatrix = RealTensor<M, 2>;
+
+/**
+ * @brief Concept for a matrix of complex values.
+ * @tparam M The type to check.
+ */
+template <typename M>
+concept ComplexMatrix = ComplexTensor<M, 2>;
+
+/**
+ * @brief Concept for a matrix of real or complex values.
+ * @tparam M The type to check.
+ */
+template <typename M>
+concept RealOrComplexMatrix = RealOrComplexTensor<M, 2>;
+
+/**
+ * @brief Concept for a writable matrix of real or complex values.
+ * @tparam M The type to check.
+ */
+template <typename M>
+concept RealOrComplexWritableMatrix = RealOrComplexWritableTensor<M, 2>;
+
+/**
+ * @brief Concept for a row-major tensor.
+ * @tparam M The type to check.
+ */
+template <typename M>
+concept LayoutRightTensor =
+    Tensor<M> and TensorLayout<M> == LayoutKind::Right;
+
+/**
+ * @brief Concept for a column-major tensor.
+ * @tparam M The type to check.
+ */
+template <typename M>
+concept LayoutLeftTensor = Tensor<M> and TensorLayout<M> == LayoutKind::Left;
+
+/**
+ * @brief A non-owning view of a multidimensional array with run-time
+ * extents.
+ * @details Elements are accessed with `operator()`, as for `std::mdspan` in
+ * C++20 mode. With LayoutRight or LayoutLeft the strides follow from the
+ * extents, while LayoutStride takes them explicitly.
+ * @tparam T The element type, const for a read-only view.
+ * @tparam N The rank.
+ * @tparam Layout One of LayoutRight, LayoutLeft or LayoutStride.
+ */
+template <typename T, std::size_t N, typename Layout = LayoutRight>
+  requires Numeric<std::remove_cv_t<T>> and (N > 0)
+class TensorSpan {
+ public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using layout_type = Layout;
+  using index_type = std::size_t;
+
+  TensorSpan() = default;
+
+  /**
+   * @brief Constructs a view of contiguous data with the given extents.
+   * @param data Pointer to the first element.
+   * @param extents The extent of each dimension.
+   */
+  TensorSpan(T* data, const std::array<std::size_t, N>& extents)
+    requires(not std::same_as<Layout, LayoutStride>)
+      : _data{data}, _extents{extents} {
+    auto stride = std::size_t{1};
+    for (auto r = std::size_t{0}; r < N; ++r) {
+      auto d = std::same_as<Layout, LayoutRight> ? N - 1 - r : r;
+      _strides[d] = stride;
+      stride *= _extents[d];
+    }
+  }
+
+  /**
+   * @brief Constructs a view of contiguous data with the given extents.
+   * @param data Pointer to the first element.
+   * @param extents The extent of each dimension.
+   */
+  template <std::convertible_to<std::size_t>... Extents>
+    requires(sizeof...(Extents) == N and
+             not std::same_as<Layout, LayoutStride>)
+  TensorSpan(T* data, Extents... extents)
+      : TensorSpan(data, std::array<std::size_t, N>{
+                             static_cast<std::size_t>(extents)...}) {}
+
+  /**
+   * @brief Constructs a view with explicit strides.
+   * @param data Pointer to the first element.
+   * @param extents The extent of each dimension.
+   * @param strides The distance in elements between consecutive indices
+   * along each dimension.
+   */
+  TensorSpan(T* data, const std::array<std::size_t, N>& extents,
+             const std::array<std::size_t, N>& strides)
+    requires std::same_as<Layout, LayoutStride>
+      : _data{data}, _extents{extents}, _strides{strides} {}
+
+  /// Converts a writable view to a read-only one.
+  template <typename U>
+    requires std::same_as<T, const U>
+  TensorSpan(const TensorSpan<U, N, Layout>& other)
+      : _data{other.data_handle()},
+        _extents{other.extents()},
+        _strides{other.strides()} {}
+
+  static constexpr std::size_t rank() { return N; }
+
+  std::size_t extent(std::size_t r) const { return _extents[r]; }
+  std::size_t stride(std::size_t r) const { return _strides[r]; }
+  const std::array<std::size_t, N>& extents() const { return _extents; }
+  const std::array<std::size_t, N>& strides() const { return _strides; }
+  T* data_handle() const { return _data; }
+
+  /// The number of elements.
+  std::size_t size() const {
+    auto n = std::size_t{1};
+    for (auto e : _extents) n *= e;
+    return n;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  /// Returns the element at the given indices.
+  template <std::convertible_to<std::size_t>... Indices>
+    requires(sizeof...(Indices) == N)
+  T& operator()(Indices... indices) const {
+    auto index = std::array<std::size_t, N>{
+        static_cast<std::size_t>(indices)...};
+    auto offset = std::size_t{0};
+    for (auto r = std::size_t{0}; r < N; ++r) {
+      offset += index[r] * _strides[r];
+    }
+    return _data[offset];
+  }
+
+ private:
+  T* _data = nullptr;
+  std::array<std::size_t, N> _extents{};
+  std::array<std::size_t, N> _strides{};
+};
+
+/**
+ * @brief A non-owning matrix view.
+ * @tparam T The element type, const for a read-only view.
+ * @tparam Layout One of LayoutRight, LayoutLeft or LayoutStride.
+ */
+template <typename T, typename Layout = LayoutRight>
+using MatrixSpan = TensorSpan<T, 2, Layout>;
+
+/**
+ * @brief Returns the transpose of a matrix view, without copying.
+ * @details A row-major matrix becomes column-major and vice versa.
+ * @param m The matrix.
+ * @return The transposed view.
+ */
+template <typename T, typename Layout>
+auto transpose(const MatrixSpan<T, Layout>& m) {
+  auto extents = std::array<std::size_t, 2>{m.extent(1), m.extent(0)};
+  if constexpr (std::same_as<Layout, LayoutRight>) {
+    return MatrixSpan<T, LayoutLeft>(m.data_handle(), extents);
+  } else if constexpr (std::same_as<Layout, LayoutLeft>) {
+    return MatrixSpan<T, LayoutRight>(m.data_handle(), extents);
+  } else {
+    return MatrixSpan<T, LayoutStride>(
+        m.data_handle(), extents,
+        std::array<std::size_t, 2>{m.stride(1), m.stride(0)});
+  }
+}
+
+}  // namespace NumericConcepts
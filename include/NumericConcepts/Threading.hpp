@@ -0,0 +1,336 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<pthread.h>)
+#include <pthread.h>
+#include <sched.h>
+#define NUMERIC_CONCEPTS_HAS_AFFINITY 1
+#endif
+
+/**
+ * @file Threading.hpp
+ * @brief Defines the threading utilities shared by the library's parallel
+ * algorithms.
+ * @details Parallel work runs on a ThreadPool whose workers each own a task
+ * deque. A worker pops its own newest task and, when idle, steals the oldest
+ * task of another worker, so recursively split work spreads out across the
+ * pool. A thread waiting for tasks it submitted runs pending tasks in the
+ * meantime, which makes nested parallelism safe, and sleeps while none are
+ * queued.
+ */
+
+namespace NumericConcepts {
+
+/**
+ * @brief Returns the number of threads used when a parallel algorithm is
+ * passed a thread count of zero.
+ * @return The hardware concurrency, or one if it cannot be determined.
+ */
+inline std::size_t default_thread_count() {
+  return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Options for constructing a ThreadPool.
+ */
+struct ThreadPoolOptions {
+  /// The number of threads including the caller, zero meaning the default.
+  std::size_t threads = 0;
+  /// Pin each worker to its own CPU. Only supported on Linux.
+  bool pin_threads = false;
+};
+
+/**
+ * @brief A work-stealing pool of worker threads.
+ * @details A pool constructed for n threads starts n - 1 workers, since the
+ * thread that submits work also runs tasks while it waits. Tasks submitted
+ * from a worker go to that worker's deque, and tasks submitted from other
+ * threads are shared out between the deques in turn.
+ */
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  explicit ThreadPool(const ThreadPoolOptions& options = {}) {
+    auto threads = options.threads ? options.threads : default_thread_count();
+    _queues = std::vector<Queue>(std::max<std::size_t>(threads - 1, 1));
+    _workers.reserve(threads - 1);
+    for (auto i = std::size_t{0}; i + 1 < threads; ++i) {
+      _workers.emplace_back([this, i]() { work(i); });
+      if (options.pin_threads) pin(_workers.back(), i + 1);
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool() {
+    {
+      auto lock = std::scoped_lock(_mutex);
+      _stopped = true;
+    }
+    _cv.notify_all();
+    for (auto& worker : _workers) worker.join();
+  }
+
+  /// Returns the pool used by the library's parallel algorithms.
+  static ThreadPool& global() {
+    static auto pool = ThreadPool();
+    return pool;
+  }
+
+  /// The number of threads that run tasks, including a waiting caller.
+  std::size_t concurrency() const { return _workers.size() + 1; }
+
+  /// Queues a task for execution.
+  void submit(Task task) {
+    auto index = current() == this ? _index
+                                   : _next_queue++ % _queues.size();
+    {
+      auto lock = std::scoped_lock(_mutex);
+      ++_queued;
+    }
+    {
+      auto& queue = _queues[index];
+      auto lock = std::scoped_lock(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+    }
+    _cv.notify_one();
+  }
+
+  /**
+   * @brief Runs one queued task on the calling thread, if there is one.
+   * @return True if a task was run.
+   */
+  bool run_pending() {
+    auto home = current() == this ? _index : std::size_t{0};
+    auto task = take(home);
+    if (!task) return false;
+    task();
+    return true;
+  }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<Queue> _queues;
+  std::vector<std::thread> _workers;
+  std::atomic<std::size_t> _next_queue{0};
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::size_t _queued = 0;
+  bool _stopped = false;
+
+  static inline thread_local ThreadPool* _current = nullptr;
+  static inline thread_local std::size_t _index = 0;
+
+  static ThreadPool* current() { return _current; }
+
+  /// Pops the newest task from the home deque, or steals the oldest task
+  /// from another deque.
+  Task take(std::size_t home) {
+    auto task = Task{};
+    for (auto k = std::size_t{0}; k < _queues.size() && !task; ++k) {
+      auto& queue = _queues[(home + k) % _queues.size()];
+      auto lock = std::scoped_lock(queue.mutex);
+      if (queue.tasks.empty()) continue;
+      if (k == 0) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+    }
+    if (task) {
+      auto lock = std::scoped_lock(_mutex);
+      --_queued;
+    }
+    return task;
+  }
+
+  void work(std::size_t index) {
+    _current = this;
+    _index = index;
+    while (true) {
+      if (auto task = take(index)) {
+        task();
+        continue;
+      }
+      auto lock = std::unique_lock(_mutex);
+      _cv.wait(lock, [&]() { return _stopped || _queued > 0; });
+      if (_stopped && _queued == 0) return;
+    }
+  }
+
+  static void pin([[maybe_unused]] std::thread& thread,
+                  [[maybe_unused]] std::size_t slot) {
+#if defined(NUMERIC_CONCEPTS_HAS_AFFINITY)
+    auto allowed = cpu_set_t{};
+    if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+    auto count = static_cast<std::size_t>(CPU_COUNT(&allowed));
+    if (count == 0) return;
+    auto target = slot % count;
+    for (auto cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (!CPU_ISSET(cpu, &allowed) || target-- > 0) continue;
+      auto set = cpu_set_t{};
+      CPU_ZERO(&set);
+      CPU_SET(cpu, &set);
+      ::pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+      return;
+    }
+#endif
+  }
+};
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief A set of tasks submitted to a pool that can be waited for together.
+ * @details Once a task has thrown, tasks that have not yet started are
+ * skipped, and wait() rethrows the first exception.
+ */
+class TaskGroup {
+ public:
+  explicit TaskGroup(ThreadPool& pool) : _pool{&pool} {}
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  ~TaskGroup() { drain(); }
+
+  /// Submits f to the pool.
+  template <typename F>
+  void run(F f) {
+    {
+      auto lock = std::scoped_lock(_mutex);
+      ++_pending;
+    }
+    _pool->submit([this, f = std::move(f)]() mutable {
+      call(f);
+      // Notifying under the lock keeps the group alive until the waiter
+      // has been woken.
+      auto lock = std::scoped_lock(_mutex);
+      --_pending;
+      _cv.notify_all();
+    });
+  }
+
+  /// Runs f on the calling thread, capturing any exception.
+  template <typename F>
+  void call(F&& f) {
+    if (_failed) return;
+    try {
+      f();
+    } catch (...) {
+      auto lock = std::scoped_lock(_mutex);
+      if (!_error) _error = std::current_exception();
+      _failed = true;
+    }
+  }
+
+  /// Waits for all submitted tasks, rethrowing the first exception.
+  void wait() {
+    drain();
+    if (_error) std::rethrow_exception(std::exchange(_error, nullptr));
+  }
+
+  bool failed() const { return _failed; }
+
+ private:
+  ThreadPool* _pool;
+  std::size_t _pending = 0;
+  std::atomic<bool> _failed{false};
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::exception_ptr _error;
+
+  /// Runs queued tasks while there are any, and otherwise sleeps until one
+  /// of the group's tasks finishes, since it may have queued more.
+  void drain() {
+    auto lock = std::unique_lock(_mutex);
+    while (_pending > 0) {
+      lock.unlock();
+      auto ran = _pool->run_pending();
+      lock.lock();
+      if (!ran && _pending > 0) _cv.wait(lock);
+    }
+  }
+};
+
+/**
+ * @internal
+ * @brief Calls f(first, last) on subranges covering [0, count), splitting
+ * recursively in halves until subranges have at most `grain` elements.
+ */
+template <typename F>
+void parallel_range(ThreadPool& pool, std::size_t count, std::size_t grain,
+                    F&& f) {
+  grain = std::max<std::size_t>(grain, 1);
+  if (count <= grain || pool.concurrency() == 1) {
+    if (count > 0) f(std::size_t{0}, count);
+    return;
+  }
+  auto group = TaskGroup(pool);
+  auto split = [&](auto& self, std::size_t first, std::size_t last) -> void {
+    while (last - first > grain && !group.failed()) {
+      auto mid = first + (last - first) / 2;
+      group.run([&self, mid, last]() { self(self, mid, last); });
+      last = mid;
+    }
+    f(first, last);
+  };
+  group.call([&]() { split(split, 0, count); });
+  group.wait();
+}
+
+/**
+ * @internal
+ * @brief Calls f(i) for each i in [0, count) using up to `threads` threads.
+ * @details Tasks are handed out dynamically, so the mapping of tasks to
+ * threads is unspecified. Callers that need reproducible results must make
+ * each task's output depend only on its index. The first exception thrown by
+ * a task is rethrown on the calling thread once all threads have finished.
+ * @param count The number of tasks.
+ * @param threads The maximum number of threads, zero meaning the default.
+ * @param f The task, invocable with a std::size_t.
+ */
+template <typename F>
+void parallel_for(std::size_t count, std::size_t threads, F&& f) {
+  auto& pool = ThreadPool::global();
+  if (threads == 0) threads = pool.concurrency();
+  threads = std::min(threads, count);
+  if (threads <= 1) {
+    for (auto i = std::size_t{0}; i < count; ++i) f(i);
+    return;
+  }
+
+  auto next = std::atomic<std::size_t>{0};
+  auto group = TaskGroup(pool);
+  auto work = [&]() {
+    for (auto i = next++; i < count && !group.failed(); i = next++) f(i);
+  };
+  for (auto t = std::size_t{1}; t < threads; ++t) group.run(work);
+  group.call(work);
+  group.wait();
+}
+
+}  // namespace Detail
+
+}  // namespace NumericConcepts
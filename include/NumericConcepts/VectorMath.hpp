@@ -0,0 +1,482 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Numeric.hpp"
+#include "Ranges.hpp"
+
+/**
+ * @file VectorMath.hpp
+ * @brief Defines vectorized elementwise transcendental functions over numeric
+ * ranges.
+ * @details The kernels follow the fdlibm algorithms, are written once with
+ * GCC vector extensions and are compiled for SSE4.2, AVX2 with FMA, and
+ * AVX-512, and the widest instruction set reported by CPUID is chosen at run
+ * time. Binaries therefore use AVX-512
+ * where it is available without being built with `-march=native`. Float
+ * elements are widened to double in registers, so both precisions share the
+ * double kernels and float results are almost always correctly rounded.
+ *
+ * Elements outside each kernel's reduced domain, e.g., overflowing, subnormal,
+ * infinite or NaN arguments, are recomputed with the `std` functions, so
+ * every special value matches the standard library. The measured bounds on
+ * the remaining elements, in units in the last place of the result, are:
+ *
+ * | Function | double | float |
+ * | :------- | -----: | ----: |
+ * | `vector_exp`, `vector_log` | 1 | 1 |
+ * | `vector_sin`, `vector_cos` | 1 | 1 |
+ * | `vector_sqrt` | 0.5 | 0.5 |
+ * | `vector_pow` | 1 | 1 |
+ * | complex `vector_exp`, per component | 2.5 | 1 |
+ * | `vector_abs` | 1.5 | 1 |
+ * | `vector_arg` | 2 | 1 |
+ *
+ * The dispatch needs GCC on x86-64. Other compilers and targets, long double
+ * and other real types, and builds defining `NUMERIC_CONCEPTS_NO_SIMD` call
+ * the `std` functions element by element. The extended types of ExtendedReal
+ * have no `std` overloads and are evaluated in long double, so `__float128`
+ * results are only as accurate as long double.
+ */
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && \
+    !defined(NUMERIC_CONCEPTS_NO_SIMD)
+#define NUMERIC_CONCEPTS_VECTOR_MATH_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace NumericConcepts {
+
+/**
+ * @brief The instruction sets that the vectorized math kernels target.
+ * @details The enumerators are ordered, each implying those before it.
+ */
+enum class InstructionSet { Scalar, Sse42, Avx2, Avx512 };
+
+/**
+ * @brief Returns the widest instruction set the kernels can use on this CPU.
+ * @details The CPU is queried once, and the result is cached.
+ */
+inline InstructionSet supported_instruction_set() {
+#ifdef NUMERIC_CONCEPTS_VECTOR_MATH_DISPATCH
+  static const auto isa = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return InstructionSet::Avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+      return InstructionSet::Avx2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) return InstructionSet::Sse42;
+    return InstructionSet::Scalar;
+  }();
+  return isa;
+#else
+  return InstructionSet::Scalar;
+#endif
+}
+
+/**
+ * @brief Options for the vectorized math functions.
+ */
+struct VectorMathOptions {
+  /// The widest instruction set to use, if the CPU supports it.
+  InstructionSet limit = InstructionSet::Avx512;
+};
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Concept for the element types with vectorized kernels.
+ */
+template <typename T>
+concept VectorMathReal = Float<T> or Double<T>;
+
+/**
+ * @internal
+ * @brief Returns the instruction set the options select on this CPU.
+ */
+inline InstructionSet vector_math_isa(const VectorMathOptions& options) {
+  return std::min(options.limit, supported_instruction_set());
+}
+
+/**
+ * @internal
+ * @brief The type in which the scalar complex functions are evaluated, which
+ * widens float so that the fallback meets the kernels' float bounds.
+ */
+template <typename T>
+using VectorMathWide = std::conditional_t<Float<T>, double, T>;
+
+/**
+ * @internal
+ * @brief The type in which the scalar real functions are evaluated, which is
+ * long double for the extended types that the `std` functions do not accept.
+ */
+template <typename T>
+using VectorMathScalar = std::conditional_t<ExtendedReal<T>, long double, T>;
+
+/**
+ * @internal
+ * @brief The scalar functions, which define the results outside the kernels'
+ * domains and for the types without kernels.
+ */
+struct ExpFunction {
+  template <typename T>
+  static T scalar(T x) {
+    using std::exp;
+    return static_cast<T>(exp(static_cast<VectorMathScalar<T>>(x)));
+  }
+};
+
+struct LogFunction {
+  template <typename T>
+  static T scalar(T x) {
+    using std::log;
+    return static_cast<T>(log(static_cast<VectorMathScalar<T>>(x)));
+  }
+};
+
+struct SinFunction {
+  template <typename T>
+  static T scalar(T x) {
+    using std::sin;
+    return static_cast<T>(sin(static_cast<VectorMathScalar<T>>(x)));
+  }
+};
+
+struct CosFunction {
+  template <typename T>
+  static T scalar(T x) {
+    using std::cos;
+    return static_cast<T>(cos(static_cast<VectorMathScalar<T>>(x)));
+  }
+};
+
+struct SqrtFunction {
+  template <typename T>
+  static T scalar(T x) {
+    using std::sqrt;
+    return static_cast<T>(sqrt(static_cast<VectorMathScalar<T>>(x)));
+  }
+};
+
+struct PowFunction {
+  template <typename T>
+  static T scalar(T x, T y) {
+    using std::pow;
+    using U = VectorMathScalar<T>;
+    return static_cast<T>(pow(static_cast<U>(x), static_cast<U>(y)));
+  }
+};
+
+struct ComplexExpFunction {
+  template <typename T>
+  static std::complex<T> scalar(std::complex<T> z) {
+    auto w = std::complex<VectorMathWide<T>>(z);
+    return static_cast<std::complex<T>>(std::exp(w));
+  }
+};
+
+struct AbsFunction {
+  template <typename T>
+  static T scalar(std::complex<T> z) {
+    auto w = std::complex<VectorMathWide<T>>(z);
+    return static_cast<T>(std::abs(w));
+  }
+};
+
+struct ArgFunction {
+  template <typename T>
+  static T scalar(std::complex<T> z) {
+    auto w = std::complex<VectorMathWide<T>>(z);
+    return static_cast<T>(std::arg(w));
+  }
+};
+
+}  // namespace Detail
+
+}  // namespace NumericConcepts
+
+#ifdef NUMERIC_CONCEPTS_VECTOR_MATH_DISPATCH
+
+#pragma GCC push_options
+#pragma GCC target("sse4.2")
+#define NUMERIC_CONCEPTS_VECTOR_BYTES 16
+namespace NumericConcepts::Detail::Sse42 {
+#include "VectorMathKernels.hpp"
+}
+#undef NUMERIC_CONCEPTS_VECTOR_BYTES
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#define NUMERIC_CONCEPTS_VECTOR_BYTES 32
+namespace NumericConcepts::Detail::Avx2 {
+#include "VectorMathKernels.hpp"
+}
+#undef NUMERIC_CONCEPTS_VECTOR_BYTES
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#define NUMERIC_CONCEPTS_VECTOR_BYTES 64
+namespace NumericConcepts::Detail::Avx512 {
+#include "VectorMathKernels.hpp"
+}
+#undef NUMERIC_CONCEPTS_VECTOR_BYTES
+#pragma GCC pop_options
+
+#endif
+
+namespace NumericConcepts {
+
+namespace Detail {
+
+/**
+ * @internal
+ * @brief Applies a function's scalar form element by element.
+ */
+template <typename Function, typename In, typename Out>
+void scalar_apply(std::size_t n, const In* x, Out* y) {
+  for (auto i = std::size_t{0}; i < n; ++i) y[i] = Function::scalar(x[i]);
+}
+
+template <typename Function, typename T>
+void scalar_apply(std::size_t n, const T* x, const T* z, T* y) {
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    y[i] = Function::scalar(x[i], z[i]);
+  }
+}
+
+/**
+ * @internal
+ * @brief Applies a function to n elements with the kernels for the
+ * instruction set selected by the options, with T the real element type.
+ */
+template <typename Function, typename T, typename... Args>
+void dispatch_function([[maybe_unused]] const VectorMathOptions& options,
+                       std::size_t n, Args... args) {
+#ifdef NUMERIC_CONCEPTS_VECTOR_MATH_DISPATCH
+  if constexpr (VectorMathReal<T>) {
+    switch (vector_math_isa(options)) {
+      case InstructionSet::Avx512:
+        return Avx512::apply<Function>(n, args...);
+      case InstructionSet::Avx2:
+        return Avx2::apply<Function>(n, args...);
+      case InstructionSet::Sse42:
+        return Sse42::apply<Function>(n, args...);
+      case InstructionSet::Scalar:
+        break;
+    }
+  }
+#endif
+  scalar_apply<Function>(n, args...);
+}
+
+/**
+ * @internal
+ * @brief The number of elements staged at a time for ranges that are not
+ * contiguous.
+ */
+inline constexpr std::size_t VectorMathBlock = 256;
+
+/**
+ * @internal
+ * @brief Applies a function to the input ranges, writing to the output range.
+ * @details Contiguous ranges of In and Out are passed to the kernels
+ * directly, and other ranges are staged in blocks.
+ * @return The number of elements written, the length of the shortest range.
+ */
+template <typename Function, typename Out, typename... In, typename OutRange,
+          typename... InRanges>
+std::size_t map_function(const VectorMathOptions& options, OutRange&& out,
+                         InRanges&&... in) {
+  constexpr auto direct =
+      (ContiguousRange<InRanges> and ...) and ContiguousRange<OutRange> and
+      (std::ranges::sized_range<InRanges> and ...) and
+      std::ranges::sized_range<OutRange> and
+      (std::same_as<std::ranges::range_value_t<InRanges>, In> and ...) and
+      std::same_as<std::ranges::range_value_t<OutRange>, Out>;
+  using T = RemoveComplex<Out>;
+  if constexpr (direct) {
+    auto n = std::min(
+        {static_cast<std::size_t>(std::ranges::size(out)),
+         static_cast<std::size_t>(std::ranges::size(in))...});
+    dispatch_function<Function, T>(
+        options, n, static_cast<const In*>(std::ranges::data(in))...,
+        std::ranges::data(out));
+    return n;
+  } else {
+    auto inputs = std::tuple{std::ranges::begin(in)...};
+    auto ends = std::tuple{std::ranges::end(in)...};
+    auto buffers = std::tuple<std::array<In, VectorMathBlock>...>{};
+    auto results = std::array<Out, VectorMathBlock>{};
+    auto oi = std::ranges::begin(out);
+    auto total = std::size_t{0};
+    auto block = [&]<std::size_t... I>(std::index_sequence<I...>) {
+      auto count = std::size_t{0};
+      for (; count < VectorMathBlock and
+             ((std::get<I>(inputs) != std::get<I>(ends)) and ...);
+           ++count) {
+        ((std::get<I>(buffers)[count] =
+              static_cast<In>(*std::get<I>(inputs)++)),
+         ...);
+      }
+      dispatch_function<Function, T>(
+          options, count,
+          static_cast<const In*>(std::get<I>(buffers).data())...,
+          results.data());
+      return count;
+    };
+    auto count = VectorMathBlock;
+    while (count == VectorMathBlock) {
+      count = block(std::index_sequence_for<In...>{});
+      for (auto j = std::size_t{0}; j < count; ++j, ++oi, ++total) {
+        if (oi == std::ranges::end(out)) return total;
+        *oi = results[j];
+      }
+    }
+    return total;
+  }
+}
+
+}  // namespace Detail
+
+/**
+ * @brief Writes the exponential of each element of a real range to another
+ * range.
+ * @details Elements are transformed until either range is exhausted, and the
+ * ranges may be the same.
+ * @param in The input range.
+ * @param out The output range.
+ * @param options The widest instruction set to use.
+ * @return The number of elements written.
+ */
+template <RealRange In, RealWritableRange Out>
+std::size_t vector_exp(In&& in, Out&& out,
+                       const VectorMathOptions& options = {}) {
+  using T = std::ranges::range_value_t<In>;
+  return Detail::map_function<Detail::ExpFunction, T, T>(options, out, in);
+}
+
+/**
+ * @brief Writes the natural logarithm of each element of a real range to
+ * another range.
+ * @details As vector_exp.
+ */
+template <RealRange In, RealWritableRange Out>
+std::size_t vector_log(In&& in, Out&& out,
+                       const VectorMathOptions& options = {}) {
+  using T = std::ranges::range_value_t<In>;
+  return Detail::map_function<Detail::LogFunction, T, T>(options, out, in);
+}
+
+/**
+ * @brief Writes the sine of each element of a real range to another range.
+ * @details As vector_exp.
+ */
+template <RealRange In, RealWritableRange Out>
+std::size_t vector_sin(In&& in, Out&& out,
+                       const VectorMathOptions& options = {}) {
+  using T = std::ranges::range_value_t<In>;
+  return Detail::map_function<Detail::SinFunction, T, T>(options, out, in);
+}
+
+/**
+ * @brief Writes the cosine of each element of a real range to another range.
+ * @details As vector_exp.
+ */
+template <RealRange In, RealWritableRange Out>
+std::size_t vector_cos(In&& in, Out&& out,
+                       const VectorMathOptions& options = {}) {
+  using T = std::ranges::range_value_t<In>;
+  return Detail::map_function<Detail::CosFunction, T, T>(options, out, in);
+}
+
+/**
+ * @brief Writes the square root of each element of a real range to another
+ * range.
+ * @details As vector_exp.
+ */
+template <RealRange In, RealWritableRange Out>
+std::size_t vector_sqrt(In&& in, Out&& out,
+                        const VectorMathOptions& options = {}) {
+  using T = std::ranges::range_value_t<In>;
+  return Detail::map_function<Detail::SqrtFunction, T, T>(options, out, in);
+}
+
+/**
+ * @brief Writes each element of a real range raised to the power of the
+ * matching element of another to a third range.
+ * @details Elements are transformed until any range is exhausted, and the
+ * output may be either input. The elements are converted to the wider of
+ * the inputs' precisions.
+ * @param base The bases.
+ * @param exponent The exponents.
+ * @param out The output range.
+ * @param options The widest instruction set to use.
+ * @return The number of elements written.
+ */
+template <RealRange Base, RealRange Exponent, RealWritableRange Out>
+std::size_t vector_pow(Base&& base, Exponent&& exponent, Out&& out,
+                       const VectorMathOptions& options = {}) {
+  using T = RangePromotePrecision<Base, Exponent>;
+  return Detail::map_function<Detail::PowFunction, T, T, T>(options, out, base,
+                                                            exponent);
+}
+
+/**
+ * @brief Writes the exponential of each element of a complex range to another
+ * range.
+ * @details As the real vector_exp.
+ */
+template <ComplexRange In, ComplexWritableRange Out>
+std::size_t vector_exp(In&& in, Out&& out,
+                       const VectorMathOptions& options = {}) {
+  using Z = std::ranges::range_value_t<In>;
+  return Detail::map_function<Detail::ComplexExpFunction, Z, Z>(options, out,
+                                                                in);
+}
+
+/**
+ * @brief Writes the magnitude of each element of a complex range to a real
+ * range.
+ * @details Elements are transformed until either range is exhausted.
+ * @param in The input range.
+ * @param out The output range.
+ * @param options The widest instruction set to use.
+ * @return The number of elements written.
+ */
+template <ComplexRange In, RealWritableRange Out>
+std::size_t vector_abs(In&& in, Out&& out,
+                       const VectorMathOptions& options = {}) {
+  using Z = std::ranges::range_value_t<In>;
+  return Detail::map_function<Detail::AbsFunction, RemoveComplex<Z>, Z>(
+      options, out, in);
+}
+
+/**
+ * @brief Writes the phase angle of each element of a complex range, in
+ * [-pi, pi], to a real range.
+ * @details As vector_abs.
+ */
+template <ComplexRange In, RealWritableRange Out>
+std::size_t vector_arg(In&& in, Out&& out,
+                       const VectorMathOptions& options = {}) {
+  using Z = std::ranges::range_value_t<In>;
+  return Detail::map_function<Detail::ArgFunction, RemoveComplex<Z>, Z>(
+      options, out, in);
+}
+
+}  // namespace NumericConcepts
@@ -0,0 +1,532 @@
+// No include guard: VectorMath.hpp includes this file once for each
+// instruction set, inside a namespace and a `#pragma GCC target` region, with
+// NUMERIC_CONCEPTS_VECTOR_BYTES defined as the width of its registers.
+
+/**
+ * @file VectorMathKernels.hpp
+ * @internal
+ * @brief Defines the vector kernels behind VectorMath.hpp for one instruction
+ * set.
+ * @details Compiling every function here for the instruction set, rather
+ * than inlining generic code into a single entry point, keeps GCC from
+ * passing the wide vectors through the baseline ABI. The kernels follow
+ * fdlibm, whose error bounds they inherit.
+ */
+
+/**
+ * @internal
+ * @brief A register of doubles, the float vector with the same number of
+ * lanes, and the mask type of comparisons.
+ */
+typedef double Real __attribute__((vector_size(NUMERIC_CONCEPTS_VECTOR_BYTES)));
+typedef float Narrow
+    __attribute__((vector_size(NUMERIC_CONCEPTS_VECTOR_BYTES / 2)));
+using Mask = decltype(Real{} < Real{});
+typedef std::uint64_t Unsigned
+    __attribute__((vector_size(NUMERIC_CONCEPTS_VECTOR_BYTES)));
+
+inline constexpr std::size_t lanes = sizeof(Real) / sizeof(double);
+
+inline Mask bits(Real x) { return __builtin_bit_cast(Mask, x); }
+
+inline Real from_bits(Mask x) { return __builtin_bit_cast(Real, x); }
+
+// Shifts in zeros, as only AVX-512 has arithmetic shifts of 64-bit lanes.
+inline Mask shift_right(Mask x, int count) {
+  return __builtin_bit_cast(Mask, __builtin_bit_cast(Unsigned, x) >> count);
+}
+
+inline Real select(Mask mask, Real a, Real b) {
+  return from_bits((mask & bits(a)) | (~mask & bits(b)));
+}
+
+inline Real fabs(Real x) { return from_bits(bits(x) & 0x7fffffffffffffff); }
+
+inline Real sqrt(Real x) {
+#if NUMERIC_CONCEPTS_VECTOR_BYTES == 64
+  // Merging into x avoids _mm512_sqrt_pd's undefined source register.
+  return _mm512_mask_sqrt_pd(x, 0xff, x);
+#elif NUMERIC_CONCEPTS_VECTOR_BYTES == 32
+  return _mm256_sqrt_pd(x);
+#else
+  return _mm_sqrt_pd(x);
+#endif
+}
+
+// Clears the low 32 bits, leaving 21 significant bits whose products with
+// other truncated values are exact.
+inline Real truncate(Real x) {
+  return from_bits(bits(x) & static_cast<std::int64_t>(0xffffffff00000000));
+}
+
+inline bool any(Mask mask) {
+  auto result = std::int64_t{0};
+  for (auto i = std::size_t{0}; i < lanes; ++i) result |= mask[i];
+  return result != 0;
+}
+
+// Adding and subtracting 1.5 * 2^52 rounds |x| < 2^51 to the nearest
+// integer, and the difference of the bits of the sum and of 1.5 * 2^52 is
+// that integer.
+inline constexpr double RoundingShift = 0x1.8p52;
+inline constexpr std::int64_t RoundingShiftBits = 0x4338000000000000;
+
+inline Real round_nearest(Real x, Mask& n) {
+  auto shifted = x + RoundingShift;
+  n = bits(shifted) - RoundingShiftBits;
+  return shifted - RoundingShift;
+}
+
+inline Real to_real(Mask n) {
+  return from_bits(n + RoundingShiftBits) - RoundingShift;
+}
+
+// Multiplies x by 2^n, assuming that the result is normal.
+inline Real scale(Real x, Mask n) { return from_bits(bits(x) + (n << 52)); }
+
+/**
+ * @internal
+ * @brief Returns exp(x) for x in [-708, 709], after fdlibm's e_exp.c.
+ */
+inline Real exp_kernel(Real x) {
+  constexpr auto inv_ln2 = 1.44269504088896338700e+00;
+  constexpr auto ln2_hi = 6.93147180369123816490e-01;
+  constexpr auto ln2_lo = 1.90821492927058770002e-10;
+  constexpr auto p1 = 1.66666666666666019037e-01;
+  constexpr auto p2 = -2.77777777770155933842e-03;
+  constexpr auto p3 = 6.61375632143793436117e-05;
+  constexpr auto p4 = -1.65339022054652515390e-06;
+  constexpr auto p5 = 4.13813679705723846039e-08;
+  auto n = Mask{};
+  auto k = round_nearest(x * inv_ln2, n);
+  auto hi = x - k * ln2_hi;
+  auto lo = k * ln2_lo;
+  auto r = hi - lo;
+  auto t = r * r;
+  auto c = r - t * (p1 + t * (p2 + t * (p3 + t * (p4 + t * p5))));
+  auto y = 1.0 - ((lo - (r * c) / (2.0 - c)) - hi);
+  return scale(y, n);
+}
+
+/**
+ * @internal
+ * @brief Returns log(x) for positive normal x, after fdlibm's e_log.c.
+ */
+inline Real log_kernel(Real x) {
+  constexpr auto ln2_hi = 6.93147180369123816490e-01;
+  constexpr auto ln2_lo = 1.90821492927058770002e-10;
+  constexpr auto lg1 = 6.666666666666735130e-01;
+  constexpr auto lg2 = 3.999999999940941908e-01;
+  constexpr auto lg3 = 2.857142874366239149e-01;
+  constexpr auto lg4 = 2.222219843214978396e-01;
+  constexpr auto lg5 = 1.818357216161805012e-01;
+  constexpr auto lg6 = 1.531383769920937332e-01;
+  constexpr auto lg7 = 1.479819860511658591e-01;
+  // Writes x = 2^k m with m in [sqrt(2) / 2, sqrt(2)).
+  constexpr auto sqrt_half = std::int64_t{0x3fe6a09e667f3bcd};
+  constexpr auto one = std::int64_t{0x3ff0000000000000};
+  auto u = bits(x) + (one - sqrt_half);
+  auto m = from_bits((u & 0x000fffffffffffff) + sqrt_half);
+  auto k = to_real(shift_right(u, 52) - 1023);
+  auto f = m - 1.0;
+  auto hfsq = 0.5 * f * f;
+  auto s = f / (2.0 + f);
+  auto z = s * s;
+  auto w = z * z;
+  auto t1 = w * (lg2 + w * (lg4 + w * lg6));
+  auto t2 = z * (lg1 + w * (lg3 + w * (lg5 + w * lg7)));
+  auto r = t2 + t1;
+  return k * ln2_hi - ((hfsq - (s * (hfsq + r) + k * ln2_lo)) - f);
+}
+
+/**
+ * @internal
+ * @brief Reduces |x| <= 2^20 to hi + lo in [-pi/4, pi/4] and the quadrant n.
+ * @details Each part of pi/2 but the last has 33 bits, so its products with
+ * n are exact, and the differences are accumulated with two-sums.
+ */
+inline void reduce_pio2(Real x, Real& hi, Real& lo, Mask& n) {
+  constexpr auto two_over_pi = 6.36619772367581382433e-01;
+  constexpr auto pio2_1 = 1.57079632673412561417e+00;
+  constexpr auto pio2_2 = 6.07710050630396597660e-11;
+  constexpr auto pio2_3 = 2.02226624871116645580e-21;
+  constexpr auto pio2_3t = 8.47842766036889956997e-32;
+  auto k = round_nearest(x * two_over_pi, n);
+  auto a = x - k * pio2_1;
+  auto w = k * pio2_2;
+  auto s = a - w;
+  auto v = s - a;
+  auto e = (a - (s - v)) - (w + v);
+  w = k * pio2_3;
+  auto s2 = s - w;
+  v = s2 - s;
+  e += (s - (s2 - v)) - (w + v);
+  e -= k * pio2_3t;
+  hi = s2 + e;
+  lo = e - (hi - s2);
+}
+
+/**
+ * @internal
+ * @brief Returns sin(x + y) for |x| <= pi/4 and |y| small, after fdlibm's
+ * k_sin.c.
+ */
+inline Real sin_kernel(Real x, Real y) {
+  constexpr auto s1 = -1.66666666666666324348e-01;
+  constexpr auto s2 = 8.33333333332248946124e-03;
+  constexpr auto s3 = -1.98412698298579493134e-04;
+  constexpr auto s4 = 2.75573137070700676789e-06;
+  constexpr auto s5 = -2.50507602534068634195e-08;
+  constexpr auto s6 = 1.58969099521155010221e-10;
+  auto z = x * x;
+  auto v = z * x;
+  auto r = s2 + z * (s3 + z * (s4 + z * (s5 + z * s6)));
+  return x - ((z * (0.5 * y - v * r) - y) - v * s1);
+}
+
+/**
+ * @internal
+ * @brief Returns cos(x + y) for |x| <= pi/4 and |y| small, after fdlibm's
+ * k_cos.c.
+ */
+inline Real cos_kernel(Real x, Real y) {
+  constexpr auto c1 = 4.16666666666666019037e-02;
+  constexpr auto c2 = -1.38888888888741095749e-03;
+  constexpr auto c3 = 2.48015872894767294178e-05;
+  constexpr auto c4 = -2.75573143513906633035e-07;
+  constexpr auto c5 = 2.08757232129817482790e-09;
+  constexpr auto c6 = -1.13596475577881948265e-11;
+  auto z = x * x;
+  auto r = z * (c1 + z * (c2 + z * (c3 + z * (c4 + z * (c5 + z * c6)))));
+  // Subtracting qx, which is about x^2 / 4 and exact in 1 - qx, keeps the
+  // rounding of 1 - z / 2 within half an ulp for |x| >= 0.3.
+  auto ax = fabs(x);
+  auto quarter = truncate(from_bits(bits(ax) - (std::int64_t{2} << 52)));
+  auto qx = select(ax > 0.78125, Real{} + 0.28125, quarter);
+  qx = select(ax < 0.3, Real{}, qx);
+  auto hz = 0.5 * z - qx;
+  auto a = 1.0 - qx;
+  return a - (hz - (z * r - x * y));
+}
+
+/**
+ * @internal
+ * @brief Sets s = sin(x) and c = cos(x) for |x| <= 2^20.
+ */
+inline void sincos_kernel(Real x, Real& s, Real& c) {
+  auto hi = Real{}, lo = Real{};
+  auto n = Mask{};
+  reduce_pio2(x, hi, lo, n);
+  auto ks = sin_kernel(hi, lo);
+  auto kc = cos_kernel(hi, lo);
+  auto odd = (n & 1) != 0;
+  auto sign_s = (n & 2) << 62;
+  auto sign_c = ((n + 1) & 2) << 62;
+  s = from_bits(bits(select(odd, kc, ks)) ^ sign_s);
+  c = from_bits(bits(select(odd, ks, kc)) ^ sign_c);
+}
+
+/**
+ * @internal
+ * @brief Returns x^y as 2^(y log2(x)) for positive normal x, with log2(x)
+ * and its product with y carried in extra precision, after fdlibm's e_pow.c.
+ * @details Lanes where |y log2(x)| is not below 1020 are set in special.
+ */
+inline Real pow_kernel(Real x, Real y, Mask& special) {
+  constexpr auto l1 = 5.99999999999994648725e-01;
+  constexpr auto l2 = 4.28571428578550184252e-01;
+  constexpr auto l3 = 3.33333329818377432918e-01;
+  constexpr auto l4 = 2.72728123808534006489e-01;
+  constexpr auto l5 = 2.30660745775561754067e-01;
+  constexpr auto l6 = 2.06975017800338417784e-01;
+  constexpr auto cp = 9.61796693925975554329e-01;
+  constexpr auto cp_h = 9.61796700954437255859e-01;
+  constexpr auto cp_l = -7.02846165095275826516e-09;
+  constexpr auto dp_h = 5.84962487220764160156e-01;
+  constexpr auto dp_l = 1.35003920212974897128e-08;
+  constexpr auto lg2 = 6.93147180559945286227e-01;
+  constexpr auto lg2_h = 6.93147182464599609375e-01;
+  constexpr auto lg2_l = -1.90465429995776804525e-09;
+  constexpr auto p1 = 1.66666666666666019037e-01;
+  constexpr auto p2 = -2.77777777770155933842e-03;
+  constexpr auto p3 = 6.61375632143793436117e-05;
+  constexpr auto p4 = -1.65339022054652515390e-06;
+  constexpr auto p5 = 4.13813679705723846039e-08;
+
+  // Writes x = 2^n m, with m in [1, sqrt(3/2)) taken about 1, and m in
+  // [sqrt(3/2), sqrt(3)) about 1.5.
+  auto ix = shift_right(bits(x), 32);
+  auto j = ix & 0x000fffff;
+  auto n = shift_right(ix, 20) - 0x3ff;
+  auto wide = j > 0x3988e;
+  auto high = j >= 0xbb67a;
+  auto k = wide & ~high;
+  n -= high;
+  ix = (j | 0x3ff00000) - (high & 0x00100000);
+  auto ax = from_bits(ix << 32 | (bits(x) & 0xffffffff));
+  auto bp = select(k, Real{} + 1.5, Real{} + 1.0);
+
+  // Computes s_h + s_l = (m - bp) / (m + bp) and log2(x) = t1 + t2.
+  auto u = ax - bp;
+  auto v = 1.0 / (ax + bp);
+  auto ss = u * v;
+  auto s_h = truncate(ss);
+  auto t_h = from_bits(
+      ((shift_right(ix, 1) | 0x20000000) + 0x00080000 + (k & (1 << 18))) << 32);
+  auto t_l = ax - (t_h - bp);
+  auto s_l = v * ((u - s_h * t_h) - s_h * t_l);
+  auto s2 = ss * ss;
+  auto r = s2 * s2 *
+           (l1 + s2 * (l2 + s2 * (l3 + s2 * (l4 + s2 * (l5 + s2 * l6)))));
+  r += s_l * (s_h + ss);
+  s2 = s_h * s_h;
+  t_h = truncate(3.0 + s2 + r);
+  t_l = r - ((t_h - 3.0) - s2);
+  u = s_h * t_h;
+  v = s_l * t_h + t_l * ss;
+  auto p_h = truncate(u + v);
+  auto p_l = v - (p_h - u);
+  auto z_h = cp_h * p_h;
+  auto z_l = cp_l * p_h + p_l * cp + select(k, Real{} + dp_l, Real{});
+  auto dp = select(k, Real{} + dp_h, Real{});
+  auto t = to_real(n);
+  auto t1 = truncate(((z_h + z_l) + dp) + t);
+  auto t2 = z_l - (((t1 - t) - dp) - z_h);
+
+  // Splits y into y1 + y2 and computes (y1 + y2) (t1 + t2) = p_h + p_l.
+  auto y1 = truncate(y);
+  p_l = (y - y1) * t1 + y * t2;
+  p_h = y1 * t1;
+  special |= ~(fabs(p_h + p_l) < 1020.0);
+
+  // Computes 2^(p_h + p_l) as 2^m exp((p_h + p_l - m) log(2)).
+  auto m = Mask{};
+  p_h -= round_nearest(p_h, m);
+  t = truncate(p_l + p_h);
+  u = t * lg2_h;
+  v = (p_l - (t - p_h)) * lg2 + t * lg2_l;
+  auto z = u + v;
+  auto w = v - (z - u);
+  t = z * z;
+  t1 = z - t * (p1 + t * (p2 + t * (p3 + t * (p4 + t * p5))));
+  r = (z * t1) / (t1 - 2.0) - (w + z * w);
+  return scale(1.0 - (r - z), m);
+}
+
+/**
+ * @internal
+ * @brief Returns atan(t) for t in [0, 1], after fdlibm's s_atan.c.
+ */
+inline Real atan_kernel(Real t) {
+  constexpr auto atan_hi_0 = 4.63647609000806093515e-01;
+  constexpr auto atan_hi_1 = 7.85398163397448278999e-01;
+  constexpr auto atan_lo_0 = 2.26987774529616870924e-17;
+  constexpr auto atan_lo_1 = 3.06161699786838301793e-17;
+  constexpr auto a0 = 3.33333333333329318027e-01;
+  constexpr auto a1 = -1.99999999998764832476e-01;
+  constexpr auto a2 = 1.42857142725034663711e-01;
+  constexpr auto a3 = -1.11111104054623557880e-01;
+  constexpr auto a4 = 9.09088713343650656196e-02;
+  constexpr auto a5 = -7.69187620504482999495e-02;
+  constexpr auto a6 = 6.66107313738753120669e-02;
+  constexpr auto a7 = -5.83357013379057348645e-02;
+  constexpr auto a8 = 4.97687799461593236017e-02;
+  constexpr auto a9 = -3.65315727442169155270e-02;
+  constexpr auto a10 = 1.62858201153657823623e-02;
+  // Reduces t >= 7/16 about atan(1/2) or atan(1).
+  auto middle = t >= 0.4375;
+  auto upper = t >= 0.6875;
+  auto x = select(upper, (t - 1.0) / (t + 1.0),
+                  select(middle, (2.0 * t - 1.0) / (2.0 + t), t));
+  auto hi = select(upper, Real{} + atan_hi_1,
+                   select(middle, Real{} + atan_hi_0, Real{}));
+  auto lo = select(upper, Real{} + atan_lo_1,
+                   select(middle, Real{} + atan_lo_0, Real{}));
+  auto z = x * x;
+  auto w = z * z;
+  auto s1 = z * (a0 + w * (a2 + w * (a4 + w * (a6 + w * (a8 + w * a10)))));
+  auto s2 = w * (a1 + w * (a3 + w * (a5 + w * (a7 + w * a9))));
+  return hi - ((x * (s1 + s2) - lo) - x);
+}
+
+/**
+ * @internal
+ * @brief The kernel for each function, which marks the lanes outside its
+ * domain in special.
+ */
+inline Real vector(ExpFunction, Real x, Mask& special) {
+  special = ~((x >= -708.0) & (x <= 709.0));
+  return exp_kernel(select(special, Real{}, x));
+}
+
+inline Real vector(LogFunction, Real x, Mask& special) {
+  special = ~((x >= 0x1p-1022) & (x <= 0x1.fffffffffffffp1023));
+  return log_kernel(select(special, Real{} + 1.0, x));
+}
+
+inline Real vector(SinFunction, Real x, Mask& special) {
+  special = ~(fabs(x) <= 0x1p20);
+  auto s = Real{}, c = Real{};
+  sincos_kernel(select(special, Real{}, x), s, c);
+  return s;
+}
+
+inline Real vector(CosFunction, Real x, Mask& special) {
+  special = ~(fabs(x) <= 0x1p20);
+  auto s = Real{}, c = Real{};
+  sincos_kernel(select(special, Real{}, x), s, c);
+  return c;
+}
+
+inline Real vector(SqrtFunction, Real x, Mask& special) {
+  special = Mask{};
+  return sqrt(x);
+}
+
+inline Real vector(PowFunction, Real x, Real y, Mask& special) {
+  special = ~((x >= 0x1p-1022) & (x <= 0x1.fffffffffffffp1023) &
+              (fabs(y) <= 0x1.fffffffffffffp1023));
+  return pow_kernel(select(special, Real{} + 1.0, x),
+                    select(special, Real{}, y), special);
+}
+
+inline void vector(ComplexExpFunction, Real& re, Real& im, Mask& special) {
+  special = ~((re >= -708.0) & (re <= 709.0) & (fabs(im) <= 0x1p20));
+  auto e = exp_kernel(select(special, Real{}, re));
+  auto s = Real{}, c = Real{};
+  sincos_kernel(select(special, Real{}, im), s, c);
+  re = e * c;
+  im = e * s;
+}
+
+inline Real vector(AbsFunction, Real re, Real im, Mask& special) {
+  auto ax = fabs(re);
+  auto ay = fabs(im);
+  auto m = select(ax < ay, ay, ax);
+  special = ~((m >= 0x1p-500) & (m <= 0x1p500));
+  ax = select(special, Real{}, ax);
+  ay = select(special, Real{}, ay);
+  return sqrt(ax * ax + ay * ay);
+}
+
+inline Real vector(ArgFunction, Real re, Real im, Mask& special) {
+  constexpr auto pi_hi = 3.1415926535897931160e+00;
+  constexpr auto pi_lo = 1.2246467991473531772e-16;
+  constexpr auto pio2_hi = 1.5707963267948965580e+00;
+  constexpr auto pio2_lo = 6.1232339957367658860e-17;
+  auto ax = fabs(re);
+  auto ay = fabs(im);
+  auto steep = ay > ax;
+  auto big = select(steep, ay, ax);
+  special = ~((big > 0.0) & (big <= 0x1.fffffffffffffp1023));
+  big = select(special, Real{} + 1.0, big);
+  auto t = select(special, Real{}, select(steep, ax, ay) / big);
+  auto theta = atan_kernel(t);
+  theta = select(steep, (pio2_hi - theta) + pio2_lo, theta);
+  theta = select(re < 0.0, (pi_hi - theta) + pi_lo, theta);
+  return from_bits(bits(theta) | (bits(im) & (std::int64_t{1} << 63)));
+}
+
+/**
+ * @internal
+ * @brief Loads count <= lanes elements of x, padding with a value in every
+ * kernel's domain.
+ */
+template <VectorMathReal T>
+Real load(const T* x, std::size_t count) {
+  if (count == lanes) {
+    if constexpr (Double<T>) {
+      auto v = Real{};
+      std::memcpy(&v, x, sizeof(v));
+      return v;
+    } else {
+      auto v = Narrow{};
+      std::memcpy(&v, x, sizeof(v));
+      return __builtin_convertvector(v, Real);
+    }
+  }
+  auto v = Real{} + 1.0;
+  for (auto i = std::size_t{0}; i < count; ++i) v[i] = x[i];
+  return v;
+}
+
+template <VectorMathReal T>
+void store(T* y, Real v, std::size_t count) {
+  if (count == lanes) {
+    if constexpr (Double<T>) {
+      std::memcpy(y, &v, sizeof(v));
+    } else {
+      auto w = __builtin_convertvector(v, Narrow);
+      std::memcpy(y, &w, sizeof(w));
+    }
+    return;
+  }
+  for (auto i = std::size_t{0}; i < count; ++i) y[i] = static_cast<T>(v[i]);
+}
+
+/**
+ * @internal
+ * @brief Applies a function's kernel to n elements, recomputing the special
+ * lanes with its scalar function.
+ * @details Each block of lanes is read before it is written, so the output
+ * may be an input.
+ */
+template <typename Function, VectorMathReal T>
+void apply(std::size_t n, const T* x, T* y) {
+  for (auto i = std::size_t{0}; i < n; i += lanes) {
+    auto count = std::min(lanes, n - i);
+    auto a = load(x + i, count);
+    auto special = Mask{};
+    store(y + i, vector(Function{}, a, special), count);
+    if (!any(special)) continue;
+    for (auto l = std::size_t{0}; l < count; ++l) {
+      if (special[l]) y[i + l] = Function::scalar(static_cast<T>(a[l]));
+    }
+  }
+}
+
+template <typename Function, VectorMathReal T>
+void apply(std::size_t n, const T* x, const T* z, T* y) {
+  for (auto i = std::size_t{0}; i < n; i += lanes) {
+    auto count = std::min(lanes, n - i);
+    auto a = load(x + i, count);
+    auto b = load(z + i, count);
+    auto special = Mask{};
+    store(y + i, vector(Function{}, a, b, special), count);
+    if (!any(special)) continue;
+    for (auto l = std::size_t{0}; l < count; ++l) {
+      if (special[l]) {
+        y[i + l] = Function::scalar(static_cast<T>(a[l]), static_cast<T>(b[l]));
+      }
+    }
+  }
+}
+
+template <typename Function, VectorMathReal T, typename Out>
+void apply(std::size_t n, const std::complex<T>* x, Out* y) {
+  for (auto i = std::size_t{0}; i < n; i += lanes) {
+    auto count = std::min(lanes, n - i);
+    auto re = Real{} + 1.0, im = Real{};
+    for (auto l = std::size_t{0}; l < count; ++l) {
+      re[l] = x[i + l].real();
+      im[l] = x[i + l].imag();
+    }
+    auto special = Mask{};
+    if constexpr (std::same_as<Out, T>) {
+      store(y + i, vector(Function{}, re, im, special), count);
+    } else {
+      auto zr = re, zi = im;
+      vector(Function{}, zr, zi, special);
+      for (auto l = std::size_t{0}; l < count; ++l) {
+        y[i + l] = Out(static_cast<T>(zr[l]), static_cast<T>(zi[l]));
+      }
+    }
+    if (!any(special)) continue;
+    for (auto l = std::size_t{0}; l < count; ++l) {
+      if (special[l]) {
+        y[i + l] = Function::scalar(
+            std::complex<T>(static_cast<T>(re[l]), static_cast<T>(im[l])));
+      }
+    }
+  }
+}
@@ -0,0 +1,40 @@
+/**
+ * @file NumericConcepts.cppm
+ * @brief The C++20 module interface unit for the NumericConcepts concepts.
+ * @details `import NumericConcepts;` provides the same declarations as
+ * including NumericConcepts.hpp, and is parsed once when the module is built
+ * rather than once per translation unit. The standard headers are included
+ * in the global module fragment, so that they stay outside the module. The
+ * library headers are then included in an exported `extern "C++"` block,
+ * which attaches their declarations to the global module, so translation
+ * units that import the module and translation units that include the
+ * headers can be linked into one program.
+ */
+
+module;
+
+#include <array>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <version>
+
+#if __cplusplus > 202002L && __has_include(<stdfloat>)
+#include <stdfloat>
+#endif
+
+#if defined(__cpp_lib_mdspan)
+#include <mdspan>
+#endif
+
+export module NumericConcepts;
+
+export extern "C++" {
+#include <NumericConcepts/NumericConcepts.hpp>
+}
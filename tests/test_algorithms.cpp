@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Algorithms.hpp>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <list>
+#include <vector>
+
+using namespace NumericConcepts;
+
+TEST(AlgorithmTests, ContiguousAndListAgree) {
+  auto x = std::vector<double>(37);
+  auto y = std::vector<double>(37);
+  for (auto i = 0; i < 37; ++i) {
+    x[i] = 0.5 * i - 3;
+    y[i] = 1.0 / (i + 1);
+  }
+  auto lx = std::list<double>(x.begin(), x.end());
+  auto ly = std::list<double>(y.begin(), y.end());
+
+  EXPECT_NEAR(dot(x, y), dot(lx, ly), 1e-12);
+  EXPECT_NEAR(asum(x), asum(lx), 1e-12);
+  EXPECT_NEAR(nrm2(x), nrm2(lx), 1e-12);
+
+  axpy(2.0, x, y);
+  axpy(2.0, lx, ly);
+  scal(-0.5, y);
+  scal(-0.5, ly);
+  auto li = ly.begin();
+  for (auto value : y) EXPECT_DOUBLE_EQ(value, *li++);
+}
+
+TEST(AlgorithmTests, FloatKernels) {
+  auto x = std::vector<float>(100, 2.0f);
+  auto y = std::vector<float>(100, -1.0f);
+  EXPECT_FLOAT_EQ(dot(x, y), -200.0f);
+  EXPECT_FLOAT_EQ(asum(y), 100.0f);
+  EXPECT_FLOAT_EQ(nrm2(x), 20.0f);
+}
+
+TEST(AlgorithmTests, ComplexKernels) {
+  using C = std::complex<double>;
+  auto x = std::vector<C>{{1, 2}, {3, -4}};
+  auto y = std::vector<C>{{0, 1}, {2, 0}};
+  EXPECT_EQ(dot(x, y), C(4, -7));
+  EXPECT_EQ(dotc(x, y), C(8, 9));
+  EXPECT_DOUBLE_EQ(asum(x), 10.0);
+  EXPECT_DOUBLE_EQ(nrm2(x), std::sqrt(30.0));
+
+  axpy(C(0, 1), x, y);
+  EXPECT_EQ(y[0], C(-2, 2));
+  scal(2.0, y);
+  EXPECT_EQ(y[1], C(12, 6));
+}
+
+TEST(AlgorithmTests, Nrm2AvoidsOverflow) {
+  auto big = std::numeric_limits<double>::max() / 2;
+  auto x = std::vector<double>{big, big};
+  EXPECT_DOUBLE_EQ(nrm2(x), big * std::sqrt(2.0));
+  auto tiny = std::numeric_limits<double>::denorm_min();
+  auto z = std::vector<double>{tiny, tiny};
+  EXPECT_GT(nrm2(z), 0.0);
+}
+
+#if defined(__FLT16_MAX__)
+TEST(AlgorithmTests, HalfPrecisionAccumulatesInFloat) {
+  auto x = std::vector<_Float16>(4096, _Float16(1));
+  static_assert(std::same_as<decltype(dot(x, x)), float>);
+  EXPECT_EQ(dot(x, x), 4096.0f);
+  EXPECT_EQ(asum(x), 4096.0f);
+  EXPECT_EQ(nrm2(x), 64.0f);
+}
+#endif
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Algorithms.hpp>
+#include <NumericConcepts/Buffer.hpp>
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+using namespace NumericConcepts;
+
+TEST(BufferTests, SatisfiesRangeConcepts) {
+  static_assert(RealWritableRange<NumericBuffer<double>>);
+  static_assert(ComplexWritableRange<NumericBuffer<std::complex<float>>>);
+  static_assert(IntegralWritableRange<NumericBuffer<int>>);
+  static_assert(ContiguousRealRange<const NumericBuffer<float>>);
+  static_assert(AlignedRange<NumericBuffer<double>, 64>);
+  static_assert(!AlignedRange<NumericBuffer<double>, 128>);
+}
+
+TEST(BufferTests, ConstructionAndGrowth) {
+  auto a = NumericBuffer<double>(5, 2.0);
+  EXPECT_EQ(a.size(), 5u);
+  EXPECT_EQ(a[4], 2.0);
+  EXPECT_TRUE(is_aligned<64>(a));
+
+  auto b = NumericBuffer<double>(std::vector<int>{1, 2, 3});
+  b.push_back(4);
+  b.resize(6, -1.0);
+  EXPECT_EQ(std::vector<double>(b.begin(), b.end()),
+            (std::vector<double>{1, 2, 3, 4, -1, -1}));
+  EXPECT_EQ(dot(a, b), 2.0 * 10 + 2.0 * -1);
+
+  auto c = b;
+  c[0] = 10;
+  EXPECT_EQ(b[0], 1.0);
+  auto d = std::move(c);
+  EXPECT_EQ(d[0], 10.0);
+  EXPECT_TRUE(c.empty());
+
+  // Elements of the buffer itself may be appended when it must grow.
+  auto e = NumericBuffer<double>(3, 7.0);
+  ASSERT_EQ(e.size(), e.capacity());
+  e.push_back(e[0]);
+  e.resize(2 * e.capacity(), e[1]);
+  EXPECT_TRUE(std::ranges::all_of(e, [](double v) { return v == 7.0; }));
+}
+
+TEST(BufferTests, ArenaResetReusesMemory) {
+  auto arena = NumericArena(1024);
+  auto first = static_cast<const void*>(nullptr);
+  for (auto iteration = 0; iteration < 3; ++iteration) {
+    arena.reset();
+    auto x = NumericBuffer<double>(100, Uninitialized, &arena);
+    auto y = NumericBuffer<std::complex<double>>(10, &arena);
+    EXPECT_TRUE(is_aligned<64>(x));
+    EXPECT_TRUE(is_aligned<64>(y));
+    EXPECT_EQ(y[9], std::complex<double>{});
+    if (iteration == 0) first = x.data();
+    EXPECT_EQ(x.data(), first);
+  }
+  EXPECT_EQ(arena.capacity(), 1024u);
+
+  auto big = NumericBuffer<float>(10000, 1.0f, &arena);
+  EXPECT_EQ(big[9999], 1.0f);
+  EXPECT_GT(arena.capacity(), 1024u);
+}
+
+TEST(BufferTests, PoolResource) {
+  auto pool = std::pmr::unsynchronized_pool_resource{};
+  auto x = NumericBuffer<float>(33, 1.5f, &pool);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(x.data()) % 64, 0u);
+  EXPECT_EQ(x.resource(), &pool);
+
+  // Copies of non-const and const buffers keep the source's resource.
+  auto y = NumericBuffer<float>(x);
+  EXPECT_EQ(y.resource(), &pool);
+  EXPECT_EQ(y.capacity(), x.size());
+  const auto& z = x;
+  EXPECT_EQ(NumericBuffer<float>(z).resource(), &pool);
+}
+
+namespace {
+
+// A resource checking that each deallocation matches its allocation.
+class CheckingResource : public std::pmr::memory_resource {
+ public:
+  std::map<void*, std::pair<std::size_t, std::size_t>> live;
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    auto p = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    live[p] = {bytes, alignment};
+    return p;
+  }
+
+  void do_deallocate(void* p, std::size_t bytes,
+                     std::size_t alignment) override {
+    EXPECT_EQ(live.at(p), std::make_pair(bytes, alignment));
+    live.erase(p);
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const
+      noexcept override {
+    return this == &other;
+  }
+};
+
+}  // namespace
+
+TEST(BufferTests, ArenaOverAlignment) {
+  auto upstream = CheckingResource{};
+  {
+    auto arena = NumericArena(4096, &upstream);
+    for (auto iteration = 0; iteration < 2; ++iteration) {
+      arena.reset();
+      EXPECT_NE(arena.allocate(8, 8), nullptr);
+      auto p = arena.allocate(100, 256);
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 256, 0u);
+      auto q = arena.allocate(10000, 1024);
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(q) % 1024, 0u);
+      auto r = arena.allocate(8, 512);
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(r) % 512, 0u);
+    }
+    EXPECT_FALSE(upstream.live.empty());
+  }
+  EXPECT_TRUE(upstream.live.empty());
+}
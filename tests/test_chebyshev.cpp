@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Chebyshev.hpp>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using namespace NumericConcepts;
+
+TEST(ChebyshevTests, RealProxySatisfiesConcept) {
+  auto f = [](double x) { return std::sin(x) * std::exp(-0.1 * x); };
+  auto proxy = chebyshev_proxy(f, 0.0, 20.0);
+  static_assert(RealFunction<decltype(proxy), double>);
+  EXPECT_TRUE(proxy.converged());
+  for (auto x = 0.0; x <= 20.0; x += 0.01) {
+    EXPECT_NEAR(proxy(x), f(x), 1e-13);
+  }
+}
+
+TEST(ChebyshevTests, ComplexProxy) {
+  auto f = [](float x) { return std::polar(1.0f, 3.0f * x); };
+  auto proxy = chebyshev_proxy(f, -1.0f, 1.0f, {.tolerance = 1e-6});
+  static_assert(ComplexFunction<decltype(proxy), float>);
+  EXPECT_EQ(proxy.pieces(), 1u);
+  EXPECT_LT(std::abs(proxy(0.3f) - f(0.3f)), 1e-5f);
+}
+
+TEST(ChebyshevTests, BisectsNonSmoothFunctions) {
+  auto f = [](double x) { return std::sqrt(std::abs(x - 0.3)); };
+  auto proxy = chebyshev_proxy(f, 0.0, 1.0, {.max_pieces = 8});
+  EXPECT_EQ(proxy.pieces(), 8u);
+  EXPECT_FALSE(proxy.converged());
+
+  // A kink at the midpoint is resolved by a single bisection.
+  auto g = [](double x) { return std::abs(x - 0.5) + std::exp(x); };
+  auto kinked = chebyshev_proxy(g, 0.0, 1.0);
+  EXPECT_TRUE(kinked.converged());
+  EXPECT_EQ(kinked.pieces(), 2u);
+  EXPECT_NEAR(kinked(0.6), g(0.6), 1e-14);
+}
+
+TEST(ChebyshevTests, BatchEvaluationMatchesScalar) {
+  auto f = [](double x) { return std::cos(x) + x * x; };
+  auto proxy = chebyshev_proxy(f, -5.0, 5.0, {.max_points = 33});
+  auto x = std::vector<double>(1000);
+  for (auto i = std::size_t{0}; i < x.size(); ++i) x[i] = -5.0 + 0.01 * i;
+  auto y = std::vector<double>(x.size());
+  EXPECT_EQ(proxy.evaluate(x, y), x.size());
+  for (auto i = std::size_t{0}; i < x.size(); ++i) {
+    EXPECT_DOUBLE_EQ(y[i], proxy(x[i]));
+    EXPECT_NEAR(y[i], f(x[i]), 1e-12);
+  }
+}
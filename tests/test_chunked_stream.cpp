@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/ChunkedStream.hpp>
+#include <NumericConcepts/Summation.hpp>
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <future>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NumericConcepts;
+
+TEST(ChunkedStreamTests, SatisfiesRangeConcepts) {
+  static_assert(std::ranges::input_range<ChunkedNumericStream<double>>);
+  static_assert(RealRange<ChunkedNumericStream<double>>);
+  static_assert(ComplexRange<ChunkedNumericStream<std::complex<float>>>);
+  static_assert(IntegralRange<ChunkedNumericStream<int>>);
+  static_assert(!std::ranges::forward_range<ChunkedNumericStream<double>>);
+  using Chunks = ChunkedNumericStream<double>::ChunkRange;
+  static_assert(std::ranges::input_range<Chunks>);
+  static_assert(std::same_as<std::ranges::range_value_t<Chunks>,
+                             std::span<const double>>);
+}
+
+TEST(ChunkedStreamTests, ReadsBinaryInChunks) {
+  auto values = std::vector<double>(1000);
+  for (auto i = std::size_t{0}; i < values.size(); ++i) values[i] = i;
+  auto bytes = std::string(reinterpret_cast<const char*>(values.data()),
+                           values.size() * sizeof(double));
+  bytes += "xyz";  // trailing partial element is ignored
+
+  auto in = std::istringstream(bytes);
+  auto stream = ChunkedNumericStream<double>(in, StreamFormat::Binary, 128);
+  auto sizes = std::vector<std::size_t>{};
+  auto total = 0.0;
+  for (auto chunk : stream.chunks()) {
+    sizes.push_back(chunk.size());
+    for (auto x : chunk) total += x;
+  }
+  ASSERT_EQ(sizes.size(), 8u);
+  EXPECT_EQ(sizes.front(), 128u);
+  EXPECT_EQ(sizes.back(), 1000u - 7 * 128);
+  EXPECT_EQ(total, 999.0 * 1000 / 2);
+}
+
+TEST(ChunkedStreamTests, ReadsTextElements) {
+  auto in = std::istringstream("1 2 3\n4 5\n6 7 8 9 10");
+  auto stream = ChunkedNumericStream<int>(in, StreamFormat::Text, 3);
+  EXPECT_EQ(sum(stream), 55);
+
+  auto complex = std::istringstream("(1,2) (3,4) (5,6)");
+  auto values = std::vector<std::complex<double>>{};
+  for (auto z : ChunkedNumericStream<std::complex<double>>(
+           complex, StreamFormat::Text, 2)) {
+    values.push_back(z);
+  }
+  ASSERT_EQ(values.size(), 3u);
+  EXPECT_EQ(values[2], std::complex<double>(5, 6));
+}
+
+template <typename T>
+concept Streamable = requires { typename ChunkedNumericStream<T>; };
+
+TEST(ChunkedStreamTests, ReadsCharacterSizedIntegersAsNumbers) {
+  static_assert(!Streamable<bool>);
+  auto in = std::istringstream("-5 100 7 200 1");
+  auto values = std::vector<std::int8_t>{};
+  for (auto v : ChunkedNumericStream<std::int8_t>(in, StreamFormat::Text, 2)) {
+    values.push_back(v);
+  }
+  // 200 does not fit and ends the stream
+  EXPECT_EQ(values, (std::vector<std::int8_t>{-5, 100, 7}));
+
+  auto bytes = std::istringstream("255 0 -1");
+  auto stream = ChunkedNumericStream<unsigned char>(bytes, StreamFormat::Text);
+  EXPECT_EQ(sum(stream), 255u);
+}
+
+#if defined(__FLT16_MAX__)
+TEST(ChunkedStreamTests, HalfPrecisionIsBinaryOnly) {
+  auto values = std::vector<_Float16>(100, _Float16(0.5));
+  auto in = std::istringstream(
+      std::string(reinterpret_cast<const char*>(values.data()),
+                  values.size() * sizeof(_Float16)));
+  auto stream = ChunkedNumericStream<_Float16>(in, StreamFormat::Binary, 16);
+  EXPECT_EQ(sum(stream), 50.0f);
+
+  auto text = std::istringstream("0.5");
+  EXPECT_THROW(ChunkedNumericStream<_Float16>(text, StreamFormat::Text),
+               std::invalid_argument);
+}
+#endif
+
+TEST(ChunkedStreamTests, EmptyStream) {
+  auto in = std::istringstream("");
+  auto stream = ChunkedNumericStream<float>(in);
+  EXPECT_TRUE(stream.begin() == stream.end());
+}
+
+#if defined(NUMERIC_CONCEPTS_HAS_FD_STREAMS)
+TEST(ChunkedStreamTests, ReadsFromFileDescriptor) {
+  auto file = std::tmpfile();
+  ASSERT_NE(file, nullptr);
+  auto values = std::vector<float>(100000, 0.25f);
+  std::fwrite(values.data(), sizeof(float), values.size(), file);
+  std::fflush(file);
+  std::rewind(file);
+
+  auto stream = ChunkedNumericStream<float>(fileno(file), StreamFormat::Binary,
+                                            4096, 3);
+  EXPECT_EQ(sum(stream), 25000.0f);
+  std::fclose(file);
+}
+
+TEST(ChunkedStreamTests, DestructionInterruptsBlockedRead) {
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+  auto values = std::vector<double>{1.0, 2.0, 3.0};
+  ASSERT_EQ(::write(fds[1], values.data(), values.size() * sizeof(double)),
+            static_cast<ssize_t>(values.size() * sizeof(double)));
+
+  // The reader blocks waiting for the rest of the second chunk, since the
+  // write end of the pipe stays open.
+  auto first = std::async(std::launch::async, [&]() {
+    auto stream = ChunkedNumericStream<double>(fds[0], StreamFormat::Binary,
+                                               2, 2);
+    auto value = *stream.begin();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    return value;
+  });
+  auto status = first.wait_for(std::chrono::seconds(10));
+  ::close(fds[1]);
+  EXPECT_EQ(status, std::future_status::ready);
+  EXPECT_EQ(first.get(), 1.0);
+  ::close(fds[0]);
+}
+#endif
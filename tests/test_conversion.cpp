@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Conversion.hpp>
+#include <NumericConcepts/SplitComplex.hpp>
+#include <complex>
+#include <list>
+#include <vector>
+
+using namespace NumericConcepts;
+
+TEST(ConversionTests, RealContiguous) {
+  auto in = std::vector<float>(37);
+  for (auto i = 0; i < 37; ++i) in[i] = 0.25f * i - 1.0f;
+  auto wide = std::vector<double>(37);
+  EXPECT_EQ(convert(in, wide), 37u);
+  for (auto i = 0; i < 37; ++i) EXPECT_EQ(wide[i], 0.25 * i - 1.0);
+
+  auto narrow = std::vector<float>(20);
+  EXPECT_EQ(convert(wide, narrow), 20u);
+  for (auto i = 0; i < 20; ++i) EXPECT_EQ(narrow[i], in[i]);
+}
+
+TEST(ConversionTests, ComplexAndMixed) {
+  auto in = std::vector<std::complex<double>>{{1, 2}, {3, 4}, {5, 6}};
+  auto out = std::vector<std::complex<float>>(3);
+  EXPECT_EQ(convert(in, out), 3u);
+  EXPECT_EQ(out[2], std::complex<float>(5, 6));
+
+  auto split = SplitComplexVector<double>(3);
+  EXPECT_EQ(convert(out, split), 3u);
+  EXPECT_EQ(split[1], std::complex<double>(3, 4));
+
+  auto reals = std::list<float>{1.5f, -2.5f};
+  auto complexes = std::vector<std::complex<double>>(2);
+  EXPECT_EQ(convert(reals, complexes), 2u);
+  EXPECT_EQ(complexes[1], std::complex<double>(-2.5, 0));
+}
+
+#if defined(__FLT16_MAX__)
+TEST(ConversionTests, HalfPrecision) {
+  auto in = std::vector<float>(21);
+  for (auto i = 0; i < 21; ++i) in[i] = 0.5f * i;
+  auto half = std::vector<_Float16>(21);
+  EXPECT_EQ(convert(in, half), 21u);
+  auto out = std::vector<double>(21);
+  EXPECT_EQ(convert(half, out), 21u);
+  for (auto i = 0; i < 21; ++i) EXPECT_EQ(out[i], 0.5 * i);
+}
+#endif
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Expression.hpp>
+#include <NumericConcepts/SplitComplex.hpp>
+#include <complex>
+#include <deque>
+#include <vector>
+
+using namespace NumericConcepts;
+
+template <typename A, typename B>
+concept Addable = requires(const A& a, const B& b) { a + b; };
+
+template <typename Out, typename E>
+concept Assignable = requires(Out& out, const E& e) { assign(out, e); };
+
+TEST(ExpressionTests, SatisfiesViewConcepts) {
+  auto a = std::vector<double>(4);
+  auto z = std::vector<std::complex<double>>(4);
+  using RealExpr = decltype(lazy(a) + lazy(a));
+  using ComplexExpr = decltype(lazy(a) * lazy(z));
+  static_assert(RealView<RealExpr>);
+  static_assert(std::ranges::random_access_range<RealExpr>);
+  static_assert(ComplexView<ComplexExpr>);
+  static_assert(SameRangePrecision<RealExpr, ComplexExpr>);
+
+  // Operands and outputs must share a precision.
+  auto f = std::vector<float>(4);
+  static_assert(!Addable<decltype(lazy(a)), decltype(lazy(f))>);
+  static_assert(Addable<decltype(lazy(f)), double>);
+  static_assert(!Assignable<std::vector<float>, RealExpr>);
+  static_assert(!Assignable<std::vector<double>, ComplexExpr>);
+  static_assert(Assignable<std::vector<std::complex<double>>, RealExpr>);
+}
+
+TEST(ExpressionTests, FusedEvaluation) {
+  auto n = std::size_t{1000};
+  auto a = std::vector<double>(n), b = a, c = a, d = a;
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    a[i] = i;
+    b[i] = 0.5 * i;
+    c[i] = 2.0;
+    d[i] = -1.0 * i;
+  }
+  auto e = lazy(a) + 2.0 * lazy(b) - lazy(c) * lazy(d);
+  EXPECT_EQ(e.size(), n);
+  EXPECT_EQ(e[10], 10.0 + 10.0 + 20.0);
+
+  auto out = std::vector<double>(n);
+  EXPECT_EQ(assign(out, e), n);
+  for (auto i = std::size_t{0}; i < n; ++i) EXPECT_EQ(out[i], 4.0 * i);
+
+  // In-place update through an operand.
+  assign(a, -lazy(a) / 2);
+  EXPECT_EQ(a[10], -5.0);
+}
+
+TEST(ExpressionTests, MixedRealAndComplex) {
+  auto x = std::vector<float>{1, 2, 3};
+  auto z = SplitComplexVector<float>{{1, 1}, {0, 2}, {-1, 0}};
+  auto w = std::deque<std::complex<float>>{{2, 0}, {0, 1}, {1, 1}, {5, 5}};
+
+  auto e = lazy(x) * lazy(z) + std::complex<double>(0, 1) * lazy(w);
+  static_assert(std::same_as<std::ranges::range_value_t<decltype(e)>,
+                             std::complex<float>>);
+  EXPECT_EQ(e.size(), 3u);
+
+  auto out = SplitComplexVector<float>(3);
+  assign(out, e);
+  EXPECT_EQ(static_cast<std::complex<float>>(out[0]),
+            std::complex<float>(1, 3));
+  EXPECT_EQ(static_cast<std::complex<float>>(out[1]),
+            std::complex<float>(-1, 4));
+  EXPECT_EQ(static_cast<std::complex<float>>(out[2]),
+            std::complex<float>(-4, 1));
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Fft.hpp>
+#include <NumericConcepts/SplitComplex.hpp>
+#include <cmath>
+#include <complex>
+#include <list>
+#include <numbers>
+#include <thread>
+#include <vector>
+
+using namespace NumericConcepts;
+
+namespace {
+
+// Reproducible complex values in [-1, 1) x [-1, 1).
+std::vector<std::complex<double>> signal(std::size_t n) {
+  auto x = std::vector<std::complex<double>>(n);
+  for (auto k = std::size_t{0}; k < n; ++k) {
+    x[k] = {std::sin(0.7 * k + 0.3), std::cos(1.3 * k * k + 0.1)};
+  }
+  return x;
+}
+
+// The direct O(n^2) transform.
+std::vector<std::complex<double>> dft(
+    const std::vector<std::complex<double>>& x, double sign = -1) {
+  auto n = x.size();
+  auto y = std::vector<std::complex<double>>(n);
+  for (auto k = std::size_t{0}; k < n; ++k) {
+    auto sum = std::complex<long double>{0};
+    for (auto j = std::size_t{0}; j < n; ++j) {
+      auto angle = sign * 2 * std::numbers::pi_v<long double> *
+                   static_cast<long double>((j * k) % n) / n;
+      sum += std::complex<long double>(x[j]) * std::polar(1.0L, angle);
+    }
+    y[k] = std::complex<double>(sum);
+  }
+  return y;
+}
+
+double max_error(const std::vector<std::complex<double>>& x,
+                 const std::vector<std::complex<double>>& y) {
+  auto error = 0.0;
+  for (auto k = std::size_t{0}; k < x.size(); ++k) {
+    error = std::max(error, std::abs(x[k] - y[k]));
+  }
+  return error;
+}
+
+}  // namespace
+
+TEST(FftTests, MatchesDirectTransform) {
+  // Powers of two and four, mixed radices, a generic radix, and primes
+  // handled by Bluestein's algorithm.
+  for (auto n : {1u, 2u, 3u, 8u, 12u, 30u, 64u, 77u, 97u, 210u, 625u, 1000u}) {
+    auto x = signal(n);
+    auto y = std::vector<std::complex<double>>(n);
+    fft(x, y);
+    EXPECT_LT(max_error(y, dft(x)), 1e-11 * n) << n;
+    fft(x, y, {.direction = FftDirection::Inverse});
+    EXPECT_LT(max_error(y, dft(x, 1)), 1e-11 * n) << n;
+  }
+}
+
+TEST(FftTests, InPlaceRoundTrip) {
+  auto x = signal(360);
+  auto y = x;
+  fft(y, y);
+  fft(y, y, {.direction = FftDirection::Inverse});
+  for (auto& z : y) z /= 360.0;
+  EXPECT_LT(max_error(x, y), 1e-13);
+}
+
+TEST(FftTests, OtherRangesAndPrecisions) {
+  auto x = signal(48);
+  auto expected = dft(x);
+
+  auto split = SplitComplexVector<double>(48);
+  fft(x, split);
+  auto listed = std::list<std::complex<float>>(x.begin(), x.end());
+  auto out = std::vector<std::complex<float>>(48);
+  fft(listed, out);
+  for (auto k = std::size_t{0}; k < 48; ++k) {
+    EXPECT_LT(std::abs(std::complex<double>(split[k]) - expected[k]), 1e-12);
+    EXPECT_LT(std::abs(std::complex<double>(out[k]) - expected[k]), 1e-4);
+  }
+
+  auto short_out = std::vector<std::complex<double>>(10);
+  EXPECT_THROW(fft(x, short_out), std::invalid_argument);
+}
+
+TEST(FftTests, RealTransform) {
+  for (auto n : {1u, 2u, 9u, 16u, 50u, 101u}) {
+    auto x = std::vector<double>(n);
+    for (auto k = std::size_t{0}; k < n; ++k) x[k] = std::sin(0.37 * k * k);
+    auto y = std::vector<std::complex<double>>(n / 2 + 1);
+    rfft(x, y);
+    auto expected =
+        dft(std::vector<std::complex<double>>(x.begin(), x.end()));
+    expected.resize(n / 2 + 1);
+    EXPECT_LT(max_error(y, expected), 1e-12 * n) << n;
+  }
+}
+
+TEST(FftTests, PlanCacheIsShared) {
+  auto cache = FftPlanCache();
+  auto x = signal(100);
+  auto y = std::vector<std::complex<double>>(100);
+  auto threads = std::vector<std::thread>{};
+  for (auto t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      auto local = std::vector<std::complex<double>>(100);
+      for (auto i = 0; i < 20; ++i) fft(x, local, {.cache = &cache});
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(cache.size(), 1u);
+  auto p = cache.plan<FftPlan<double>>(100, FftDirection::Forward);
+  auto q = cache.plan<FftPlan<double>>(100, FftDirection::Forward);
+  EXPECT_EQ(p, q);
+  cache.plan<FftPlan<float>>(100, FftDirection::Forward);
+  cache.plan<RealFftPlan<double>>(100, FftDirection::Forward);
+  EXPECT_EQ(cache.size(), 3u);
+  EXPECT_FALSE(p->bluestein());
+  EXPECT_TRUE(cache.plan<FftPlan<double>>(37, FftDirection::Forward)
+                  ->bluestein());
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(p->size(), 100u);
+}
+
+TEST(FftTests, BatchedAndTwoDimensional) {
+  auto rows = std::size_t{12}, cols = std::size_t{20};
+  auto data = signal(rows * cols);
+  auto in = MatrixSpan<const std::complex<double>>(data.data(), rows, cols);
+
+  auto batched = std::vector<std::complex<double>>(rows * cols);
+  fft_batch(in, MatrixSpan<std::complex<double>>(batched.data(), rows, cols),
+            {.parallel = {.grain = 1}});
+  for (auto i = std::size_t{0}; i < rows; ++i) {
+    auto first = data.begin() + static_cast<std::ptrdiff_t>(i * cols);
+    auto expected = dft({first, first + static_cast<std::ptrdiff_t>(cols)});
+    for (auto j = std::size_t{0}; j < cols; ++j) {
+      EXPECT_LT(std::abs(batched[i * cols + j] - expected[j]), 1e-12);
+    }
+  }
+
+  // The 2-D transform into a column-major matrix, checked at a few points.
+  auto out = std::vector<std::complex<double>>(rows * cols);
+  auto transformed =
+      MatrixSpan<std::complex<double>, LayoutLeft>(out.data(), rows, cols);
+  fft2(in, transformed, {.parallel = {.grain = 3}});
+  for (auto [k, l] : {std::pair{0u, 0u}, {3u, 7u}, {11u, 19u}}) {
+    auto sum = std::complex<double>{0};
+    for (auto i = std::size_t{0}; i < rows; ++i) {
+      for (auto j = std::size_t{0}; j < cols; ++j) {
+        auto phase = double(i * k) / rows + double(j * l) / cols;
+        auto angle = -2 * std::numbers::pi * phase;
+        sum += data[i * cols + j] * std::polar(1.0, angle);
+      }
+    }
+    EXPECT_LT(std::abs(out[k + l * rows] - sum), 1e-11);
+  }
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/IntegerAlgorithms.hpp>
+#include <NumericConcepts/SplitComplex.hpp>
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+using namespace NumericConcepts;
+
+namespace {
+
+// Returns reproducible integers spread over the whole range of T.
+template <typename T>
+std::vector<T> keys(std::size_t n, unsigned seed) {
+  auto v = std::vector<T>(n);
+  auto state = std::uint64_t{seed};
+  for (auto& x : v) {
+    state = state * 6364136223846793005u + 1442695040888963407u;
+    x = static_cast<T>(state >> 17);
+  }
+  return v;
+}
+
+}  // namespace
+
+TEST(IntegerAlgorithmsTests, Scans) {
+  auto pool = ThreadPool({.threads = 4});
+  auto x = keys<std::int32_t>(100'003, 1);
+  for (auto& v : x) v %= 1000;
+  auto expected = std::vector<std::int64_t>(x.size());
+  std::inclusive_scan(x.begin(), x.end(), expected.begin(), std::plus<>{},
+                      std::int64_t{0});
+
+  auto y = std::vector<std::int64_t>(x.size());
+  EXPECT_EQ(parallel_inclusive_scan(x, y, {.grain = 1000, .pool = &pool}),
+            x.size());
+  EXPECT_EQ(y, expected);
+
+  EXPECT_EQ(parallel_exclusive_scan(x, y, 5, {.grain = 777, .pool = &pool}),
+            x.size());
+  EXPECT_EQ(y[0], 5);
+  for (auto i = std::size_t{1}; i < y.size(); ++i) {
+    ASSERT_EQ(y[i], expected[i - 1] + 5);
+  }
+
+  // In place, and over a range that is not random access.
+  auto counts = std::vector<unsigned>{2, 0, 3, 1};
+  parallel_exclusive_scan(counts, counts, 0u, {.grain = 1, .pool = &pool});
+  EXPECT_EQ(counts, (std::vector<unsigned>{0, 2, 2, 5}));
+  auto list = std::list<int>{1, 2, 3};
+  auto out = std::vector<int>(5);
+  EXPECT_EQ(parallel_inclusive_scan(list, out), 3u);
+  EXPECT_EQ(out, (std::vector<int>{1, 3, 6, 0, 0}));
+}
+
+TEST(IntegerAlgorithmsTests, ScansOnOneThread) {
+  // The sequential path carries the sum across blocks.
+  auto pool = ThreadPool({.threads = 1});
+  auto x = keys<std::int32_t>(1003, 2);
+  for (auto& v : x) v %= 1000;
+  auto expected = std::vector<std::int64_t>(x.size());
+  auto y = std::vector<std::int64_t>(x.size());
+
+  std::inclusive_scan(x.begin(), x.end(), expected.begin(), std::plus<>{},
+                      std::int64_t{0});
+  EXPECT_EQ(parallel_inclusive_scan(x, y, {.grain = 4, .pool = &pool}),
+            x.size());
+  EXPECT_EQ(y, expected);
+
+  std::exclusive_scan(x.begin(), x.end(), expected.begin(), std::int64_t{5});
+  EXPECT_EQ(parallel_exclusive_scan(x, y, 5, {.grain = 7, .pool = &pool}),
+            x.size());
+  EXPECT_EQ(y, expected);
+}
+
+TEST(IntegerAlgorithmsTests, Histogram) {
+  auto pool = ThreadPool({.threads = 4});
+  auto x = keys<std::int16_t>(200'000, 2);
+  auto counts = std::vector<std::uint32_t>(1000);
+  auto counted = parallel_histogram(x, counts, {.grain = 5000, .pool = &pool});
+  auto expected = std::vector<std::uint32_t>(1000);
+  auto inside = std::size_t{0};
+  for (auto v : x) {
+    if (v >= 0 && v < 1000) {
+      ++expected[static_cast<std::size_t>(v)];
+      ++inside;
+    }
+  }
+  EXPECT_EQ(counts, expected);
+  EXPECT_EQ(counted, inside);
+
+  auto small = std::deque<int>{0, 1, 1, 3, -1, 7};
+  auto bins = std::vector<int>(4, 99);
+  EXPECT_EQ(parallel_histogram(std::list<int>(small.begin(), small.end()),
+                               bins),
+            4u);
+  EXPECT_EQ(bins, (std::vector<int>{1, 2, 0, 1}));
+}
+
+TEST(IntegerAlgorithmsTests, RadixSortKeys) {
+  auto pool = ThreadPool({.threads = 4});
+  auto x = keys<std::int64_t>(123'457, 3);
+  auto expected = x;
+  std::ranges::sort(expected);
+  parallel_radix_sort(x, {.grain = 4096, .pool = &pool});
+  EXPECT_EQ(x, expected);
+
+  // Few distinct bytes, so most passes are skipped.
+  auto u = keys<std::uint32_t>(50'000, 4);
+  for (auto& v : u) v &= 0x00ff00u;
+  auto d = std::deque<std::uint32_t>(u.begin(), u.end());
+  std::ranges::sort(u);
+  parallel_radix_sort(d, {.pool = &pool});
+  EXPECT_TRUE(std::ranges::equal(d, u));
+
+  auto c = keys<signed char>(1000, 5);
+  parallel_radix_sort(c);
+  EXPECT_TRUE(std::ranges::is_sorted(c));
+}
+
+TEST(IntegerAlgorithmsTests, RadixSortKeysAndValues) {
+  auto pool = ThreadPool({.threads = 4});
+  auto n = std::size_t{30'000};
+  auto k = keys<std::int32_t>(n, 6);
+  for (auto& v : k) v %= 500;
+  auto values = std::vector<double>(n);
+  std::iota(values.begin(), values.end(), 0.0);
+  auto split = SplitComplexVector<float>(n);
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    split[i] = std::complex<float>(static_cast<float>(k[i]), 0.0f);
+  }
+
+  auto order = std::vector<std::size_t>(n);
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::ranges::stable_sort(order, {}, [&](std::size_t i) { return k[i]; });
+
+  auto k2 = k;
+  parallel_radix_sort(k, values, {.grain = 1000, .pool = &pool});
+  parallel_radix_sort(k2, split, {.grain = 1000, .pool = &pool});
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    ASSERT_EQ(values[i], static_cast<double>(order[i]));
+    ASSERT_EQ(std::complex<float>(split[i]).real(),
+              static_cast<float>(k[i]));
+  }
+  EXPECT_EQ(k, k2);
+  EXPECT_THROW(parallel_radix_sort(k, std::vector<double>(3)),
+               std::invalid_argument);
+}
+
+TEST(IntegerAlgorithmsTests, Compact) {
+  auto pool = ThreadPool({.threads = 4});
+  auto indices = std::views::iota(0, 100'000);
+  auto out = std::vector<int>(50'000);
+  auto even = [](int i) { return i % 2 == 0; };
+  EXPECT_EQ(parallel_compact(indices, out, even, {.grain = 999, .pool = &pool}),
+            50'000u);
+  for (auto i = std::size_t{0}; i < out.size(); ++i) {
+    ASSERT_EQ(out[i], static_cast<int>(2 * i));
+  }
+  auto positive = [](double v) { return v > 0.0; };
+  auto x = std::list<double>{1.0, -2.0, 3.0};
+  auto y = std::vector<double>(2);
+  EXPECT_EQ(parallel_compact(x, y, positive), 2u);
+  EXPECT_EQ(y, (std::vector<double>{1.0, 3.0}));
+  EXPECT_THROW(parallel_compact(indices, y, even, {.pool = &pool}),
+               std::invalid_argument);
+}
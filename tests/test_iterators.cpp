@@ -32,6 +32,17 @@ TEST(IteratorTests, WritableIteratorConcepts) {
   static_assert(NumericWritableIterator<IntVecIter>);
 }
 
+TEST(IteratorTests, ContiguousIteratorConcepts) {
+  using DoubleVecIter = std::vector<double>::iterator;
+  using ComplexListIter = std::list<std::complex<float>>::iterator;
+
+  static_assert(ContiguousRealIterator<DoubleVecIter>);
+  static_assert(ContiguousRealIterator<const float*>);
+  static_assert(ContiguousComplexIterator<std::complex<double>*>);
+  static_assert(!ContiguousComplexIterator<ComplexListIter>);
+  static_assert(ContiguousNumericIterator<int*>);
+}
+
 TEST(IteratorTests, PrecisionConcepts) {
   using FloatVecIter = std::vector<float>::iterator;
   using DoubleVecIter = std::vector<double>::iterator;
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Algorithms.hpp>
+#include <NumericConcepts/MappedView.hpp>
+#include <complex>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(NUMERIC_CONCEPTS_HAS_MMAP)
+
+using namespace NumericConcepts;
+
+TEST(MappedViewTests, SatisfiesViewConcepts) {
+  static_assert(RealView<MappedRealView<double>>);
+  static_assert(!RealWritableView<MappedRealView<double>>);
+  static_assert(RealWritableView<MappedRealWritableView<float>>);
+  static_assert(ComplexView<MappedComplexView<double>>);
+  static_assert(ComplexWritableView<MappedComplexWritableView<double>>);
+  static_assert(NumericWritableView<MappedWritableView<int>>);
+  static_assert(ContiguousRealRange<MappedRealView<double>>);
+}
+
+TEST(MappedViewTests, WriteThenReadBack) {
+  // Named after the process, as ctest may run tests in parallel.
+  auto path = std::filesystem::temp_directory_path() /
+              ("nc_mapped_view_" + std::to_string(::getpid()) + ".bin");
+  {
+    auto out = MappedRealWritableView<double>::create(path, 1000);
+    ASSERT_EQ(out.size(), 1000u);
+    for (auto i = std::size_t{0}; i < out.size(); ++i) out[i] = 0.5 * i;
+    out.sync();
+  }
+
+  auto in = MappedRealView<double>(path, {.access = MappedAccess::Random});
+  ASSERT_EQ(in.size(), 1000u);
+  EXPECT_EQ(in[999], 499.5);
+  EXPECT_DOUBLE_EQ(asum(in), 0.5 * 999 * 1000 / 2);
+
+  auto tail = MappedRealView<double>(path, {.offset = 8 * sizeof(double)});
+  EXPECT_EQ(tail.size(), 992u);
+  EXPECT_EQ(tail.front(), 4.0);
+
+  auto complex = MappedComplexView<double>(path);
+  EXPECT_EQ(complex.size(), 500u);
+  EXPECT_EQ(complex[1], std::complex<double>(1.0, 1.5));
+
+  EXPECT_THROW(MappedRealView<double>(path, {.offset = 3}), std::system_error);
+  std::filesystem::remove(path);
+  EXPECT_THROW(MappedRealView<double>{path}, std::system_error);
+
+  // The offset is checked before the missing file is opened.
+  try {
+    MappedRealView<double>(path, {.offset = 3});
+    ADD_FAILURE();
+  } catch (const std::system_error& e) {
+    EXPECT_EQ(e.code(), std::errc::invalid_argument);
+  }
+}
+
+#endif
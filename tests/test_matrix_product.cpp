@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/MatrixProduct.hpp>
+#include <NumericConcepts/SplitComplex.hpp>
+#include <NumericConcepts/Tensor.hpp>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using namespace NumericConcepts;
+
+namespace {
+
+// Fills a vector with reproducible values in [-1, 1).
+template <typename T>
+std::vector<T> values(std::size_t n, unsigned seed) {
+  auto v = std::vector<T>(n);
+  auto state = seed;
+  auto next = [&]() {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<double>(state >> 8) / (1 << 23) - 1.0;
+  };
+  for (auto& x : v) {
+    if constexpr (Complex<T>) {
+      auto re = next();
+      x = T(re, next());
+    } else {
+      x = static_cast<T>(next());
+    }
+  }
+  return v;
+}
+
+// The reference product c = alpha * a * b + beta * c.
+template <typename A, typename B, typename C, typename S>
+void reference_gemm(S alpha, const A& a, const B& b, S beta, const C& c) {
+  for (auto i = std::size_t{0}; i < c.extent(0); ++i) {
+    for (auto j = std::size_t{0}; j < c.extent(1); ++j) {
+      auto sum = S{0};
+      for (auto p = std::size_t{0}; p < a.extent(1); ++p) {
+        sum += a(i, p) * b(p, j);
+      }
+      c(i, j) = alpha * sum + (beta == S{0} ? S{0} : beta * c(i, j));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(MatrixProductTests, TensorConcepts) {
+  using Right = MatrixSpan<double>;
+  using Left = MatrixSpan<const std::complex<float>, LayoutLeft>;
+  using Strided = TensorSpan<float, 3, LayoutStride>;
+  static_assert(RealMatrix<Right>);
+  static_assert(RealOrComplexWritableMatrix<Right&>);
+  static_assert(ComplexMatrix<Left>);
+  static_assert(!RealOrComplexWritableMatrix<Left>);
+  static_assert(RealOrComplexTensor<Strided, 3>);
+  static_assert(!RealMatrix<Strided>);
+  static_assert(LayoutRightTensor<Right>);
+  static_assert(LayoutLeftTensor<Left>);
+  static_assert(TensorLayout<Strided> == LayoutKind::Strided);
+  static_assert(!Tensor<std::vector<double>>);
+
+  auto data = std::vector<double>(6);
+  auto m = Right(data.data(), 2, 3);
+  EXPECT_EQ(m.stride(0), 3u);
+  EXPECT_EQ(m.stride(1), 1u);
+  m(1, 2) = 5.0;
+  EXPECT_EQ(data[5], 5.0);
+  auto t = transpose(m);
+  static_assert(LayoutLeftTensor<decltype(t)>);
+  EXPECT_EQ(t(2, 1), 5.0);
+  auto c = MatrixSpan<const double>(m);
+  EXPECT_EQ(c.extent(0), 2u);
+}
+
+TEST(MatrixProductTests, SmallMixedLayouts) {
+  auto m = std::size_t{7}, n = std::size_t{5}, k = std::size_t{3};
+  auto av = values<double>(m * k, 1), bv = values<double>(k * n, 2);
+  auto cv = values<double>(m * n, 3), rv = cv;
+  auto a = MatrixSpan<const double>(av.data(), m, k);
+  auto b = MatrixSpan<const double, LayoutLeft>(bv.data(), k, n);
+  auto c = MatrixSpan<double, LayoutLeft>(cv.data(), m, n);
+  auto r = MatrixSpan<double, LayoutLeft>(rv.data(), m, n);
+  gemm(2.0, a, b, 0.5, c);
+  reference_gemm(2.0, a, b, 0.5, r);
+  for (auto i = std::size_t{0}; i < cv.size(); ++i) {
+    EXPECT_NEAR(cv[i], rv[i], 1e-14);
+  }
+}
+
+TEST(MatrixProductTests, BlockedMatchesReference) {
+  // Sizes that are not multiples of the block and tile sizes.
+  auto m = std::size_t{131}, n = std::size_t{77}, k = std::size_t{300};
+  auto av = values<double>(m * k, 4), bv = values<double>(k * n, 5);
+  auto cv = std::vector<double>(m * n, std::nan("")), rv = cv;
+  auto a = MatrixSpan<const double, LayoutLeft>(av.data(), m, k);
+  auto b = MatrixSpan<const double>(bv.data(), k, n);
+  auto c = MatrixSpan<double>(cv.data(), m, n);
+  auto r = MatrixSpan<double>(rv.data(), m, n);
+  gemm(1.0, a, b, 0.0, c, {.grain = 1024});
+  reference_gemm(1.0, a, b, 0.0, r);
+  for (auto i = std::size_t{0}; i < cv.size(); ++i) {
+    EXPECT_NEAR(cv[i], rv[i], 1e-12);
+  }
+}
+
+TEST(MatrixProductTests, ComplexAndStrided) {
+  using Z = std::complex<float>;
+  auto m = std::size_t{20}, n = std::size_t{18}, k = std::size_t{40};
+  auto av = values<Z>(m * k, 6), bv = values<Z>(2 * k * n, 7);
+  auto cv = values<Z>(m * n, 8), rv = cv;
+  auto a = MatrixSpan<const Z>(av.data(), m, k);
+  // Every other column of a k by 2n matrix.
+  auto b = MatrixSpan<const Z, LayoutStride>(
+      bv.data(), std::array<std::size_t, 2>{k, n},
+      std::array<std::size_t, 2>{2 * n, 2});
+  auto c = MatrixSpan<Z>(cv.data(), m, n);
+  auto r = MatrixSpan<Z>(rv.data(), m, n);
+  auto alpha = Z(0.5f, -1.0f), beta = Z(1.0f, 0.25f);
+  gemm(alpha, a, b, beta, c, {.grain = 256});
+  reference_gemm(alpha, a, b, beta, r);
+  for (auto i = std::size_t{0}; i < cv.size(); ++i) {
+    EXPECT_LT(std::abs(cv[i] - rv[i]), 1e-4f);
+  }
+}
+
+TEST(MatrixProductTests, RealTimesComplex) {
+  using Z = std::complex<double>;
+  auto av = std::vector<double>{1, 2, 3, 4};
+  auto bv = std::vector<Z>{Z(0, 1), Z(1, 0), Z(1, 1), Z(0, 0)};
+  auto cv = std::vector<Z>(4);
+  gemm(1.0, MatrixSpan<const double>(av.data(), 2, 2),
+       MatrixSpan<const Z>(bv.data(), 2, 2), 0.0,
+       MatrixSpan<Z>(cv.data(), 2, 2));
+  EXPECT_EQ(cv[0], Z(2, 3));
+  EXPECT_EQ(cv[1], Z(1, 0));
+  EXPECT_EQ(cv[2], Z(4, 7));
+  EXPECT_EQ(cv[3], Z(3, 0));
+
+  auto dv = std::vector<double>(4);
+  EXPECT_THROW(gemm(1.0, MatrixSpan<const double>(av.data(), 2, 2),
+                    MatrixSpan<const double>(av.data(), 1, 4), 0.0,
+                    MatrixSpan<double>(dv.data(), 2, 2)),
+               std::invalid_argument);
+}
+
+TEST(MatrixProductTests, Gemv) {
+  auto m = std::size_t{300}, n = std::size_t{90};
+  auto av = values<double>(m * n, 9), x = values<double>(n, 10);
+  for (auto layout : {0, 1}) {
+    auto y = values<double>(m, 11), expected = y;
+    for (auto i = std::size_t{0}; i < m; ++i) {
+      auto sum = 0.0;
+      for (auto j = std::size_t{0}; j < n; ++j) {
+        sum += (layout ? av[i + j * m] : av[i * n + j]) * x[j];
+      }
+      expected[i] = 3.0 * sum - y[i];
+    }
+    if (layout) {
+      gemv(3.0, MatrixSpan<const double, LayoutLeft>(av.data(), m, n), x,
+           -1.0, y, {.grain = 512});
+    } else {
+      gemv(3.0, MatrixSpan<const double>(av.data(), m, n), x, -1.0, y,
+           {.grain = 512});
+    }
+    for (auto i = std::size_t{0}; i < m; ++i) {
+      EXPECT_NEAR(y[i], expected[i], 1e-12);
+    }
+  }
+}
+
+TEST(MatrixProductTests, GemvIntoSplitComplex) {
+  using Z = std::complex<double>;
+  auto av = std::vector<Z>{Z(1, 1), Z(0, 2), Z(3, 0), Z(1, -1)};
+  auto x = std::vector<double>{1, 2};
+  auto y = SplitComplexVector<double>(2);
+  gemv(1.0, MatrixSpan<const Z>(av.data(), 2, 2), x, 0.0, y);
+  EXPECT_EQ(Z(y[0]), Z(1, 5));
+  EXPECT_EQ(Z(y[1]), Z(5, -2));
+  EXPECT_THROW(gemv(1.0, MatrixSpan<const Z>(av.data(), 2, 2),
+                    std::vector<double>(3), 0.0, y),
+               std::invalid_argument);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Memoize.hpp>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <thread>
+#include <vector>
+
+using namespace NumericConcepts;
+
+double slow_square(double x) { return x * x; }
+
+TEST(MemoizeTests, SatisfiesFunctionConcepts) {
+  auto f = memoize(slow_square);
+  static_assert(RealFunction<decltype(f), double>);
+  auto g = memoize<double, int>([](double x, int n) { return std::pow(x, n); });
+  static_assert(RealFunction<decltype(g), double, int>);
+  auto h = memoize([](std::complex<double> z) { return z * z; }, ClockCache{});
+  static_assert(ComplexFunction<decltype(h), std::complex<double>>);
+  EXPECT_EQ(h({0, 1}), std::complex<double>(-1, 0));
+  EXPECT_EQ(g(2.0, 10), 1024.0);
+}
+
+TEST(MemoizeTests, CountsHitsAndMisses) {
+  auto calls = std::atomic<int>{0};
+  auto f = memoize([&](double x) {
+    ++calls;
+    return std::sin(x);
+  });
+  for (auto repeat = 0; repeat < 3; ++repeat) {
+    for (auto i = 0; i < 100; ++i) EXPECT_EQ(f(0.1 * i), std::sin(0.1 * i));
+  }
+  EXPECT_EQ(calls, 100);
+  auto stats = f.statistics();
+  EXPECT_EQ(stats.hits, 200u);
+  EXPECT_EQ(stats.misses, 100u);
+  EXPECT_EQ(stats.entries, 100u);
+
+  // Copies share the cache, and NaN arguments are never cached.
+  auto copy = f;
+  copy(0.55);
+  f(std::nan(""));
+  f(std::nan(""));
+  EXPECT_EQ(calls, 103);
+  EXPECT_EQ(f.statistics().entries, 101u);
+}
+
+template <typename P>
+void check_eviction() {
+  auto f = memoize([](double x) { return 2 * x; }, P{},
+                   {.max_bytes = 1 << 12, .shards = 1});
+  auto capacity = f.capacity();
+  ASSERT_GT(capacity, 4u);
+  for (auto i = std::size_t{0}; i < 4 * capacity; ++i) {
+    f(static_cast<double>(i));
+    f(0.0);  // keep one entry hot
+  }
+  auto stats = f.statistics();
+  EXPECT_EQ(stats.entries, capacity);
+  EXPECT_EQ(stats.evictions, 4 * capacity - capacity);
+  auto before = f.hits();
+  f(0.0);
+  EXPECT_EQ(f.hits(), before + 1);
+}
+
+TEST(MemoizeTests, EvictsWithinMemoryCap) {
+  check_eviction<LruCache>();
+  check_eviction<ClockCache>();
+}
+
+TEST(MemoizeTests, ConcurrentCallers) {
+  auto f = memoize([](double x) { return std::exp(x); }, ClockCache{});
+  auto threads = std::vector<std::thread>{};
+  for (auto t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      for (auto i = 0; i < 2000; ++i) {
+        auto x = 0.001 * (i % 500);
+        EXPECT_EQ(f(x), std::exp(x));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  auto stats = f.statistics();
+  EXPECT_EQ(stats.hits + stats.misses, 8000u);
+  EXPECT_EQ(stats.entries, 500u);
+}
@@ -5,6 +5,9 @@
 
 using namespace NumericConcepts;
 
+template <typename T, typename U>
+concept Promotable = requires { typename PromotePrecision<T, U>; };
+
 TEST(NumericTests, TypeConcepts) {
   // Test Integral
   static_assert(Integral<int>);
@@ -41,4 +44,46 @@ TEST(NumericTests, UtilityConcepts) {
   static_assert(SamePrecision<float, std::complex<float>, float>);
   static_assert(!SamePrecision<float, double>);
   static_assert(!SamePrecision<float, std::complex<double>>);
-}
\ No newline at end of file
+}
+
+TEST(NumericTests, PromotionTraits) {
+  using CF = std::complex<float>;
+  using CD = std::complex<double>;
+
+  static_assert(std::is_same_v<PromotePrecision<float, double>, double>);
+  static_assert(std::is_same_v<PromotePrecision<float, CD>, CD>);
+  static_assert(std::is_same_v<PromotePrecision<CF, double, float>, CD>);
+  static_assert(std::is_same_v<PromotePrecision<CF>, CF>);
+
+  static_assert(std::is_same_v<WidenPrecision<float>, double>);
+  static_assert(std::is_same_v<WidenPrecision<CF>, CD>);
+  static_assert(std::is_same_v<WidenPrecision<long double>, long double>);
+  static_assert(std::is_same_v<NarrowPrecision<CD>, CF>);
+  static_assert(std::is_same_v<NarrowPrecision<float>, float>);
+  static_assert(std::is_same_v<ReplacePrecision<CF, long double>,
+                               std::complex<long double>>);
+}
+
+TEST(NumericTests, ExtendedFloatingPointTypes) {
+  static_assert(!Half<float> && !BFloat16<float> && !Quad<double>);
+  static_assert(!ExtendedReal<double>);
+#if defined(__FLT16_MAX__)
+  static_assert(Half<_Float16> && Real<_Float16>);
+  // std::complex is unspecified for extended types.
+  static_assert(!Complex<std::complex<_Float16>>);
+  static_assert(!RealOrComplex<std::complex<_Float16>>);
+  static_assert(std::is_same_v<WidenPrecision<_Float16>, float>);
+  static_assert(std::is_same_v<AccumulatorPrecision<_Float16>, float>);
+  static_assert(std::is_same_v<PromotePrecision<_Float16, double>, double>);
+#endif
+#if defined(__SIZEOF_FLOAT128__)
+  static_assert(Quad<__float128> && Real<__float128>);
+  static_assert(!Complex<std::complex<__float128>>);
+  static_assert(!SamePrecision<__float128, std::complex<__float128>>);
+  static_assert(
+      std::is_same_v<PromotePrecision<float, __float128>, __float128>);
+  static_assert(!Promotable<std::complex<float>, __float128>);
+#endif
+  static_assert(std::is_same_v<AccumulatorPrecision<std::complex<double>>,
+                               double>);
+}
@@ -0,0 +1,281 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Ode.hpp>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <deque>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace NumericConcepts;
+
+namespace {
+
+// y'' = -y as a first-order system.
+auto oscillator = [](double, std::span<const double> y,
+                     std::span<double> dydt) {
+  dydt[0] = y[1];
+  dydt[1] = -y[0];
+};
+
+template <typename Method>
+void expect_oscillator(Method method, const OdeOptions& options,
+                       double tolerance) {
+  auto y = std::vector<double>{1.0, 0.0};
+  auto result = integrate(oscillator, y, 0.0, 10.0, method, options);
+  EXPECT_EQ(result.systems, 1u);
+  EXPECT_EQ(result.completed, 1u);
+  EXPECT_GT(result.steps, 0u);
+  EXPECT_NEAR(y[0], std::cos(10.0), tolerance);
+  EXPECT_NEAR(y[1], -std::sin(10.0), tolerance);
+}
+
+// A resource counting the allocations made through it.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  std::size_t allocations = 0;
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes,
+                     std::size_t alignment) override {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const
+      noexcept override {
+    return this == &other;
+  }
+};
+
+// Runs a stepper with any further use of its resource counted and the
+// default resource replaced by one that throws.
+template <typename Stepper>
+void expect_steps_allocation_free(Stepper& stepper,
+                                  CountingResource& resource, auto start) {
+  struct DefaultResourceGuard {
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(
+        std::pmr::null_memory_resource());
+    ~DefaultResourceGuard() { std::pmr::set_default_resource(previous); }
+  };
+  auto before = resource.allocations;
+  auto steps = std::size_t{0};
+  {
+    auto guard = DefaultResourceGuard{};
+    start();
+    for (; stepper.time() < 10.0 && steps < 100000; ++steps) {
+      ASSERT_TRUE(stepper.step(oscillator, 10.0));
+    }
+  }
+  EXPECT_EQ(resource.allocations, before);
+  EXPECT_EQ(stepper.time(), 10.0);
+  EXPECT_NEAR(stepper.state()[0], std::cos(10.0), 1e-5);
+  EXPECT_GT(steps, 10u);
+}
+
+}  // namespace
+
+TEST(OdeTests, Methods) {
+  static_assert(OdeFunction<decltype(oscillator), double, double>);
+  static_assert(!OdeFunction<decltype(oscillator), double, float>);
+  expect_oscillator(Rk4{}, {.step = 0.01}, 1e-8);
+  expect_oscillator(DormandPrince54{},
+                    {.abs_tolerance = 1e-10, .rel_tolerance = 1e-10}, 1e-8);
+  expect_oscillator(Bdf{}, {.abs_tolerance = 1e-9, .rel_tolerance = 1e-9},
+                    1e-5);
+
+  // Tighter tolerances take more steps and are more accurate.
+  auto loose = std::vector<double>{1.0, 0.0};
+  auto tight = loose;
+  auto a = integrate(oscillator, loose, 0.0, 10.0);
+  auto b = integrate(oscillator, tight, 0.0, 10.0, DormandPrince54{},
+                     {.abs_tolerance = 1e-12, .rel_tolerance = 1e-12});
+  EXPECT_GT(b.steps, a.steps);
+  EXPECT_LT(std::abs(tight[0] - std::cos(10.0)),
+            std::abs(loose[0] - std::cos(10.0)));
+}
+
+TEST(OdeTests, ComplexStateAndBackwardIntegration) {
+  // y' = i y, integrated backwards from t = 2 to t = -1.
+  auto f = [](double, std::span<const std::complex<double>> y,
+              std::span<std::complex<double>> dydt) {
+    dydt[0] = std::complex<double>(0, 1) * y[0];
+  };
+  for (auto run : {0, 1, 2}) {
+    auto y = std::deque<std::complex<double>>{std::polar(1.0, 2.0)};
+    auto result =
+        run == 0   ? integrate(f, y, 2.0, -1.0, Rk4{}, {.step = 0.01})
+        : run == 1 ? integrate(f, y, 2.0, -1.0, DormandPrince54{},
+                               {.abs_tolerance = 1e-11,
+                                .rel_tolerance = 1e-11})
+                   : integrate(f, y, 2.0, -1.0, Bdf{},
+                               {.abs_tolerance = 1e-10,
+                                .rel_tolerance = 1e-10});
+    EXPECT_EQ(result.completed, 1u) << run;
+    EXPECT_NEAR(std::abs(y[0] - std::polar(1.0, -1.0)), 0.0, 1e-6) << run;
+  }
+}
+
+TEST(OdeTests, Stiff) {
+  // Robertson-like linear stiff system with eigenvalues -1 and -1e5.
+  auto f = [](double, std::span<const double> y, std::span<double> dydt) {
+    dydt[0] = -y[0];
+    dydt[1] = 1e5 * (y[0] - y[1]);
+  };
+  auto exact = [](double t) {
+    auto k = 1e5 / (1e5 - 1);
+    return std::array<double, 2>{
+        std::exp(-t), k * std::exp(-t) + (1 - k) * std::exp(-1e5 * t)};
+  };
+  auto y = std::vector<double>{1.0, 0.0};
+  auto bdf = integrate(f, y, 0.0, 10.0, Bdf{},
+                       {.abs_tolerance = 1e-10, .rel_tolerance = 1e-6});
+  EXPECT_EQ(bdf.completed, 1u);
+  EXPECT_GT(bdf.jacobians, 0u);
+  EXPECT_NEAR(y[0], exact(10.0)[0], 1e-8);
+  EXPECT_NEAR(y[1], exact(10.0)[1], 1e-8);
+
+  // The explicit method needs far more steps, bounded by stability, even
+  // over a tenth of the interval.
+  auto z = std::vector<double>{1.0, 0.0};
+  auto explicit_result = integrate(f, z, 0.0, 1.0);
+  EXPECT_EQ(explicit_result.completed, 1u);
+  EXPECT_GT(explicit_result.steps, 20 * bdf.steps);
+
+  // Lower-order formulas and the step limit.
+  for (auto order : {1u, 2u, 3u}) {
+    auto w = std::vector<double>{1.0, 0.0};
+    auto result = integrate(f, w, 0.0, 1.0, Bdf{},
+                            {.abs_tolerance = 1e-10,
+                             .rel_tolerance = 1e-8,
+                             .max_order = order});
+    EXPECT_EQ(result.completed, 1u) << order;
+    EXPECT_NEAR(w[0], exact(1.0)[0], order == 1 ? 1e-4 : 1e-6) << order;
+  }
+  auto w = std::vector<double>{1.0, 0.0};
+  auto limited = integrate(f, w, 0.0, 10.0, DormandPrince54{},
+                           {.max_steps = 10});
+  EXPECT_EQ(limited.completed, 0u);
+  EXPECT_EQ(limited.steps, 10u);
+  EXPECT_THROW(BdfStepper<double>(2, {.max_order = 6}),
+               std::invalid_argument);
+}
+
+TEST(OdeTests, DenseOutput) {
+  auto times = std::vector<double>(41);
+  for (auto i = std::size_t{0}; i < times.size(); ++i) times[i] = 0.25 * i;
+  auto check = [&](auto method, double tolerance) {
+    auto y = std::vector<double>{1.0, 0.0};
+    auto out = std::vector<double>(2 * times.size());
+    auto result = integrate_at(oscillator, y, 0.0, times, out, method,
+                               {.abs_tolerance = 1e-10,
+                                .rel_tolerance = 1e-10,
+                                .step = 0.01});
+    EXPECT_EQ(result.completed, 1u);
+    for (auto i = std::size_t{0}; i < times.size(); ++i) {
+      EXPECT_NEAR(out[2 * i], std::cos(times[i]), tolerance) << i;
+      EXPECT_NEAR(out[2 * i + 1], -std::sin(times[i]), tolerance) << i;
+    }
+    EXPECT_NEAR(y[0], std::cos(10.0), tolerance);
+    return result;
+  };
+  check(Rk4{}, 1e-8);
+  check(Bdf{}, 1e-5);
+  // The continuous extension does not force steps onto the output times.
+  auto dense = check(DormandPrince54{}, 1e-8);
+  auto y = std::vector<double>{1.0, 0.0};
+  auto plain = integrate(oscillator, y, 0.0, 10.0, DormandPrince54{},
+                         {.abs_tolerance = 1e-10,
+                          .rel_tolerance = 1e-10,
+                          .step = 0.01});
+  EXPECT_EQ(dense.steps, plain.steps);
+
+  // A stepper used directly.
+  auto stepper = DormandPrince54Stepper<double>(2);
+  auto y0 = std::vector<double>{1.0, 0.0};
+  stepper.start(oscillator, 0.0, y0, 0.0, 1.0);
+  ASSERT_TRUE(stepper.step(oscillator, 1.0));
+  auto t = stepper.time() / 2;
+  auto mid = std::vector<double>(2);
+  stepper.interpolate(t, mid);
+  EXPECT_NEAR(mid[0], std::cos(t), 1e-6);
+}
+
+TEST(OdeTests, StepsDoNotAllocate) {
+  auto resource = CountingResource{};
+  auto y0 = std::vector<double>{1.0, 0.0};
+  auto options = OdeOptions{.abs_tolerance = 1e-10, .rel_tolerance = 1e-10};
+
+  auto rk4 = Rk4Stepper<double>(2, options, &resource);
+  expect_steps_allocation_free(
+      rk4, resource, [&]() { rk4.start(oscillator, 0.0, y0, 0.01); });
+  auto dopri = DormandPrince54Stepper<double>(2, options, &resource);
+  expect_steps_allocation_free(dopri, resource, [&]() {
+    dopri.start(oscillator, 0.0, y0, 0.0, 10.0);
+  });
+  auto bdf = BdfStepper<double>(2, options, &resource);
+  expect_steps_allocation_free(bdf, resource, [&]() {
+    bdf.start(oscillator, 0.0, y0, 0.0, 10.0);
+  });
+  EXPECT_GT(bdf.statistics().jacobians, 0u);
+  EXPECT_GT(resource.allocations, 0u);
+}
+
+TEST(OdeTests, Ensemble) {
+  // Decay rates varying with the system's index.
+  auto systems = std::size_t{1000};
+  auto states = std::vector<double>(3 * systems);
+  for (auto s = std::size_t{0}; s < systems; ++s) {
+    states[3 * s] = 1.0;
+    states[3 * s + 1] = 2.0;
+    states[3 * s + 2] = 3.0;
+  }
+  auto rate = [](std::size_t s) { return 0.1 + 0.001 * s; };
+  auto f = [&](double, std::span<const double> y, std::span<double> dydt,
+               std::size_t s) {
+    for (auto i = std::size_t{0}; i < y.size(); ++i) {
+      dydt[i] = -rate(s) * (i + 1) * y[i];
+    }
+  };
+  auto pool = ThreadPool({.threads = 4});
+  for (auto run : {0, 1}) {
+    auto copy = states;
+    auto result =
+        run == 0 ? integrate_ensemble(f, copy, 3, 0.0, 2.0, DormandPrince54{},
+                                      {.abs_tolerance = 1e-12,
+                                       .rel_tolerance = 1e-10,
+                                       .grain = 64,
+                                       .pool = &pool})
+                 : integrate_ensemble(f, copy, 3, 0.0, 2.0, Bdf{},
+                                      {.abs_tolerance = 1e-10,
+                                       .rel_tolerance = 1e-8,
+                                       .pool = &pool});
+    EXPECT_EQ(result.systems, systems);
+    EXPECT_EQ(result.completed, systems);
+    for (auto s = std::size_t{0}; s < systems; ++s) {
+      for (auto i = std::size_t{0}; i < 3; ++i) {
+        auto expected = (i + 1) * std::exp(-rate(s) * (i + 1) * 2.0);
+        EXPECT_NEAR(copy[3 * s + i], expected, 1e-6) << run << " " << s;
+      }
+    }
+  }
+
+  // The same right-hand side for every system.
+  auto shared = std::vector<float>(8, 1.0f);
+  auto g = [](float, std::span<const float> y, std::span<float> dydt) {
+    dydt[0] = -y[0];
+    dydt[1] = -y[1];
+  };
+  auto result = integrate_ensemble(g, shared, 2, 0.0f, 1.0f, Rk4{});
+  EXPECT_EQ(result.completed, 4u);
+  for (auto v : shared) EXPECT_NEAR(v, std::exp(-1.0f), 1e-6f);
+  EXPECT_THROW(integrate_ensemble(g, shared, 3, 0.0f, 1.0f),
+               std::invalid_argument);
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Pack.hpp>
+#include <cmath>
+#include <complex>
+#include <span>
+#include <vector>
+
+using namespace NumericConcepts;
+
+namespace {
+
+// A kernel written once against the concepts.
+template <RealLike T>
+T gaussian(T x) {
+  using std::exp;
+  return exp(-x * x / 2) + 1;
+}
+
+template <ComplexLike Z>
+Z rotate(Z z) {
+  return z * z + conj(z) / LanePrecision<Z>(2);
+}
+
+}  // namespace
+
+TEST(PackTests, Concepts) {
+  static_assert(RealLike<double>);
+  static_assert(!RealLike<int>);
+  static_assert(ComplexLike<std::complex<float>>);
+  static_assert(!ComplexLike<double>);
+  static_assert(std::same_as<LanePrecision<std::complex<float>>, float>);
+  static_assert(std::same_as<RemoveComplexLike<std::complex<double>>, double>);
+  static_assert(lane_count<std::complex<double>> == 1);
+  static_assert(RealLikeFunction<decltype(&gaussian<double>), double>);
+
+#ifdef NUMERIC_CONCEPTS_STD_SIMD
+  using P = std::experimental::native_simd<double>;
+  using Z = SplitComplexPack<P>;
+  static_assert(RealPack<P> and RealLike<P> and !Real<P>);
+  static_assert(ComplexPack<Z> and ComplexLike<Z> and !Complex<Z>);
+  static_assert(!RealLike<Z> and RealOrComplexLike<Z>);
+  static_assert(std::same_as<RemoveComplexLike<Z>, P>);
+  static_assert(std::same_as<LanePrecision<Z>, double>);
+  static_assert(lane_count<Z> == P::size());
+  static_assert(std::same_as<NativePack<double>, P>);
+  static_assert(std::same_as<NativePack<std::complex<double>>, Z>);
+  static_assert(std::same_as<NativePack<std::complex<float>>,
+                             SplitComplexPack<
+                                 std::experimental::native_simd<float>>>);
+  static_assert(RealLikeFunction<decltype(&gaussian<P>), P>);
+  static_assert(ComplexLikeFunction<decltype(&rotate<Z>), Z>);
+#endif
+}
+
+TEST(PackTests, SplitComplexArithmetic) {
+  using Z = NativePack<std::complex<double>>;
+  constexpr auto lanes = lane_count<Z>;
+  auto a = std::vector<std::complex<double>>(lanes);
+  auto b = std::vector<std::complex<double>>(lanes);
+  for (auto i = std::size_t{0}; i < lanes; ++i) {
+    a[i] = {0.5 + i, -1.25 * i};
+    b[i] = {-2.0 + 0.5 * i, 3.0};
+  }
+  auto za = Detail::pack_load<Z>(a.data());
+  auto zb = Detail::pack_load<Z>(b.data());
+  auto check = [&](auto z, auto expected) {
+    auto out = std::vector<std::complex<double>>(lanes);
+    Detail::pack_store(Z(z), out.data());
+    for (auto i = std::size_t{0}; i < lanes; ++i) {
+      auto e = std::complex<double>(expected(a[i], b[i]));
+      EXPECT_NEAR(out[i].real(), e.real(), 1e-14 * (1 + std::abs(e)));
+      EXPECT_NEAR(out[i].imag(), e.imag(), 1e-14 * (1 + std::abs(e)));
+    }
+  };
+  check(za + zb, [](auto x, auto y) { return x + y; });
+  check(za - zb, [](auto x, auto y) { return x - y; });
+  check(za * zb, [](auto x, auto y) { return x * y; });
+  check(za / zb, [](auto x, auto y) { return x / y; });
+  check(-za + 2.0, [](auto x, auto) { return -x + 2.0; });
+  check(3.0 * za, [](auto x, auto) { return 3.0 * x; });
+  check(1.0 / zb, [](auto, auto y) { return 1.0 / y; });
+  check(conj(za), [](auto x, auto) { return std::conj(x); });
+  check(exp(za), [](auto x, auto) { return std::exp(x); });
+  check(abs(zb), [](auto, auto y) { return std::abs(y); });
+  check(arg(zb), [](auto, auto y) { return std::arg(y); });
+  check(norm(za), [](auto x, auto) { return std::norm(x); });
+
+  auto zc = za;
+  zc *= zb;
+  zc += std::complex<double>(1, 1);
+  check(zc, [](auto x, auto y) { return x * y + std::complex<double>(1, 1); });
+  check(za, [](auto x, auto) { return x; });
+}
+
+TEST(PackTests, TransformMatchesScalarKernel) {
+  for (auto n : {0, 1, 7, 64, 101}) {
+    auto x = std::vector<double>(n);
+    for (auto i = 0; i < n; ++i) x[i] = -3.0 + 0.07 * i;
+    auto y = std::vector<double>(n);
+    auto f = [](auto v) { return gaussian(v); };
+    EXPECT_EQ(pack_transform(f, x, y), static_cast<std::size_t>(n));
+    for (auto i = 0; i < n; ++i) {
+      EXPECT_NEAR(y[i], gaussian(x[i]), 1e-15) << i;
+    }
+  }
+
+  auto z = std::vector<std::complex<float>>(37);
+  for (auto i = std::size_t{0}; i < z.size(); ++i) {
+    z[i] = {0.1f * i, 1.0f - 0.05f * i};
+  }
+  auto w = std::vector<std::complex<float>>(z.size());
+  pack_transform([](auto v) { return rotate(v); }, z, w);
+  for (auto i = std::size_t{0}; i < z.size(); ++i) {
+    auto e = rotate(z[i]);
+    EXPECT_NEAR(w[i].real(), e.real(), 1e-5f) << i;
+    EXPECT_NEAR(w[i].imag(), e.imag(), 1e-5f) << i;
+  }
+}
+
+TEST(PackTests, TransformConvertsAndTruncates) {
+  auto x = std::vector<float>(50);
+  for (auto i = std::size_t{0}; i < x.size(); ++i) x[i] = 0.25f * i;
+  auto y = std::vector<double>(45);
+  auto square = [](auto v) { return v * v; };
+  EXPECT_EQ(pack_transform(square, x, y), 45u);
+  for (auto i = std::size_t{0}; i < y.size(); ++i) {
+    EXPECT_EQ(y[i], static_cast<double>(x[i] * x[i]));
+  }
+
+  // A real kernel writing complex output, in place over a span.
+  auto polar = [](auto v) {
+    using std::cos;
+    using std::sin;
+    return NativePack<std::complex<double>>(cos(v), sin(v));
+  };
+  auto t = std::vector<double>{0.0, 0.5, 1.0, 1.5, 2.0, 2.5, 3.0, 3.5, 4.0};
+  auto u = std::vector<std::complex<double>>(t.size());
+  auto scalar = [&](double v) { return std::polar(1.0, v); };
+  auto both = [&](auto v) {
+    if constexpr (std::same_as<decltype(v), double>) {
+      return scalar(v);
+    } else {
+      return polar(v);
+    }
+  };
+  pack_transform(both, std::span<const double>(t), u);
+  for (auto i = std::size_t{0}; i < t.size(); ++i) {
+    EXPECT_NEAR(std::abs(u[i] - scalar(t[i])), 0.0, 1e-15) << i;
+  }
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Parallel.hpp>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <ctime>
+#include <list>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace NumericConcepts;
+
+TEST(ParallelTests, ForEachModifiesElements) {
+  auto pool = ThreadPool({.threads = 4});
+  auto x = std::vector<double>(100'001, 1.0);
+  parallel_for_each(x, [](double& v) { v *= 2.0; },
+                    {.grain = 1000, .pool = &pool});
+  EXPECT_TRUE(std::ranges::all_of(x, [](double v) { return v == 2.0; }));
+
+  auto list = std::list<int>(10, 1);
+  auto count = 0;
+  parallel_for_each(list, [&](int v) { count += v; });
+  EXPECT_EQ(count, 10);
+}
+
+TEST(ParallelTests, TransformToComplex) {
+  auto x = std::vector<double>(50'000);
+  for (auto i = std::size_t{0}; i < x.size(); ++i) x[i] = 0.001 * i;
+  auto y = std::vector<std::complex<double>>(x.size());
+  auto f = [](double t) { return std::polar(1.0, t); };
+  static_assert(ComplexFunction<decltype(f), double>);
+  EXPECT_EQ(parallel_transform(x, y, f), x.size());
+  EXPECT_EQ(y[1234], f(x[1234]));
+
+  auto z = std::vector<float>(10);
+  EXPECT_EQ(parallel_transform(std::list<float>(5, 4.0f), z,
+                               [](float v) { return std::sqrt(v); }),
+            5u);
+  EXPECT_EQ(z[4], 2.0f);
+  EXPECT_EQ(z[5], 0.0f);
+}
+
+TEST(ParallelTests, ReduceIndependentOfThreadCount) {
+  auto x = std::vector<double>(100'003);
+  for (auto i = std::size_t{0}; i < x.size(); ++i) x[i] = 1.0 / (1.0 + i);
+
+  auto serial = ThreadPool({.threads = 1});
+  auto parallel = ThreadPool({.threads = 3});
+  auto a = parallel_reduce(x, 0.0, std::plus<>{}, {.pool = &serial});
+  auto b = parallel_reduce(x, 0.0, std::plus<>{}, {.pool = &parallel});
+  EXPECT_EQ(a, b);
+  EXPECT_NEAR(a, std::log(100'003.0) + 0.5772156649, 1e-5);
+
+  auto max = parallel_reduce(
+      x, 0.0, [](double p, double q) { return std::max(p, q); });
+  EXPECT_EQ(max, 1.0);
+  EXPECT_EQ(parallel_reduce(std::vector<int>{}, 7), 7);
+}
+
+TEST(ParallelTests, NestedParallelismAndExceptions) {
+  auto pool = ThreadPool({.threads = 2, .pin_threads = true});
+  auto rows = std::vector<int>(16);
+  auto total = std::atomic<int>{0};
+  parallel_for_each(
+      rows,
+      [&](int&) {
+        auto inner = std::vector<int>(1000, 1);
+        total += parallel_reduce(inner, 0, std::plus<>{},
+                                 {.grain = 100, .pool = &pool});
+      },
+      {.grain = 1, .pool = &pool});
+  EXPECT_EQ(total, 16000);
+
+  auto x = std::vector<double>(10'000);
+  EXPECT_THROW(parallel_for_each(
+                   x,
+                   [](double&) { throw std::runtime_error("task failed"); },
+                   {.grain = 10, .pool = &pool}),
+               std::runtime_error);
+}
+
+#if defined(__linux__)
+TEST(ParallelTests, WaitingSleepsOnceQueueIsEmpty) {
+  auto cpu_time = []() {
+    auto t = timespec{};
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+    return t.tv_sec + 1e-9 * t.tv_nsec;
+  };
+  auto pool = ThreadPool({.threads = 2});
+  auto start = cpu_time();
+  {
+    auto group = Detail::TaskGroup(pool);
+    group.run([]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    });
+    // Let the worker take the task, leaving nothing for this thread to run.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    group.wait();
+  }
+  EXPECT_LT(cpu_time() - start, 0.1);
+}
+#endif
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Quadrature.hpp>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <span>
+
+using namespace NumericConcepts;
+
+TEST(QuadratureTests, RulesIntegratePolynomialsExactly) {
+  // The 15 and 21 point Kronrod rules are exact to degree 22 and 31.
+  auto p = [](double x) { return std::pow(x, 22) - 3 * x + 1; };
+  auto exact = std::pow(2.0, 23) / 23 - 3 * 2.0 + 2.0;
+  auto g15 = integrate(p, 0.0, 2.0, GaussKronrod15{});
+  auto g21 = integrate(p, 0.0, 2.0, GaussKronrod21{});
+  EXPECT_NEAR(g15.value, exact, 1e-12 * exact);
+  EXPECT_NEAR(g21.value, exact, 1e-12 * exact);
+  EXPECT_TRUE(g21.converged);
+  EXPECT_EQ(g21.intervals, 1u);
+  EXPECT_EQ(g21.evaluations, 21u);
+  EXPECT_EQ(g15.evaluations % 15, 0u);
+}
+
+TEST(QuadratureTests, AdaptiveRefinementInParallel) {
+  auto pool = ThreadPool({.threads = 4});
+  auto calls = std::atomic<std::size_t>{0};
+  auto f = [&](double x) {
+    ++calls;
+    return std::sin(50 * x) * std::exp(-x);
+  };
+  auto result = integrate(f, 0.0, 10.0, GaussKronrod21{},
+                          {.abs_tolerance = 1e-12, .rel_tolerance = 1e-12,
+                           .pool = &pool});
+  auto exact = (50 - std::exp(-10.0) * (std::sin(500.0) +
+                                        50 * std::cos(500.0))) /
+               2501;
+  EXPECT_TRUE(result.converged);
+  EXPECT_GT(result.intervals, 1u);
+  EXPECT_EQ(result.evaluations, calls);
+  EXPECT_NEAR(result.value, exact, 1e-11);
+  EXPECT_LE(std::abs(result.value - exact), 10 * result.error + 1e-14);
+
+  // Reversed limits negate the result.
+  auto reversed = integrate(f, 10.0, 0.0, GaussKronrod21{},
+                            {.rel_tolerance = 1e-12, .pool = &pool});
+  EXPECT_NEAR(reversed.value, -exact, 1e-11);
+}
+
+TEST(QuadratureTests, ComplexIntegrand) {
+  auto f = [](double x) { return std::polar(1.0, x); };
+  auto result = integrate(f, 0.0, std::numbers::pi);
+  static_assert(std::same_as<decltype(result.value), std::complex<double>>);
+  static_assert(std::same_as<decltype(result.error), double>);
+  EXPECT_NEAR(result.value.real(), 0.0, 1e-12);
+  EXPECT_NEAR(result.value.imag(), 2.0, 1e-12);
+}
+
+TEST(QuadratureTests, TanhSinhHandlesEndPointSingularities) {
+  auto f = [](double x) { return 1.0 / std::sqrt(x) + std::log(1 - x); };
+  auto result = integrate(f, 0.0, 1.0, TanhSinh{}, {.rel_tolerance = 1e-10});
+  EXPECT_TRUE(result.converged);
+  EXPECT_NEAR(result.value, 2.0 - 1.0, 1e-9);
+
+  auto g = [](float x) { return 1.0f / std::sqrt(1.0f - x * x); };
+  auto arcsine = integrate(g, -1.0f, 1.0f, TanhSinh{});
+  // Nodes within float spacing of the end points are rounded away.
+  EXPECT_NEAR(arcsine.value, std::numbers::pi_v<float>, 1e-3f);
+}
+
+TEST(QuadratureTests, ReportsNonConvergence) {
+  auto f = [](double x) { return std::sin(1.0 / x); };
+  auto result = integrate(f, 1e-6, 1.0, GaussKronrod15{},
+                          {.rel_tolerance = 1e-14, .max_intervals = 20});
+  EXPECT_FALSE(result.converged);
+  EXPECT_EQ(result.intervals, 20u);
+}
+
+namespace {
+
+// An integrand with both calling conventions, counting the calls of each.
+struct CountingIntegrand {
+  std::atomic<std::size_t>* scalar;
+  std::atomic<std::size_t>* batched;
+
+  double operator()(double x) const {
+    ++*scalar;
+    return std::cos(x);
+  }
+
+  void operator()(std::span<const double> x, std::span<double> out) const {
+    ++*batched;
+    for (auto i = std::size_t{0}; i < x.size(); ++i) out[i] = std::cos(x[i]);
+  }
+};
+
+}  // namespace
+
+TEST(QuadratureTests, BatchedIntegrandAndNestedParallelism) {
+  auto scalar = std::atomic<std::size_t>{0};
+  auto batched = std::atomic<std::size_t>{0};
+  auto f = CountingIntegrand{&scalar, &batched};
+  auto result = integrate(f, 0.0, 20.0, GaussKronrod15{},
+                          {.rel_tolerance = 1e-12});
+  EXPECT_NEAR(result.value, std::sin(20.0), 1e-11);
+  EXPECT_EQ(scalar, 0u);
+  EXPECT_EQ(batched * GaussKronrod15::evaluations, result.evaluations);
+
+  // An integrand that integrates on the same pool.
+  auto pool = ThreadPool({.threads = 4});
+  auto options = QuadratureOptions{.rel_tolerance = 1e-10, .pool = &pool};
+  auto inner = [&](double x) {
+    auto g = [x](double y) { return std::exp(-x * y); };
+    return integrate(g, 0.0, 1.0, GaussKronrod21{}, options).value;
+  };
+  // The integral of (1 - exp(-x)) / x over [1, 2].
+  auto outer = integrate(inner, 1.0, 2.0, GaussKronrod21{}, options);
+  auto exact = std::log(2.0) + std::expint(-1.0) - std::expint(-2.0);
+  EXPECT_NEAR(outer.value, exact, 1e-9);
+}
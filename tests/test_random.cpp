@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Random.hpp>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace NumericConcepts;
+
+namespace {
+
+template <typename T>
+std::pair<double, double> moments(const std::vector<T>& x) {
+  auto mean = 0.0;
+  for (auto v : x) mean += v;
+  mean /= x.size();
+  auto variance = 0.0;
+  for (auto v : x) variance += (v - mean) * (v - mean);
+  return {mean, variance / (x.size() - 1)};
+}
+
+template <typename Generator>
+void expect_kernels_match_scalar() {
+  using Traits = Detail::RandomGeneratorTraits<Generator>;
+  constexpr auto n = Traits::words * Detail::RandomLaneCount;
+  auto reference = std::array<std::uint32_t, n>{};
+  // A first counter whose lanes carry into the high word.
+  auto first = std::uint64_t{0xfffffffffffffff8};
+  auto options = RandomOptions{.seed = 0x0123456789abcdef, .stream = 42};
+  options.vector_math.limit = InstructionSet::Scalar;
+  Traits::blocks(first, options, reference.data());
+  for (auto isa : {InstructionSet::Sse42, InstructionSet::Avx2,
+                   InstructionSet::Avx512}) {
+    auto words = std::array<std::uint32_t, n>{};
+    options.vector_math.limit = isa;
+    Traits::blocks(first, options, words.data());
+    EXPECT_EQ(words, reference);
+  }
+}
+
+}  // namespace
+
+TEST(RandomTests, KnownAnswers) {
+  // The known-answer vectors of Random123.
+  using P = Detail::PhiloxCounter;
+  EXPECT_EQ(Detail::philox4x32({0, 0, 0, 0}, {0, 0}),
+            (P{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  EXPECT_EQ(Detail::philox4x32({0xffffffff, 0xffffffff, 0xffffffff,
+                                0xffffffff},
+                               {0xffffffff, 0xffffffff}),
+            (P{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+  EXPECT_EQ(Detail::philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e,
+                                0x03707344},
+                               {0xa4093822, 0x299f31d0}),
+            (P{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+  using T = Detail::ThreefryCounter;
+  EXPECT_EQ(Detail::threefry4x64({0, 0, 0, 0}, {0, 0, 0, 0}),
+            (T{0x09218ebde6c85537, 0x55941f5266d86105, 0x4bd25e16282434dc,
+               0xee29ec846bd2e40b}));
+  auto ones = ~std::uint64_t{0};
+  EXPECT_EQ(Detail::threefry4x64({ones, ones, ones, ones},
+                                 {ones, ones, ones, ones}),
+            (T{0x29c24097942bba1b, 0x0371bbfb0f6f4e11, 0x3c231ffa33f83a1c,
+               0xcd29113fde32d168}));
+
+  expect_kernels_match_scalar<Philox4x32>();
+  expect_kernels_match_scalar<Threefry4x64>();
+}
+
+TEST(RandomTests, Reproducible) {
+  auto n = std::size_t{100003};
+  auto serial_pool = ThreadPool({.threads = 1});
+  auto pool = ThreadPool({.threads = 4});
+  auto check = [&](auto distribution, auto generator, auto element) {
+    using E = decltype(element);
+    auto a = std::vector<E>(n);
+    auto b = std::vector<E>(n);
+    random_fill(a, distribution, generator,
+                {.seed = 7, .grain = n, .pool = &serial_pool});
+    random_fill(b, distribution, generator,
+                {.seed = 7, .grain = 1000, .pool = &pool});
+    EXPECT_EQ(a, b);
+
+    // Two fills continuing one sequence, split at an odd element.
+    auto draws = std::uint64_t{std::same_as<E, std::complex<double>> ? 2 : 1};
+    auto c = std::vector<E>(n);
+    auto head = std::span<E>(c).first(33333);
+    auto tail = std::span<E>(c).subspan(33333);
+    random_fill(head, distribution, generator, {.seed = 7, .pool = &pool});
+    random_fill(tail, distribution, generator,
+                {.seed = 7, .offset = 33333 * draws, .pool = &pool});
+    EXPECT_EQ(a, c);
+
+    // Other seeds and streams differ.
+    random_fill(b, distribution, generator, {.seed = 8, .pool = &pool});
+    EXPECT_NE(a, b);
+    random_fill(b, distribution, generator,
+                {.seed = 7, .stream = 1, .pool = &pool});
+    EXPECT_NE(a, b);
+  };
+  check(Uniform{}, Philox4x32{}, 0.0f);
+  check(Normal{}, Philox4x32{}, 0.0);
+  check(Normal{}, Threefry4x64{}, std::complex<double>{});
+  check(Exponential{}, Threefry4x64{}, 0.0f);
+  check(RandomBits{}, Philox4x32{}, std::uint64_t{});
+}
+
+TEST(RandomTests, Distributions) {
+  auto n = std::size_t{1} << 20;
+  auto x = std::vector<double>(n);
+  random_fill(x, Uniform{-1, 3});
+  auto [mean, variance] = moments(x);
+  EXPECT_NEAR(mean, 1.0, 0.01);
+  EXPECT_NEAR(variance, 16.0 / 12, 0.01);
+  EXPECT_GE(*std::ranges::min_element(x), -1.0);
+  EXPECT_LT(*std::ranges::max_element(x), 3.0);
+
+  auto y = std::vector<float>(n);
+  random_fill(y, Normal{2, 0.5}, Threefry4x64{});
+  std::tie(mean, variance) = moments(y);
+  EXPECT_NEAR(mean, 2.0, 0.005);
+  EXPECT_NEAR(variance, 0.25, 0.005);
+  auto within = std::ranges::count_if(
+      y, [](float v) { return std::abs(v - 2) < 0.5f; });
+  EXPECT_NEAR(static_cast<double>(within) / n, 0.6827, 0.005);
+
+  random_fill(x, Exponential{4}, Philox4x32{}, {.seed = 3});
+  std::tie(mean, variance) = moments(x);
+  EXPECT_NEAR(mean, 0.25, 0.005);
+  EXPECT_NEAR(variance, 0.0625, 0.005);
+  EXPECT_GT(*std::ranges::min_element(x), 0.0);
+
+  // Independent real and imaginary parts.
+  auto z = std::vector<std::complex<double>>(n / 2);
+  random_fill(z, Normal{});
+  auto re = std::vector<double>(z.size());
+  auto im = std::vector<double>(z.size());
+  auto product = 0.0;
+  for (auto i = std::size_t{0}; i < z.size(); ++i) {
+    re[i] = z[i].real();
+    im[i] = z[i].imag();
+    product += re[i] * im[i];
+  }
+  EXPECT_NEAR(moments(re).second, 1.0, 0.01);
+  EXPECT_NEAR(moments(im).second, 1.0, 0.01);
+  EXPECT_NEAR(product / z.size(), 0.0, 0.01);
+
+  EXPECT_THROW(random_fill(x, Exponential{0}), std::invalid_argument);
+  EXPECT_THROW(random_fill(x, Normal{0, -1}), std::invalid_argument);
+}
+
+TEST(RandomTests, Integers) {
+  auto dice = std::vector<int>(60000);
+  random_fill(dice, UniformInteger{1, 6});
+  auto counts = std::array<int, 6>{};
+  for (auto v : dice) {
+    ASSERT_TRUE(v >= 1 && v <= 6);
+    ++counts[v - 1];
+  }
+  for (auto count : counts) EXPECT_NEAR(count, 10000, 400);
+
+  // Negative bounds, the full range, and raw bits of narrow types.
+  auto wide = std::vector<std::int64_t>(1000);
+  random_fill(wide, UniformInteger{-5, -3});
+  for (auto v : wide) EXPECT_TRUE(v >= -5 && v <= -3);
+  random_fill(wide, UniformInteger{INT64_MIN, INT64_MAX});
+  EXPECT_GT(std::ranges::count_if(wide, [](auto v) { return v < 0; }), 400);
+  auto bytes = std::vector<std::uint8_t>(4096);
+  random_fill(bytes, RandomBits{});
+  auto seen = std::array<bool, 256>{};
+  for (auto v : bytes) seen[v] = true;
+  EXPECT_EQ(std::ranges::count(seen, true), 256);
+  EXPECT_THROW(random_fill(wide, UniformInteger{2, 1}),
+               std::invalid_argument);
+  // Bounds outside the element type would wrap.
+  EXPECT_THROW(random_fill(bytes, UniformInteger{0, 1000}),
+               std::invalid_argument);
+  EXPECT_THROW(random_fill(bytes, UniformInteger{-1, 10}),
+               std::invalid_argument);
+  EXPECT_THROW(random_fill(dice, UniformInteger{0, INT64_MAX}),
+               std::invalid_argument);
+  random_fill(bytes, UniformInteger{0, 255});
+  auto small = std::vector<signed char>(100);
+  random_fill(small, UniformInteger{-128, 127});
+
+  // A range without random access matches a vector.
+  auto list = std::list<short>(1000);
+  auto vector = std::vector<short>(1000);
+  EXPECT_EQ(random_fill(list, UniformInteger{-100, 100}), 1000u);
+  random_fill(vector, UniformInteger{-100, 100});
+  EXPECT_TRUE(std::ranges::equal(list, vector));
+}
@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <NumericConcepts/NumericConcepts.hpp>
+#include <array>
 #include <complex>
+#include <deque>
+#include <list>
+#include <span>
 #include <vector>
 
 using namespace NumericConcepts;
@@ -24,6 +28,29 @@ TEST(RangeTests, WritableRangeConcepts) {
   static_assert(NumericWritableRange<IntVec>);
 }
 
+TEST(RangeTests, ContiguousRangeConcepts) {
+  static_assert(ContiguousRealRange<std::vector<double>>);
+  static_assert(ContiguousRealRange<std::span<const float>>);
+  static_assert(ContiguousComplexRange<std::array<std::complex<double>, 4>>);
+  static_assert(!ContiguousRealRange<std::list<double>>);
+  static_assert(!ContiguousRealRange<std::deque<double>>);
+  static_assert(ContiguousRealWritableRange<std::vector<double>>);
+  static_assert(!ContiguousRealWritableRange<std::span<const double>>);
+}
+
+TEST(RangeTests, AlignedRangeConcepts) {
+  struct alignas(64) Aligned {
+    std::array<double, 8> data;
+  };
+  static_assert(AlignedRange<std::vector<double>, alignof(double)>);
+  static_assert(!AlignedRange<std::vector<double>, 64>);
+
+  auto storage = Aligned{};
+  auto span = std::span(storage.data);
+  EXPECT_TRUE(is_aligned<64>(span));
+  EXPECT_FALSE(is_aligned<64>(span.subspan(1)));
+}
+
 TEST(RangeTests, PrecisionConcepts) {
   using FloatVec = std::vector<float>;
   using DoubleVec = std::vector<double>;
@@ -31,4 +58,10 @@ TEST(RangeTests, PrecisionConcepts) {
 
   static_assert(SameRangePrecision<FloatVec, ComplexFloatVec>);
   static_assert(!SameRangePrecision<FloatVec, DoubleVec>);
+  static_assert(
+      std::is_same_v<RangePromotePrecision<FloatVec, std::vector<double>>,
+                     double>);
+  static_assert(
+      std::is_same_v<RangePromotePrecision<ComplexFloatVec, DoubleVec>,
+                     std::complex<double>>);
 }
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/RootFinding.hpp>
+#include <cmath>
+#include <deque>
+#include <list>
+#include <vector>
+
+using namespace NumericConcepts;
+
+namespace {
+
+auto cube = [](double x, double p) { return x * x * x - p; };
+auto cube_derivative = [](double x, double) { return 3 * x * x; };
+
+std::vector<double> parameters(std::size_t n) {
+  auto p = std::vector<double>(n);
+  for (auto i = std::size_t{0}; i < n; ++i) p[i] = 0.5 + 0.37 * i;
+  return p;
+}
+
+template <typename Method>
+void expect_cube_roots(Method method) {
+  auto p = parameters(1000);
+  auto roots = std::vector<double>(p.size());
+  auto pool = ThreadPool({.threads = 4});
+  auto result = find_roots(cube, p, 0.0, 20.0, roots, method,
+                           {.grain = 100, .pool = &pool});
+  EXPECT_EQ(result.roots, p.size());
+  EXPECT_EQ(result.converged, p.size());
+  EXPECT_EQ(result.unbracketed, 0u);
+  EXPECT_GT(result.evaluations, 2 * p.size());
+  for (auto i = std::size_t{0}; i < p.size(); ++i) {
+    EXPECT_NEAR(roots[i], std::cbrt(p[i]), 1e-13 * std::cbrt(p[i])) << i;
+  }
+}
+
+}  // namespace
+
+TEST(RootFindingTests, Methods) {
+  expect_cube_roots(Brent{});
+  expect_cube_roots(Itp{});
+  expect_cube_roots(Newton{cube_derivative});
+}
+
+TEST(RootFindingTests, BracketsAndEndPoints) {
+  auto p = std::vector<double>{8.0, 8.0, 8.0, 8.0, 27.0};
+  auto lower = std::vector<double>{0.0, 2.0, 3.0, 3.0, 10.0};
+  auto upper = std::vector<double>{5.0, 6.0, 1.0, 4.0, 2.0};
+  auto roots = std::vector<double>(p.size());
+  for (auto run : {0, 1, 2}) {
+    auto result = run == 0   ? find_roots(cube, p, lower, upper, roots)
+                  : run == 1 ? find_roots(cube, p, lower, upper, roots, Itp{})
+                             : find_roots(cube, p, lower, upper, roots,
+                                          Newton{cube_derivative});
+    EXPECT_EQ(result.converged, 4u);
+    EXPECT_EQ(result.unbracketed, 1u);
+    EXPECT_NEAR(roots[0], 2.0, 1e-14);
+    EXPECT_EQ(roots[1], 2.0);
+    EXPECT_NEAR(roots[2], 2.0, 1e-14);
+    EXPECT_TRUE(std::isnan(roots[3]));
+    EXPECT_NEAR(roots[4], 3.0, 1e-14);
+  }
+}
+
+TEST(RootFindingTests, TolerancesAndIterationLimit) {
+  auto p = parameters(200);
+  auto loose = std::vector<double>(p.size());
+  auto result = find_roots(cube, p, 0.0, 20.0, loose, Itp{},
+                           {.abs_tolerance = 1e-3});
+  EXPECT_EQ(result.converged, p.size());
+  for (auto i = std::size_t{0}; i < p.size(); ++i) {
+    EXPECT_NEAR(loose[i], std::cbrt(p[i]), 1e-3);
+  }
+
+  // A flat function that Newton's method cannot solve in three steps.
+  auto flat = [](double x, double q) { return std::pow(x - q, 9.0); };
+  auto dflat = [](double x, double q) { return 9 * std::pow(x - q, 8.0); };
+  auto q = std::vector<double>{0.3, 0.6};
+  auto roots = std::vector<double>(q.size());
+  result = find_roots(flat, q, 0.0, 1.0, roots, Newton{dflat},
+                      {.max_iterations = 3});
+  EXPECT_EQ(result.converged, 0u);
+  EXPECT_EQ(result.roots, 2u);
+  for (auto i = std::size_t{0}; i < q.size(); ++i) {
+    EXPECT_TRUE(roots[i] > 0 && roots[i] < 1);
+  }
+  // ITP needs at most one iteration more than bisection.
+  result = find_roots(flat, q, 0.0, 1.0, roots, Itp{});
+  EXPECT_EQ(result.converged, 2u);
+  EXPECT_LE(result.evaluations, 2u * (2 + 54));
+  for (auto i = std::size_t{0}; i < q.size(); ++i) {
+    EXPECT_NEAR(roots[i], q[i], 1e-12);
+  }
+  // A bracket straddling zero, where the tolerance at its midpoint is far
+  // smaller than at the root, which bisection finds in 65 iterations.
+  auto near_zero = std::vector<double>{1e-4};
+  auto root = std::vector<double>(1);
+  result = find_roots(flat, near_zero, -1.0, 1.0, root, Itp{},
+                      {.max_iterations = 1000});
+  EXPECT_EQ(result.converged, 1u);
+  EXPECT_LE(result.evaluations, 2u + 66);
+  EXPECT_NEAR(root[0], 1e-4, 1e-15);
+}
+
+TEST(RootFindingTests, Ranges) {
+  // Integral parameters and a bracket per equation from non-random-access
+  // ranges, written to a deque of floats.
+  auto p = std::list<int>{1, 8, 27, 64, 125};
+  auto lower = std::list<float>(5, 0.0f);
+  auto upper = std::vector<double>(5, 6.0);
+  auto roots = std::deque<float>(4);
+  auto f = [](double x, const int& n) { return x * x * x - n; };
+  auto result = find_roots(f, p, lower, upper, roots);
+  EXPECT_EQ(result.roots, 4u);
+  for (auto i = 0; i < 4; ++i) {
+    EXPECT_FLOAT_EQ(roots[i], static_cast<float>(i + 1));
+  }
+
+  // Float brackets solve in float.
+  auto q = std::vector<float>{2.0f, 3.0f, 5.0f};
+  auto sqrts = std::vector<float>(q.size());
+  auto g = [](float x, float v) { return x * x - v; };
+  find_roots(g, q, 0.0f, 3.0f, sqrts, Itp{});
+  for (auto i = std::size_t{0}; i < q.size(); ++i) {
+    EXPECT_NEAR(sqrts[i], std::sqrt(q[i]), 1e-6f);
+  }
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Chebyshev.hpp>
+#include <NumericConcepts/Sampling.hpp>
+#include <NumericConcepts/SplitComplex.hpp>
+#include <cmath>
+#include <complex>
+#include <forward_list>
+#include <list>
+#include <span>
+#include <sstream>
+#include <vector>
+
+using namespace NumericConcepts;
+
+namespace {
+
+// A batched function that counts how often it is called.
+struct CountingBatch {
+  int* calls;
+  std::size_t* points = nullptr;
+  void operator()(std::span<const double> x, std::span<double> out) const {
+    ++*calls;
+    if (points) *points += x.size();
+    for (auto i = std::size_t{0}; i < x.size(); ++i) out[i] = 2 * x[i];
+  }
+};
+
+}  // namespace
+
+TEST(SamplingTests, BatchConcepts) {
+  auto scalar = [](double x) { return std::cos(x); };
+  auto batch = as_batch(scalar);
+  static_assert(!BatchRealFunction<decltype(scalar), double>);
+  static_assert(BatchRealFunction<decltype(batch), double>);
+  static_assert(BatchRealFunction<decltype(batch), float>);
+  static_assert(RealFunction<decltype(batch), double>);
+  static_assert(!BatchComplexFunction<CountingBatch, double>);
+  static_assert(BatchRealFunction<CountingBatch, double>);
+  static_assert(!BatchRealFunction<CountingBatch, float>);
+  static_assert(
+      BatchRealOrComplexFunction<decltype(batch), double, std::list<double>&>);
+
+  auto polar = as_batch([](double x) { return std::polar(1.0, x); });
+  static_assert(BatchComplexFunction<decltype(polar), double>);
+  static_assert(!BatchRealFunction<decltype(polar), double>);
+  static_assert(BatchComplexFunction<decltype(polar), double,
+                                     SplitComplexVector<double>&>);
+}
+
+TEST(SamplingTests, AdaptorMatchesScalarLoop) {
+  auto f = [](double x) { return std::exp(-x * x); };
+  auto x = std::vector<double>(1000);
+  for (auto i = std::size_t{0}; i < x.size(); ++i) x[i] = 0.01 * i;
+  auto out = std::vector<double>(x.size());
+  as_batch(f)(std::span<const double>(x), out);
+  for (auto i = std::size_t{0}; i < x.size(); ++i) {
+    EXPECT_EQ(out[i], f(x[i]));
+  }
+
+  auto listed = std::list<double>(x.size());
+  as_batch(f)(std::span<const double>(x), listed);
+  EXPECT_TRUE(std::equal(out.begin(), out.end(), listed.begin()));
+}
+
+TEST(SamplingTests, ContiguousBatchPathCallsOnce) {
+  auto calls = 0;
+  auto f = CountingBatch{&calls};
+  auto grid = std::vector<double>(1000, 1.5);
+  auto out = std::vector<double>(800);
+  EXPECT_EQ(sample(f, grid, out), 800u);
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(out.back(), 3.0);
+}
+
+TEST(SamplingTests, NonContiguousBatchPathUsesBlocks) {
+  auto calls = 0;
+  auto f = CountingBatch{&calls};
+  auto grid = std::list<double>(600, 0.25);
+  auto out = std::vector<double>(600);
+  EXPECT_EQ(sample(f, grid, out), 600u);
+  EXPECT_EQ(calls, 3);
+  EXPECT_EQ(out.front(), 0.5);
+  EXPECT_EQ(out.back(), 0.5);
+}
+
+TEST(SamplingTests, BlocksStopAtTheEndOfTheOutput) {
+  auto calls = 0;
+  auto points = std::size_t{0};
+  auto f = CountingBatch{&calls, &points};
+  auto grid = std::list<double>(600, 0.25);
+  auto out = std::vector<double>(10);
+  EXPECT_EQ(sample(f, grid, out), 10u);
+  EXPECT_EQ(points, 10u);
+
+  // An unsized output range, and a grid read from a stream that must not be
+  // consumed past the point after the last one evaluated, which the
+  // istream view reads ahead.
+  points = 0;
+  auto unsized = std::forward_list<double>(300);
+  auto in = std::istringstream("1 2 3 4 5");
+  auto values = std::views::istream<double>(in);
+  auto partial = std::forward_list<double>(3);
+  EXPECT_EQ(sample(f, grid, unsized), 300u);
+  EXPECT_EQ(points, 300u);
+  EXPECT_EQ(sample(f, values, partial), 3u);
+  EXPECT_EQ(partial, (std::forward_list<double>{2.0, 4.0, 6.0}));
+  auto next = 0.0;
+  in >> next;
+  EXPECT_EQ(next, 5.0);
+}
+
+TEST(SamplingTests, ScalarFallback) {
+  auto grid = std::vector<float>{0.0f, 1.0f, 2.0f};
+  auto out = std::list<double>(5, -1.0);
+  EXPECT_EQ(sample([](float x) { return x * x; }, grid, out), 3u);
+  EXPECT_EQ(out, (std::list<double>{0.0, 1.0, 4.0, -1.0, -1.0}));
+
+  auto complex = SplitComplexVector<double>(3);
+  sample([](float x) { return std::complex<double>(x, -x); }, grid, complex);
+  EXPECT_EQ(std::complex<double>(complex[2]), std::complex<double>(2, -2));
+}
+
+TEST(SamplingTests, ChebyshevProxyIsBatched) {
+  auto f = [](double x) { return std::sin(3 * x); };
+  auto proxy = chebyshev_proxy(f, 0.0, 2.0);
+  static_assert(BatchRealFunction<decltype(proxy), double>);
+  auto grid = std::vector<double>(300);
+  for (auto i = std::size_t{0}; i < grid.size(); ++i) grid[i] = i / 150.0;
+  auto out = std::vector<double>(grid.size());
+  EXPECT_EQ(sample(proxy, grid, out), grid.size());
+  for (auto i = std::size_t{0}; i < grid.size(); ++i) {
+    EXPECT_NEAR(out[i], f(grid[i]), 1e-13);
+  }
+}
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Sparse.hpp>
+#include <NumericConcepts/Tensor.hpp>
+#include <complex>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace NumericConcepts;
+
+namespace {
+
+// Returns reproducible values in [-1, 1).
+struct Generator {
+  unsigned state;
+  double operator()() {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<double>(state >> 8) / (1 << 23) - 1.0;
+  }
+};
+
+// A sparse m by n matrix, as triplets and as a dense row-major array, with
+// a few long rows among many short or empty ones.
+template <typename T>
+struct Problem {
+  std::vector<std::tuple<int, int, T>> triplets;
+  std::vector<T> dense;
+};
+
+template <typename T>
+Problem<T> problem(std::size_t m, std::size_t n, unsigned seed) {
+  auto next = Generator{seed};
+  auto p = Problem<T>{{}, std::vector<T>(m * n)};
+  for (auto i = std::size_t{0}; i < m; ++i) {
+    auto count = i % 17 == 0 ? n / 2 : i % 3;
+    for (auto k = std::size_t{0}; k < count; ++k) {
+      auto j = static_cast<std::size_t>((next() + 1.0) / 2.0 * n) % n;
+      auto value = T{};
+      if constexpr (Complex<T>) {
+        auto re = next();
+        value = T(re, next());
+      } else {
+        value = static_cast<T>(next());
+      }
+      p.triplets.emplace_back(static_cast<int>(i), static_cast<int>(j), value);
+      p.dense[i * n + j] += value;
+    }
+  }
+  return p;
+}
+
+template <typename T>
+std::vector<T> values(std::size_t n, unsigned seed) {
+  auto next = Generator{seed};
+  auto v = std::vector<T>(n);
+  for (auto& x : v) x = static_cast<T>(next());
+  return v;
+}
+
+}  // namespace
+
+TEST(SparseTests, Concepts) {
+  static_assert(SparseRealRange<std::vector<std::pair<int, double>>>);
+  static_assert(SparseComplexRange<std::map<long, std::complex<float>>>);
+  static_assert(
+      SparseRealOrComplexRange<std::vector<std::tuple<unsigned, float>>>);
+  static_assert(!SparseRange<std::vector<double>>);
+  static_assert(!SparseRange<std::vector<std::pair<double, double>>>);
+  static_assert(std::same_as<
+                SparseIndex<std::map<long, double>>, long>);
+
+  static_assert(CsrSparseMatrix<CsrMatrix<double>>);
+  static_assert(CscSparseMatrix<CscMatrix<std::complex<float>, long>>);
+  static_assert(!CscSparseMatrix<CsrMatrix<double>>);
+  static_assert(RealOrComplexRange<decltype(CsrMatrix<double>{}.values())>);
+  static_assert(IntegralRange<decltype(CsrMatrix<double>{}.indices())>);
+  static_assert(!CompressedSparseMatrix<MatrixSpan<double>>);
+
+  auto x = std::map<int, double>{{1, 2.0}, {3, -1.0}};
+  auto y = std::vector<double>{5.0, 1.0, 7.0, 4.0};
+  EXPECT_EQ(sparse_dot(x, y), -2.0);
+}
+
+TEST(SparseTests, Construction) {
+  auto triplets = std::vector<std::tuple<int, int, double>>{
+      {1, 2, 1.0}, {0, 1, 2.0}, {1, 0, 3.0}, {1, 2, 4.0}};
+  auto a = CsrMatrix<double>::from_triplets(3, 3, triplets);
+  EXPECT_EQ(a.nonzeros(), 3u);
+  EXPECT_EQ(std::vector(a.offsets().begin(), a.offsets().end()),
+            (std::vector<std::size_t>{0, 1, 3, 3}));
+  EXPECT_EQ(std::vector(a.indices().begin(), a.indices().end()),
+            (std::vector<std::int32_t>{1, 0, 2}));
+  EXPECT_EQ(std::vector(a.values().begin(), a.values().end()),
+            (std::vector<double>{2.0, 3.0, 5.0}));
+
+  auto c = CscMatrix<double>::from_triplets(3, 3, triplets);
+  EXPECT_EQ(std::vector(c.offsets().begin(), c.offsets().end()),
+            (std::vector<std::size_t>{0, 1, 2, 3}));
+  EXPECT_EQ(std::vector(c.indices().begin(), c.indices().end()),
+            (std::vector<std::int32_t>{1, 0, 1}));
+
+  auto t = a.transpose();
+  static_assert(CscSparseMatrix<decltype(t)>);
+  EXPECT_EQ(t.rows(), 3u);
+  EXPECT_EQ(t.values()[2], 5.0);
+
+  EXPECT_THROW(CsrMatrix<double>::from_triplets(2, 2, triplets),
+               std::invalid_argument);
+  EXPECT_THROW(CsrMatrix<double>(2, 2, {0, 1, 1}, {2}, {1.0}),
+               std::invalid_argument);
+  EXPECT_THROW(CsrMatrix<double>(2, 2, {0, 2, 1}, {0, 1}, {1.0, 1.0}),
+               std::invalid_argument);
+  EXPECT_NO_THROW(CsrMatrix<double>(2, 2, {0, 1, 1}, {1}, {1.0}));
+
+  // Indices must fit the index type, which may be unsigned.
+  auto wide = std::vector<std::tuple<int, int, double>>{{0, 300, 1.0}};
+  EXPECT_THROW((CsrMatrix<double, std::uint8_t>::from_triplets(1, 400, wide)),
+               std::invalid_argument);
+  auto narrow = CscMatrix<double, std::uint8_t>::from_triplets(1, 400, wide);
+  EXPECT_EQ(narrow.indices()[0], 0u);
+  EXPECT_THROW((CsrMatrix<double, std::uint16_t>(2, 2, {0, 1, 1}, {2}, {1.0})),
+               std::invalid_argument);
+}
+
+TEST(SparseTests, SpmvMatchesDense) {
+  auto m = std::size_t{500}, n = std::size_t{300};
+  auto p = problem<double>(m, n, 1);
+  auto csr = CsrMatrix<double>::from_triplets(m, n, p.triplets);
+  auto csc = CscMatrix<double>::from_triplets(m, n, p.triplets);
+  auto x = values<double>(n, 2);
+  auto expected = values<double>(m, 3);
+  auto y0 = expected;
+  for (auto i = std::size_t{0}; i < m; ++i) {
+    auto sum = 0.0;
+    for (auto j = std::size_t{0}; j < n; ++j) sum += p.dense[i * n + j] * x[j];
+    expected[i] = 2.0 * sum - 0.5 * expected[i];
+  }
+  auto pool = ThreadPool({.threads = 4});
+  for (auto grain : {std::size_t{16}, std::size_t{1} << 20}) {
+    auto y = y0;
+    spmv(2.0, csr, x, -0.5, y, {.grain = grain, .pool = &pool});
+    for (auto i = std::size_t{0}; i < m; ++i) {
+      EXPECT_NEAR(y[i], expected[i], 1e-12);
+    }
+    y = y0;
+    spmv(2.0, csc, x, -0.5, y, {.grain = grain, .pool = &pool});
+    for (auto i = std::size_t{0}; i < m; ++i) {
+      EXPECT_NEAR(y[i], expected[i], 1e-12);
+    }
+  }
+  auto y = std::vector<double>(m);
+  EXPECT_THROW(spmv(1.0, csr, y, 0.0, y), std::invalid_argument);
+}
+
+TEST(SparseTests, ComplexSpmv) {
+  using Z = std::complex<double>;
+  auto triplets = std::vector<std::tuple<int, int, Z>>{{0, 0, Z(0, 1)},
+                                                       {1, 0, Z(2, 0)},
+                                                       {1, 1, Z(1, -1)}};
+  auto a = CsrMatrix<Z>::from_triplets(2, 2, triplets);
+  auto x = std::vector<double>{1.0, 2.0};
+  auto y = std::vector<Z>(2, Z(std::nan(""), 0));
+  spmv(1.0, a, x, 0.0, y);
+  EXPECT_EQ(y[0], Z(0, 1));
+  EXPECT_EQ(y[1], Z(4, -2));
+}
+
+TEST(SparseTests, SpmmMatchesDense) {
+  auto m = std::size_t{200}, k = std::size_t{150}, n = std::size_t{7};
+  auto p = problem<float>(m, k, 4);
+  auto csr = CsrMatrix<float>::from_triplets(m, k, p.triplets);
+  auto csc = CscMatrix<float>::from_triplets(m, k, p.triplets);
+  auto bv = values<float>(k * n, 5);
+  auto c0 = values<float>(m * n, 6);
+  auto expected = c0;
+  for (auto i = std::size_t{0}; i < m; ++i) {
+    for (auto j = std::size_t{0}; j < n; ++j) {
+      auto sum = 0.0f;
+      for (auto q = std::size_t{0}; q < k; ++q) {
+        sum += p.dense[i * k + q] * bv[q * n + j];
+      }
+      expected[i * n + j] = sum + 3.0f * c0[i * n + j];
+    }
+  }
+  auto b = MatrixSpan<const float>(bv.data(), k, n);
+  auto pool = ThreadPool({.threads = 4});
+  auto cv = c0;
+  spmm(1.0f, csr, b, 3.0f, MatrixSpan<float>(cv.data(), m, n),
+       {.grain = 64, .pool = &pool});
+  for (auto i = std::size_t{0}; i < cv.size(); ++i) {
+    EXPECT_NEAR(cv[i], expected[i], 1e-4f);
+  }
+  // A column-major c holding the same matrix.
+  auto lv = std::vector<float>(m * n);
+  for (auto i = std::size_t{0}; i < m; ++i) {
+    for (auto j = std::size_t{0}; j < n; ++j) lv[i + j * m] = c0[i * n + j];
+  }
+  auto l = MatrixSpan<float, LayoutLeft>(lv.data(), m, n);
+  spmm(1.0f, csc, b, 3.0f, l, {.grain = 64, .pool = &pool});
+  for (auto i = std::size_t{0}; i < m; ++i) {
+    for (auto j = std::size_t{0}; j < n; ++j) {
+      EXPECT_NEAR(l(i, j), expected[i * n + j], 1e-4f);
+    }
+  }
+  EXPECT_THROW(spmm(1.0f, csr, MatrixSpan<const float>(bv.data(), n, k), 0.0f,
+                    l),
+               std::invalid_argument);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Algorithms.hpp>
+#include <NumericConcepts/NumericConcepts.hpp>
+#include <NumericConcepts/SplitComplex.hpp>
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+using namespace NumericConcepts;
+
+TEST(SplitComplexTests, SatisfiesComplexConcepts) {
+  using Vec = SplitComplexVector<double>;
+  static_assert(Complex<SplitComplexReference<double>>);
+  static_assert(Complex<SplitComplexReference<const float>>);
+  static_assert(ComplexIterator<Vec::iterator>);
+  static_assert(ComplexWritableIterator<Vec::iterator>);
+  static_assert(std::random_access_iterator<Vec::const_iterator>);
+  static_assert(ComplexRange<Vec>);
+  static_assert(ComplexRange<const Vec>);
+  static_assert(ComplexWritableRange<Vec>);
+  static_assert(!ComplexWritableRange<const Vec>);
+  static_assert(std::same_as<RangePrecision<Vec>, double>);
+  static_assert(SameRangePrecision<Vec, std::vector<double>>);
+  static_assert(SplitComplexWritableRange<Vec>);
+  static_assert(SplitComplexRange<const Vec>);
+  static_assert(!SplitComplexRange<std::vector<std::complex<double>>>);
+}
+
+TEST(SplitComplexTests, StorageAndProxies) {
+  auto v = SplitComplexVector<float>{{1, 2}, {3, 4}};
+  EXPECT_EQ(v.size(), 2u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.real_data()) % 64, 0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.imag_data()) % 64, 0u);
+
+  v[0] = std::complex<float>(5, 6);
+  EXPECT_EQ(v.real_data()[0], 5.0f);
+  EXPECT_EQ(v.imag_data()[0], 6.0f);
+
+  v.push_back({7, 8});
+  std::ranges::reverse(v);
+  auto values = std::vector<std::complex<float>>(v.begin(), v.end());
+  EXPECT_EQ(values, (std::vector<std::complex<float>>{{7, 8}, {3, 4}, {5, 6}}));
+}
+
+TEST(SplitComplexTests, AlgorithmsMatchInterleaved) {
+  using C = std::complex<double>;
+  auto a = std::vector<C>(29), b = std::vector<C>(29);
+  for (auto i = 0; i < 29; ++i) {
+    a[i] = C(i, 1.0 - i);
+    b[i] = C(0.5 * i, 2.0);
+  }
+  auto sa = SplitComplexVector<double>(a), sb = SplitComplexVector<double>(b);
+
+  EXPECT_EQ(dot(sa, sb), dot(a, b));
+  EXPECT_EQ(dotc(sa, sb), dotc(a, b));
+  EXPECT_DOUBLE_EQ(asum(sa), asum(a));
+  EXPECT_DOUBLE_EQ(nrm2(sa), nrm2(a));
+
+  axpy(C(2, -1), a, b);
+  axpy(C(2, -1), sa, sb);
+  scal(C(0, 1), b);
+  scal(C(0, 1), sb);
+  for (auto i = 0; i < 29; ++i) EXPECT_EQ(sb[i], b[i]);
+}
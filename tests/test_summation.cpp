@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/Summation.hpp>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <vector>
+
+using namespace NumericConcepts;
+
+TEST(SummationTests, CompensatedSumsAreAccurate) {
+  // 1 followed by many values that are lost to naive float summation.
+  auto x = std::vector<float>(1'000'000, 1e-8f);
+  x.front() = 1.0f;
+  auto exact = 1.0 + 1e-8 * (x.size() - 1);
+
+  EXPECT_GT(std::abs(sum(x, NaiveSum{}) - exact), 1e-5);
+  EXPECT_NEAR(sum(x, PairwiseSum{}), exact, 1e-6);
+  EXPECT_NEAR(sum(x, KahanSum{}), exact, 1e-6);
+  EXPECT_NEAR(sum(x, NeumaierSum{}), exact, 1e-6);
+
+  // Large cancelling terms defeat Kahan but not Neumaier.
+  auto y = std::vector<double>{1.0, 1e100, 1.0, -1e100};
+  EXPECT_NE(sum(y, KahanSum{}), 2.0);
+  EXPECT_EQ(sum(y, NeumaierSum{}), 2.0);
+}
+
+TEST(SummationTests, ResultIndependentOfThreadCount) {
+  auto x = std::vector<double>(100'003);
+  for (auto i = std::size_t{0}; i < x.size(); ++i) x[i] = 1.0 / (1.0 + i);
+  auto list = std::list<double>(x.begin(), x.end());
+
+  for (auto policy : {0, 1, 2, 3}) {
+    auto reference = 0.0;
+    for (auto threads : {1, 2, 3, 8}) {
+      auto result = policy == 0   ? sum(x, NaiveSum{}, threads)
+                    : policy == 1 ? sum(x, PairwiseSum{}, threads)
+                    : policy == 2 ? sum(x, KahanSum{}, threads)
+                                  : sum(x, NeumaierSum{}, threads);
+      if (threads == 1) reference = result;
+      EXPECT_EQ(result, reference);
+    }
+  }
+  EXPECT_EQ(sum(list), sum(x));
+}
+
+TEST(SummationTests, ComplexAndIntegralRanges) {
+  auto z = std::vector<std::complex<float>>(10, {1.0f, -2.0f});
+  static_assert(std::same_as<decltype(sum(z)), std::complex<float>>);
+  EXPECT_EQ(sum(z), std::complex<float>(10.0f, -20.0f));
+
+  auto n = std::vector<short>(1000, 100);
+  static_assert(std::same_as<decltype(sum(n)), std::int64_t>);
+  EXPECT_EQ(sum(n), 100000);
+
+  // Sums beyond the range of int, in parallel blocks.
+  auto big = std::vector<int>(100'000, std::numeric_limits<int>::max());
+  EXPECT_EQ(sum(big, NeumaierSum{}, 4),
+            std::int64_t{100'000} * std::numeric_limits<int>::max());
+  auto u = std::vector<unsigned>(3, 0xffffffffu);
+  static_assert(std::same_as<decltype(sum(u)), std::uint64_t>);
+  EXPECT_EQ(sum(u), 3 * std::uint64_t{0xffffffff});
+  EXPECT_EQ(sum(std::vector<double>{}), 0.0);
+}
+
+#if defined(__FLT16_MAX__)
+TEST(SummationTests, HalfPrecisionWidensToFloat) {
+  // Every partial sum above 2048 is inexact in _Float16.
+  auto x = std::vector<_Float16>(10000, _Float16(1));
+  static_assert(RealRange<decltype(x)>);
+  static_assert(std::same_as<decltype(sum(x)), float>);
+  EXPECT_EQ(sum(x, NaiveSum{}), 10000.0f);
+}
+#endif
@@ -0,0 +1,320 @@
+#include <gtest/gtest.h>
+
+#include <NumericConcepts/VectorMath.hpp>
+#include <cmath>
+#include <complex>
+#include <deque>
+#include <limits>
+#include <list>
+#include <ranges>
+#include <vector>
+
+using namespace NumericConcepts;
+
+namespace {
+
+// Returns reproducible values in [lo, hi).
+template <typename T>
+std::vector<T> uniform(double lo, double hi, std::size_t n, unsigned seed) {
+  auto v = std::vector<T>(n);
+  for (auto& x : v) {
+    seed = seed * 1664525u + 1013904223u;
+    x = static_cast<T>(lo + (hi - lo) * (seed >> 8) / double(1 << 24));
+  }
+  return v;
+}
+
+// Returns the distance of y from the exact value in units in the last place
+// of the exact value, rounded to T.
+template <typename T>
+long double ulps(T y, long double exact) {
+  if (std::isnan(exact)) return std::isnan(y) ? 0 : 1e9;
+  auto e = 0;
+  std::frexp(exact, &e);
+  e = std::max(e, std::numeric_limits<T>::min_exponent);
+  auto ulp = std::ldexp(1.0L, e - std::numeric_limits<T>::digits);
+  return std::fabs(y - exact) / ulp;
+}
+
+// Returns the instruction sets supported by this CPU.
+std::vector<InstructionSet> instruction_sets() {
+  auto all = std::vector<InstructionSet>{};
+  for (auto isa : {InstructionSet::Scalar, InstructionSet::Sse42,
+                   InstructionSet::Avx2, InstructionSet::Avx512}) {
+    if (isa <= supported_instruction_set()) all.push_back(isa);
+  }
+  return all;
+}
+
+// Checks that f writes values within bound ulps of exact for each isa.
+template <typename T, typename F, typename Exact>
+void expect_accurate(const std::vector<T>& x, F f, Exact exact,
+                     long double bound) {
+  for (auto isa : instruction_sets()) {
+    auto y = std::vector<T>(x.size());
+    EXPECT_EQ(f(x, y, VectorMathOptions{isa}), x.size());
+    auto worst = 0.0L;
+    for (auto i = std::size_t{0}; i < x.size(); ++i) {
+      auto expected = exact(static_cast<long double>(x[i]));
+      worst = std::max(worst, ulps(y[i], expected));
+    }
+    EXPECT_LE(worst, bound) << "instruction set " << static_cast<int>(isa);
+  }
+}
+
+template <typename T>
+void check_real_accuracy(long double bound) {
+  auto n = std::size_t{20000};
+  auto exp = [](auto& x, auto& y, auto o) { return vector_exp(x, y, o); };
+  auto log = [](auto& x, auto& y, auto o) { return vector_log(x, y, o); };
+  auto sin = [](auto& x, auto& y, auto o) { return vector_sin(x, y, o); };
+  auto cos = [](auto& x, auto& y, auto o) { return vector_cos(x, y, o); };
+  auto sqrt = [](auto& x, auto& y, auto o) { return vector_sqrt(x, y, o); };
+  auto exact_exp = [](long double x) { return std::exp(x); };
+  auto exact_log = [](long double x) { return std::log(x); };
+  auto exact_sin = [](long double x) { return std::sin(x); };
+  auto exact_cos = [](long double x) { return std::cos(x); };
+  auto exact_sqrt = [](long double x) { return std::sqrt(x); };
+  auto wide = std::is_same_v<T, double> ? 700.0 : 80.0;
+  expect_accurate(uniform<T>(-wide, wide, n, 1), exp, exact_exp, bound);
+  expect_accurate(uniform<T>(-1.0, 1.0, n, 2), exp, exact_exp, bound);
+  auto positive = uniform<T>(-wide, wide, n, 3);
+  for (auto& x : positive) x = std::exp(x);
+  expect_accurate(positive, log, exact_log, bound);
+  expect_accurate(uniform<T>(0.5, 2.0, n, 4), log, exact_log, bound);
+  expect_accurate(positive, sqrt, exact_sqrt, 0.5L);
+  for (auto range : {10.0, 1e6}) {
+    expect_accurate(uniform<T>(-range, range, n, 5), sin, exact_sin, bound);
+    expect_accurate(uniform<T>(-range, range, n, 6), cos, exact_cos, bound);
+  }
+  // The nearest values to multiples of pi / 2 have the largest cancellation.
+  auto multiples = std::vector<T>{};
+  for (auto k = 1; k < 100000; k += 17) {
+    multiples.push_back(static_cast<T>(k * 1.5707963267948966192313216916L));
+  }
+  expect_accurate(multiples, sin, exact_sin, bound);
+  expect_accurate(multiples, cos, exact_cos, bound);
+}
+
+}  // namespace
+
+TEST(VectorMathTests, InstructionSets) {
+  auto isa = supported_instruction_set();
+  EXPECT_EQ(isa, supported_instruction_set());
+#if !defined(__x86_64__) || defined(__clang__) || \
+    defined(NUMERIC_CONCEPTS_NO_SIMD)
+  EXPECT_EQ(isa, InstructionSet::Scalar);
+#endif
+#ifdef __AVX2__
+  EXPECT_GE(isa, InstructionSet::Avx2);
+#endif
+  // The scalar path calls the standard functions.
+  auto x = uniform<double>(-5.0, 5.0, 100, 7);
+  auto y = std::vector<double>(x.size());
+  vector_sin(x, y, {.limit = InstructionSet::Scalar});
+  for (auto i = std::size_t{0}; i < x.size(); ++i) {
+    EXPECT_EQ(y[i], std::sin(x[i]));
+  }
+}
+
+TEST(VectorMathTests, RealAccuracy) {
+  check_real_accuracy<double>(1.0L);
+  check_real_accuracy<float>(1.0L);
+
+  // Bases near 1 with large exponents need log(x) in extra precision.
+  auto n = std::size_t{20000};
+  auto moderate = uniform<double>(-12.0, 12.0, n, 8);
+  for (auto& x : moderate) x = std::exp(x);
+  auto near_one = uniform<double>(0.99, 1.01, n, 9);
+  auto exponent = uniform<double>(-60.0, 60.0, n, 10);
+  auto large = exponent;
+  for (auto& e : large) e *= 1000.0;
+  for (auto isa : instruction_sets()) {
+    for (auto [base, power] : {std::pair{&moderate, &exponent},
+                               std::pair{&near_one, &large}}) {
+      auto y = std::vector<double>(n);
+      vector_pow(*base, *power, y, {isa});
+      auto worst = 0.0L;
+      for (auto i = std::size_t{0}; i < n; ++i) {
+        auto exact = std::pow(static_cast<long double>((*base)[i]),
+                              static_cast<long double>((*power)[i]));
+        worst = std::max(worst, ulps(y[i], exact));
+      }
+      EXPECT_LE(worst, 1.0L) << "instruction set " << static_cast<int>(isa);
+    }
+  }
+}
+
+TEST(VectorMathTests, SpecialValues) {
+  auto inf = std::numeric_limits<double>::infinity();
+  auto nan = std::numeric_limits<double>::quiet_NaN();
+  auto x = std::vector<double>{0.0,   -0.0,    1.0,    -1.0,   inf,  -inf,
+                               nan,   710.0,   -750.0, 1e-310, 1e300, -1e300,
+                               1e20,  -708.5,  709.5,  5e-324, 1.0,  2.0};
+  auto y = std::vector<double>{2.0, 0.5, inf, -inf, nan, 0.0, 3.0, -2.0, 0.5,
+                               1e10, -1e10, 2.0, 0.5, 1.0, 1.0, 0.5, nan, 1e3};
+  // Results must match the standard functions where either is special, and
+  // be accurate elsewhere.
+  auto agree = [](double a, double b, long double exact) {
+    if (std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b);
+    if (!std::isnormal(b) || std::isinf(exact)) {
+      return a == b && std::signbit(a) == std::signbit(b);
+    }
+    return ulps(a, exact) <= 1.0L;
+  };
+  auto wide = [](double v) { return static_cast<long double>(v); };
+  for (auto isa : instruction_sets()) {
+    auto options = VectorMathOptions{isa};
+    auto out = std::vector<double>(x.size());
+    vector_exp(x, out, options);
+    for (auto i = std::size_t{0}; i < x.size(); ++i) {
+      EXPECT_TRUE(agree(out[i], std::exp(x[i]), std::exp(wide(x[i])))) << x[i];
+    }
+    vector_log(x, out, options);
+    for (auto i = std::size_t{0}; i < x.size(); ++i) {
+      EXPECT_TRUE(agree(out[i], std::log(x[i]), std::log(wide(x[i])))) << x[i];
+    }
+    vector_cos(x, out, options);
+    for (auto i = std::size_t{0}; i < x.size(); ++i) {
+      EXPECT_TRUE(agree(out[i], std::cos(x[i]), std::cos(wide(x[i])))) << x[i];
+    }
+    vector_sqrt(x, out, options);
+    for (auto i = std::size_t{0}; i < x.size(); ++i) {
+      EXPECT_TRUE(agree(out[i], std::sqrt(x[i]), std::sqrt(wide(x[i]))))
+          << x[i];
+    }
+    vector_pow(x, y, out, options);
+    for (auto i = std::size_t{0}; i < x.size(); ++i) {
+      auto exact = std::pow(wide(x[i]), wide(y[i]));
+      EXPECT_TRUE(agree(out[i], std::pow(x[i], y[i]), exact))
+          << x[i] << "^" << y[i];
+    }
+  }
+}
+
+TEST(VectorMathTests, ComplexFunctions) {
+  using Z = std::complex<double>;
+  auto n = std::size_t{20000};
+  auto re = uniform<double>(-700.0, 700.0, n, 11);
+  auto im = uniform<double>(-100.0, 100.0, n, 12);
+  auto z = std::vector<Z>(n);
+  for (auto i = std::size_t{0}; i < n; ++i) z[i] = Z(re[i], im[i]);
+  z[0] = Z(0.0, 0.0);
+  z[1] = Z(-1.0, -0.0);
+  z[2] = Z(std::numeric_limits<double>::infinity(), 1.0);
+  z[3] = Z(1e-320, -1e-320);
+  for (auto isa : instruction_sets()) {
+    auto options = VectorMathOptions{isa};
+    auto w = std::vector<Z>(n);
+    auto r = std::vector<double>(n);
+    auto a = std::vector<double>(n);
+    EXPECT_EQ(vector_exp(z, w, options), n);
+    vector_abs(z, r, options);
+    vector_arg(z, a, options);
+    auto worst = std::vector<long double>(4);
+    for (auto i = std::size_t{4}; i < n; ++i) {
+      auto exact = std::complex<long double>(z[i].real(), z[i].imag());
+      auto e = std::exp(exact);
+      worst[0] = std::max(worst[0], ulps(w[i].real(), e.real()));
+      worst[1] = std::max(worst[1], ulps(w[i].imag(), e.imag()));
+      worst[2] = std::max(worst[2], ulps(r[i], std::abs(exact)));
+      worst[3] = std::max(worst[3], ulps(a[i], std::arg(exact)));
+    }
+    EXPECT_LE(worst[0], 2.5L);
+    EXPECT_LE(worst[1], 2.5L);
+    EXPECT_LE(worst[2], 1.5L);
+    EXPECT_LE(worst[3], 2.0L);
+    for (auto i = std::size_t{0}; i < 4; ++i) {
+      EXPECT_EQ(r[i], std::abs(z[i]));
+      EXPECT_EQ(a[i], std::arg(z[i]));
+    }
+    EXPECT_EQ(w[0], Z(1.0, 0.0));
+    EXPECT_EQ(w[2], std::exp(z[2]));
+  }
+
+  // Float elements are computed in double and rounded.
+  auto zf = std::vector<std::complex<float>>(z.begin() + 4, z.end());
+  for (auto& v : zf) v /= 10.0f;
+  auto wf = zf;
+  vector_exp(wf, wf);
+  for (auto i = std::size_t{0}; i < zf.size(); ++i) {
+    auto e = std::exp(std::complex<long double>(zf[i].real(), zf[i].imag()));
+    EXPECT_LE(ulps(wf[i].real(), e.real()), 1.0L);
+    EXPECT_LE(ulps(wf[i].imag(), e.imag()), 1.0L);
+  }
+}
+
+TEST(VectorMathTests, Ranges) {
+  auto x = uniform<double>(-3.0, 3.0, 1000, 13);
+  auto expected = std::vector<double>(x.size());
+  vector_exp(x, expected);
+
+  // Non-contiguous ranges are staged in blocks.
+  auto list = std::list<double>(x.begin(), x.end());
+  auto deque = std::deque<double>(x.size());
+  EXPECT_EQ(vector_exp(list, deque), x.size());
+  EXPECT_TRUE(std::ranges::equal(deque, expected));
+  auto view = x | std::views::transform([](double v) { return v; });
+  auto out = std::vector<double>(x.size());
+  EXPECT_EQ(vector_exp(view, out), x.size());
+  EXPECT_EQ(out, expected);
+
+  // The output may be the input, and the shorter range bounds the output.
+  out = x;
+  vector_exp(out, out);
+  EXPECT_EQ(out, expected);
+  auto shorter = std::vector<double>(10, -1.0);
+  EXPECT_EQ(vector_exp(x, shorter), 10u);
+  EXPECT_TRUE(std::equal(shorter.begin(), shorter.end(), expected.begin()));
+  EXPECT_EQ(vector_exp(list, shorter), 10u);
+  EXPECT_EQ(vector_pow(x, std::vector<double>(3, 2.0), out), 3u);
+  EXPECT_DOUBLE_EQ(out[2], x[2] * x[2]);
+
+  // Float inputs may be written to double outputs, and long double elements
+  // use the standard functions.
+  auto xf = std::vector<float>(x.begin(), x.end());
+  vector_sin(xf, out);
+  for (auto i = std::size_t{0}; i < x.size(); ++i) {
+    EXPECT_EQ(out[i], static_cast<float>(out[i]));
+    auto exact = std::sin(static_cast<long double>(xf[i]));
+    EXPECT_LE(ulps(static_cast<float>(out[i]), exact), 1.0L);
+  }
+  auto xl = std::vector<long double>(x.begin(), x.end());
+  auto yl = std::vector<long double>(x.size());
+  vector_log(xl, yl);
+  EXPECT_TRUE(std::isnan(yl[0]) || yl[0] == std::log(xl[0]));
+  auto p = std::vector<long double>{2.0L};
+  vector_pow(p, std::vector<float>{0.5f}, yl);
+  EXPECT_EQ(yl[0], std::sqrt(2.0L));
+}
+
+TEST(VectorMathTests, ExtendedTypes) {
+  // Extended types have no std overloads and are evaluated in long double.
+  auto x = std::vector<double>{0.25, 1.0, 2.0};
+  auto expected = std::vector<long double>(x.size());
+  auto xl = std::vector<long double>(x.begin(), x.end());
+  vector_sqrt(xl, expected);
+#if defined(__FLT16_MAX__)
+  auto xh = std::vector<_Float16>(x.begin(), x.end());
+  auto yh = std::vector<_Float16>(x.size());
+  EXPECT_EQ(vector_sqrt(xh, yh), x.size());
+  for (auto i = std::size_t{0}; i < x.size(); ++i) {
+    EXPECT_EQ(yh[i], static_cast<_Float16>(expected[i]));
+  }
+#endif
+#if defined(__SIZEOF_FLOAT128__)
+  auto xq = std::vector<__float128>(x.begin(), x.end());
+  auto yq = std::vector<__float128>(x.size());
+  EXPECT_EQ(vector_sqrt(xq, yq), x.size());
+  for (auto i = std::size_t{0}; i < x.size(); ++i) {
+    EXPECT_EQ(yq[i], static_cast<__float128>(expected[i]));
+  }
+  vector_exp(xq, yq);
+  EXPECT_EQ(yq[1], static_cast<__float128>(std::exp(1.0L)));
+  vector_log(xq, yq);
+  vector_sin(xq, yq);
+  vector_cos(xq, yq);
+  vector_pow(xq, xq, yq);
+  EXPECT_EQ(yq[2], static_cast<__float128>(4));
+#endif
+}